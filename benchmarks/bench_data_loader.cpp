@@ -0,0 +1,36 @@
+#include "benchmark.hpp"
+#include <NovaML/Data/data_loader.hpp>
+#include <cstdio>
+#include <fstream>
+
+using namespace NovaML;
+namespace Bench = NovaML::Bench;
+
+namespace
+{
+    // One shuffled epoch of a mapped binary file; the size is the record count
+    // (64 inputs + 1 target, batches of 256).
+    void data_loader_epoch(Bench::State &state)
+    {
+        constexpr size_t record = 65;
+        const std::string path = "bench_data_loader_" + std::to_string(state.size()) + ".bin";
+        {
+            std::vector<float> values(state.size() * record);
+            for (size_t i = 0; i < values.size(); i++)
+                values[i] = static_cast<float>(i % 1000) * 0.001f;
+            std::ofstream(path, std::ios::binary).write(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(float));
+        }
+        Data::DataLoaderOptions options;
+        options.batch_size = 256;
+        options.shuffle_buffer = 8192;
+        options.prefetch = 4;
+        Data::DataLoader<float> loader(std::make_shared<Data::BinaryFileSource<float>>(path, record), record - 1, options);
+        Data::Batch<float> batch;
+        for (auto _ : state)
+            while (loader.next(batch))
+                Bench::do_not_optimize(batch);
+        state.set_bytes(double(state.size() * record * sizeof(float)));
+        std::remove(path.c_str());
+    }
+    NOVAML_BENCHMARK(data_loader_epoch, 1 << 14, 1 << 17);
+}
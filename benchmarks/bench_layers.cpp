@@ -0,0 +1,269 @@
+#include "benchmark.hpp"
+#include <NovaML/Core/Layer/dense.hpp>
+#include <NovaML/Core/Layer/conv2d.hpp>
+#include <NovaML/Core/Layer/normalization.hpp>
+#include <NovaML/Core/Activation/relu.hpp>
+#include <NovaML/Core/Activation/sigmoid.hpp>
+#include <NovaML/Core/Module/sequential.hpp>
+#include <NovaML/Core/Loss/mse.hpp>
+#include <NovaML/Core/Optimizer/sgd.hpp>
+#include <NovaML/Core/Optimizer/adam.hpp>
+#include <NovaML/Core/Quantization/quantized_sequential.hpp>
+#include <NovaML/Parallel/data_parallel.hpp>
+#include <cmath>
+
+using namespace NovaML::Core;
+namespace Bench = NovaML::Bench;
+
+namespace
+{
+    // Layer benchmarks use the size as the batch dimension.
+    constexpr size_t in_features = 512, out_features = 256;
+
+    Tensor<float> batch_input(size_t batch, size_t features)
+    {
+        std::vector<float> v(batch * features);
+        for (size_t i = 0; i < v.size(); i++)
+            v[i] = 0.5f * std::sin(0.11f * static_cast<float>(i));
+        return Tensor<float>(v, Shape{batch, features});
+    }
+
+    void dense_forward(Bench::State &state)
+    {
+        NoGradGuard no_grad;
+        const size_t batch = state.size();
+        LayerModule::Dense<float> layer(in_features, out_features);
+        Tensor<float> x = batch_input(batch, in_features);
+        for (auto _ : state)
+            Bench::do_not_optimize(layer.forward(x));
+        state.set_flops(2.0 * batch * in_features * out_features);
+        state.set_bytes(((batch + out_features) * in_features + batch * out_features) * sizeof(float));
+        state.set_label("Dense(512->256)");
+    }
+    NOVAML_BENCHMARK(dense_forward, 1, 32, 256);
+
+    // Same layer on bf16 storage: half the weight bytes, fp32 accumulation
+    void dense_forward_bf16(Bench::State &state)
+    {
+        NoGradGuard no_grad;
+        const size_t batch = state.size();
+        LayerModule::Dense<bfloat16> layer(in_features, out_features);
+        const auto x32 = batch_input(batch, in_features).get_data();
+        Tensor<bfloat16> x(std::vector<bfloat16>(x32.begin(), x32.end()), Shape{batch, in_features});
+        for (auto _ : state)
+            Bench::do_not_optimize(layer.forward(x));
+        state.set_flops(2.0 * batch * in_features * out_features);
+        state.set_bytes(((batch + out_features) * in_features + batch * out_features) * sizeof(bfloat16));
+        state.set_label("Dense(512->256) bf16");
+    }
+    NOVAML_BENCHMARK(dense_forward_bf16, 1, 32, 256);
+
+    void dense_forward_backward(Bench::State &state)
+    {
+        const size_t batch = state.size();
+        LayerModule::Dense<float> layer(in_features, out_features);
+        Tensor<float> x = batch_input(batch, in_features);
+        Tensor<float> g = batch_input(batch, out_features);
+        for (auto _ : state)
+        {
+            Bench::do_not_optimize(layer.forward(x));
+            Bench::do_not_optimize(layer.backward(g));
+        }
+        // one GEMM forward, two backward
+        state.set_flops(6.0 * batch * in_features * out_features);
+        state.set_label("Dense(512->256)");
+    }
+    NOVAML_BENCHMARK(dense_forward_backward, 1, 32, 256);
+
+    // -------------------------
+    // Convolution: 3x3, stride 1, same padding on a batch of 8 32x32
+    // images; the size is the channel count (in = out). FLOPs are those
+    // of the direct convolution, so both algorithms are comparable.
+    // -------------------------
+    constexpr size_t conv_batch = 8, conv_side = 32;
+
+    void conv3x3_forward(Bench::State &state, LayerModule::ConvAlgorithm algorithm, LayerModule::DataFormat format)
+    {
+        NoGradGuard no_grad;
+        const size_t channels = state.size();
+        LayerModule::Conv2D<float> conv(channels, channels, 3, {1, 1, format, Kernel::Activation::ReLU, algorithm});
+        const size_t pixels = conv_side * conv_side;
+        Tensor<float> x = batch_input(conv_batch * pixels, channels);
+        x = Tensor<float>(x.get_storage(), Layout::contiguous(LayerModule::ImageShape{conv_batch, channels, conv_side, conv_side}.to_shape(format)));
+        for (auto _ : state)
+            Bench::do_not_optimize(conv.forward(x));
+        state.set_flops(2.0 * conv_batch * pixels * channels * channels * 9);
+        state.set_bytes((2.0 * conv_batch * pixels * channels + 9.0 * channels * channels) * sizeof(float));
+        state.set_label(conv.info(std::cout) + (conv.uses_winograd() ? " winograd" : " im2col"));
+    }
+
+    void conv3x3_im2col(Bench::State &state) { conv3x3_forward(state, LayerModule::ConvAlgorithm::Im2col, LayerModule::DataFormat::NCHW); }
+    NOVAML_BENCHMARK(conv3x3_im2col, 8, 32, 64, 128);
+
+    void conv3x3_winograd(Bench::State &state) { conv3x3_forward(state, LayerModule::ConvAlgorithm::Winograd, LayerModule::DataFormat::NCHW); }
+    NOVAML_BENCHMARK(conv3x3_winograd, 8, 32, 64, 128);
+
+    void conv3x3_im2col_nhwc(Bench::State &state) { conv3x3_forward(state, LayerModule::ConvAlgorithm::Im2col, LayerModule::DataFormat::NHWC); }
+    NOVAML_BENCHMARK(conv3x3_im2col_nhwc, 8, 32, 64, 128);
+
+    void conv3x3_winograd_nhwc(Bench::State &state) { conv3x3_forward(state, LayerModule::ConvAlgorithm::Winograd, LayerModule::DataFormat::NHWC); }
+    NOVAML_BENCHMARK(conv3x3_winograd_nhwc, 8, 32, 64, 128);
+
+    void batch_norm_train(Bench::State &state)
+    {
+        const size_t channels = state.size();
+        LayerModule::BatchNorm<float> bn(channels);
+        Tensor<float> x = batch_input(conv_batch * conv_side * conv_side, channels);
+        x = Tensor<float>(x.get_storage(), Layout::contiguous(Shape{conv_batch, channels, conv_side, conv_side}));
+        for (auto _ : state)
+        {
+            Bench::do_not_optimize(bn.forward(x));
+            Bench::do_not_optimize(bn.backward(x));
+        }
+        state.set_bytes(6.0 * x.size() * sizeof(float));
+        state.set_label(bn.info(std::cout) + " forward+backward");
+    }
+    NOVAML_BENCHMARK(batch_norm_train, 8, 32, 128);
+
+    // -------------------------
+    // End to end: one optimizer step of a small MLP on a mini-batch
+    // -------------------------
+    constexpr size_t train_sizes[] = {256, 512, 256, 10};
+
+    std::shared_ptr<Module::Sequential<float>> train_model()
+    {
+        auto model = std::make_shared<Module::Sequential<float>>();
+        for (size_t l = 0; l + 1 < std::size(train_sizes); l++)
+        {
+            model->add(std::make_shared<LayerModule::Dense<float>>(train_sizes[l], train_sizes[l + 1]));
+            if (l + 2 < std::size(train_sizes))
+                model->add(std::make_shared<ActivationModule::ReLU<float>>());
+        }
+        model->add(std::make_shared<ActivationModule::Sigmoid<float>>());
+        return model;
+    }
+
+    double train_flops(size_t batch)
+    {
+        double macs = 0;
+        for (size_t l = 0; l + 1 < std::size(train_sizes); l++)
+            macs += static_cast<double>(train_sizes[l]) * train_sizes[l + 1];
+        return 6.0 * batch * macs;
+    }
+
+    void sequential_train_step(Bench::State &state)
+    {
+        const size_t batch = state.size();
+        auto model = train_model();
+        LossModule::MSELoss<float> criterion;
+        Tensor<float> x = batch_input(batch, train_sizes[0]);
+        Tensor<float> y = Tensor<float>::zeros({batch, train_sizes[3]});
+
+        for (auto _ : state)
+        {
+            Tensor<float> pred = model->forward(x);
+            Bench::do_not_optimize(criterion.forward(pred, y));
+            model->backward(criterion.backward());
+            model->update(0.01f);
+        }
+        state.set_flops(train_flops(batch));
+        state.set_label("MLP 256-512-256-10");
+    }
+    NOVAML_BENCHMARK(sequential_train_step, 1, 32, 256);
+
+    // The same step with one model replica per thread, each on a shard of the batch
+    void data_parallel_train_step(Bench::State &state)
+    {
+        const size_t batch = state.size();
+        NovaML::Parallel::DataParallel<float> trainer(train_model(), train_model);
+        OptimizerModule::SGD<float> optimizer(trainer.parameters(), 0.01f);
+        Tensor<float> x = batch_input(batch, train_sizes[0]);
+        Tensor<float> y = Tensor<float>::zeros({batch, train_sizes[3]});
+
+        for (auto _ : state)
+        {
+            Bench::do_not_optimize(trainer.backward(x, y));
+            optimizer.step();
+        }
+        state.set_flops(train_flops(batch));
+        state.set_label(std::to_string(trainer.num_replicas()) + " replicas");
+    }
+    NOVAML_BENCHMARK(data_parallel_train_step, 32, 256);
+
+    // -------------------------
+    // Inference: the same MLP in fp32 and after int8 post-training quantization
+    // -------------------------
+    constexpr size_t inference_sizes[] = {512, 1024, 1024, 10};
+
+    std::shared_ptr<Module::Sequential<float>> inference_model()
+    {
+        auto model = std::make_shared<Module::Sequential<float>>();
+        for (size_t l = 0; l + 1 < std::size(inference_sizes); l++)
+        {
+            model->add(std::make_shared<LayerModule::Dense<float>>(inference_sizes[l], inference_sizes[l + 1]));
+            model->add(std::make_shared<ActivationModule::ReLU<float>>());
+        }
+        return model;
+    }
+
+    double inference_macs()
+    {
+        double macs = 0;
+        for (size_t l = 0; l + 1 < std::size(inference_sizes); l++)
+            macs += static_cast<double>(inference_sizes[l]) * inference_sizes[l + 1];
+        return macs;
+    }
+
+    void mlp_inference(Bench::State &state)
+    {
+        NoGradGuard no_grad;
+        auto model = inference_model();
+        Tensor<float> x = batch_input(state.size(), inference_sizes[0]);
+        for (auto _ : state)
+            Bench::do_not_optimize(model->forward(x));
+        state.set_flops(2.0 * state.size() * inference_macs());
+        state.set_bytes(inference_macs() * sizeof(float));
+        state.set_label("MLP 512-1024-1024-10 fp32");
+    }
+    NOVAML_BENCHMARK(mlp_inference, 1, 32, 256);
+
+    void mlp_inference_int8(Bench::State &state)
+    {
+        auto model = inference_model();
+        auto qmodel = QuantizationModule::quantize(*model, {batch_input(64, inference_sizes[0])});
+        Tensor<float> x = batch_input(state.size(), inference_sizes[0]);
+        for (auto _ : state)
+            Bench::do_not_optimize(qmodel->forward(x));
+        state.set_flops(2.0 * state.size() * inference_macs());
+        state.set_bytes(inference_macs());
+        state.set_label("MLP 512-1024-1024-10 int8");
+    }
+    NOVAML_BENCHMARK(mlp_inference_int8, 1, 32, 256);
+
+    // -------------------------
+    // Optimizer steps over a flat buffer; the size is the parameter count
+    // -------------------------
+    void sgd_momentum_step(Bench::State &state)
+    {
+        auto params = std::make_shared<Module::ParameterBuffer<float>>(state.size());
+        std::fill(params->grad.begin(), params->grad.end(), 1e-3f);
+        OptimizerModule::SGD<float> sgd(params, 0.01f, 0.9f);
+        for (auto _ : state)
+            sgd.step();
+        state.set_flops(7.0 * state.size());
+        state.set_bytes(5.0 * state.size() * sizeof(float));
+    }
+    NOVAML_BENCHMARK(sgd_momentum_step, 1 << 16, 1 << 20, 1 << 24);
+
+    void adamw_step(Bench::State &state)
+    {
+        auto params = std::make_shared<Module::ParameterBuffer<float>>(state.size());
+        std::fill(params->grad.begin(), params->grad.end(), 1e-3f);
+        OptimizerModule::AdamW<float> adamw(params);
+        for (auto _ : state)
+            adamw.step();
+        state.set_flops(14.0 * state.size());
+        state.set_bytes(7.0 * state.size() * sizeof(float));
+    }
+    NOVAML_BENCHMARK(adamw_step, 1 << 16, 1 << 20, 1 << 24);
+}
@@ -0,0 +1,32 @@
+#include "benchmark.hpp"
+#include <NovaML/Core/Serialization/checkpoint.hpp>
+#include <NovaML/Core/Module/sequential.hpp>
+#include <NovaML/Core/Layer/dense.hpp>
+#include <NovaML/Core/Activation/relu.hpp>
+#include <cstdio>
+
+using namespace NovaML::Core;
+namespace Bench = NovaML::Bench;
+
+namespace
+{
+    // Model loading; the size is the number of 1024 x 1024 layers (4 MiB of fp32 each).
+    void checkpoint_load(Bench::State &state)
+    {
+        const std::string path = "bench_checkpoint_" + std::to_string(state.size()) + ".novaml";
+        {
+            Module::Sequential<float> model;
+            for (size_t l = 0; l < state.size(); l++)
+            {
+                model.add(std::make_shared<LayerModule::Dense<float>>(1024, 1024));
+                model.add(std::make_shared<ActivationModule::ReLU<float>>());
+            }
+            SerializationModule::save(model, path);
+        }
+        for (auto _ : state)
+            Bench::do_not_optimize(SerializationModule::load<float>(path));
+        state.set_label(std::to_string(state.size() * 4) + " MiB");
+        std::remove(path.c_str());
+    }
+    NOVAML_BENCHMARK(checkpoint_load, 1, 8, 64);
+}
@@ -0,0 +1,80 @@
+#include "benchmark.hpp"
+#include <NovaML/Serving/inference_server.hpp>
+#include <NovaML/Core/Layer/dense.hpp>
+#include <NovaML/Core/Activation/relu.hpp>
+#include <NovaML/Core/Module/sequential.hpp>
+#include <cmath>
+#include <sstream>
+
+using namespace NovaML;
+using namespace NovaML::Core;
+namespace Bench = NovaML::Bench;
+
+namespace
+{
+    // Serving benchmarks answer `size` single-sample requests per iteration
+    // with a 256 -> 512 -> 512 -> 10 ReLU MLP.
+    constexpr size_t features = 256;
+
+    std::shared_ptr<Module::Sequential<float>> serving_model()
+    {
+        auto model = std::make_shared<Module::Sequential<float>>();
+        model->add(std::make_shared<LayerModule::Dense<float>>(features, 512));
+        model->add(std::make_shared<ActivationModule::ReLU<float>>());
+        model->add(std::make_shared<LayerModule::Dense<float>>(512, 512));
+        model->add(std::make_shared<ActivationModule::ReLU<float>>());
+        model->add(std::make_shared<LayerModule::Dense<float>>(512, 10));
+        return model;
+    }
+
+    std::vector<Tensor<float>> requests(size_t n)
+    {
+        std::vector<Tensor<float>> samples;
+        for (size_t r = 0; r < n; r++)
+        {
+            std::vector<float> v(features);
+            for (size_t i = 0; i < features; i++)
+                v[i] = 0.5f * std::sin(0.11f * static_cast<float>(r * features + i));
+            samples.emplace_back(v, Shape{features});
+        }
+        return samples;
+    }
+
+    double model_flops(size_t rows) { return 2.0 * rows * (features * 512 + 512 * 512 + 512 * 10); }
+
+    // Baseline: one infer() call per request, in arrival order.
+    void serving_per_sample(Bench::State &state)
+    {
+        auto model = serving_model();
+        const auto samples = requests(state.size());
+        for (auto _ : state)
+            for (const auto &x : samples)
+                Bench::do_not_optimize(model->infer(x));
+        state.set_flops(model_flops(state.size()));
+    }
+    NOVAML_BENCHMARK(serving_per_sample, 256, 2048);
+
+    // All requests in flight at once, merged by the server into batches of up to 64.
+    void serving_dynamic_batch(Bench::State &state)
+    {
+        Serving::ServerOptions options;
+        options.max_batch_size = 64;
+        options.max_delay = std::chrono::microseconds(500);
+        options.num_workers = 2;
+        Serving::InferenceServer<float> server(serving_model(), features, options);
+        const auto samples = requests(state.size());
+        std::vector<std::future<Tensor<float>>> results(samples.size());
+        for (auto _ : state)
+        {
+            for (size_t r = 0; r < samples.size(); r++)
+                results[r] = server.submit(samples[r]);
+            for (auto &y : results)
+                Bench::do_not_optimize(y.get());
+        }
+        state.set_flops(model_flops(state.size()));
+        std::ostringstream label;
+        label << "mean batch " << server.stats().mean_batch_size();
+        state.set_label(label.str());
+    }
+    NOVAML_BENCHMARK(serving_dynamic_batch, 256, 2048);
+}
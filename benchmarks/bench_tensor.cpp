@@ -0,0 +1,246 @@
+#include "benchmark.hpp"
+#include <NovaML/Core/Tensor/tensor.hpp>
+#include <NovaML/Core/Tensor/tensor_math.hpp>
+#include <NovaML/Core/Tensor/expression.hpp>
+#include <NovaML/Core/Tensor/graph.hpp>
+#include <NovaML/Core/Kernel/gemm.hpp>
+#include <NovaML/Core/Kernel/vmath.hpp>
+#include <cmath>
+
+using namespace NovaML::Core;
+namespace Bench = NovaML::Bench;
+
+namespace
+{
+    using TensorPtr = std::shared_ptr<Tensor<float>>;
+
+    TensorPtr make(size_t n, float shift, bool requires_grad = false)
+    {
+        std::vector<float> v(n);
+        for (size_t i = 0; i < n; i++)
+            v[i] = shift + 0.5f * std::sin(0.37f * static_cast<float>(i));
+        return std::make_shared<Tensor<float>>(v, requires_grad);
+    }
+
+    constexpr double fbytes = sizeof(float);
+
+    // -------------------------
+    // Element-wise
+    // -------------------------
+    void elementwise_add(Bench::State &state)
+    {
+        NoGradGuard no_grad;
+        auto a = make(state.size(), 1.0f), b = make(state.size(), 2.0f);
+        for (auto _ : state)
+            Bench::do_not_optimize(a + b);
+        state.set_flops(state.size());
+        state.set_bytes(3 * state.size() * fbytes);
+    }
+    NOVAML_BENCHMARK(elementwise_add, 1 << 10, 1 << 16, 1 << 22);
+
+    void elementwise_exp(Bench::State &state)
+    {
+        NoGradGuard no_grad;
+        auto a = make(state.size(), 0.0f);
+        for (auto _ : state)
+            Bench::do_not_optimize(exp(a));
+        state.set_flops(state.size());
+        state.set_bytes(2 * state.size() * fbytes);
+    }
+    NOVAML_BENCHMARK(elementwise_exp, 1 << 10, 1 << 16, 1 << 22);
+
+    // Transcendental kernels per accuracy tier, against a plain libm loop
+    template <typename Kernel>
+    void run_vmath(Bench::State &state, float lo, float hi, Kernel kernel)
+    {
+        std::vector<float> x(state.size()), y(state.size());
+        for (size_t i = 0; i < x.size(); i++)
+            x[i] = lo + (hi - lo) * float(i) / float(x.size());
+        for (auto _ : state)
+        {
+            kernel(x.size(), x.data(), y.data());
+            Bench::do_not_optimize(y.data());
+        }
+        state.set_bytes(2 * state.size() * fbytes);
+    }
+
+    void vmath_exp_libm(Bench::State &state)
+    {
+        run_vmath(state, -20.0f, 20.0f, [](size_t n, const float *x, float *y)
+                  { for (size_t i = 0; i < n; i++) y[i] = std::exp(x[i]); });
+    }
+    void vmath_exp_exact(Bench::State &state)
+    {
+        run_vmath(state, -20.0f, 20.0f, [](size_t n, const float *x, float *y)
+                  { Kernel::vexp(n, x, y, Kernel::MathAccuracy::Exact); });
+    }
+    void vmath_exp_fast(Bench::State &state)
+    {
+        run_vmath(state, -20.0f, 20.0f, [](size_t n, const float *x, float *y)
+                  { Kernel::vexp(n, x, y, Kernel::MathAccuracy::Fast); });
+    }
+    void vmath_log_libm(Bench::State &state)
+    {
+        run_vmath(state, 0.01f, 100.0f, [](size_t n, const float *x, float *y)
+                  { for (size_t i = 0; i < n; i++) y[i] = std::log(x[i]); });
+    }
+    void vmath_log_exact(Bench::State &state)
+    {
+        run_vmath(state, 0.01f, 100.0f, [](size_t n, const float *x, float *y)
+                  { Kernel::vlog(n, x, y, Kernel::MathAccuracy::Exact); });
+    }
+    void vmath_tanh_libm(Bench::State &state)
+    {
+        run_vmath(state, -5.0f, 5.0f, [](size_t n, const float *x, float *y)
+                  { for (size_t i = 0; i < n; i++) y[i] = std::tanh(x[i]); });
+    }
+    void vmath_tanh_exact(Bench::State &state)
+    {
+        run_vmath(state, -5.0f, 5.0f, [](size_t n, const float *x, float *y)
+                  { Kernel::vtanh(n, x, y, Kernel::MathAccuracy::Exact); });
+    }
+    NOVAML_BENCHMARK(vmath_exp_libm, 1 << 16);
+    NOVAML_BENCHMARK(vmath_exp_exact, 1 << 16);
+    NOVAML_BENCHMARK(vmath_exp_fast, 1 << 16);
+    NOVAML_BENCHMARK(vmath_log_libm, 1 << 16);
+    NOVAML_BENCHMARK(vmath_log_exact, 1 << 16);
+    NOVAML_BENCHMARK(vmath_tanh_libm, 1 << 16);
+    NOVAML_BENCHMARK(vmath_tanh_exact, 1 << 16);
+
+    // (a * b + c) / d as four eager ops and as one fused pass
+    void chain_eager(Bench::State &state)
+    {
+        NoGradGuard no_grad;
+        auto a = make(state.size(), 1.0f), b = make(state.size(), 2.0f), c = make(state.size(), 0.0f), d = make(state.size(), 3.0f);
+        for (auto _ : state)
+            Bench::do_not_optimize((a * b + c) / d);
+        state.set_flops(3 * state.size());
+        state.set_bytes(9 * state.size() * fbytes);
+    }
+    NOVAML_BENCHMARK(chain_eager, 1 << 16, 1 << 22);
+
+    void chain_fused(Bench::State &state)
+    {
+        NoGradGuard no_grad;
+        auto a = make(state.size(), 1.0f), b = make(state.size(), 2.0f), c = make(state.size(), 0.0f), d = make(state.size(), 3.0f);
+        for (auto _ : state)
+            Bench::do_not_optimize(Expr::evaluate((Expr::lazy(a) * b + c) / d));
+        state.set_flops(3 * state.size());
+        state.set_bytes(5 * state.size() * fbytes);
+    }
+    NOVAML_BENCHMARK(chain_fused, 1 << 16, 1 << 22);
+
+    // [size, size] + [size] through a stride-0 view
+    void broadcast_add(Bench::State &state)
+    {
+        NoGradGuard no_grad;
+        const size_t n = state.size();
+        auto a = std::make_shared<Tensor<float>>(make(n * n, 1.0f)->get_data(), Shape{n, n});
+        auto b = make(n, 2.0f);
+        for (auto _ : state)
+            Bench::do_not_optimize(a + b);
+        state.set_flops(n * n);
+        state.set_bytes((2 * n * n + n) * fbytes);
+        state.set_label("[" + std::to_string(n) + ", " + std::to_string(n) + "] + [" + std::to_string(n) + "]");
+    }
+    NOVAML_BENCHMARK(broadcast_add, 64, 512, 2048);
+
+    // -------------------------
+    // Reductions
+    // -------------------------
+    void reduce_sum(Bench::State &state)
+    {
+        NoGradGuard no_grad;
+        auto a = make(state.size(), 1.0f);
+        for (auto _ : state)
+            Bench::do_not_optimize(sum(a));
+        state.set_flops(state.size());
+        state.set_bytes(state.size() * fbytes);
+    }
+    NOVAML_BENCHMARK(reduce_sum, 1 << 10, 1 << 16, 1 << 22);
+
+    // Per-row and per-column statistics of an [n, 256] batch
+    void reduce_rows_var(Bench::State &state)
+    {
+        NoGradGuard no_grad;
+        auto a = reshape(make(state.size() * 256, 1.0f), Shape{state.size(), 256});
+        for (auto _ : state)
+            Bench::do_not_optimize(var(a, {1}));
+        state.set_flops(4.0 * a->size());
+        state.set_bytes(2.0 * a->size() * fbytes);
+    }
+    NOVAML_BENCHMARK(reduce_rows_var, 64, 4096);
+
+    void reduce_columns_mean(Bench::State &state)
+    {
+        NoGradGuard no_grad;
+        auto a = reshape(make(state.size() * 256, 1.0f), Shape{state.size(), 256});
+        for (auto _ : state)
+            Bench::do_not_optimize(mean(a, {0}));
+        state.set_flops(a->size());
+        state.set_bytes(a->size() * fbytes);
+    }
+    NOVAML_BENCHMARK(reduce_columns_mean, 64, 4096);
+
+    void reduce_rows_logsumexp(Bench::State &state)
+    {
+        NoGradGuard no_grad;
+        auto a = reshape(make(state.size() * 256, 1.0f), Shape{state.size(), 256});
+        for (auto _ : state)
+            Bench::do_not_optimize(logsumexp(a, {1}));
+        state.set_flops(3.0 * a->size());
+        state.set_bytes(2.0 * a->size() * fbytes);
+    }
+    NOVAML_BENCHMARK(reduce_rows_logsumexp, 64, 4096);
+
+    // -------------------------
+    // Autograd: forward + backward through a recorded graph
+    // -------------------------
+    void autograd_backward(Bench::State &state)
+    {
+        auto a = make(state.size(), 1.0f, true), b = make(state.size(), 2.0f, true);
+        for (auto _ : state)
+        {
+            auto loss = sum(exp(a * b + a) * 0.5f);
+            loss->backward();
+            Bench::do_not_optimize(a->get_grad().data());
+        }
+        // forward 5 ops, backward roughly twice that
+        state.set_flops(15 * state.size());
+        state.set_label("sum(exp(a * b + a) * 0.5)");
+    }
+    NOVAML_BENCHMARK(autograd_backward, 1 << 10, 1 << 16, 1 << 20);
+
+    // The same step captured once and replayed: no graph construction, no allocation
+    void autograd_replay(Bench::State &state)
+    {
+        auto a = make(state.size(), 1.0f, true), b = make(state.size(), 2.0f, true);
+        auto graph = Graph<float>::capture([&]
+                                           { return sum(exp(a * b + a) * 0.5f); });
+        for (auto _ : state)
+        {
+            graph.replay();
+            Bench::do_not_optimize(a->get_grad().data());
+        }
+        state.set_flops(15 * state.size());
+        state.set_label("sum(exp(a * b + a) * 0.5)");
+    }
+    NOVAML_BENCHMARK(autograd_replay, 1 << 10, 1 << 16, 1 << 20);
+
+    // -------------------------
+    // GEMM kernel
+    // -------------------------
+    void gemm_square(Bench::State &state)
+    {
+        const size_t n = state.size();
+        std::vector<float> a = make(n * n, 0.0f)->get_data(), b = make(n * n, 1.0f)->get_data(), c(n * n);
+        for (auto _ : state)
+        {
+            Kernel::gemm(false, false, n, n, n, 1.0f, a.data(), n, b.data(), n, 0.0f, c.data(), n);
+            Bench::do_not_optimize(c.data());
+        }
+        state.set_flops(2.0 * n * n * n);
+        state.set_bytes(3.0 * n * n * fbytes);
+    }
+    NOVAML_BENCHMARK(gemm_square, 64, 256, 1024);
+}
@@ -0,0 +1,146 @@
+#pragma once
+#include <NovaML/Memory/allocator.hpp>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace NovaML::Bench
+{
+    // -------------------------
+    // Minimal Google-Benchmark-style harness
+    //
+    //     void bench_add(Bench::State &state)
+    //     {
+    //         auto a = ...; auto b = ...;              // setup, not timed
+    //         for (auto _ : state)
+    //             Bench::do_not_optimize(a + b);       // timed per iteration
+    //         state.set_flops(state.size());           // per iteration
+    //         state.set_bytes(3 * state.size() * sizeof(float));
+    //     }
+    //     NOVAML_BENCHMARK(bench_add, 1 << 10, 1 << 16, 1 << 20);
+    //
+    // Every registered benchmark runs once per (size, thread count). Each
+    // iteration is timed on its own so latency percentiles are available, and
+    // allocator statistics around the loop give allocations per iteration.
+    // -------------------------
+
+    /// Keep a value observable so the optimizer cannot drop the work producing it.
+    template <typename V>
+    inline void do_not_optimize(V const &value)
+    {
+        asm volatile("" : : "g"(&value) : "memory");
+    }
+
+    class State
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        State(size_t size, size_t threads, size_t iterations)
+            : size_(size), threads_(threads), iterations_(iterations) { samples_ns.reserve(iterations); }
+
+        size_t size() const { return size_; }
+        size_t threads() const { return threads_; }
+        size_t iterations() const { return iterations_; }
+
+        /// Floating-point operations and bytes moved by one iteration.
+        void set_flops(double per_iteration) { flops = per_iteration; }
+        void set_bytes(double per_iteration) { bytes = per_iteration; }
+        /// Free-form label shown next to the result (e.g. the shape).
+        void set_label(std::string text) { label = std::move(text); }
+
+        class Iterator
+        {
+        public:
+            /// What `for (auto _ : state)` binds; user-provided constructor and
+            /// destructor keep compilers from flagging `_` as unused.
+            struct Value
+            {
+                Value() {}
+                ~Value() {}
+            };
+
+            Iterator(State *state, size_t remaining) : state(state), remaining(remaining) {}
+            Value operator*() const { return {}; }
+            bool operator!=(const Iterator &) const
+            {
+                if (remaining > 0)
+                    return true;
+                state->finish();
+                return false;
+            }
+            Iterator &operator++()
+            {
+                state->lap();
+                --remaining;
+                return *this;
+            }
+
+        private:
+            State *state;
+            size_t remaining;
+        };
+
+        Iterator begin()
+        {
+            Memory::reset_stats();
+            allocations_before = Memory::get_stats().allocations;
+            last = Clock::now();
+            return {this, iterations_};
+        }
+        Iterator end() { return {this, 0}; }
+
+        // Filled in by the loop
+        std::vector<double> samples_ns;
+        size_t allocations = 0;
+        size_t peak_bytes = 0;
+        double flops = 0;
+        double bytes = 0;
+        std::string label;
+
+    private:
+        void lap()
+        {
+            auto now = Clock::now();
+            samples_ns.push_back(std::chrono::duration<double, std::nano>(now - last).count());
+            last = now;
+        }
+
+        void finish()
+        {
+            auto stats = Memory::get_stats();
+            allocations = stats.allocations - allocations_before;
+            peak_bytes = stats.peak_bytes_in_use;
+        }
+
+        size_t size_;
+        size_t threads_;
+        size_t iterations_;
+        size_t allocations_before = 0;
+        Clock::time_point last;
+    };
+
+    using BenchmarkFn = void (*)(State &);
+
+    struct Benchmark
+    {
+        std::string name;
+        std::vector<size_t> sizes;
+        BenchmarkFn fn;
+    };
+
+    std::vector<Benchmark> &registry();
+
+    struct Registrar
+    {
+        Registrar(const char *name, std::vector<size_t> sizes, BenchmarkFn fn)
+        {
+            registry().push_back({name, std::move(sizes), fn});
+        }
+    };
+}
+
+#define NOVAML_BENCHMARK(fn, ...) \
+    static ::NovaML::Bench::Registrar fn##_registrar(#fn, {__VA_ARGS__}, fn)
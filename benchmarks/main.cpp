@@ -0,0 +1,259 @@
+#include "benchmark.hpp"
+#include <NovaML/Core/Kernel/cpu_features.hpp>
+#include <NovaML/Parallel/thread_pool.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <regex>
+#include <sstream>
+#include <thread>
+#include <tuple>
+
+namespace NovaML::Bench
+{
+    std::vector<Benchmark> &registry()
+    {
+        static std::vector<Benchmark> benchmarks;
+        return benchmarks;
+    }
+}
+
+using namespace NovaML;
+
+namespace
+{
+    struct Options
+    {
+        std::regex filter{".*"};
+        std::vector<size_t> threads;
+        double min_time = 0.1; ///< seconds of measured iterations per case
+        std::string json_path;
+        std::string baseline_path;
+        double max_regression = 0.10; ///< tolerated p50 slowdown against the baseline
+        bool list = false;
+    };
+
+    struct Result
+    {
+        std::string name;
+        size_t size = 0;
+        size_t threads = 0;
+        std::string label;
+        size_t iterations = 0;
+        double mean_ns = 0, min_ns = 0, p50_ns = 0, p90_ns = 0, p99_ns = 0;
+        double gflops = 0, gbps = 0;
+        double allocs_per_iter = 0;
+        size_t peak_bytes = 0;
+    };
+
+    using Key = std::tuple<std::string, size_t, size_t>;
+
+    std::vector<size_t> parse_list(const std::string &text)
+    {
+        std::vector<size_t> out;
+        std::stringstream ss(text);
+        for (std::string item; std::getline(ss, item, ',');)
+            out.push_back(std::stoul(item));
+        return out;
+    }
+
+    Options parse_args(int argc, char **argv)
+    {
+        Options opt;
+        for (int i = 1; i < argc; i++)
+        {
+            std::string arg = argv[i];
+            auto value = [&](const std::string &flag) -> const char *
+            {
+                return arg.rfind(flag + "=", 0) == 0 ? argv[i] + flag.size() + 1 : nullptr;
+            };
+            if (const char *v = value("--filter"))
+                opt.filter = std::regex(v);
+            else if (const char *v = value("--threads"))
+                opt.threads = parse_list(v);
+            else if (const char *v = value("--min-time"))
+                opt.min_time = std::stod(v);
+            else if (const char *v = value("--json"))
+                opt.json_path = v;
+            else if (const char *v = value("--baseline"))
+                opt.baseline_path = v;
+            else if (const char *v = value("--max-regression"))
+                opt.max_regression = std::stod(v);
+            else if (arg == "--list")
+                opt.list = true;
+            else
+            {
+                std::cout << "usage: " << argv[0] << " [--filter=REGEX] [--threads=1,2,...] [--min-time=SEC]\n"
+                          << "       [--json=OUT.json] [--baseline=OLD.json] [--max-regression=0.10] [--list]\n";
+                std::exit(arg == "--help" ? 0 : 2);
+            }
+        }
+        if (opt.threads.empty())
+        {
+            opt.threads.push_back(1);
+            size_t hw = std::max<size_t>(1, std::thread::hardware_concurrency());
+            if (hw > 1)
+                opt.threads.push_back(hw);
+        }
+        return opt;
+    }
+
+    double percentile(const std::vector<double> &sorted, double p)
+    {
+        size_t rank = static_cast<size_t>(std::ceil(p * static_cast<double>(sorted.size())));
+        return sorted[std::min(sorted.size() - 1, rank == 0 ? 0 : rank - 1)];
+    }
+
+    Result run_case(const Bench::Benchmark &bench, size_t size, size_t threads, double min_time)
+    {
+        Parallel::set_num_threads(threads);
+
+        // Warm-up (first-touch, allocator cache, thread start-up) and calibration.
+        Bench::State warm(size, threads, 2);
+        bench.fn(warm);
+        double estimate = std::max(1.0, *std::min_element(warm.samples_ns.begin(), warm.samples_ns.end()));
+        size_t iterations = static_cast<size_t>(std::clamp(min_time * 1e9 / estimate, 5.0, 1e6));
+
+        Bench::State state(size, threads, iterations);
+        bench.fn(state);
+
+        Result r;
+        r.name = bench.name;
+        r.size = size;
+        r.threads = threads;
+        r.label = state.label;
+        r.iterations = iterations;
+        std::vector<double> sorted = state.samples_ns;
+        std::sort(sorted.begin(), sorted.end());
+        double total = 0;
+        for (double s : sorted)
+            total += s;
+        r.mean_ns = total / static_cast<double>(sorted.size());
+        r.min_ns = sorted.front();
+        r.p50_ns = percentile(sorted, 0.50);
+        r.p90_ns = percentile(sorted, 0.90);
+        r.p99_ns = percentile(sorted, 0.99);
+        r.gflops = state.flops / r.mean_ns;
+        r.gbps = state.bytes / r.mean_ns;
+        r.allocs_per_iter = static_cast<double>(state.allocations) / static_cast<double>(iterations);
+        r.peak_bytes = state.peak_bytes;
+        return r;
+    }
+
+    std::string format_time(double ns)
+    {
+        char buf[32];
+        if (ns < 1e3)
+            std::snprintf(buf, sizeof(buf), "%.0f ns", ns);
+        else if (ns < 1e6)
+            std::snprintf(buf, sizeof(buf), "%.2f us", ns / 1e3);
+        else
+            std::snprintf(buf, sizeof(buf), "%.2f ms", ns / 1e6);
+        return buf;
+    }
+
+    std::string json_escape(const std::string &s)
+    {
+        std::string out;
+        for (char c : s)
+        {
+            if (c == '"' || c == '\\')
+                out += '\\';
+            out += c;
+        }
+        return out;
+    }
+
+    // One result object per line, which keeps load_baseline() a line scan.
+    void write_json(const std::string &path, const std::vector<Result> &results, const Options &opt)
+    {
+        std::ofstream out(path);
+        if (!out)
+            throw std::runtime_error("benchmarks: cannot write " + path);
+        out << "{\n  \"context\": {\"isa\": \"" << Core::Kernel::isa_name(Core::Kernel::active_isa())
+            << "\", \"hardware_threads\": " << std::thread::hardware_concurrency()
+            << ", \"min_time\": " << opt.min_time << "},\n  \"benchmarks\": [\n";
+        for (size_t i = 0; i < results.size(); i++)
+        {
+            const Result &r = results[i];
+            out << "    {\"name\": \"" << json_escape(r.name) << "\", \"size\": " << r.size
+                << ", \"threads\": " << r.threads << ", \"label\": \"" << json_escape(r.label) << "\""
+                << ", \"iterations\": " << r.iterations << ", \"mean_ns\": " << r.mean_ns
+                << ", \"min_ns\": " << r.min_ns << ", \"p50_ns\": " << r.p50_ns << ", \"p90_ns\": " << r.p90_ns
+                << ", \"p99_ns\": " << r.p99_ns << ", \"gflops\": " << r.gflops << ", \"gbps\": " << r.gbps
+                << ", \"allocs_per_iter\": " << r.allocs_per_iter << ", \"peak_bytes\": " << r.peak_bytes << "}"
+                << (i + 1 < results.size() ? "," : "") << "\n";
+        }
+        out << "  ]\n}\n";
+    }
+
+    std::map<Key, double> load_baseline(const std::string &path)
+    {
+        std::ifstream in(path);
+        if (!in)
+            throw std::runtime_error("benchmarks: cannot read baseline " + path);
+        static const std::regex entry(R"re("name": "([^"]*)", "size": (\d+), "threads": (\d+).*"p50_ns": ([-+0-9.eE]+))re");
+        std::map<Key, double> p50;
+        std::smatch m;
+        for (std::string line; std::getline(in, line);)
+            if (std::regex_search(line, m, entry))
+                p50[{m[1], std::stoul(m[2]), std::stoul(m[3])}] = std::stod(m[4]);
+        return p50;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    Options opt = parse_args(argc, argv);
+    std::map<Key, double> baseline;
+    if (!opt.baseline_path.empty())
+        baseline = load_baseline(opt.baseline_path);
+
+    std::printf("NovaML benchmarks (isa %s, %u hardware threads)\n",
+                Core::Kernel::isa_name(Core::Kernel::active_isa()).c_str(), std::thread::hardware_concurrency());
+    std::printf("%-28s %9s %3s %10s %10s %10s %9s %8s %7s%s\n", "benchmark", "size", "thr", "p50", "p90", "p99",
+                "GFLOP/s", "GB/s", "allocs", baseline.empty() ? "" : "  vs base");
+
+    std::vector<Result> results;
+    size_t regressions = 0;
+    for (const auto &bench : Bench::registry())
+    {
+        if (!std::regex_search(bench.name, opt.filter))
+            continue;
+        for (size_t size : bench.sizes)
+            for (size_t threads : opt.threads)
+            {
+                if (opt.list)
+                {
+                    std::printf("%s/%zu/%zu\n", bench.name.c_str(), size, threads);
+                    continue;
+                }
+                Result r = run_case(bench, size, threads, opt.min_time);
+                std::printf("%-28s %9zu %3zu %10s %10s %10s %9.2f %8.2f %7.1f", r.name.c_str(), r.size, r.threads,
+                            format_time(r.p50_ns).c_str(), format_time(r.p90_ns).c_str(),
+                            format_time(r.p99_ns).c_str(), r.gflops, r.gbps, r.allocs_per_iter);
+                auto it = baseline.find({r.name, r.size, r.threads});
+                if (it != baseline.end())
+                {
+                    double ratio = r.p50_ns / it->second;
+                    bool regressed = ratio > 1.0 + opt.max_regression;
+                    regressions += regressed;
+                    std::printf("  %6.2fx%s", ratio, regressed ? " REGRESSION" : "");
+                }
+                std::printf("%s%s\n", r.label.empty() ? "" : "  ", r.label.c_str());
+                std::fflush(stdout);
+                results.push_back(std::move(r));
+            }
+    }
+    Parallel::set_num_threads(0);
+
+    if (!opt.json_path.empty())
+        write_json(opt.json_path, results, opt);
+    if (regressions)
+        std::printf("%zu case(s) slower than the baseline by more than %.0f%%\n", regressions, 100 * opt.max_regression);
+    return regressions ? 1 : 0;
+}
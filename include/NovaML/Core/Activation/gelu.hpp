@@ -0,0 +1,35 @@
+#pragma once
+#include "../Module/module.hpp"
+#include <string>
+#include <cmath>
+
+namespace NovaML::Core::ActivationModule {
+
+// GELU(x) = x * Phi(x), the exact (erf) form
+template <typename T = float>
+class GELU : public NovaML::Core::Module::BaseModule<T> {
+public:
+    GELU();
+
+    // Forward pass
+    NovaML::Core::TensorModule::Tensor<T> forward(
+        const NovaML::Core::TensorModule::Tensor<T> &input) override;
+    NovaML::Core::TensorModule::Tensor<T> infer(
+        const NovaML::Core::TensorModule::Tensor<T> &input) const override;
+
+    // Backward pass
+    NovaML::Core::TensorModule::Tensor<T> backward(
+        const NovaML::Core::TensorModule::Tensor<T> &grad_output) override;
+
+    // Info
+    std::string info(std::ostream &) const override { return "GELU"; }
+    Kernel::Activation fusable_activation() const override { return Kernel::Activation::GELU; }
+    void release_activations() override { last_input = NovaML::Core::TensorModule::Tensor<T>(0); }
+
+private:
+    NovaML::Core::TensorModule::Tensor<T> last_input;
+};
+
+}
+
+#include "gelu.tpp"
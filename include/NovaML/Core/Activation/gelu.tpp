@@ -0,0 +1,37 @@
+#pragma once
+#include "gelu.hpp"
+
+namespace NovaML::Core::ActivationModule
+{
+
+    template <typename T>
+    GELU<T>::GELU() : last_input(0) {}
+
+    template <typename T>
+    NovaML::Core::TensorModule::Tensor<T> GELU<T>::forward(const NovaML::Core::TensorModule::Tensor<T> &input)
+    {
+        if (GradMode::is_enabled())
+            last_input = input;
+        return infer(input);
+    }
+
+    template <typename T>
+    NovaML::Core::TensorModule::Tensor<T> GELU<T>::infer(const NovaML::Core::TensorModule::Tensor<T> &input) const
+    {
+        auto output = NovaML::Core::TensorModule::Tensor<T>::zeros(input.shape());
+        for (size_t i = 0; i < input.size(); ++i)
+            output[i] = Kernel::activate(Kernel::Activation::GELU, input[i]);
+        return output;
+    }
+
+    // Backward: gradient = grad_output * (Phi(x) + x * phi(x))
+    template <typename T>
+    NovaML::Core::TensorModule::Tensor<T> GELU<T>::backward(const NovaML::Core::TensorModule::Tensor<T> &grad_output)
+    {
+        auto grad = NovaML::Core::TensorModule::Tensor<T>::zeros(grad_output.shape());
+        for (size_t i = 0; i < grad_output.size(); ++i)
+            grad[i] = grad_output[i] * Kernel::activation_derivative(Kernel::Activation::GELU, last_input[i]);
+        return grad;
+    }
+
+}
@@ -12,10 +12,13 @@ namespace NovaML::Core::ActivationModule
 
         // Forward pass
         NovaML::Core::TensorModule::Tensor<T> forward(const NovaML::Core::TensorModule::Tensor<T> &input) override;
+        NovaML::Core::TensorModule::Tensor<T> infer(const NovaML::Core::TensorModule::Tensor<T> &input) const override;
         // Backward pass
         NovaML::Core::TensorModule::Tensor<T> backward(const NovaML::Core::TensorModule::Tensor<T> &grad_output) override;
         // Info
-        std::string info(std::ostream &os) const override { return "ReLU"; }
+        std::string info(std::ostream &) const override { return "ReLU"; }
+        Kernel::Activation fusable_activation() const override { return Kernel::Activation::ReLU; }
+        void release_activations() override { last_input = NovaML::Core::TensorModule::Tensor<T>(0); }
 
     private:
         NovaML::Core::TensorModule::Tensor<T> last_input;
@@ -8,8 +8,16 @@ namespace NovaML::Core::ActivationModule
     NovaML::Core::TensorModule::Tensor<T> ReLU<T>::forward(
         const NovaML::Core::TensorModule::Tensor<T> &input)
     {
-        last_input = input;
-        NovaML::Core::TensorModule::Tensor<T> output(input.size());
+        if (GradMode::is_enabled())
+            last_input = input;
+        return infer(input);
+    }
+
+    template <typename T>
+    NovaML::Core::TensorModule::Tensor<T> ReLU<T>::infer(
+        const NovaML::Core::TensorModule::Tensor<T> &input) const
+    {
+        auto output = NovaML::Core::TensorModule::Tensor<T>::zeros(input.shape());
 
         for (size_t i = 0; i < input.size(); ++i)
             output[i] = input[i] > T(0) ? input[i] : T(0);
@@ -21,7 +29,7 @@ namespace NovaML::Core::ActivationModule
     NovaML::Core::TensorModule::Tensor<T> ReLU<T>::backward(
         const NovaML::Core::TensorModule::Tensor<T> &grad_output)
     {
-        NovaML::Core::TensorModule::Tensor<T> grad(grad_output.size());
+        auto grad = NovaML::Core::TensorModule::Tensor<T>::zeros(grad_output.shape());
 
         for (size_t i = 0; i < grad_output.size(); ++i)
             grad[i] = last_input[i] > T(0) ? grad_output[i] : T(0);
@@ -13,13 +13,17 @@ public:
     // Forward pass
     NovaML::Core::TensorModule::Tensor<T> forward(
         const NovaML::Core::TensorModule::Tensor<T> &input) override;
+    NovaML::Core::TensorModule::Tensor<T> infer(
+        const NovaML::Core::TensorModule::Tensor<T> &input) const override;
 
     // Backward pass
     NovaML::Core::TensorModule::Tensor<T> backward(
         const NovaML::Core::TensorModule::Tensor<T> &grad_output) override;
 
     // Info
-    std::string info(std::ostream &os) const override { return "Sigmoid"; }
+    std::string info(std::ostream &) const override { return "Sigmoid"; }
+    Kernel::Activation fusable_activation() const override { return Kernel::Activation::Sigmoid; }
+    void release_activations() override { last_output = NovaML::Core::TensorModule::Tensor<T>(0); }
 
 private:
     NovaML::Core::TensorModule::Tensor<T> last_output;
@@ -1,5 +1,6 @@
 #pragma once
 #include "sigmoid.hpp"
+#include "../Kernel/vmath.hpp"
 
 namespace NovaML::Core::ActivationModule
 {
@@ -11,17 +12,29 @@ namespace NovaML::Core::ActivationModule
     template <typename T>
     NovaML::Core::TensorModule::Tensor<T> Sigmoid<T>::forward(const NovaML::Core::TensorModule::Tensor<T> &input)
     {
-        last_output = NovaML::Core::TensorModule::Tensor<T>(input.size());
-        for (size_t i = 0; i < input.size(); ++i)
-            last_output[i] = T(1) / (T(1) + std::exp(-input[i]));
-        return last_output;
+        auto output = infer(input);
+        if (GradMode::is_enabled())
+            last_output = output;
+        return output;
+    }
+
+    template <typename T>
+    NovaML::Core::TensorModule::Tensor<T> Sigmoid<T>::infer(const NovaML::Core::TensorModule::Tensor<T> &input) const
+    {
+        auto output = NovaML::Core::TensorModule::Tensor<T>::zeros(input.shape());
+        if (input.is_contiguous())
+            Kernel::vsigmoid(input.size(), input.data_ptr(), output.data_ptr());
+        else
+            for (size_t i = 0; i < input.size(); ++i)
+                output[i] = T(1) / (T(1) + std::exp(-input[i]));
+        return output;
     }
 
     // Backward: gradient = grad_output * sigmoid(x) * (1 - sigmoid(x))
     template <typename T>
     NovaML::Core::TensorModule::Tensor<T> Sigmoid<T>::backward(const NovaML::Core::TensorModule::Tensor<T> &grad_output)
     {
-        NovaML::Core::TensorModule::Tensor<T> grad(grad_output.size());
+        auto grad = NovaML::Core::TensorModule::Tensor<T>::zeros(grad_output.shape());
         for (size_t i = 0; i < grad_output.size(); ++i)
             grad[i] = grad_output[i] * last_output[i] * (T(1) - last_output[i]);
         return grad;
@@ -0,0 +1,125 @@
+#pragma once
+#include <cmath>
+#include <string>
+#include "vmath.hpp"
+
+namespace NovaML::Core::Kernel
+{
+    /**
+     * @brief Point-wise activations that kernels can apply in their epilogue.
+     */
+    enum class Activation
+    {
+        None,
+        ReLU,
+        Sigmoid,
+        GELU // exact form: x * Phi(x)
+    };
+
+    inline std::string activation_name(Activation activation)
+    {
+        switch (activation)
+        {
+        case Activation::ReLU:
+            return "ReLU";
+        case Activation::Sigmoid:
+            return "Sigmoid";
+        case Activation::GELU:
+            return "GELU";
+        default:
+            return "None";
+        }
+    }
+
+    template <typename T>
+    inline T activate(Activation activation, T x)
+    {
+        switch (activation)
+        {
+        case Activation::ReLU:
+            return x > T(0) ? x : T(0);
+        case Activation::Sigmoid:
+            return T(1) / (T(1) + std::exp(-x));
+        case Activation::GELU:
+            return T(0.5) * x * (T(1) + std::erf(x * T(0.70710678118654752440)));
+        default:
+            return x;
+        }
+    }
+
+    /// Whether the backward pass needs the pre-activation input (otherwise the output suffices).
+    inline bool needs_preactivation(Activation activation) { return activation == Activation::GELU; }
+
+    /**
+     * @brief Local derivative of an activation.
+     *
+     * `value` is the activation output for ReLU and Sigmoid and the
+     * pre-activation input for GELU, see needs_preactivation().
+     */
+    template <typename T>
+    inline T activation_derivative(Activation activation, T value)
+    {
+        switch (activation)
+        {
+        case Activation::ReLU:
+            return value > T(0) ? T(1) : T(0);
+        case Activation::Sigmoid:
+            return value * (T(1) - value);
+        case Activation::GELU:
+        {
+            const T cdf = T(0.5) * (T(1) + std::erf(value * T(0.70710678118654752440)));
+            const T pdf = T(0.39894228040143267794) * std::exp(T(-0.5) * value * value);
+            return cdf + value * pdf;
+        }
+        default:
+            return T(1);
+        }
+    }
+
+    /**
+     * @brief Work fused into the store of a GEMM result: C = act(C + bias).
+     *
+     * `bias` holds one value per output column (N) and may be null. The
+     * epilogue runs on every output tile right after its last K block, while
+     * the tile is still in registers / L1, instead of as separate passes.
+     */
+    template <typename T>
+    struct Epilogue
+    {
+        const T *bias = nullptr;
+        Activation activation = Activation::None;
+
+        bool active() const { return bias || activation != Activation::None; }
+    };
+
+    /// Apply an epilogue to a rows x cols tile of C whose first column is output column col0.
+    template <typename T>
+    void apply_epilogue(const Epilogue<T> &epilogue, T *C, size_t ldc, size_t rows, size_t col0, size_t cols)
+    {
+        for (size_t r = 0; r < rows; r++)
+        {
+            T *c = C + r * ldc;
+            if (epilogue.bias)
+            {
+                const T *b = epilogue.bias + col0;
+                for (size_t j = 0; j < cols; j++)
+                    c[j] += b[j];
+            }
+            switch (epilogue.activation)
+            {
+            case Activation::None:
+                break;
+            case Activation::ReLU:
+                for (size_t j = 0; j < cols; j++)
+                    c[j] = c[j] > T(0) ? c[j] : T(0);
+                break;
+            case Activation::Sigmoid:
+                vsigmoid(cols, c, c);
+                break;
+            default:
+                for (size_t j = 0; j < cols; j++)
+                    c[j] = activate(epilogue.activation, c[j]);
+            }
+        }
+    }
+}
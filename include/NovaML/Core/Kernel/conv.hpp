@@ -0,0 +1,246 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+
+namespace NovaML::Core::Kernel
+{
+    /**
+     * @brief One image of a square-kernel convolution: input C x H x W, output OH x OW.
+     *
+     * Input pixel (ih, iw) = (oh * stride - padding + kh, ow * stride - padding + kw);
+     * outside the image it reads as zero.
+     */
+    struct ConvGeometry
+    {
+        size_t channels, height, width;
+        size_t kernel, stride, padding;
+        size_t out_height, out_width;
+
+        /// Length of one patch (one row of the GEMM operand): channels * kernel^2.
+        size_t patch() const { return channels * kernel * kernel; }
+        size_t out_pixels() const { return out_height * out_width; }
+
+        /// Output columns [lo, hi) whose input column for kernel column kw is inside the image.
+        void valid_columns(size_t kw, size_t &lo, size_t &hi) const
+        {
+            lo = padding > kw ? (padding - kw + stride - 1) / stride : 0;
+            hi = width + padding > kw ? std::min(out_width, (width + padding - kw - 1) / stride + 1) : 0;
+            lo = std::min(lo, hi);
+        }
+    };
+
+    // -------------------------
+    // im2col / col2im: channels-first images, patch-major columns
+    // cols[(c * K + kh) * K + kw][oh * OW + ow], so W[out x patch] * cols is the NCHW output
+    // -------------------------
+    template <typename T>
+    void im2col_nchw(const ConvGeometry &g, const T *x, T *cols)
+    {
+        const size_t K = g.kernel, OW = g.out_width;
+        for (size_t c = 0; c < g.channels; c++)
+            for (size_t kh = 0; kh < K; kh++)
+                for (size_t kw = 0; kw < K; kw++)
+                {
+                    size_t lo, hi;
+                    g.valid_columns(kw, lo, hi);
+                    T *row = cols + ((c * K + kh) * K + kw) * g.out_pixels();
+                    for (size_t oh = 0; oh < g.out_height; oh++, row += OW)
+                    {
+                        const size_t ih = oh * g.stride + kh;
+                        if (ih < g.padding || ih - g.padding >= g.height)
+                        {
+                            std::fill(row, row + OW, T(0));
+                            continue;
+                        }
+                        const T *src = x + (c * g.height + ih - g.padding) * g.width + kw - g.padding;
+                        std::fill(row, row + lo, T(0));
+                        for (size_t ow = lo; ow < hi; ow++)
+                            row[ow] = src[ow * g.stride];
+                        std::fill(row + hi, row + OW, T(0));
+                    }
+                }
+    }
+
+    /// dx += the columns scattered back to their input pixels.
+    template <typename T>
+    void col2im_nchw(const ConvGeometry &g, const T *cols, T *dx)
+    {
+        const size_t K = g.kernel, OW = g.out_width;
+        for (size_t c = 0; c < g.channels; c++)
+            for (size_t kh = 0; kh < K; kh++)
+                for (size_t kw = 0; kw < K; kw++)
+                {
+                    size_t lo, hi;
+                    g.valid_columns(kw, lo, hi);
+                    const T *row = cols + ((c * K + kh) * K + kw) * g.out_pixels();
+                    for (size_t oh = 0; oh < g.out_height; oh++, row += OW)
+                    {
+                        const size_t ih = oh * g.stride + kh;
+                        if (ih < g.padding || ih - g.padding >= g.height)
+                            continue;
+                        T *dst = dx + (c * g.height + ih - g.padding) * g.width + kw - g.padding;
+                        for (size_t ow = lo; ow < hi; ow++)
+                            dst[ow * g.stride] += row[ow];
+                    }
+                }
+    }
+
+    // -------------------------
+    // im2col / col2im: channels-last images, pixel-major patches
+    // patches[oh * OW + ow][(kh * K + kw) * C + c], so patches * W^T is the NHWC output
+    // -------------------------
+    template <typename T>
+    void im2col_nhwc(const ConvGeometry &g, const T *x, T *patches)
+    {
+        const size_t K = g.kernel, C = g.channels;
+        T *dst = patches;
+        for (size_t oh = 0; oh < g.out_height; oh++)
+            for (size_t ow = 0; ow < g.out_width; ow++)
+                for (size_t kh = 0; kh < K; kh++)
+                {
+                    const size_t ih = oh * g.stride + kh;
+                    const bool row_inside = ih >= g.padding && ih - g.padding < g.height;
+                    for (size_t kw = 0; kw < K; kw++, dst += C)
+                    {
+                        const size_t iw = ow * g.stride + kw;
+                        if (row_inside && iw >= g.padding && iw - g.padding < g.width)
+                        {
+                            const T *src = x + ((ih - g.padding) * g.width + iw - g.padding) * C;
+                            std::copy(src, src + C, dst);
+                        }
+                        else
+                            std::fill(dst, dst + C, T(0));
+                    }
+                }
+    }
+
+    template <typename T>
+    void col2im_nhwc(const ConvGeometry &g, const T *patches, T *dx)
+    {
+        const size_t K = g.kernel, C = g.channels;
+        const T *src = patches;
+        for (size_t oh = 0; oh < g.out_height; oh++)
+            for (size_t ow = 0; ow < g.out_width; ow++)
+                for (size_t kh = 0; kh < K; kh++)
+                {
+                    const size_t ih = oh * g.stride + kh;
+                    const bool row_inside = ih >= g.padding && ih - g.padding < g.height;
+                    for (size_t kw = 0; kw < K; kw++, src += C)
+                    {
+                        const size_t iw = ow * g.stride + kw;
+                        if (!row_inside || iw < g.padding || iw - g.padding >= g.width)
+                            continue;
+                        T *dst = dx + ((ih - g.padding) * g.width + iw - g.padding) * C;
+                        for (size_t c = 0; c < C; c++)
+                            dst[c] += src[c];
+                    }
+                }
+    }
+
+    // -------------------------
+    // Winograd F(2x2, 3x3): a 2x2 output tile from a 4x4 input tile with 16
+    // multiplies per channel pair instead of 36. With U = G g G^T (weights)
+    // and V = B^T d B (input), Y = A^T [sum over channels of U . V] A, so the
+    // channel sum is 16 independent GEMMs over the tiles.
+    // -------------------------
+
+    /// U[16][out][in] from 3x3 weights stored [out][in][3][3], or [out][3][3][in] when channels_last.
+    template <typename T>
+    void winograd_weights(size_t out, size_t in, const T *w, bool channels_last, T *U)
+    {
+        for (size_t o = 0; o < out; o++)
+            for (size_t c = 0; c < in; c++)
+            {
+                T g[3][3];
+                for (size_t i = 0; i < 3; i++)
+                    for (size_t j = 0; j < 3; j++)
+                        g[i][j] = channels_last ? w[(o * 9 + i * 3 + j) * in + c] : w[(o * in + c) * 9 + i * 3 + j];
+                T t[4][3]; // G g
+                for (size_t j = 0; j < 3; j++)
+                {
+                    t[0][j] = g[0][j];
+                    t[1][j] = T(0.5) * (g[0][j] + g[1][j] + g[2][j]);
+                    t[2][j] = T(0.5) * (g[0][j] - g[1][j] + g[2][j]);
+                    t[3][j] = g[2][j];
+                }
+                for (size_t i = 0; i < 4; i++) // (G g) G^T
+                {
+                    T *u = U + (i * 4) * out * in + o * in + c;
+                    const size_t plane = out * in;
+                    u[0] = t[i][0];
+                    u[plane] = T(0.5) * (t[i][0] + t[i][1] + t[i][2]);
+                    u[2 * plane] = T(0.5) * (t[i][0] - t[i][1] + t[i][2]);
+                    u[3 * plane] = t[i][2];
+                }
+            }
+    }
+
+    /**
+     * @brief V = B^T d B for one tile, vectorized over the channels.
+     *
+     * d is the 4x4 input tile as 16 rows of `channels` values; row k of
+     * plane xi lands at V + xi * plane_stride.
+     */
+    template <typename T>
+    void winograd_input_tile(const T *d, size_t channels, T *V, size_t plane_stride)
+    {
+        const size_t C = channels;
+        auto at = [&](size_t i, size_t j)
+        { return d + (i * 4 + j) * C; };
+        auto out = [&](size_t i, size_t j)
+        { return V + (i * 4 + j) * plane_stride; };
+        for (size_t j = 0; j < 4; j++) // columns of B^T d, then rows of (B^T d) B, one channel vector at a time
+        {
+            const T *d0 = at(0, j), *d1 = at(1, j), *d2 = at(2, j), *d3 = at(3, j);
+            T *t0 = out(0, j), *t1 = out(1, j), *t2 = out(2, j), *t3 = out(3, j);
+            for (size_t c = 0; c < C; c++)
+            {
+                t0[c] = d0[c] - d2[c];
+                t1[c] = d1[c] + d2[c];
+                t2[c] = d2[c] - d1[c];
+                t3[c] = d1[c] - d3[c];
+            }
+        }
+        for (size_t i = 0; i < 4; i++)
+        {
+            T *v0 = out(i, 0), *v1 = out(i, 1), *v2 = out(i, 2), *v3 = out(i, 3);
+            for (size_t c = 0; c < C; c++)
+            {
+                const T a = v0[c], b = v1[c], e = v2[c], f = v3[c];
+                v0[c] = a - e;
+                v1[c] = b + e;
+                v2[c] = e - b;
+                v3[c] = b - f;
+            }
+        }
+    }
+
+    /**
+     * @brief y = A^T m A for one tile, vectorized over the output channels.
+     *
+     * m is plane xi at M + xi * plane_stride (`channels` values each);
+     * y receives the 2x2 outputs as 4 rows of `channels` values.
+     */
+    template <typename T>
+    void winograd_output_tile(const T *M, size_t plane_stride, size_t channels, T *y)
+    {
+        const size_t C = channels;
+        auto m = [&](size_t i, size_t j)
+        { return M + (i * 4 + j) * plane_stride; };
+        T *y00 = y, *y01 = y + C, *y10 = y + 2 * C, *y11 = y + 3 * C;
+        for (size_t c = 0; c < C; c++)
+        {
+            T s[2][4]; // A^T m
+            for (size_t j = 0; j < 4; j++)
+            {
+                const T a = m(0, j)[c], b = m(1, j)[c], e = m(2, j)[c], f = m(3, j)[c];
+                s[0][j] = a + b + e;
+                s[1][j] = b - e - f;
+            }
+            y00[c] = s[0][0] + s[0][1] + s[0][2];
+            y01[c] = s[0][1] - s[0][2] - s[0][3];
+            y10[c] = s[1][0] + s[1][1] + s[1][2];
+            y11[c] = s[1][1] - s[1][2] - s[1][3];
+        }
+    }
+}
@@ -0,0 +1,26 @@
+#pragma once
+#include <cstddef>
+#include "../Tensor/half.hpp"
+
+namespace NovaML::Core::Kernel
+{
+    /**
+     * @brief Bulk conversion between fp32 and the 16-bit storage types.
+     *
+     * narrow() rounds to nearest even, exactly like the scalar conversions
+     * in half.hpp. fp16 uses the F16C conversions on AVX2 / AVX-512 CPUs;
+     * bf16 is a shift plus rounding and vectorizes on every path.
+     */
+    void widen(size_t n, const bfloat16 *src, float *dst);
+    void widen(size_t n, const float16 *src, float *dst);
+    void narrow(size_t n, const float *src, bfloat16 *dst);
+    void narrow(size_t n, const float *src, float16 *dst);
+
+    /// sum_i x[i] * h[i] in fp32, widening h on the fly.
+    float dot(size_t n, const float *x, const bfloat16 *h);
+    float dot(size_t n, const float *x, const float16 *h);
+
+    /// y[i] += a * h[i] in fp32, widening h on the fly.
+    void axpy(size_t n, float a, const bfloat16 *h, float *y);
+    void axpy(size_t n, float a, const float16 *h, float *y);
+}
@@ -0,0 +1,35 @@
+#pragma once
+#include <string>
+
+namespace NovaML::Core::Kernel
+{
+    /**
+     * @brief Instruction-set paths that compiled kernels can dispatch to.
+     */
+    enum class Isa
+    {
+        Scalar, // portable C++ fallback
+        Avx2,   // x86-64 AVX2 + FMA
+        Avx512, // x86-64 AVX-512F
+        Neon    // AArch64 Advanced SIMD
+    };
+
+    /// Best instruction set supported by the running CPU.
+    Isa detected_isa();
+
+    /// Instruction set kernels currently dispatch to (detected_isa() unless overridden).
+    Isa active_isa();
+
+    /**
+     * @brief Force kernels onto a specific path (benchmarks, testing).
+     *
+     * @throws std::invalid_argument if the CPU does not support `isa`.
+     */
+    void set_active_isa(Isa isa);
+
+    bool isa_supported(Isa isa);
+
+    /// Whether the CPU has AVX-512 VNNI (u8 x s8 dot products, used by qgemm on the Avx512 path).
+    bool has_avx512_vnni();
+    std::string isa_name(Isa isa);
+}
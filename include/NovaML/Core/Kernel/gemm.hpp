@@ -0,0 +1,98 @@
+#pragma once
+#include <cstddef>
+#include <algorithm>
+#include "activation.hpp"
+#include "../Tensor/half.hpp"
+
+namespace NovaML::Core::Kernel
+{
+    /**
+     * @brief Row-major general matrix multiply.
+     *
+     * C[M x N] = alpha * op(A)[M x K] * op(B)[K x N] + beta * C
+     *
+     * op(X) is X or X^T depending on trans_a / trans_b; lda, ldb and ldc are
+     * the row strides of A, B and C as stored. When beta is zero C is
+     * overwritten and never read. An optional epilogue adds a per-column
+     * bias and applies an activation to each output tile as it is finished.
+     *
+     * float and double run on packed, cache-blocked micro-kernels with an
+     * AVX2 / AVX-512 / NEON path picked at runtime (see cpu_features.hpp).
+     * Other element types use the portable blocked template below.
+     */
+    void gemm(bool trans_a, bool trans_b, size_t M, size_t N, size_t K,
+              float alpha, const float *A, size_t lda, const float *B, size_t ldb,
+              float beta, float *C, size_t ldc, const Epilogue<float> &epilogue = {});
+
+    void gemm(bool trans_a, bool trans_b, size_t M, size_t N, size_t K,
+              double alpha, const double *A, size_t lda, const double *B, size_t ldb,
+              double beta, double *C, size_t ldc, const Epilogue<double> &epilogue = {});
+
+    /**
+     * @brief GEMM on 16-bit storage with fp32 accumulation.
+     *
+     * Operands are widened to fp32 and multiplied on the fp32 kernels; C is
+     * rounded once, after the epilogue. Matrix-vector shapes (M or N == 1)
+     * widen the matrix a block at a time instead, so it is read in 16 bits
+     * straight from memory.
+     */
+    void gemm(bool trans_a, bool trans_b, size_t M, size_t N, size_t K,
+              bfloat16 alpha, const bfloat16 *A, size_t lda, const bfloat16 *B, size_t ldb,
+              bfloat16 beta, bfloat16 *C, size_t ldc, const Epilogue<bfloat16> &epilogue = {});
+
+    void gemm(bool trans_a, bool trans_b, size_t M, size_t N, size_t K,
+              float16 alpha, const float16 *A, size_t lda, const float16 *B, size_t ldb,
+              float16 beta, float16 *C, size_t ldc, const Epilogue<float16> &epilogue = {});
+
+    /**
+     * @brief Row-major matrix-vector multiply.
+     *
+     * y[M or N] = alpha * op(A) * x + beta * y, with A stored as M x N.
+     */
+    void gemv(bool trans, size_t M, size_t N, float alpha, const float *A, size_t lda,
+              const float *x, float beta, float *y);
+
+    void gemv(bool trans, size_t M, size_t N, double alpha, const double *A, size_t lda,
+              const double *x, double beta, double *y);
+
+    // -------------------------
+    // Portable fallback for element types without a tuned kernel
+    // -------------------------
+    template <typename T>
+    void gemm(bool trans_a, bool trans_b, size_t M, size_t N, size_t K,
+              T alpha, const T *A, size_t lda, const T *B, size_t ldb,
+              T beta, T *C, size_t ldc, const Epilogue<T> &epilogue = {})
+    {
+        constexpr size_t block = 64;
+        for (size_t i = 0; i < M; i++)
+            for (size_t j = 0; j < N; j++)
+                C[i * ldc + j] = beta == T(0) ? T(0) : T(beta * C[i * ldc + j]);
+
+        for (size_t i0 = 0; i0 < M; i0 += block)
+            for (size_t k0 = 0; k0 < K; k0 += block)
+                for (size_t i = i0; i < std::min(M, i0 + block); i++)
+                    for (size_t k = k0; k < std::min(K, k0 + block); k++)
+                    {
+                        T a = alpha * (trans_a ? A[k * lda + i] : A[i * lda + k]);
+                        T *c = C + i * ldc;
+                        if (trans_b)
+                            for (size_t j = 0; j < N; j++)
+                                c[j] += a * B[j * ldb + k];
+                        else
+                            for (size_t j = 0; j < N; j++)
+                                c[j] += a * B[k * ldb + j];
+                    }
+        if (epilogue.active())
+            apply_epilogue(epilogue, C, ldc, M, 0, N);
+    }
+
+    template <typename T>
+    void gemv(bool trans, size_t M, size_t N, T alpha, const T *A, size_t lda,
+              const T *x, T beta, T *y)
+    {
+        if (trans)
+            gemm<T>(false, false, 1, N, M, alpha, x, M, A, lda, beta, y, N);
+        else
+            gemm<T>(false, true, 1, M, N, alpha, x, N, A, lda, beta, y, M);
+    }
+}
@@ -0,0 +1,77 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "activation.hpp"
+#include "../../Memory/allocator.hpp"
+
+namespace NovaML::Core::Kernel
+{
+    /**
+     * @brief Int8 weights W[N x K] packed for qgemm.
+     *
+     * Output channels are grouped in panels of 16; inside a panel every
+     * group of 4 consecutive k holds 16 channels x 4 bytes, the operand
+     * layout of the u8 x s8 dot-product instructions (AVX-512 VNNI
+     * vpdpbusd). K is padded to a multiple of 4 and N to a multiple of 16
+     * with zero weights.
+     */
+    struct PackedInt8
+    {
+        static constexpr size_t panel = 16; ///< output channels per panel
+
+        size_t rows = 0;  ///< N
+        size_t depth = 0; ///< K
+        Memory::Buffer<int8_t> data;
+        std::vector<int32_t> row_sums; ///< sum_k W[n][k], folds the activation zero point out of the K loop
+
+        size_t padded_depth() const { return (depth + 3) / 4 * 4; }
+        size_t bytes() const { return data.size() + row_sums.size() * sizeof(int32_t); }
+    };
+
+    /**
+     * @brief Pack row-major int8 weights, W[n][k] at W[n * ldw + k].
+     *
+     * @throws std::invalid_argument if K is so large that the int32 sums could overflow.
+     */
+    PackedInt8 pack_int8(size_t N, size_t K, const int8_t *W, size_t ldw);
+
+    /**
+     * @brief How qgemm turns int32 sums into the layer output.
+     *
+     * y[n] = act(scale[n] * (acc[n] + offset[n]) + bias[n]), stored as float
+     * or requantized to uint8 as clamp(round(y / output_scale) +
+     * output_zero_point, 0, 255). `scale` and `offset` hold one value per
+     * output column; `bias` may be null.
+     */
+    struct Requantize
+    {
+        const float *scale = nullptr;
+        const int32_t *offset = nullptr;
+        const float *bias = nullptr;
+        Activation activation = Activation::None;
+        float output_scale = 1.0f;
+        int32_t output_zero_point = 0;
+    };
+
+    /**
+     * @brief C[M x N] = requantize(A[M x K] W^T) on uint8 activations and int8 weights.
+     *
+     * Products are summed exactly in int32 and requantized per output tile
+     * while it is still in registers / L1, so the int32 matrix is never
+     * stored. A is read 4 bytes of k at a time: its rows must be readable
+     * up to W.padded_depth() (lda >= that); the padding bytes meet zero
+     * weights and their values do not matter.
+     *
+     * Runs on AVX-512 VNNI when the CPU has it and the active ISA is
+     * Avx512, on an exact AVX2 path (16-bit products) otherwise on x86-64,
+     * and on portable loops elsewhere.
+     */
+    void qgemm(size_t M, const uint8_t *A, size_t lda, const PackedInt8 &W, const Requantize &rq,
+               uint8_t *C, size_t ldc);
+    void qgemm(size_t M, const uint8_t *A, size_t lda, const PackedInt8 &W, const Requantize &rq,
+               float *C, size_t ldc);
+
+    /// q[i] = clamp(round(x[i] / scale) + zero_point, 0, 255)
+    void quantize(size_t n, const float *x, float scale, int32_t zero_point, uint8_t *q);
+}
@@ -0,0 +1,141 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+#include "../Tensor/half.hpp"
+
+namespace NovaML::Core::Kernel
+{
+    /**
+     * @brief Accuracy tier of the vectorized transcendental kernels.
+     *
+     * Exact keeps exp and log within 1 ulp of the correctly rounded result
+     * (tanh, sigmoid and pow are composed from them and stay within a
+     * couple of ulp). Fast uses shorter polynomials: relative error below
+     * 1e-4, enough for activations and losses, at roughly two thirds of the
+     * cost.
+     */
+    enum class MathAccuracy
+    {
+        Fast,
+        Exact
+    };
+
+    /// Tier used when a kernel is called without one. Exact unless NOVAML_MATH=fast.
+    MathAccuracy math_accuracy();
+    void set_math_accuracy(MathAccuracy accuracy);
+
+    /**
+     * @brief Element-wise y[i] = f(x[i]) over n contiguous values.
+     *
+     * float and double run branch-free polynomial approximations
+     * vectorized for the active ISA (picked at runtime like gemm) and split
+     * across the intra-op thread pool. x and y may be the same array.
+     * Special values follow libm: exp overflows to inf and underflows
+     * through the subnormals to 0, log(0) = -inf and log(x < 0) = NaN.
+     */
+    void vexp(size_t n, const float *x, float *y, MathAccuracy accuracy = math_accuracy());
+    void vexp(size_t n, const double *x, double *y, MathAccuracy accuracy = math_accuracy());
+    void vlog(size_t n, const float *x, float *y, MathAccuracy accuracy = math_accuracy());
+    void vlog(size_t n, const double *x, double *y, MathAccuracy accuracy = math_accuracy());
+    void vtanh(size_t n, const float *x, float *y, MathAccuracy accuracy = math_accuracy());
+    void vtanh(size_t n, const double *x, double *y, MathAccuracy accuracy = math_accuracy());
+
+    /// y = 1 / (1 + exp(-x))
+    void vsigmoid(size_t n, const float *x, float *y, MathAccuracy accuracy = math_accuracy());
+    void vsigmoid(size_t n, const double *x, double *y, MathAccuracy accuracy = math_accuracy());
+
+    /**
+     * @brief y[i] = pow(x[i], exponent).
+     *
+     * Exponents 0, 1, 2 and -1 are plain arithmetic; other integer
+     * exponents multiply by repeated squaring in the Fast tier. Everything
+     * else is exp(exponent * log|x|) with the sign of odd integer powers
+     * restored; a negative base with a fractional exponent gives NaN. The
+     * Exact tier evaluates that in double for float, and calls std::pow for
+     * double.
+     */
+    void vpow(size_t n, const float *x, float exponent, float *y, MathAccuracy accuracy = math_accuracy());
+    void vpow(size_t n, const double *x, double exponent, double *y, MathAccuracy accuracy = math_accuracy());
+
+    /// True when no x[i] is <= 0 (NaN passes), as one branch-free pass: the domain check of log.
+    template <typename T>
+    bool all_positive(size_t n, const T *x)
+    {
+        bool bad = false;
+        for (size_t i = 0; i < n; i++)
+            bad |= x[i] <= T(0);
+        return !bad;
+    }
+
+    // -------------------------
+    // Other element types: 16-bit types widen block-wise to the float
+    // kernels, anything else falls back to libm element by element
+    // -------------------------
+    namespace detail
+    {
+        template <typename T, typename Kernel, typename Scalar>
+        void vmath_fallback(size_t n, const T *x, T *y, Kernel &&kernel, Scalar &&scalar)
+        {
+            if constexpr (std::is_same_v<T, bfloat16> || std::is_same_v<T, float16>)
+            {
+                float block[256];
+                for (size_t b = 0; b < n; b += 256)
+                {
+                    const size_t m = std::min<size_t>(256, n - b);
+                    for (size_t i = 0; i < m; i++)
+                        block[i] = float(x[b + i]);
+                    kernel(m, block, block);
+                    for (size_t i = 0; i < m; i++)
+                        y[b + i] = T(block[i]);
+                }
+            }
+            else
+            {
+                for (size_t i = 0; i < n; i++)
+                    y[i] = T(scalar(x[i]));
+            }
+        }
+    }
+
+    template <typename T>
+    void vexp(size_t n, const T *x, T *y, MathAccuracy accuracy = math_accuracy())
+    {
+        detail::vmath_fallback(n, x, y, [accuracy](size_t m, const float *a, float *b)
+                               { vexp(m, a, b, accuracy); }, [](const T &v)
+                               { return std::exp(v); });
+    }
+
+    template <typename T>
+    void vlog(size_t n, const T *x, T *y, MathAccuracy accuracy = math_accuracy())
+    {
+        detail::vmath_fallback(n, x, y, [accuracy](size_t m, const float *a, float *b)
+                               { vlog(m, a, b, accuracy); }, [](const T &v)
+                               { return std::log(v); });
+    }
+
+    template <typename T>
+    void vtanh(size_t n, const T *x, T *y, MathAccuracy accuracy = math_accuracy())
+    {
+        detail::vmath_fallback(n, x, y, [accuracy](size_t m, const float *a, float *b)
+                               { vtanh(m, a, b, accuracy); }, [](const T &v)
+                               { return std::tanh(v); });
+    }
+
+    template <typename T>
+    void vsigmoid(size_t n, const T *x, T *y, MathAccuracy accuracy = math_accuracy())
+    {
+        detail::vmath_fallback(n, x, y, [accuracy](size_t m, const float *a, float *b)
+                               { vsigmoid(m, a, b, accuracy); }, [](const T &v)
+                               { return T(1) / (T(1) + std::exp(-v)); });
+    }
+
+    template <typename T>
+    void vpow(size_t n, const T *x, T exponent, T *y, MathAccuracy accuracy = math_accuracy())
+    {
+        detail::vmath_fallback(n, x, y, [exponent, accuracy](size_t m, const float *a, float *b)
+                               { vpow(m, a, float(exponent), b, accuracy); }, [exponent](const T &v)
+                               { return std::pow(v, exponent); });
+    }
+}
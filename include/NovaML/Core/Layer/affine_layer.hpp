@@ -0,0 +1,73 @@
+#pragma once
+#include "../Module/module.hpp"
+#include "../Tensor/tensor.hpp"
+#include "../Kernel/activation.hpp"
+#include <string>
+#include <vector>
+
+namespace NovaML::Core::LayerModule
+{
+    /**
+     * @brief Shared parameter block and activation handling of Dense and Conv2D.
+     *
+     * Weights [outputs x fan_in] and the bias live in one aligned block of a
+     * ParameterBuffer (gradients in the same block of its gradient buffer):
+     * the layer's own until flatten_parameters() moves it into a model-wide
+     * one. Derived layers compute act(W x + b) in apply(), with the
+     * activation as their GEMM epilogue; a training forward keeps what the
+     * activation derivative needs.
+     */
+    template <typename T>
+    class AffineLayer : public NovaML::Core::Module::BaseModule<T>
+    {
+    public:
+        NovaML::Core::TensorModule::Tensor<T> forward(const NovaML::Core::TensorModule::Tensor<T> &input) override;
+        NovaML::Core::TensorModule::Tensor<T> infer(const NovaML::Core::TensorModule::Tensor<T> &input) const override;
+        void update(T lr) override;
+        size_t num_params() const override { return outputs * fan_in + outputs; }
+        void release_activations() override;
+        size_t parameter_size() const override;
+        void bind_parameters(const std::shared_ptr<NovaML::Core::Module::ParameterBuffer<T>> &buffer, size_t offset) override;
+        bool fuse_activation(Kernel::Activation act) override;
+        bool fold_channel_affine(const std::vector<T> &scale, const std::vector<T> &shift) override;
+
+        Kernel::Activation get_activation() const { return activation; }
+
+        /// Row-major [outputs x fan_in]
+        T *weights() { return parameters->data.data() + offset; }
+        const T *weights() const { return parameters->data.data() + offset; }
+        T *bias() { return weights() + bias_offset; }
+        const T *bias() const { return weights() + bias_offset; }
+        const T *grad_weights() const { return parameters->grad.data() + offset; }
+        const T *grad_bias() const { return grad_weights() + bias_offset; }
+
+    protected:
+        /// A new, zero-initialized parameter block.
+        AffineLayer(size_t outputs, size_t fan_in, Kernel::Activation activation, const char *name);
+        /// The parameters already in `buffer` at `offset`.
+        AffineLayer(size_t outputs, size_t fan_in, Kernel::Activation activation, const char *name,
+                    std::shared_ptr<NovaML::Core::Module::ParameterBuffer<T>> buffer, size_t offset);
+
+        /// act(W x + b) into a new tensor, with the given activation.
+        virtual NovaML::Core::TensorModule::Tensor<T> apply(const NovaML::Core::TensorModule::Tensor<T> &input,
+                                                             Kernel::Activation act) const = 0;
+
+        /// dL/d(W x + b) for the last forward: `grad` itself, or grad * act'(.) written to `scratch`.
+        const T *preactivation_grad(const NovaML::Core::TensorModule::Tensor<T> &grad, Buffer<T> &scratch) const;
+
+        /// Overwrite the bias gradient with G [outer x outputs x inner] summed over outer and inner.
+        void bias_grad(const T *g, size_t outer, size_t inner);
+
+        size_t outputs;
+        size_t fan_in;
+        Kernel::Activation activation;
+        const char *name;
+        size_t bias_offset; ///< weights rounded up to a whole cache line, so the bias is aligned too
+        std::shared_ptr<NovaML::Core::Module::ParameterBuffer<T>> parameters; ///< [weights | padding | bias] at offset
+        size_t offset = 0;
+        NovaML::Core::TensorModule::Tensor<T> last_input;
+        NovaML::Core::TensorModule::Tensor<T> last_activation; ///< Output, or pre-activation when the derivative needs it
+    };
+}
+
+#include "affine_layer.tpp"
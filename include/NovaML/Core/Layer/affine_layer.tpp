@@ -0,0 +1,174 @@
+#pragma once
+#include "affine_layer.hpp"
+#include "../../Parallel/thread_pool.hpp"
+
+namespace NovaML::Core::LayerModule
+{
+    template <typename T>
+    AffineLayer<T>::AffineLayer(size_t outputs, size_t fan_in, Kernel::Activation activation, const char *name)
+        : outputs(outputs),
+          fan_in(fan_in),
+          activation(activation),
+          name(name),
+          bias_offset(NovaML::Core::Module::aligned_elements<T>(outputs * fan_in)),
+          parameters(std::make_shared<NovaML::Core::Module::ParameterBuffer<T>>(parameter_size())),
+          last_input(0),
+          last_activation(0)
+    {
+    }
+
+    template <typename T>
+    AffineLayer<T>::AffineLayer(size_t outputs, size_t fan_in, Kernel::Activation activation, const char *name,
+                                std::shared_ptr<NovaML::Core::Module::ParameterBuffer<T>> buffer, size_t offset)
+        : outputs(outputs),
+          fan_in(fan_in),
+          activation(activation),
+          name(name),
+          bias_offset(NovaML::Core::Module::aligned_elements<T>(outputs * fan_in)),
+          parameters(std::move(buffer)),
+          offset(offset),
+          last_input(0),
+          last_activation(0)
+    {
+        if (!parameters || offset > parameters->size() || parameter_size() > parameters->size() - offset)
+            throw std::invalid_argument(std::string(name) + ": parameter block does not fit the buffer");
+    }
+
+    template <typename T>
+    NovaML::Core::TensorModule::Tensor<T> AffineLayer<T>::infer(const NovaML::Core::TensorModule::Tensor<T> &input) const
+    {
+        return apply(input, activation);
+    }
+
+    template <typename T>
+    NovaML::Core::TensorModule::Tensor<T> AffineLayer<T>::forward(const NovaML::Core::TensorModule::Tensor<T> &input)
+    {
+        // Only keep the input alive when a backward pass can follow.
+        if (!GradMode::is_enabled())
+            return infer(input);
+
+        NovaML::Core::TensorModule::Tensor<T> x = input.is_contiguous() ? input : NovaML::Core::TensorModule::Tensor<T>(input.get_data(), input.shape());
+        // GELU's derivative needs the pre-activation, so training keeps it and activates separately.
+        const bool split = Kernel::needs_preactivation(activation);
+        auto output = apply(x, split ? Kernel::Activation::None : activation);
+        last_input = x;
+
+        if (split)
+        {
+            last_activation = output;
+            output = NovaML::Core::TensorModule::Tensor<T>(std::make_shared<Storage<T>>(Buffer<T>(last_activation.size())),
+                                                           Layout::contiguous(last_activation.shape()));
+            const T *z = last_activation.data_ptr();
+            T *y = output.data_ptr();
+            const Kernel::Activation act = activation;
+            NovaML::Parallel::parallel_for(0, output.size(), NovaML::Parallel::elementwise_grain, [=](size_t b, size_t e)
+                                           {
+                                               for (size_t i = b; i < e; ++i)
+                                                   y[i] = Kernel::activate(act, z[i]); });
+        }
+        else if (activation != Kernel::Activation::None)
+            last_activation = output;
+
+        return output;
+    }
+
+    template <typename T>
+    const T *AffineLayer<T>::preactivation_grad(const NovaML::Core::TensorModule::Tensor<T> &grad, Buffer<T> &scratch) const
+    {
+        const T *g = grad.data_ptr();
+        if (activation == Kernel::Activation::None)
+            return g;
+        scratch = Buffer<T>(grad.size());
+        const T *v = last_activation.data_ptr();
+        T *d = scratch.data();
+        const Kernel::Activation act = activation;
+        NovaML::Parallel::parallel_for(0, scratch.size(), NovaML::Parallel::elementwise_grain, [=](size_t b, size_t e)
+                                       {
+                                           for (size_t i = b; i < e; ++i)
+                                               d[i] = g[i] * Kernel::activation_derivative(act, v[i]); });
+        return d;
+    }
+
+    template <typename T>
+    void AffineLayer<T>::bias_grad(const T *g, size_t outer, size_t inner)
+    {
+        // Parameter gradients are summed over the batch; the loss decides on averaging.
+        // Each task owns a block of output features and walks every outer row of it,
+        // so the sums do not depend on the thread count.
+        T *db = parameters->grad.data() + offset + bias_offset;
+        const size_t grain = std::max<size_t>(1, NovaML::Parallel::elementwise_grain / std::max<size_t>(1, outer * inner));
+        NovaML::Parallel::parallel_for(0, outputs, grain, [&](size_t c0, size_t c1)
+                                       {
+                                           std::vector<accumulate_t<T>> sum(c1 - c0, 0);
+                                           for (size_t o = 0; o < outer; o++)
+                                               for (size_t c = c0; c < c1; c++)
+                                               {
+                                                   const T *row = g + (o * outputs + c) * inner;
+                                                   for (size_t i = 0; i < inner; i++)
+                                                       sum[c - c0] += row[i];
+                                               }
+                                           std::copy(sum.begin(), sum.end(), db + c0); });
+    }
+
+    template <typename T>
+    void AffineLayer<T>::update(T lr)
+    {
+        // One pass over the layer's block (the padding has zero gradient).
+        T *p = weights();
+        const T *g = grad_weights();
+        NovaML::Parallel::parallel_for(0, bias_offset + outputs, NovaML::Parallel::elementwise_grain, [=](size_t b, size_t e)
+                                       {
+                                           for (size_t i = b; i < e; ++i)
+                                               p[i] -= lr * g[i]; });
+    }
+
+    template <typename T>
+    void AffineLayer<T>::release_activations()
+    {
+        last_input = NovaML::Core::TensorModule::Tensor<T>(0);
+        last_activation = NovaML::Core::TensorModule::Tensor<T>(0);
+    }
+
+    template <typename T>
+    size_t AffineLayer<T>::parameter_size() const
+    {
+        return NovaML::Core::Module::aligned_elements<T>(bias_offset + outputs);
+    }
+
+    template <typename T>
+    void AffineLayer<T>::bind_parameters(const std::shared_ptr<NovaML::Core::Module::ParameterBuffer<T>> &buffer, size_t at)
+    {
+        if (at + parameter_size() > buffer->size())
+            throw std::invalid_argument(std::string(name) + ": parameter block does not fit the buffer");
+        const size_t n = bias_offset + outputs;
+        std::copy(weights(), weights() + n, buffer->data.data() + at);
+        std::copy(grad_weights(), grad_weights() + n, buffer->grad.data() + at);
+        parameters = buffer;
+        offset = at;
+    }
+
+    template <typename T>
+    bool AffineLayer<T>::fuse_activation(Kernel::Activation act)
+    {
+        if (activation != Kernel::Activation::None || act == Kernel::Activation::None)
+            return false;
+        activation = act;
+        return true;
+    }
+
+    template <typename T>
+    bool AffineLayer<T>::fold_channel_affine(const std::vector<T> &scale, const std::vector<T> &shift)
+    {
+        if (activation != Kernel::Activation::None || scale.size() != outputs || shift.size() != outputs)
+            return false;
+        T *w = weights();
+        T *b = bias();
+        for (size_t o = 0; o < outputs; o++)
+        {
+            for (size_t i = 0; i < fan_in; i++)
+                w[o * fan_in + i] *= scale[o];
+            b[o] = b[o] * scale[o] + shift[o];
+        }
+        return true;
+    }
+}
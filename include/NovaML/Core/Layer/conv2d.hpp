@@ -0,0 +1,104 @@
+#pragma once
+#include "affine_layer.hpp"
+#include "../Tensor/tensor.hpp"
+#include "../Kernel/gemm.hpp"
+#include "../Kernel/conv.hpp"
+#include "../Kernel/activation.hpp"
+#include "image.hpp"
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace NovaML::Core::LayerModule
+{
+    enum class ConvAlgorithm
+    {
+        Auto,     ///< Winograd where it applies and pays off, im2col otherwise
+        Im2col,   ///< patches gathered into a matrix, one GEMM per image
+        Winograd  ///< F(2x2, 3x3): 3x3 kernels with stride 1 only
+    };
+
+    struct Conv2DOptions
+    {
+        size_t stride = 1;
+        size_t padding = 0; ///< zero rows / columns on every side
+        DataFormat format = DataFormat::NCHW;
+        Kernel::Activation activation = Kernel::Activation::None;
+        ConvAlgorithm algorithm = ConvAlgorithm::Auto;
+    };
+
+    /**
+     * @brief 2-d convolution y = act(conv(x, W) + b) over square kernels.
+     *
+     * Inputs are [N, C, H, W] or [N, H, W, C] (Conv2DOptions::format), and
+     * the output has the same format. Weights follow the format too:
+     * [out, in, k, k] for NCHW and [out, k, k, in] for NHWC, so a patch is
+     * read in memory order. They share one ParameterBuffer block with the
+     * bias (see AffineLayer), as in Dense.
+     *
+     * The im2col path gathers each image's patches into a matrix and runs
+     * one GEMM, with the bias and activation applied as the epilogue
+     * (channels-last) or on each finished channel row (channels-first).
+     * 1x1 kernels with stride 1 and no padding skip the gather. 3x3 kernels
+     * with stride 1 can use Winograd F(2x2, 3x3) instead: 16 GEMMs over
+     * transformed tiles, 2.25x fewer multiplies. Images (im2col) or tile
+     * blocks (Winograd) are spread over the thread pool. The transformed
+     * Winograd weights are kept between calls and rebuilt only when the
+     * weights change. Backward always uses the im2col formulation.
+     */
+    template <typename T = float>
+    class Conv2D : public AffineLayer<T>
+    {
+    public:
+        Conv2D(size_t in_channels, size_t out_channels, size_t kernel_size, Conv2DOptions options = {});
+
+        /// Use the parameters already in `buffer` at `offset` (a loaded checkpoint) instead of initializing new ones.
+        Conv2D(size_t in_channels, size_t out_channels, size_t kernel_size, Conv2DOptions options,
+               std::shared_ptr<NovaML::Core::Module::ParameterBuffer<T>> buffer, size_t offset);
+
+        NovaML::Core::TensorModule::Tensor<T> backward(const NovaML::Core::TensorModule::Tensor<T> &grad_output) override;
+        std::string info(std::ostream &) const override;
+        void update(T lr) override;
+        void bind_parameters(const std::shared_ptr<NovaML::Core::Module::ParameterBuffer<T>> &buffer, size_t offset) override;
+        bool fold_channel_affine(const std::vector<T> &scale, const std::vector<T> &shift) override;
+
+        size_t input_channels() const { return in_channels; }
+        size_t output_channels() const { return this->outputs; }
+        size_t kernel_size() const { return kernel; }
+        /// The construction options, with the activation currently applied (fused ones included).
+        Conv2DOptions options() const;
+
+        /// Output shape for an input shape, in the layer's format.
+        Shape output_shape(const Shape &input_shape) const;
+
+        /// Whether forward() runs Winograd (otherwise im2col).
+        bool uses_winograd() const;
+
+    protected:
+        /// act(conv(x) + b) into a new tensor, with the given activation.
+        NovaML::Core::TensorModule::Tensor<T> apply(const NovaML::Core::TensorModule::Tensor<T> &input,
+                                                    Kernel::Activation act) const override;
+
+    private:
+        void im2col_forward(const T *x, T *y, const ImageShape &in, const Kernel::ConvGeometry &g, Kernel::Activation act) const;
+        void winograd_forward(const T *x, T *y, const ImageShape &in, const Kernel::ConvGeometry &g, Kernel::Activation act) const;
+        Kernel::ConvGeometry geometry(const ImageShape &in) const;
+        void check_options() const;
+
+        /// Winograd weights U[16][out][in] for the current weights, transformed again only after they change.
+        std::shared_ptr<const Buffer<T>> winograd_transform() const;
+        void invalidate_winograd();
+
+        size_t in_channels;
+        size_t kernel;
+        Conv2DOptions opts; ///< activation lives in AffineLayer, so fusion can change it
+
+        mutable std::mutex winograd_mutex;
+        mutable std::shared_ptr<const Buffer<T>> winograd_cache; ///< null until the first Winograd forward
+        mutable std::vector<T> winograd_source;                  ///< the weights winograd_cache was built from
+    };
+}
+
+#include "conv2d.tpp"
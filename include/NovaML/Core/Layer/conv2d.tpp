@@ -0,0 +1,378 @@
+#pragma once
+#include "conv2d.hpp"
+#include "../../Parallel/thread_pool.hpp"
+#include <cmath>
+#include <cstring>
+#include <type_traits>
+
+namespace NovaML::Core::LayerModule
+{
+
+    template <typename T>
+    Conv2D<T>::Conv2D(size_t in_channels, size_t out_channels, size_t kernel_size, Conv2DOptions options)
+        : AffineLayer<T>(out_channels, in_channels * kernel_size * kernel_size, options.activation, "Conv2D"),
+          in_channels(in_channels),
+          kernel(kernel_size),
+          opts(options)
+    {
+        check_options();
+
+        std::mt19937 gen(42);
+        const double bound = 1.0 / std::sqrt(double(this->fan_in));
+        std::uniform_real_distribution<accumulate_t<T>> dist(-bound, bound);
+        T *w = this->weights();
+        for (size_t i = 0; i < out_channels * this->fan_in; ++i)
+            w[i] = dist(gen);
+    }
+
+    template <typename T>
+    Conv2D<T>::Conv2D(size_t in_channels, size_t out_channels, size_t kernel_size, Conv2DOptions options,
+                      std::shared_ptr<NovaML::Core::Module::ParameterBuffer<T>> buffer, size_t offset)
+        : AffineLayer<T>(out_channels, in_channels * kernel_size * kernel_size, options.activation, "Conv2D", std::move(buffer), offset),
+          in_channels(in_channels),
+          kernel(kernel_size),
+          opts(options)
+    {
+        check_options();
+    }
+
+    template <typename T>
+    void Conv2D<T>::check_options() const
+    {
+        if (in_channels == 0 || this->outputs == 0 || kernel == 0 || opts.stride == 0)
+            throw std::invalid_argument("Conv2D: channels, kernel size and stride must be positive");
+        if (opts.algorithm == ConvAlgorithm::Winograd && (kernel != 3 || opts.stride != 1))
+            throw std::invalid_argument("Conv2D: Winograd needs a 3x3 kernel with stride 1");
+    }
+
+    template <typename T>
+    Conv2DOptions Conv2D<T>::options() const
+    {
+        Conv2DOptions o = opts;
+        o.activation = this->activation;
+        return o;
+    }
+
+    template <typename T>
+    Kernel::ConvGeometry Conv2D<T>::geometry(const ImageShape &in) const
+    {
+        const size_t oh = window_output_size(in.h, kernel, opts.stride, opts.padding);
+        const size_t ow = window_output_size(in.w, kernel, opts.stride, opts.padding);
+        if (oh == 0 || ow == 0)
+            throw std::invalid_argument("Conv2D: " + std::to_string(kernel) + "x" + std::to_string(kernel) +
+                                        " kernel does not fit a " + std::to_string(in.h) + "x" + std::to_string(in.w) + " image");
+        return {in.c, in.h, in.w, kernel, opts.stride, opts.padding, oh, ow};
+    }
+
+    template <typename T>
+    Shape Conv2D<T>::output_shape(const Shape &input_shape) const
+    {
+        const ImageShape in = image_shape(input_shape, opts.format, in_channels, "Conv2D");
+        const Kernel::ConvGeometry g = geometry(in);
+        return ImageShape{in.n, this->outputs, g.out_height, g.out_width}.to_shape(opts.format);
+    }
+
+    template <typename T>
+    bool Conv2D<T>::uses_winograd() const
+    {
+        if (kernel != 3 || opts.stride != 1 || opts.algorithm == ConvAlgorithm::Im2col)
+            return false;
+        if (opts.algorithm == ConvAlgorithm::Winograd)
+            return true;
+        // The transforms cost O(channels) per tile and pay off once the GEMMs are wide enough;
+        // channels-first images are gathered with strided reads, so they need wider layers
+        // (bench_layers: conv3x3_*).
+        constexpr bool tuned = std::is_same_v<T, float> || std::is_same_v<T, double>;
+        const size_t min_channels = opts.format == DataFormat::NHWC ? 32 : 128;
+        return tuned && std::min(in_channels, this->outputs) >= min_channels;
+    }
+
+    template <typename T>
+    NovaML::Core::TensorModule::Tensor<T> Conv2D<T>::apply(const NovaML::Core::TensorModule::Tensor<T> &input,
+                                                           Kernel::Activation act) const
+    {
+        const ImageShape in = image_shape(input.shape(), opts.format, in_channels, "Conv2D");
+        const Kernel::ConvGeometry g = geometry(in);
+        NovaML::Core::TensorModule::Tensor<T> x = input.is_contiguous() ? input : NovaML::Core::TensorModule::Tensor<T>(input.get_data(), input.shape());
+
+        const Shape out_shape = ImageShape{in.n, this->outputs, g.out_height, g.out_width}.to_shape(opts.format);
+        // Every element is written by the GEMMs: no zero fill.
+        NovaML::Core::TensorModule::Tensor<T> output(std::make_shared<Storage<T>>(Buffer<T>(numel(out_shape))),
+                                                     Layout::contiguous(out_shape));
+        if (uses_winograd())
+            winograd_forward(x.data_ptr(), output.data_ptr(), in, g, act);
+        else
+            im2col_forward(x.data_ptr(), output.data_ptr(), in, g, act);
+        return output;
+    }
+
+    template <typename T>
+    void Conv2D<T>::im2col_forward(const T *x, T *y, const ImageShape &in, const Kernel::ConvGeometry &g,
+                                   Kernel::Activation act) const
+    {
+        const size_t out_channels = this->outputs, patch = this->fan_in;
+        const size_t P = g.out_pixels(), in_size = in.c * in.h * in.w, out_size = out_channels * P;
+        const bool pointwise = kernel == 1 && opts.stride == 1 && opts.padding == 0; // the image is its own patch matrix
+        const bool nchw = opts.format == DataFormat::NCHW;
+        // Large per-image GEMMs split further over the pool; GEMM keeps no
+        // per-thread state across its waits, so nesting it in these tasks is safe.
+        NovaML::Parallel::parallel_for(0, in.n, 1, [&](size_t begin, size_t end)
+                                       {
+            Buffer<T> cols(pointwise ? 0 : patch * P);
+            for (size_t n = begin; n < end; n++)
+            {
+                const T *xn = x + n * in_size;
+                T *yn = y + n * out_size;
+                if (nchw)
+                {
+                    // Y[out x P] = W[out x patch] cols[patch x P], then bias and activation per channel row
+                    if (!pointwise)
+                        Kernel::im2col_nchw(g, xn, cols.data());
+                    Kernel::gemm(false, false, out_channels, P, patch,
+                                 T(1), this->weights(), patch, pointwise ? xn : cols.data(), P,
+                                 T(0), yn, P);
+                    const T *b = this->bias();
+                    for (size_t o = 0; o < out_channels; o++)
+                    {
+                        T *row = yn + o * P;
+                        for (size_t p = 0; p < P; p++)
+                            row[p] += b[o];
+                        Kernel::apply_epilogue(Kernel::Epilogue<T>{nullptr, act}, row, P, 1, 0, P);
+                    }
+                }
+                else
+                {
+                    // Y[P x out] = patches[P x patch] W^T, bias and activation as the epilogue
+                    if (!pointwise)
+                        Kernel::im2col_nhwc(g, xn, cols.data());
+                    Kernel::Epilogue<T> epilogue{this->bias(), act};
+                    Kernel::gemm(false, true, P, out_channels, patch,
+                                 T(1), pointwise ? xn : cols.data(), patch, this->weights(), patch,
+                                 T(0), yn, out_channels, epilogue);
+                }
+            } });
+    }
+
+    template <typename T>
+    void Conv2D<T>::winograd_forward(const T *x, T *y, const ImageShape &in, const Kernel::ConvGeometry &g,
+                                     Kernel::Activation act) const
+    {
+        const size_t C = in_channels, O = this->outputs;
+        const bool nhwc = opts.format == DataFormat::NHWC;
+        const std::shared_ptr<const Buffer<T>> transformed = winograd_transform();
+        const T *U = transformed->data();
+
+        const size_t tiles_h = (g.out_height + 1) / 2, tiles_w = (g.out_width + 1) / 2;
+        const size_t tiles = in.n * tiles_h * tiles_w;
+        // Tiles per block: the transformed inputs and products of a block stay around 4 MiB,
+        // so the 16 GEMMs are tall enough to run near peak.
+        const size_t block = std::clamp<size_t>((4 << 20) / (16 * (C + O) * sizeof(T)), 16, 512);
+        const size_t blocks = (tiles + block - 1) / block;
+
+        NovaML::Parallel::parallel_for(0, blocks, 1, [&](size_t b0, size_t b1)
+                                       {
+            Buffer<T> d(16 * C), V(16 * block * C), M(16 * block * O), tile(4 * O);
+            for (size_t blk = b0; blk < b1; blk++)
+            {
+                const size_t first = blk * block, count = std::min(block, tiles - first);
+                // Input transform, one tile at a time
+                for (size_t t = 0; t < count; t++)
+                {
+                    const size_t id = first + t, n = id / (tiles_h * tiles_w);
+                    const size_t ty = id / tiles_w % tiles_h, tx = id % tiles_w;
+                    for (size_t i = 0; i < 4; i++)
+                        for (size_t j = 0; j < 4; j++)
+                        {
+                            T *dst = d.data() + (i * 4 + j) * C;
+                            const size_t ih = 2 * ty + i, iw = 2 * tx + j;
+                            if (ih < g.padding || ih - g.padding >= in.h || iw < g.padding || iw - g.padding >= in.w)
+                            {
+                                std::fill(dst, dst + C, T(0));
+                                continue;
+                            }
+                            const size_t pixel = (ih - g.padding) * in.w + iw - g.padding;
+                            if (nhwc)
+                            {
+                                const T *src = x + (n * in.h * in.w + pixel) * C;
+                                std::copy(src, src + C, dst);
+                            }
+                            else
+                                for (size_t c = 0; c < C; c++)
+                                    dst[c] = x[(n * C + c) * in.h * in.w + pixel];
+                        }
+                    Kernel::winograd_input_tile(d.data(), C, V.data() + t * C, block * C);
+                }
+                // M[xi][tiles x O] = V[xi][tiles x C] U[xi]^T
+                for (size_t xi = 0; xi < 16; xi++)
+                    Kernel::gemm(false, true, count, O, C,
+                                 T(1), V.data() + xi * block * C, C, U + xi * O * C, C,
+                                 T(0), M.data() + xi * block * O, O);
+                // Output transform, bias and activation, then the 2x2 outputs that fall inside the image
+                Kernel::Epilogue<T> epilogue{this->bias(), act};
+                for (size_t t = 0; t < count; t++)
+                {
+                    const size_t id = first + t, n = id / (tiles_h * tiles_w);
+                    const size_t ty = id / tiles_w % tiles_h, tx = id % tiles_w;
+                    Kernel::winograd_output_tile(M.data() + t * O, block * O, O, tile.data());
+                    Kernel::apply_epilogue(epilogue, tile.data(), O, 4, 0, O);
+                    for (size_t i = 0; i < 2; i++)
+                        for (size_t j = 0; j < 2; j++)
+                        {
+                            const size_t oh = 2 * ty + i, ow = 2 * tx + j;
+                            if (oh >= g.out_height || ow >= g.out_width)
+                                continue;
+                            const T *src = tile.data() + (i * 2 + j) * O;
+                            const size_t pixel = oh * g.out_width + ow;
+                            if (nhwc)
+                                std::copy(src, src + O, y + (n * g.out_pixels() + pixel) * O);
+                            else
+                                for (size_t o = 0; o < O; o++)
+                                    y[(n * O + o) * g.out_pixels() + pixel] = src[o];
+                        }
+                }
+            } });
+    }
+
+    template <typename T>
+    std::shared_ptr<const Buffer<T>> Conv2D<T>::winograd_transform() const
+    {
+        const size_t n = this->outputs * this->fan_in;
+        const T *w = this->weights();
+        std::lock_guard<std::mutex> lock(winograd_mutex);
+        // Optimizers write the weights through the shared ParameterBuffer without
+        // calling update(), so the cache is also checked against the weights it came from.
+        if (!winograd_cache || std::memcmp(w, winograd_source.data(), n * sizeof(T)) != 0)
+        {
+            auto U = std::make_shared<Buffer<T>>(16 * this->outputs * in_channels);
+            Kernel::winograd_weights(this->outputs, in_channels, w, opts.format == DataFormat::NHWC, U->data());
+            winograd_source.assign(w, w + n);
+            winograd_cache = std::move(U);
+        }
+        return winograd_cache;
+    }
+
+    template <typename T>
+    void Conv2D<T>::invalidate_winograd()
+    {
+        std::lock_guard<std::mutex> lock(winograd_mutex);
+        winograd_cache.reset();
+        winograd_source.clear();
+    }
+
+    template <typename T>
+    void Conv2D<T>::update(T lr)
+    {
+        AffineLayer<T>::update(lr);
+        invalidate_winograd();
+    }
+
+    template <typename T>
+    void Conv2D<T>::bind_parameters(const std::shared_ptr<NovaML::Core::Module::ParameterBuffer<T>> &buffer, size_t offset)
+    {
+        AffineLayer<T>::bind_parameters(buffer, offset);
+        invalidate_winograd();
+    }
+
+    template <typename T>
+    bool Conv2D<T>::fold_channel_affine(const std::vector<T> &scale, const std::vector<T> &shift)
+    {
+        if (!AffineLayer<T>::fold_channel_affine(scale, shift))
+            return false;
+        invalidate_winograd();
+        return true;
+    }
+
+    template <typename T>
+    NovaML::Core::TensorModule::Tensor<T> Conv2D<T>::backward(const NovaML::Core::TensorModule::Tensor<T> &grad_output)
+    {
+        const auto &last_input = this->last_input;
+        if (last_input.ndim() != 4)
+            throw std::logic_error("Conv2D: backward without a training forward");
+        const ImageShape in = image_shape(last_input.shape(), opts.format, in_channels, "Conv2D");
+        const Kernel::ConvGeometry g = geometry(in);
+        const size_t out_channels = this->outputs, patch = this->fan_in;
+        const size_t P = g.out_pixels(), in_size = in.c * in.h * in.w, out_size = out_channels * P;
+        if (grad_output.size() != in.n * out_size)
+            throw std::invalid_argument("Conv2D: grad_output does not match the last forward batch");
+
+        NovaML::Core::TensorModule::Tensor<T> grad(grad_output.is_contiguous() ? grad_output : NovaML::Core::TensorModule::Tensor<T>(grad_output.get_data()));
+        auto grad_input = NovaML::Core::TensorModule::Tensor<T>::zeros(last_input.shape());
+
+        // Through the fused activation first: G = dL/dY * act'(.)
+        Buffer<T> grad_pre;
+        const T *g_all = this->preactivation_grad(grad, grad_pre);
+
+        // G is [N, out, P] channels-first and [N * P, out] channels-last.
+        const bool nchw = opts.format == DataFormat::NCHW;
+        if (nchw)
+            this->bias_grad(g_all, in.n, P);
+        else
+            this->bias_grad(g_all, in.n * P, 1);
+
+        // Images are split into a fixed number of blocks that depends only on the
+        // batch, each accumulating its own weight gradient; the partials are then
+        // added in block order, so dW does not depend on the thread count.
+        T *gw = this->parameters->grad.data() + this->offset;
+        const size_t weight_size = out_channels * patch;
+        std::fill(gw, gw + weight_size, T(0)); // an empty batch still leaves a zero gradient
+        constexpr size_t max_blocks = 16;
+        const size_t blocks = std::min(in.n, max_blocks);
+        Buffer<T> partials(blocks > 1 ? (blocks - 1) * weight_size : 0);
+        NovaML::Parallel::parallel_for(0, blocks, 1, [&](size_t b0, size_t b1)
+                                       {
+            Buffer<T> cols(patch * P), grad_cols(patch * P);
+            for (size_t blk = b0; blk < b1; blk++)
+            {
+                T *dw = blk == 0 ? gw : partials.data() + (blk - 1) * weight_size;
+                const size_t first = blk * in.n / blocks;
+                for (size_t n = first; n < (blk + 1) * in.n / blocks; n++)
+                {
+                    const T *xn = last_input.data_ptr() + n * in_size;
+                    const T *gn = g_all + n * out_size;
+                    const T beta = n == first ? T(0) : T(1);
+                    if (nchw)
+                    {
+                        Kernel::im2col_nchw(g, xn, cols.data());
+                        // dW[out x patch] += G[out x P] cols^T, dcols[patch x P] = W^T G
+                        Kernel::gemm(false, true, out_channels, patch, P, T(1), gn, P, cols.data(), P, beta, dw, patch);
+                        Kernel::gemm(true, false, patch, P, out_channels, T(1), this->weights(), patch, gn, P, T(0), grad_cols.data(), P);
+                        Kernel::col2im_nchw(g, grad_cols.data(), grad_input.data_ptr() + n * in_size);
+                    }
+                    else
+                    {
+                        Kernel::im2col_nhwc(g, xn, cols.data());
+                        // dW[out x patch] += G^T[out x P] patches, dpatches[P x patch] = G W
+                        Kernel::gemm(true, false, out_channels, patch, P, T(1), gn, out_channels, cols.data(), patch, beta, dw, patch);
+                        Kernel::gemm(false, false, P, patch, out_channels, T(1), gn, out_channels, this->weights(), patch, T(0), grad_cols.data(), patch);
+                        Kernel::col2im_nhwc(g, grad_cols.data(), grad_input.data_ptr() + n * in_size);
+                    }
+                }
+            } });
+        if (blocks > 1)
+            NovaML::Parallel::parallel_for(0, weight_size, NovaML::Parallel::elementwise_grain, [&](size_t i0, size_t i1)
+                                           {
+                for (size_t blk = 1; blk < blocks; blk++)
+                {
+                    const T *dw = partials.data() + (blk - 1) * weight_size;
+                    for (size_t i = i0; i < i1; i++)
+                        gw[i] += dw[i];
+                } });
+        return grad_input;
+    }
+
+    template <typename T>
+    std::string Conv2D<T>::info(std::ostream &) const
+    {
+        std::string name = "Conv2D(" + std::to_string(in_channels) + "->" + std::to_string(this->outputs) + ", " +
+                           std::to_string(kernel) + "x" + std::to_string(kernel);
+        if (opts.stride != 1)
+            name += ", stride " + std::to_string(opts.stride);
+        if (opts.padding != 0)
+            name += ", pad " + std::to_string(opts.padding);
+        name += ", " + data_format_name(opts.format) + ")";
+        if (this->activation != Kernel::Activation::None)
+            name += "+" + Kernel::activation_name(this->activation);
+        return name;
+    }
+
+}
@@ -1,6 +1,8 @@
 #pragma once
-#include "../Module/module.hpp"
+#include "affine_layer.hpp"
 #include "../Tensor/tensor.hpp"
+#include "../Kernel/gemm.hpp"
+#include "../Kernel/activation.hpp"
 #include <vector>
 #include <random>
 #include <string>
@@ -9,26 +11,39 @@
 namespace NovaML::Core::LayerModule
 {
 
+    /**
+     * @brief Fully connected layer y = act(x W^T + b).
+     *
+     * Weights and bias share one ParameterBuffer block (see AffineLayer).
+     * The bias add and the optional activation run as the GEMM epilogue, so
+     * the output is written once; Sequential hands a directly following
+     * ReLU / Sigmoid / GELU module to the layer through fuse_activation().
+     */
     template <typename T = float>
-    class Dense : public NovaML::Core::Module::BaseModule<T>
+    class Dense : public AffineLayer<T>
     {
     public:
-        Dense(size_t in_features, size_t out_features);
+        Dense(size_t in_features, size_t out_features,
+              Kernel::Activation activation = Kernel::Activation::None);
+
+        /// Use the parameters already in `buffer` at `offset` (a loaded checkpoint) instead of initializing new ones.
+        Dense(size_t in_features, size_t out_features, Kernel::Activation activation,
+              std::shared_ptr<NovaML::Core::Module::ParameterBuffer<T>> buffer, size_t offset);
 
-        NovaML::Core::TensorModule::Tensor<T> forward(const NovaML::Core::TensorModule::Tensor<T> &input) override;
         NovaML::Core::TensorModule::Tensor<T> backward(const NovaML::Core::TensorModule::Tensor<T> &grad_output) override;
-        void update(T lr) override;
-        std::string info(std::ostream &os) const override;
-        size_t num_params() const override;
-
-    private:
-        std::vector<std::vector<T>> weights;
-        std::vector<T> bias;
-        std::vector<std::vector<T>> grad_weights;
-        std::vector<T> grad_bias;
-        NovaML::Core::TensorModule::Tensor<T> last_input;
+        std::string info(std::ostream &) const override;
+
+        size_t input_size() const { return this->fan_in; }
+        size_t output_size() const { return this->outputs; }
+
+        void set_activation(Kernel::Activation act) { this->activation = act; }
+
+    protected:
+        /// act(x W^T + b) into a new tensor, with the given activation as the GEMM epilogue.
+        NovaML::Core::TensorModule::Tensor<T> apply(const NovaML::Core::TensorModule::Tensor<T> &input,
+                                                    Kernel::Activation act) const override;
     };
 
 }
 
-#include "dense.tpp"
\ No newline at end of file
+#include "dense.tpp"
@@ -1,80 +1,92 @@
+#pragma once
 #include "dense.hpp"
 
 namespace NovaML::Core::LayerModule
 {
 
     template <typename T>
-    Dense<T>::Dense(size_t in_features, size_t out_features)
-        : weights(out_features, std::vector<T>(in_features)),
-          bias(out_features, T(0)),
-          grad_weights(out_features, std::vector<T>(in_features, T(0))),
-          grad_bias(out_features, T(0)),
-          last_input(in_features)
+    Dense<T>::Dense(size_t in_features, size_t out_features, Kernel::Activation activation)
+        : AffineLayer<T>(out_features, in_features, activation, "Dense")
     {
         std::mt19937 gen(42);
-        std::uniform_real_distribution<T> dist(T(-0.1), T(0.1));
+        std::uniform_real_distribution<accumulate_t<T>> dist(-0.1, 0.1);
 
-        for (auto &row : weights)
-            for (auto &w : row)
-                w = dist(gen);
+        T *w = this->weights();
+        for (size_t i = 0; i < out_features * in_features; ++i)
+            w[i] = dist(gen);
     }
 
     template <typename T>
-    NovaML::Core::TensorModule::Tensor<T> Dense<T>::forward(const NovaML::Core::TensorModule::Tensor<T> &input)
+    Dense<T>::Dense(size_t in_features, size_t out_features, Kernel::Activation activation,
+                    std::shared_ptr<NovaML::Core::Module::ParameterBuffer<T>> buffer, size_t offset)
+        : AffineLayer<T>(out_features, in_features, activation, "Dense", std::move(buffer), offset)
     {
-        last_input = input;
-        NovaML::Core::TensorModule::Tensor<T> output(weights.size());
+    }
+
+    template <typename T>
+    NovaML::Core::TensorModule::Tensor<T> Dense<T>::apply(const NovaML::Core::TensorModule::Tensor<T> &input,
+                                                          Kernel::Activation act) const
+    {
+        const size_t in_features = this->fan_in, out_features = this->outputs;
+        if (input.ndim() == 0 || input.ndim() > 2 || input.shape().back() != in_features)
+            throw std::invalid_argument("Dense: expected input of shape [batch, " + std::to_string(in_features) +
+                                        "] or [" + std::to_string(in_features) + "], got " + shape_to_string(input.shape()));
 
-        for (size_t i = 0; i < weights.size(); ++i)
-        {
-            T sum = bias[i];
-            for (size_t j = 0; j < input.size(); ++j)
-                sum += weights[i][j] * input[j];
-            output[i] = sum;
-        }
+        NovaML::Core::TensorModule::Tensor<T> x = input.is_contiguous() ? input : NovaML::Core::TensorModule::Tensor<T>(input.get_data(), input.shape());
+        const size_t batch = input.ndim() == 2 ? input.dim(0) : 1;
 
+        Shape out_shape = input.shape();
+        out_shape.back() = out_features;
+        // Every element is written by the GEMM (beta = 0): no zero fill.
+        NovaML::Core::TensorModule::Tensor<T> output(std::make_shared<Storage<T>>(Buffer<T>(numel(out_shape))),
+                                                     Layout::contiguous(out_shape));
+
+        // Y[batch x out] = act(X[batch x in] W^T + b), bias and activation applied per output tile.
+        Kernel::Epilogue<T> epilogue{this->bias(), act};
+        Kernel::gemm(false, true, batch, out_features, in_features,
+                     T(1), x.data_ptr(), in_features, this->weights(), in_features,
+                     T(0), output.data_ptr(), out_features, epilogue);
         return output;
     }
 
     template <typename T>
     NovaML::Core::TensorModule::Tensor<T> Dense<T>::backward(const NovaML::Core::TensorModule::Tensor<T> &grad_output)
     {
-        NovaML::Core::TensorModule::Tensor<T> grad_input(last_input.size());
-
-        for (size_t i = 0; i < weights.size(); ++i)
-        {
-            grad_bias[i] = grad_output[i];
-            for (size_t j = 0; j < last_input.size(); ++j)
-            {
-                grad_weights[i][j] = grad_output[i] * last_input[j];
-                grad_input[j] += weights[i][j] * grad_output[i];
-            }
-        }
+        const size_t in_features = this->fan_in, out_features = this->outputs;
+        const auto &last_input = this->last_input;
+        const size_t batch = last_input.ndim() == 2 ? last_input.dim(0) : 1;
+        if (grad_output.size() != batch * out_features)
+            throw std::invalid_argument("Dense: grad_output does not match the last forward batch");
 
-        return grad_input;
-    }
+        NovaML::Core::TensorModule::Tensor<T> grad(grad_output.is_contiguous() ? grad_output : NovaML::Core::TensorModule::Tensor<T>(grad_output.get_data()));
+        auto grad_input = NovaML::Core::TensorModule::Tensor<T>::zeros(last_input.shape());
 
-    template <typename T>
-    void Dense<T>::update(T lr)
-    {
-        for (size_t i = 0; i < weights.size(); ++i)
-        {
-            for (size_t j = 0; j < weights[0].size(); ++j)
-                weights[i][j] -= lr * grad_weights[i][j];
-            bias[i] -= lr * grad_bias[i];
-        }
-    }
+        // Through the fused activation first: G = dL/dY * act'(.)
+        Buffer<T> grad_pre;
+        const T *g = this->preactivation_grad(grad, grad_pre);
 
-    template <typename T>
-    std::string Dense<T>::info(std::ostream &os) const
-    {
-        return "Dense(" + std::to_string(weights[0].size()) + "->" + std::to_string(weights.size()) + ")";
+        this->bias_grad(g, batch, 1);
+
+        // dW[out x in] = G^T[out x batch] X[batch x in]
+        Kernel::gemm(true, false, out_features, in_features, batch,
+                     T(1), g, out_features, last_input.data_ptr(), in_features,
+                     T(0), this->parameters->grad.data() + this->offset, in_features);
+
+        // dX[batch x in] = G[batch x out] W[out x in]
+        Kernel::gemm(false, false, batch, in_features, out_features,
+                     T(1), g, out_features, this->weights(), in_features,
+                     T(0), grad_input.data_ptr(), in_features);
+
+        return grad_input;
     }
 
     template <typename T>
-    size_t Dense<T>::num_params() const
+    std::string Dense<T>::info(std::ostream &) const
     {
-        return weights.size() * weights[0].size() + bias.size();
+        std::string name = "Dense(" + std::to_string(this->fan_in) + "->" + std::to_string(this->outputs) + ")";
+        if (this->activation != Kernel::Activation::None)
+            name += "+" + Kernel::activation_name(this->activation);
+        return name;
     }
 
-}
\ No newline at end of file
+}
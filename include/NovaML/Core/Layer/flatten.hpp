@@ -0,0 +1,33 @@
+#pragma once
+#include "../Module/module.hpp"
+#include "../Tensor/tensor.hpp"
+#include <string>
+
+namespace NovaML::Core::LayerModule
+{
+    /**
+     * @brief [N, d1, d2, ...] -> [N, d1 * d2 * ...], in memory order.
+     *
+     * Bridges image layers and Dense. A contiguous input is viewed, not
+     * copied; backward restores the input shape the same way.
+     */
+    template <typename T = float>
+    class Flatten : public NovaML::Core::Module::BaseModule<T>
+    {
+    public:
+        Flatten() = default;
+
+        NovaML::Core::TensorModule::Tensor<T> forward(const NovaML::Core::TensorModule::Tensor<T> &input) override;
+        NovaML::Core::TensorModule::Tensor<T> infer(const NovaML::Core::TensorModule::Tensor<T> &input) const override;
+        NovaML::Core::TensorModule::Tensor<T> backward(const NovaML::Core::TensorModule::Tensor<T> &grad_output) override;
+        std::string info(std::ostream &) const override { return "Flatten"; }
+        void release_activations() override { last_shape.clear(); }
+
+    private:
+        static NovaML::Core::TensorModule::Tensor<T> reshaped(const NovaML::Core::TensorModule::Tensor<T> &input, const Shape &shape);
+
+        Shape last_shape;
+    };
+}
+
+#include "flatten.tpp"
@@ -0,0 +1,41 @@
+#pragma once
+#include "flatten.hpp"
+
+namespace NovaML::Core::LayerModule
+{
+    template <typename T>
+    NovaML::Core::TensorModule::Tensor<T> Flatten<T>::reshaped(const NovaML::Core::TensorModule::Tensor<T> &input, const Shape &shape)
+    {
+        if (input.is_contiguous())
+            return NovaML::Core::TensorModule::Tensor<T>(input.get_storage(), view_layout(input.get_layout(), shape));
+        return NovaML::Core::TensorModule::Tensor<T>(input.get_data(), shape);
+    }
+
+    template <typename T>
+    NovaML::Core::TensorModule::Tensor<T> Flatten<T>::infer(const NovaML::Core::TensorModule::Tensor<T> &input) const
+    {
+        if (input.ndim() < 2)
+            throw std::invalid_argument("Flatten: expected input of shape [batch, ...], got " + shape_to_string(input.shape()));
+        const size_t batch = input.dim(0);
+        return reshaped(input, Shape{batch, batch ? input.size() / batch : 0});
+    }
+
+    template <typename T>
+    NovaML::Core::TensorModule::Tensor<T> Flatten<T>::forward(const NovaML::Core::TensorModule::Tensor<T> &input)
+    {
+        auto output = infer(input);
+        if (GradMode::is_enabled())
+            last_shape = input.shape();
+        return output;
+    }
+
+    template <typename T>
+    NovaML::Core::TensorModule::Tensor<T> Flatten<T>::backward(const NovaML::Core::TensorModule::Tensor<T> &grad_output)
+    {
+        if (last_shape.empty())
+            throw std::logic_error("Flatten: backward without a training forward");
+        if (grad_output.size() != numel(last_shape))
+            throw std::invalid_argument("Flatten: grad_output does not match the last forward batch");
+        return reshaped(grad_output, last_shape);
+    }
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include "../Tensor/tensor.hpp"
+#include <stdexcept>
+#include <string>
+
+namespace NovaML::Core::LayerModule
+{
+    /// Memory order of a batch of images: channels-first or channels-last.
+    enum class DataFormat
+    {
+        NCHW,
+        NHWC
+    };
+
+    inline std::string data_format_name(DataFormat format)
+    {
+        return format == DataFormat::NCHW ? "NCHW" : "NHWC";
+    }
+
+    /// Dimensions of a 4-d image batch, independent of its format.
+    struct ImageShape
+    {
+        size_t n, c, h, w;
+
+        size_t pixels() const { return h * w; }
+        size_t size() const { return n * c * h * w; }
+
+        Shape to_shape(DataFormat format) const
+        {
+            return format == DataFormat::NCHW ? Shape{n, c, h, w} : Shape{n, h, w, c};
+        }
+    };
+
+    /**
+     * @brief Read [N, C, H, W] or [N, H, W, C] according to `format`.
+     *
+     * @throws std::invalid_argument naming `layer` if the input is not 4-d
+     * or has other than `channels` channels (0 accepts any count)
+     */
+    inline ImageShape image_shape(const Shape &shape, DataFormat format, size_t channels, const std::string &layer)
+    {
+        const bool nchw = format == DataFormat::NCHW;
+        if (shape.size() != 4 || (channels && shape[nchw ? 1 : 3] != channels))
+            throw std::invalid_argument(layer + ": expected " + data_format_name(format) + " input with " +
+                                        (channels ? std::to_string(channels) : std::string("any number of")) +
+                                        " channels, got " + shape_to_string(shape));
+        return nchw ? ImageShape{shape[0], shape[1], shape[2], shape[3]} : ImageShape{shape[0], shape[3], shape[1], shape[2]};
+    }
+
+    /// Output extent of a sliding window: floor((in + 2 pad - window) / stride) + 1, 0 if it does not fit.
+    inline size_t window_output_size(size_t in, size_t window, size_t stride, size_t padding)
+    {
+        return in + 2 * padding < window ? 0 : (in + 2 * padding - window) / stride + 1;
+    }
+}
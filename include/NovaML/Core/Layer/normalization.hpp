@@ -0,0 +1,154 @@
+#pragma once
+#include "../Module/module.hpp"
+#include "../Tensor/tensor.hpp"
+#include "image.hpp"
+#include <string>
+#include <vector>
+
+namespace NovaML::Core::LayerModule
+{
+    /**
+     * @brief Per-channel batch normalization y = gamma * (x - mean) / sqrt(var + eps) + beta.
+     *
+     * Inputs are [N, C] or a 4-d image batch in the layer's format. In
+     * training mode (BaseModule::set_training, the default) forward
+     * normalizes with the batch statistics, and a forward with gradients on
+     * also folds them into the running mean and (unbiased) variance with
+     * `momentum`. Gradient mode alone does not switch statistics, so a
+     * checkpointed forward and its recompute agree. infer() and forward in
+     * eval mode use the running statistics. gamma and beta share one
+     * ParameterBuffer block, as in Dense.
+     *
+     * With fixed statistics the layer is a per-channel affine map, so
+     * Sequential::fold_batch_norm() can absorb it into a preceding Conv2D or
+     * Dense for inference. Running statistics are plain members, outside
+     * the ParameterBuffer: checkpoints store them as module state and
+     * Parallel::DataParallel merges them with merge_shard_statistics().
+     */
+    template <typename T = float>
+    class BatchNorm : public NovaML::Core::Module::BaseModule<T>
+    {
+    public:
+        explicit BatchNorm(size_t channels, DataFormat format = DataFormat::NCHW, T momentum = T(0.1), T eps = T(1e-5));
+
+        /// Use gamma and beta already in `buffer` at `offset` (a loaded checkpoint) instead of initializing new ones.
+        BatchNorm(size_t channels, DataFormat format, T momentum, T eps,
+                  std::shared_ptr<NovaML::Core::Module::ParameterBuffer<T>> buffer, size_t offset);
+
+        NovaML::Core::TensorModule::Tensor<T> forward(const NovaML::Core::TensorModule::Tensor<T> &input) override;
+        NovaML::Core::TensorModule::Tensor<T> infer(const NovaML::Core::TensorModule::Tensor<T> &input) const override;
+        NovaML::Core::TensorModule::Tensor<T> backward(const NovaML::Core::TensorModule::Tensor<T> &grad_output) override;
+        void update(T lr) override;
+        std::string info(std::ostream &) const override;
+        size_t num_params() const override { return 2 * channels; }
+        void release_activations() override;
+        size_t parameter_size() const override;
+        void bind_parameters(const std::shared_ptr<NovaML::Core::Module::ParameterBuffer<T>> &buffer, size_t offset) override;
+        bool channel_affine(std::vector<T> &scale, std::vector<T> &shift) const override;
+        void set_training(bool on) override { training = on; }
+
+        bool is_training() const { return training; }
+        size_t num_channels() const { return channels; }
+        DataFormat format() const { return fmt; }
+        T get_momentum() const { return momentum; }
+        T get_eps() const { return eps; }
+
+        T *gamma() { return parameters->data.data() + offset; }
+        const T *gamma() const { return parameters->data.data() + offset; }
+        T *beta() { return gamma() + beta_offset; }
+        const T *beta() const { return gamma() + beta_offset; }
+        const T *grad_gamma() const { return parameters->grad.data() + offset; }
+        const T *grad_beta() const { return grad_gamma() + beta_offset; }
+
+        std::vector<T> &running_mean() { return mean; }
+        const std::vector<T> &running_mean() const { return mean; }
+        std::vector<T> &running_var() { return var; }
+        const std::vector<T> &running_var() const { return var; }
+
+        /**
+         * @brief Running statistics as if the shards' last recorded forwards had been one batch.
+         *
+         * For data-parallel training: each shard is a replica of this layer
+         * that normalized its own rows, starting from `mean0` / `var0`. Their
+         * batch statistics are pooled (exactly, with the between-shard
+         * spread) and folded into `mean0` / `var0` once, with this layer's
+         * momentum, as a forward over the whole batch would have.
+         */
+        void merge_shard_statistics(const std::vector<const BatchNorm<T> *> &shards,
+                                    const std::vector<T> &mean0, const std::vector<T> &var0);
+
+    private:
+        /// Element (o, c, i) of the input is at (o * channels + c) * inner + i.
+        void groups(const Shape &shape, size_t &outer, size_t &inner) const;
+        NovaML::Core::TensorModule::Tensor<T> normalize(const NovaML::Core::TensorModule::Tensor<T> &input,
+                                                        const std::vector<T> &scale, const std::vector<T> &shift) const;
+
+        size_t channels;
+        DataFormat fmt;
+        T momentum;
+        T eps;
+        bool training = true;
+        size_t beta_offset; ///< gamma rounded up to a whole cache line
+        std::shared_ptr<NovaML::Core::Module::ParameterBuffer<T>> parameters; ///< [gamma | padding | beta] at offset
+        size_t offset = 0;
+        std::vector<T> mean;
+        std::vector<T> var;
+        NovaML::Core::TensorModule::Tensor<T> last_normalized; ///< (x - mean) / sqrt(var + eps) of the last training forward
+        std::vector<T> last_invstd;
+        std::vector<T> last_mean; ///< batch mean and (biased) variance of the last forward that moved the running statistics
+        std::vector<T> last_var;
+        size_t last_count = 0; ///< values per channel in that batch
+    };
+
+    /**
+     * @brief Normalization over the last dimension, per row: y = gamma * (x - mean) / sqrt(var + eps) + beta.
+     *
+     * Rows (every index but the last) are spread over the thread pool and
+     * use only their own statistics, so training and inference agree.
+     */
+    template <typename T = float>
+    class LayerNorm : public NovaML::Core::Module::BaseModule<T>
+    {
+    public:
+        explicit LayerNorm(size_t features, T eps = T(1e-5));
+
+        /// Use gamma and beta already in `buffer` at `offset` (a loaded checkpoint) instead of initializing new ones.
+        LayerNorm(size_t features, T eps, std::shared_ptr<NovaML::Core::Module::ParameterBuffer<T>> buffer, size_t offset);
+
+        NovaML::Core::TensorModule::Tensor<T> forward(const NovaML::Core::TensorModule::Tensor<T> &input) override;
+        NovaML::Core::TensorModule::Tensor<T> infer(const NovaML::Core::TensorModule::Tensor<T> &input) const override;
+        NovaML::Core::TensorModule::Tensor<T> backward(const NovaML::Core::TensorModule::Tensor<T> &grad_output) override;
+        void update(T lr) override;
+        std::string info(std::ostream &) const override { return "LayerNorm(" + std::to_string(features) + ")"; }
+        size_t num_params() const override { return 2 * features; }
+        void release_activations() override;
+        size_t parameter_size() const override;
+        void bind_parameters(const std::shared_ptr<NovaML::Core::Module::ParameterBuffer<T>> &buffer, size_t offset) override;
+
+        size_t num_features() const { return features; }
+        T get_eps() const { return eps; }
+
+        T *gamma() { return parameters->data.data() + offset; }
+        const T *gamma() const { return parameters->data.data() + offset; }
+        T *beta() { return gamma() + beta_offset; }
+        const T *beta() const { return gamma() + beta_offset; }
+        const T *grad_gamma() const { return parameters->grad.data() + offset; }
+        const T *grad_beta() const { return grad_gamma() + beta_offset; }
+
+    private:
+        /// Normalized rows into a new tensor; `normalized` / `invstd`, when given, keep what backward needs.
+        NovaML::Core::TensorModule::Tensor<T> normalize(const NovaML::Core::TensorModule::Tensor<T> &input,
+                                                        NovaML::Core::TensorModule::Tensor<T> *normalized,
+                                                        std::vector<T> *invstd) const;
+
+        size_t features;
+        T eps;
+        size_t beta_offset;
+        std::shared_ptr<NovaML::Core::Module::ParameterBuffer<T>> parameters; ///< [gamma | padding | beta] at offset
+        size_t offset = 0;
+        NovaML::Core::TensorModule::Tensor<T> last_normalized;
+        std::vector<T> last_invstd; ///< per row
+    };
+}
+
+#include "normalization.tpp"
@@ -0,0 +1,555 @@
+#pragma once
+#include "normalization.hpp"
+#include "../../Parallel/thread_pool.hpp"
+#include <cmath>
+
+namespace NovaML::Core::LayerModule
+{
+    namespace detail
+    {
+        /// Grain for parallel loops over rows of `row` elements: about 16K elements per task.
+        inline size_t row_grain(size_t row)
+        {
+            return std::max<size_t>(1, (16 << 10) / std::max<size_t>(1, row));
+        }
+
+        /**
+         * @brief Split the channels of an [outer, C, inner] array into blocks and run fn(c0, c1) on them in parallel.
+         *
+         * fn walks every outer row of its block with the channel loop inside,
+         * so channels-last data (inner == 1) is still read row by row.
+         */
+        template <typename F>
+        void for_channel_blocks(size_t outer, size_t C, size_t inner, F &&fn)
+        {
+            NovaML::Parallel::parallel_for(0, C, row_grain(outer * inner), fn);
+        }
+    }
+
+    // -------------------------
+    // BatchNorm
+    // -------------------------
+    template <typename T>
+    BatchNorm<T>::BatchNorm(size_t channels, DataFormat format, T momentum, T eps)
+        : channels(channels),
+          fmt(format),
+          momentum(momentum),
+          eps(eps),
+          beta_offset(NovaML::Core::Module::aligned_elements<T>(channels)),
+          mean(channels, T(0)),
+          var(channels, T(1)),
+          last_normalized(0)
+    {
+        if (channels == 0)
+            throw std::invalid_argument("BatchNorm: channel count must be positive");
+        parameters = std::make_shared<NovaML::Core::Module::ParameterBuffer<T>>(parameter_size());
+        std::fill(gamma(), gamma() + channels, T(1));
+    }
+
+    template <typename T>
+    BatchNorm<T>::BatchNorm(size_t channels, DataFormat format, T momentum, T eps,
+                            std::shared_ptr<NovaML::Core::Module::ParameterBuffer<T>> buffer, size_t offset)
+        : channels(channels),
+          fmt(format),
+          momentum(momentum),
+          eps(eps),
+          beta_offset(NovaML::Core::Module::aligned_elements<T>(channels)),
+          parameters(std::move(buffer)),
+          offset(offset),
+          mean(channels, T(0)),
+          var(channels, T(1)),
+          last_normalized(0)
+    {
+        if (channels == 0)
+            throw std::invalid_argument("BatchNorm: channel count must be positive");
+        if (!parameters || offset > parameters->size() || parameter_size() > parameters->size() - offset)
+            throw std::invalid_argument("BatchNorm: parameter block does not fit the buffer");
+    }
+
+    template <typename T>
+    void BatchNorm<T>::groups(const Shape &shape, size_t &outer, size_t &inner) const
+    {
+        if (shape.size() == 2 && shape[1] == channels)
+        {
+            outer = shape[0];
+            inner = 1;
+            return;
+        }
+        const ImageShape in = image_shape(shape, fmt, channels, "BatchNorm");
+        const bool nchw = fmt == DataFormat::NCHW;
+        outer = nchw ? in.n : in.n * in.pixels();
+        inner = nchw ? in.pixels() : 1;
+    }
+
+    template <typename T>
+    NovaML::Core::TensorModule::Tensor<T> BatchNorm<T>::normalize(const NovaML::Core::TensorModule::Tensor<T> &input,
+                                                                  const std::vector<T> &scale, const std::vector<T> &shift) const
+    {
+        size_t outer, inner;
+        groups(input.shape(), outer, inner);
+        NovaML::Core::TensorModule::Tensor<T> xc = input.is_contiguous() ? input : NovaML::Core::TensorModule::Tensor<T>(input.get_data(), input.shape());
+        NovaML::Core::TensorModule::Tensor<T> output(std::make_shared<Storage<T>>(Buffer<T>(input.size())),
+                                                     Layout::contiguous(input.shape()));
+        const T *x = xc.data_ptr();
+        T *y = output.data_ptr();
+        const size_t C = channels;
+        NovaML::Parallel::parallel_for(0, outer, detail::row_grain(C * inner), [&](size_t o0, size_t o1)
+                                       {
+            for (size_t o = o0; o < o1; o++)
+                for (size_t c = 0; c < C; c++)
+                {
+                    const T s = scale[c], b = shift[c];
+                    const size_t base = (o * C + c) * inner;
+                    for (size_t i = 0; i < inner; i++)
+                        y[base + i] = x[base + i] * s + b;
+                } });
+        return output;
+    }
+
+    template <typename T>
+    bool BatchNorm<T>::channel_affine(std::vector<T> &scale, std::vector<T> &shift) const
+    {
+        scale.resize(channels);
+        shift.resize(channels);
+        for (size_t c = 0; c < channels; c++)
+        {
+            scale[c] = T(accumulate_t<T>(gamma()[c]) / std::sqrt(accumulate_t<T>(var[c]) + accumulate_t<T>(eps)));
+            shift[c] = beta()[c] - mean[c] * scale[c];
+        }
+        return true;
+    }
+
+    template <typename T>
+    NovaML::Core::TensorModule::Tensor<T> BatchNorm<T>::infer(const NovaML::Core::TensorModule::Tensor<T> &input) const
+    {
+        std::vector<T> scale, shift;
+        channel_affine(scale, shift);
+        return normalize(input, scale, shift);
+    }
+
+    template <typename T>
+    NovaML::Core::TensorModule::Tensor<T> BatchNorm<T>::forward(const NovaML::Core::TensorModule::Tensor<T> &input)
+    {
+        if (!training)
+            return infer(input);
+
+        size_t outer, inner;
+        groups(input.shape(), outer, inner);
+        const size_t C = channels, count = outer * inner;
+        if (count < 2)
+            throw std::invalid_argument("BatchNorm: training needs more than one value per channel, got " + shape_to_string(input.shape()));
+        // Only a forward that backward can follow keeps xhat and moves the running statistics,
+        // so a checkpointed forward and its recompute count once.
+        const bool record = GradMode::is_enabled();
+        NovaML::Core::TensorModule::Tensor<T> xc = input.is_contiguous() ? input : NovaML::Core::TensorModule::Tensor<T>(input.get_data(), input.shape());
+        const T *x = xc.data_ptr();
+
+        // Batch statistics per channel, two passes for a stable variance
+        using Acc = accumulate_t<T>;
+        std::vector<Acc> batch_mean(C, 0), batch_var(C, 0);
+        detail::for_channel_blocks(outer, C, inner, [&](size_t c0, size_t c1)
+                                   {
+            for (size_t o = 0; o < outer; o++)
+                for (size_t c = c0; c < c1; c++)
+                {
+                    const T *row = x + (o * C + c) * inner;
+                    Acc s = 0;
+                    for (size_t i = 0; i < inner; i++)
+                        s += Acc(row[i]);
+                    batch_mean[c] += s;
+                }
+            for (size_t c = c0; c < c1; c++)
+                batch_mean[c] /= Acc(count);
+            for (size_t o = 0; o < outer; o++)
+                for (size_t c = c0; c < c1; c++)
+                {
+                    const T *row = x + (o * C + c) * inner;
+                    const Acc m = batch_mean[c];
+                    Acc s = 0;
+                    for (size_t i = 0; i < inner; i++)
+                        s += (Acc(row[i]) - m) * (Acc(row[i]) - m);
+                    batch_var[c] += s;
+                }
+            for (size_t c = c0; c < c1; c++)
+                batch_var[c] /= Acc(count); });
+
+        std::vector<T> m(C), invstd(C);
+        for (size_t c = 0; c < C; c++)
+        {
+            m[c] = T(batch_mean[c]);
+            invstd[c] = T(Acc(1) / std::sqrt(batch_var[c] + Acc(eps)));
+            if (!record)
+                continue;
+            const Acc unbiased = batch_var[c] * Acc(count) / Acc(count - 1);
+            mean[c] = T((Acc(1) - Acc(momentum)) * Acc(mean[c]) + Acc(momentum) * batch_mean[c]);
+            var[c] = T((Acc(1) - Acc(momentum)) * Acc(var[c]) + Acc(momentum) * unbiased);
+        }
+
+        // y = gamma * xhat + beta, xhat kept for backward
+        NovaML::Core::TensorModule::Tensor<T> output(std::make_shared<Storage<T>>(Buffer<T>(input.size())),
+                                                     Layout::contiguous(input.shape()));
+        if (record)
+        {
+            last_normalized = NovaML::Core::TensorModule::Tensor<T>(std::make_shared<Storage<T>>(Buffer<T>(input.size())),
+                                                                    Layout::contiguous(input.shape()));
+            last_invstd = invstd;
+            last_mean.assign(batch_mean.begin(), batch_mean.end());
+            last_var.assign(batch_var.begin(), batch_var.end());
+            last_count = count;
+        }
+        T *xhat = record ? last_normalized.data_ptr() : nullptr;
+        T *y = output.data_ptr();
+        const T *gm = gamma(), *bt = beta();
+        NovaML::Parallel::parallel_for(0, outer, detail::row_grain(C * inner), [&](size_t o0, size_t o1)
+                                       {
+            for (size_t o = o0; o < o1; o++)
+                for (size_t c = 0; c < C; c++)
+                {
+                    const T mu = m[c], is = invstd[c], s = gm[c], b = bt[c];
+                    const size_t base = (o * C + c) * inner;
+                    if (xhat)
+                        for (size_t i = 0; i < inner; i++)
+                        {
+                            const T h = (x[base + i] - mu) * is;
+                            xhat[base + i] = h;
+                            y[base + i] = s * h + b;
+                        }
+                    else
+                        for (size_t i = 0; i < inner; i++)
+                            y[base + i] = s * ((x[base + i] - mu) * is) + b;
+                } });
+        return output;
+    }
+
+    template <typename T>
+    NovaML::Core::TensorModule::Tensor<T> BatchNorm<T>::backward(const NovaML::Core::TensorModule::Tensor<T> &grad_output)
+    {
+        if (last_invstd.empty())
+            throw std::logic_error("BatchNorm: backward without a training forward");
+        if (grad_output.size() != last_normalized.size())
+            throw std::invalid_argument("BatchNorm: grad_output does not match the last forward batch");
+        size_t outer, inner;
+        groups(last_normalized.shape(), outer, inner);
+        const size_t C = channels, count = outer * inner;
+
+        NovaML::Core::TensorModule::Tensor<T> grad(grad_output.is_contiguous() ? grad_output : NovaML::Core::TensorModule::Tensor<T>(grad_output.get_data()));
+        NovaML::Core::TensorModule::Tensor<T> grad_input(std::make_shared<Storage<T>>(Buffer<T>(grad.size())),
+                                                         Layout::contiguous(last_normalized.shape()));
+        const T *g = grad.data_ptr();
+        const T *xhat = last_normalized.data_ptr();
+        T *dx = grad_input.data_ptr();
+
+        // dbeta = sum g, dgamma = sum g * xhat, per channel
+        using Acc = accumulate_t<T>;
+        std::vector<Acc> sum_g(C, 0), sum_gx(C, 0);
+        detail::for_channel_blocks(outer, C, inner, [&](size_t c0, size_t c1)
+                                   {
+            for (size_t o = 0; o < outer; o++)
+                for (size_t c = c0; c < c1; c++)
+                {
+                    const size_t base = (o * C + c) * inner;
+                    Acc s = 0, sx = 0;
+                    for (size_t i = 0; i < inner; i++)
+                    {
+                        s += Acc(g[base + i]);
+                        sx += Acc(g[base + i]) * Acc(xhat[base + i]);
+                    }
+                    sum_g[c] += s;
+                    sum_gx[c] += sx;
+                } });
+
+        T *gg = parameters->grad.data() + offset;
+        T *gb = gg + beta_offset;
+        std::vector<T> k(C), mg(C), mgx(C);
+        for (size_t c = 0; c < C; c++)
+        {
+            gg[c] = T(sum_gx[c]);
+            gb[c] = T(sum_g[c]);
+            k[c] = gamma()[c] * last_invstd[c];
+            mg[c] = T(sum_g[c] / Acc(count));
+            mgx[c] = T(sum_gx[c] / Acc(count));
+        }
+
+        // dx = gamma * invstd * (g - mean(g) - xhat * mean(g * xhat))
+        NovaML::Parallel::parallel_for(0, outer, detail::row_grain(C * inner), [&](size_t o0, size_t o1)
+                                       {
+            for (size_t o = o0; o < o1; o++)
+                for (size_t c = 0; c < C; c++)
+                {
+                    const T kc = k[c], a = mg[c], b = mgx[c];
+                    const size_t base = (o * C + c) * inner;
+                    for (size_t i = 0; i < inner; i++)
+                        dx[base + i] = kc * (g[base + i] - a - xhat[base + i] * b);
+                } });
+        return grad_input;
+    }
+
+    template <typename T>
+    void BatchNorm<T>::update(T lr)
+    {
+        T *p = gamma();
+        const T *g = grad_gamma();
+        NovaML::Parallel::parallel_for(0, beta_offset + channels, NovaML::Parallel::elementwise_grain, [=](size_t b, size_t e)
+                                       {
+                                           for (size_t i = b; i < e; ++i)
+                                               p[i] -= lr * g[i]; });
+    }
+
+    template <typename T>
+    void BatchNorm<T>::merge_shard_statistics(const std::vector<const BatchNorm<T> *> &shards,
+                                              const std::vector<T> &mean0, const std::vector<T> &var0)
+    {
+        using Acc = accumulate_t<T>;
+        size_t total = 0;
+        for (const BatchNorm<T> *shard : shards)
+        {
+            if (shard->channels != channels || shard->last_count == 0)
+                throw std::invalid_argument("BatchNorm: shard without batch statistics for " + std::to_string(channels) + " channels");
+            total += shard->last_count;
+        }
+        if (total < 2 || mean0.size() != channels || var0.size() != channels)
+            throw std::invalid_argument("BatchNorm: nothing to merge");
+
+        for (size_t c = 0; c < channels; c++)
+        {
+            Acc m = 0;
+            for (const BatchNorm<T> *shard : shards)
+                m += Acc(shard->last_count) * Acc(shard->last_mean[c]);
+            m /= Acc(total);
+            // Sum of squared deviations: within each shard plus each shard's offset from the pooled mean
+            Acc ss = 0;
+            for (const BatchNorm<T> *shard : shards)
+            {
+                const Acc d = Acc(shard->last_mean[c]) - m;
+                ss += Acc(shard->last_count) * (Acc(shard->last_var[c]) + d * d);
+            }
+            const Acc unbiased = ss / Acc(total - 1);
+            mean[c] = T((Acc(1) - Acc(momentum)) * Acc(mean0[c]) + Acc(momentum) * m);
+            var[c] = T((Acc(1) - Acc(momentum)) * Acc(var0[c]) + Acc(momentum) * unbiased);
+        }
+    }
+
+    template <typename T>
+    void BatchNorm<T>::release_activations()
+    {
+        last_normalized = NovaML::Core::TensorModule::Tensor<T>(0);
+        last_invstd.clear();
+    }
+
+    template <typename T>
+    size_t BatchNorm<T>::parameter_size() const
+    {
+        return NovaML::Core::Module::aligned_elements<T>(beta_offset + channels);
+    }
+
+    template <typename T>
+    void BatchNorm<T>::bind_parameters(const std::shared_ptr<NovaML::Core::Module::ParameterBuffer<T>> &buffer, size_t at)
+    {
+        if (at + parameter_size() > buffer->size())
+            throw std::invalid_argument("BatchNorm: parameter block does not fit the buffer");
+        const size_t n = beta_offset + channels;
+        std::copy(gamma(), gamma() + n, buffer->data.data() + at);
+        std::copy(grad_gamma(), grad_gamma() + n, buffer->grad.data() + at);
+        parameters = buffer;
+        offset = at;
+    }
+
+    template <typename T>
+    std::string BatchNorm<T>::info(std::ostream &) const
+    {
+        return "BatchNorm(" + std::to_string(channels) + ", " + data_format_name(fmt) + ")";
+    }
+
+    // -------------------------
+    // LayerNorm
+    // -------------------------
+    template <typename T>
+    LayerNorm<T>::LayerNorm(size_t features, T eps)
+        : features(features),
+          eps(eps),
+          beta_offset(NovaML::Core::Module::aligned_elements<T>(features)),
+          last_normalized(0)
+    {
+        if (features == 0)
+            throw std::invalid_argument("LayerNorm: feature count must be positive");
+        parameters = std::make_shared<NovaML::Core::Module::ParameterBuffer<T>>(parameter_size());
+        std::fill(gamma(), gamma() + features, T(1));
+    }
+
+    template <typename T>
+    LayerNorm<T>::LayerNorm(size_t features, T eps, std::shared_ptr<NovaML::Core::Module::ParameterBuffer<T>> buffer, size_t offset)
+        : features(features),
+          eps(eps),
+          beta_offset(NovaML::Core::Module::aligned_elements<T>(features)),
+          parameters(std::move(buffer)),
+          offset(offset),
+          last_normalized(0)
+    {
+        if (features == 0)
+            throw std::invalid_argument("LayerNorm: feature count must be positive");
+        if (!parameters || offset > parameters->size() || parameter_size() > parameters->size() - offset)
+            throw std::invalid_argument("LayerNorm: parameter block does not fit the buffer");
+    }
+
+    template <typename T>
+    NovaML::Core::TensorModule::Tensor<T> LayerNorm<T>::normalize(const NovaML::Core::TensorModule::Tensor<T> &input,
+                                                                  NovaML::Core::TensorModule::Tensor<T> *normalized,
+                                                                  std::vector<T> *invstd) const
+    {
+        if (input.ndim() == 0 || input.shape().back() != features)
+            throw std::invalid_argument("LayerNorm: expected input whose last dimension is " + std::to_string(features) +
+                                        ", got " + shape_to_string(input.shape()));
+        NovaML::Core::TensorModule::Tensor<T> xc = input.is_contiguous() ? input : NovaML::Core::TensorModule::Tensor<T>(input.get_data(), input.shape());
+        NovaML::Core::TensorModule::Tensor<T> output(std::make_shared<Storage<T>>(Buffer<T>(input.size())),
+                                                     Layout::contiguous(input.shape()));
+        const size_t rows = input.size() / features, F = features;
+        if (normalized)
+        {
+            *normalized = NovaML::Core::TensorModule::Tensor<T>(std::make_shared<Storage<T>>(Buffer<T>(input.size())),
+                                                                Layout::contiguous(input.shape()));
+            invstd->resize(rows);
+        }
+        const T *x = xc.data_ptr();
+        T *y = output.data_ptr();
+        T *xhat = normalized ? normalized->data_ptr() : nullptr;
+        const T *gm = gamma(), *bt = beta();
+
+        using Acc = accumulate_t<T>;
+        NovaML::Parallel::parallel_for(0, rows, detail::row_grain(F), [&](size_t r0, size_t r1)
+                                       {
+            for (size_t r = r0; r < r1; r++)
+            {
+                const T *xr = x + r * F;
+                Acc s = 0;
+                for (size_t f = 0; f < F; f++)
+                    s += Acc(xr[f]);
+                const Acc mu = s / Acc(F);
+                Acc v = 0;
+                for (size_t f = 0; f < F; f++)
+                    v += (Acc(xr[f]) - mu) * (Acc(xr[f]) - mu);
+                const T is = T(Acc(1) / std::sqrt(v / Acc(F) + Acc(eps))), m = T(mu);
+                T *yr = y + r * F;
+                if (xhat)
+                {
+                    (*invstd)[r] = is;
+                    T *hr = xhat + r * F;
+                    for (size_t f = 0; f < F; f++)
+                    {
+                        hr[f] = (xr[f] - m) * is;
+                        yr[f] = gm[f] * hr[f] + bt[f];
+                    }
+                }
+                else
+                    for (size_t f = 0; f < F; f++)
+                        yr[f] = gm[f] * ((xr[f] - m) * is) + bt[f];
+            } });
+        return output;
+    }
+
+    template <typename T>
+    NovaML::Core::TensorModule::Tensor<T> LayerNorm<T>::infer(const NovaML::Core::TensorModule::Tensor<T> &input) const
+    {
+        return normalize(input, nullptr, nullptr);
+    }
+
+    template <typename T>
+    NovaML::Core::TensorModule::Tensor<T> LayerNorm<T>::forward(const NovaML::Core::TensorModule::Tensor<T> &input)
+    {
+        if (!GradMode::is_enabled())
+            return infer(input);
+        return normalize(input, &last_normalized, &last_invstd);
+    }
+
+    template <typename T>
+    NovaML::Core::TensorModule::Tensor<T> LayerNorm<T>::backward(const NovaML::Core::TensorModule::Tensor<T> &grad_output)
+    {
+        if (last_invstd.empty())
+            throw std::logic_error("LayerNorm: backward without a training forward");
+        if (grad_output.size() != last_normalized.size())
+            throw std::invalid_argument("LayerNorm: grad_output does not match the last forward batch");
+        const size_t rows = last_invstd.size(), F = features;
+
+        NovaML::Core::TensorModule::Tensor<T> grad(grad_output.is_contiguous() ? grad_output : NovaML::Core::TensorModule::Tensor<T>(grad_output.get_data()));
+        NovaML::Core::TensorModule::Tensor<T> grad_input(std::make_shared<Storage<T>>(Buffer<T>(grad.size())),
+                                                         Layout::contiguous(last_normalized.shape()));
+        const T *g = grad.data_ptr();
+        const T *xhat = last_normalized.data_ptr();
+        T *dx = grad_input.data_ptr();
+        const T *gm = gamma();
+
+        // dx = invstd * (dxhat - mean(dxhat) - xhat * mean(dxhat * xhat)), dxhat = g * gamma, per row
+        using Acc = accumulate_t<T>;
+        NovaML::Parallel::parallel_for(0, rows, detail::row_grain(F), [&](size_t r0, size_t r1)
+                                       {
+            for (size_t r = r0; r < r1; r++)
+            {
+                const T *gr = g + r * F, *hr = xhat + r * F;
+                Acc s = 0, sx = 0;
+                for (size_t f = 0; f < F; f++)
+                {
+                    const Acc d = Acc(gr[f]) * Acc(gm[f]);
+                    s += d;
+                    sx += d * Acc(hr[f]);
+                }
+                const T a = T(s / Acc(F)), b = T(sx / Acc(F)), is = last_invstd[r];
+                T *dr = dx + r * F;
+                for (size_t f = 0; f < F; f++)
+                    dr[f] = is * (gr[f] * gm[f] - a - hr[f] * b);
+            } });
+
+        // Parameter gradients are summed over the rows, each task owning a block of features
+        T *gg = parameters->grad.data() + offset;
+        T *gb = gg + beta_offset;
+        detail::for_channel_blocks(rows, F, 1, [&](size_t f0, size_t f1)
+                                   {
+            std::vector<Acc> sum_g(f1 - f0, 0), sum_gx(f1 - f0, 0);
+            for (size_t r = 0; r < rows; r++)
+                for (size_t f = f0; f < f1; f++)
+                {
+                    sum_g[f - f0] += Acc(g[r * F + f]);
+                    sum_gx[f - f0] += Acc(g[r * F + f]) * Acc(xhat[r * F + f]);
+                }
+            for (size_t f = f0; f < f1; f++)
+            {
+                gg[f] = T(sum_gx[f - f0]);
+                gb[f] = T(sum_g[f - f0]);
+            } });
+        return grad_input;
+    }
+
+    template <typename T>
+    void LayerNorm<T>::update(T lr)
+    {
+        T *p = gamma();
+        const T *g = grad_gamma();
+        NovaML::Parallel::parallel_for(0, beta_offset + features, NovaML::Parallel::elementwise_grain, [=](size_t b, size_t e)
+                                       {
+                                           for (size_t i = b; i < e; ++i)
+                                               p[i] -= lr * g[i]; });
+    }
+
+    template <typename T>
+    void LayerNorm<T>::release_activations()
+    {
+        last_normalized = NovaML::Core::TensorModule::Tensor<T>(0);
+        last_invstd.clear();
+    }
+
+    template <typename T>
+    size_t LayerNorm<T>::parameter_size() const
+    {
+        return NovaML::Core::Module::aligned_elements<T>(beta_offset + features);
+    }
+
+    template <typename T>
+    void LayerNorm<T>::bind_parameters(const std::shared_ptr<NovaML::Core::Module::ParameterBuffer<T>> &buffer, size_t at)
+    {
+        if (at + parameter_size() > buffer->size())
+            throw std::invalid_argument("LayerNorm: parameter block does not fit the buffer");
+        const size_t n = beta_offset + features;
+        std::copy(gamma(), gamma() + n, buffer->data.data() + at);
+        std::copy(grad_gamma(), grad_gamma() + n, buffer->grad.data() + at);
+        parameters = buffer;
+        offset = at;
+    }
+}
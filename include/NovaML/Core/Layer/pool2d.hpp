@@ -0,0 +1,88 @@
+#pragma once
+#include "../Module/module.hpp"
+#include "../Tensor/tensor.hpp"
+#include "image.hpp"
+#include <string>
+#include <vector>
+
+namespace NovaML::Core::LayerModule
+{
+    struct Pool2DOptions
+    {
+        size_t stride = 0;  ///< 0: the kernel size (non-overlapping windows)
+        size_t padding = 0; ///< at most half the kernel; padded positions never win a max or count in an average
+        DataFormat format = DataFormat::NCHW;
+    };
+
+    /// Shared window geometry and validation of the pooling layers.
+    template <typename T>
+    class Pool2D : public NovaML::Core::Module::BaseModule<T>
+    {
+    public:
+        size_t kernel_size() const { return kernel; }
+        const Pool2DOptions &options() const { return opts; }
+
+        /// Output shape for an input shape, in the layer's format.
+        Shape output_shape(const Shape &input_shape) const;
+
+        void release_activations() override { last_shape.clear(); }
+
+    protected:
+        Pool2D(size_t kernel_size, Pool2DOptions options, const char *name);
+
+        /// Input rows [ih0, ih1) and columns [iw0, iw1) of the window of output (oh, ow), clipped to the image.
+        void window(const ImageShape &in, size_t oh, size_t ow, size_t &ih0, size_t &ih1, size_t &iw0, size_t &iw1) const;
+        ImageShape output_image(const ImageShape &in) const;
+        std::string describe() const;
+
+        size_t kernel;
+        Pool2DOptions opts;
+        const char *name;
+        Shape last_shape; ///< input shape of the last training forward
+    };
+
+    /**
+     * @brief Maximum over each kernel x kernel window, per channel.
+     *
+     * Output rows (NCHW planes or NHWC pixel rows) are spread over the
+     * thread pool; channels-last windows compare whole channel vectors.
+     * A training forward keeps the position of every maximum for backward.
+     * The first NaN of a window wins, as in Tensor max(), so it propagates
+     * and receives the gradient.
+     */
+    template <typename T = float>
+    class MaxPool2D : public Pool2D<T>
+    {
+    public:
+        explicit MaxPool2D(size_t kernel_size, Pool2DOptions options = {}) : Pool2D<T>(kernel_size, options, "MaxPool2D") {}
+
+        NovaML::Core::TensorModule::Tensor<T> forward(const NovaML::Core::TensorModule::Tensor<T> &input) override;
+        NovaML::Core::TensorModule::Tensor<T> infer(const NovaML::Core::TensorModule::Tensor<T> &input) const override;
+        NovaML::Core::TensorModule::Tensor<T> backward(const NovaML::Core::TensorModule::Tensor<T> &grad_output) override;
+        std::string info(std::ostream &) const override { return "MaxPool2D(" + this->describe() + ")"; }
+        void release_activations() override;
+
+    private:
+        /// argmax, when given, receives the input index of every output's maximum.
+        NovaML::Core::TensorModule::Tensor<T> pool(const NovaML::Core::TensorModule::Tensor<T> &input, std::vector<size_t> *argmax) const;
+        /// `v` replaces the window's current maximum `best`.
+        static bool wins(T v, T best) { return v > best || (v != v && best == best); }
+
+        std::vector<size_t> argmax;
+    };
+
+    /// Mean over each kernel x kernel window, per channel (padding is not counted).
+    template <typename T = float>
+    class AvgPool2D : public Pool2D<T>
+    {
+    public:
+        explicit AvgPool2D(size_t kernel_size, Pool2DOptions options = {}) : Pool2D<T>(kernel_size, options, "AvgPool2D") {}
+
+        NovaML::Core::TensorModule::Tensor<T> forward(const NovaML::Core::TensorModule::Tensor<T> &input) override;
+        NovaML::Core::TensorModule::Tensor<T> infer(const NovaML::Core::TensorModule::Tensor<T> &input) const override;
+        NovaML::Core::TensorModule::Tensor<T> backward(const NovaML::Core::TensorModule::Tensor<T> &grad_output) override;
+        std::string info(std::ostream &) const override { return "AvgPool2D(" + this->describe() + ")"; }
+    };
+}
+
+#include "pool2d.tpp"
@@ -0,0 +1,298 @@
+#pragma once
+#include "pool2d.hpp"
+#include "../../Parallel/thread_pool.hpp"
+
+namespace NovaML::Core::LayerModule
+{
+    template <typename T>
+    Pool2D<T>::Pool2D(size_t kernel_size, Pool2DOptions options, const char *name)
+        : kernel(kernel_size), opts(options), name(name)
+    {
+        if (opts.stride == 0)
+            opts.stride = kernel;
+        if (kernel == 0 || 2 * opts.padding > kernel)
+            throw std::invalid_argument(std::string(name) + ": kernel size must be positive and padding at most half of it");
+    }
+
+    template <typename T>
+    ImageShape Pool2D<T>::output_image(const ImageShape &in) const
+    {
+        const size_t oh = window_output_size(in.h, kernel, opts.stride, opts.padding);
+        const size_t ow = window_output_size(in.w, kernel, opts.stride, opts.padding);
+        if (oh == 0 || ow == 0)
+            throw std::invalid_argument(std::string(name) + ": " + std::to_string(kernel) + "x" + std::to_string(kernel) +
+                                        " window does not fit a " + std::to_string(in.h) + "x" + std::to_string(in.w) + " image");
+        return {in.n, in.c, oh, ow};
+    }
+
+    template <typename T>
+    Shape Pool2D<T>::output_shape(const Shape &input_shape) const
+    {
+        return output_image(image_shape(input_shape, opts.format, 0, name)).to_shape(opts.format);
+    }
+
+    template <typename T>
+    void Pool2D<T>::window(const ImageShape &in, size_t oh, size_t ow, size_t &ih0, size_t &ih1, size_t &iw0, size_t &iw1) const
+    {
+        const size_t h = oh * opts.stride, w = ow * opts.stride; // window start, padded coordinates
+        ih0 = h > opts.padding ? h - opts.padding : 0;
+        iw0 = w > opts.padding ? w - opts.padding : 0;
+        ih1 = std::min(in.h, h + kernel - opts.padding);
+        iw1 = std::min(in.w, w + kernel - opts.padding);
+    }
+
+    template <typename T>
+    std::string Pool2D<T>::describe() const
+    {
+        std::string text = std::to_string(kernel) + "x" + std::to_string(kernel);
+        if (opts.stride != kernel)
+            text += ", stride " + std::to_string(opts.stride);
+        if (opts.padding != 0)
+            text += ", pad " + std::to_string(opts.padding);
+        return text + ", " + data_format_name(opts.format);
+    }
+
+    // -------------------------
+    // MaxPool2D
+    // -------------------------
+    template <typename T>
+    NovaML::Core::TensorModule::Tensor<T> MaxPool2D<T>::pool(const NovaML::Core::TensorModule::Tensor<T> &input,
+                                                             std::vector<size_t> *positions) const
+    {
+        const ImageShape in = image_shape(input.shape(), this->opts.format, 0, this->name);
+        const ImageShape out = this->output_image(in);
+        NovaML::Core::TensorModule::Tensor<T> xc = input.is_contiguous() ? input : NovaML::Core::TensorModule::Tensor<T>(input.get_data(), input.shape());
+        const Shape out_shape = out.to_shape(this->opts.format);
+        NovaML::Core::TensorModule::Tensor<T> output(std::make_shared<Storage<T>>(Buffer<T>(numel(out_shape))),
+                                                     Layout::contiguous(out_shape));
+        if (positions)
+            positions->assign(out.size(), 0);
+        const T *x = xc.data_ptr();
+        T *y = output.data_ptr();
+        size_t *arg = positions ? positions->data() : nullptr;
+        const size_t C = in.c;
+
+        if (this->opts.format == DataFormat::NCHW)
+        {
+            // One (image, channel) plane per task
+            NovaML::Parallel::parallel_for(0, in.n * C, 1, [&](size_t q0, size_t q1)
+                                           {
+                for (size_t q = q0; q < q1; q++)
+                    for (size_t oh = 0; oh < out.h; oh++)
+                        for (size_t ow = 0; ow < out.w; ow++)
+                        {
+                            size_t ih0, ih1, iw0, iw1;
+                            this->window(in, oh, ow, ih0, ih1, iw0, iw1);
+                            size_t best = (q * in.h + ih0) * in.w + iw0;
+                            for (size_t ih = ih0; ih < ih1; ih++)
+                                for (size_t iw = iw0; iw < iw1; iw++)
+                                {
+                                    const size_t i = (q * in.h + ih) * in.w + iw;
+                                    best = wins(x[i], x[best]) ? i : best;
+                                }
+                            const size_t o = (q * out.h + oh) * out.w + ow;
+                            y[o] = x[best];
+                            if (arg)
+                                arg[o] = best;
+                        } });
+        }
+        else
+        {
+            // One output row per task; every window position compares a whole channel vector
+            NovaML::Parallel::parallel_for(0, in.n * out.h, 1, [&](size_t r0, size_t r1)
+                                           {
+                for (size_t r = r0; r < r1; r++)
+                {
+                    const size_t n = r / out.h, oh = r % out.h;
+                    for (size_t ow = 0; ow < out.w; ow++)
+                    {
+                        size_t ih0, ih1, iw0, iw1;
+                        this->window(in, oh, ow, ih0, ih1, iw0, iw1);
+                        const size_t o = (r * out.w + ow) * C;
+                        const size_t first = ((n * in.h + ih0) * in.w + iw0) * C;
+                        std::copy(x + first, x + first + C, y + o);
+                        if (arg)
+                            for (size_t c = 0; c < C; c++)
+                                arg[o + c] = first + c;
+                        for (size_t ih = ih0; ih < ih1; ih++)
+                            for (size_t iw = iw0; iw < iw1; iw++)
+                            {
+                                const size_t base = ((n * in.h + ih) * in.w + iw) * C;
+                                const T *v = x + base;
+                                T *best = y + o;
+                                if (arg)
+                                    for (size_t c = 0; c < C; c++)
+                                    {
+                                        const bool larger = wins(v[c], best[c]);
+                                        best[c] = larger ? v[c] : best[c];
+                                        arg[o + c] = larger ? base + c : arg[o + c];
+                                    }
+                                else
+                                    for (size_t c = 0; c < C; c++)
+                                        best[c] = wins(v[c], best[c]) ? v[c] : best[c];
+                            }
+                    }
+                } });
+        }
+        return output;
+    }
+
+    template <typename T>
+    NovaML::Core::TensorModule::Tensor<T> MaxPool2D<T>::infer(const NovaML::Core::TensorModule::Tensor<T> &input) const
+    {
+        return pool(input, nullptr);
+    }
+
+    template <typename T>
+    NovaML::Core::TensorModule::Tensor<T> MaxPool2D<T>::forward(const NovaML::Core::TensorModule::Tensor<T> &input)
+    {
+        if (!GradMode::is_enabled())
+            return infer(input);
+        auto output = pool(input, &argmax);
+        this->last_shape = input.shape();
+        return output;
+    }
+
+    template <typename T>
+    NovaML::Core::TensorModule::Tensor<T> MaxPool2D<T>::backward(const NovaML::Core::TensorModule::Tensor<T> &grad_output)
+    {
+        if (this->last_shape.empty())
+            throw std::logic_error("MaxPool2D: backward without a training forward");
+        if (grad_output.size() != argmax.size())
+            throw std::invalid_argument("MaxPool2D: grad_output does not match the last forward batch");
+        NovaML::Core::TensorModule::Tensor<T> grad(grad_output.is_contiguous() ? grad_output : NovaML::Core::TensorModule::Tensor<T>(grad_output.get_data()));
+        auto grad_input = NovaML::Core::TensorModule::Tensor<T>::zeros(this->last_shape);
+        const T *g = grad.data_ptr();
+        T *dx = grad_input.data_ptr();
+
+        // Overlapping windows can share a maximum, so images (which never do) are the unit of work.
+        const size_t images = this->last_shape[0], per_image = argmax.size() / images;
+        NovaML::Parallel::parallel_for(0, images, 1, [&](size_t n0, size_t n1)
+                                       {
+            for (size_t i = n0 * per_image; i < n1 * per_image; i++)
+                dx[argmax[i]] += g[i]; });
+        return grad_input;
+    }
+
+    template <typename T>
+    void MaxPool2D<T>::release_activations()
+    {
+        Pool2D<T>::release_activations();
+        argmax = std::vector<size_t>();
+    }
+
+    // -------------------------
+    // AvgPool2D
+    // -------------------------
+    template <typename T>
+    NovaML::Core::TensorModule::Tensor<T> AvgPool2D<T>::infer(const NovaML::Core::TensorModule::Tensor<T> &input) const
+    {
+        const ImageShape in = image_shape(input.shape(), this->opts.format, 0, this->name);
+        const ImageShape out = this->output_image(in);
+        NovaML::Core::TensorModule::Tensor<T> xc = input.is_contiguous() ? input : NovaML::Core::TensorModule::Tensor<T>(input.get_data(), input.shape());
+        const Shape out_shape = out.to_shape(this->opts.format);
+        NovaML::Core::TensorModule::Tensor<T> output(std::make_shared<Storage<T>>(Buffer<T>(numel(out_shape))),
+                                                     Layout::contiguous(out_shape));
+        const T *x = xc.data_ptr();
+        T *y = output.data_ptr();
+        const size_t C = in.c;
+        using Acc = accumulate_t<T>;
+
+        if (this->opts.format == DataFormat::NCHW)
+        {
+            NovaML::Parallel::parallel_for(0, in.n * C, 1, [&](size_t q0, size_t q1)
+                                           {
+                for (size_t q = q0; q < q1; q++)
+                    for (size_t oh = 0; oh < out.h; oh++)
+                        for (size_t ow = 0; ow < out.w; ow++)
+                        {
+                            size_t ih0, ih1, iw0, iw1;
+                            this->window(in, oh, ow, ih0, ih1, iw0, iw1);
+                            Acc sum = 0;
+                            for (size_t ih = ih0; ih < ih1; ih++)
+                                for (size_t iw = iw0; iw < iw1; iw++)
+                                    sum += Acc(x[(q * in.h + ih) * in.w + iw]);
+                            y[(q * out.h + oh) * out.w + ow] = T(sum / Acc((ih1 - ih0) * (iw1 - iw0)));
+                        } });
+        }
+        else
+        {
+            NovaML::Parallel::parallel_for(0, in.n * out.h, 1, [&](size_t r0, size_t r1)
+                                           {
+                std::vector<Acc> sum(C);
+                for (size_t r = r0; r < r1; r++)
+                {
+                    const size_t n = r / out.h, oh = r % out.h;
+                    for (size_t ow = 0; ow < out.w; ow++)
+                    {
+                        size_t ih0, ih1, iw0, iw1;
+                        this->window(in, oh, ow, ih0, ih1, iw0, iw1);
+                        std::fill(sum.begin(), sum.end(), Acc(0));
+                        for (size_t ih = ih0; ih < ih1; ih++)
+                            for (size_t iw = iw0; iw < iw1; iw++)
+                            {
+                                const T *v = x + ((n * in.h + ih) * in.w + iw) * C;
+                                for (size_t c = 0; c < C; c++)
+                                    sum[c] += Acc(v[c]);
+                            }
+                        const Acc inv = Acc(1) / Acc((ih1 - ih0) * (iw1 - iw0));
+                        T *dst = y + (r * out.w + ow) * C;
+                        for (size_t c = 0; c < C; c++)
+                            dst[c] = T(sum[c] * inv);
+                    }
+                } });
+        }
+        return output;
+    }
+
+    template <typename T>
+    NovaML::Core::TensorModule::Tensor<T> AvgPool2D<T>::forward(const NovaML::Core::TensorModule::Tensor<T> &input)
+    {
+        auto output = infer(input);
+        if (GradMode::is_enabled())
+            this->last_shape = input.shape();
+        return output;
+    }
+
+    template <typename T>
+    NovaML::Core::TensorModule::Tensor<T> AvgPool2D<T>::backward(const NovaML::Core::TensorModule::Tensor<T> &grad_output)
+    {
+        if (this->last_shape.empty())
+            throw std::logic_error("AvgPool2D: backward without a training forward");
+        const ImageShape in = image_shape(this->last_shape, this->opts.format, 0, this->name);
+        const ImageShape out = this->output_image(in);
+        if (grad_output.size() != out.size())
+            throw std::invalid_argument("AvgPool2D: grad_output does not match the last forward batch");
+        NovaML::Core::TensorModule::Tensor<T> grad(grad_output.is_contiguous() ? grad_output : NovaML::Core::TensorModule::Tensor<T>(grad_output.get_data()));
+        auto grad_input = NovaML::Core::TensorModule::Tensor<T>::zeros(this->last_shape);
+        const T *g = grad.data_ptr();
+        T *dx = grad_input.data_ptr();
+        const bool nchw = this->opts.format == DataFormat::NCHW;
+        const size_t C = in.c;
+
+        // Every output spreads its gradient evenly over its window; images are independent.
+        NovaML::Parallel::parallel_for(0, in.n, 1, [&](size_t n0, size_t n1)
+                                       {
+            for (size_t n = n0; n < n1; n++)
+                for (size_t oh = 0; oh < out.h; oh++)
+                    for (size_t ow = 0; ow < out.w; ow++)
+                    {
+                        size_t ih0, ih1, iw0, iw1;
+                        this->window(in, oh, ow, ih0, ih1, iw0, iw1);
+                        const T inv = T(1) / T((ih1 - ih0) * (iw1 - iw0));
+                        for (size_t ih = ih0; ih < ih1; ih++)
+                            for (size_t iw = iw0; iw < iw1; iw++)
+                                if (nchw)
+                                    for (size_t c = 0; c < C; c++)
+                                        dx[((n * C + c) * in.h + ih) * in.w + iw] += g[((n * C + c) * out.h + oh) * out.w + ow] * inv;
+                                else
+                                {
+                                    const T *src = g + ((n * out.h + oh) * out.w + ow) * C;
+                                    T *dst = dx + ((n * in.h + ih) * in.w + iw) * C;
+                                    for (size_t c = 0; c < C; c++)
+                                        dst[c] += src[c] * inv;
+                                }
+                    } });
+        return grad_input;
+    }
+}
@@ -6,25 +6,32 @@
 namespace NovaML::Core::LossModule
 {
 
+    enum class Reduction
+    {
+        Mean, // average over every element of the batch
+        Sum   // sum over every element of the batch
+    };
+
     template <typename T = float>
     class MSELoss
     {
     public:
-        MSELoss();
+        explicit MSELoss(Reduction reduction = Reduction::Mean);
 
-        // Forward: compute scalar loss
+        // Forward: compute scalar loss over a sample [features] or a batch [batch, features]
         T forward(
             const NovaML::Core::TensorModule::Tensor<T> &pred,
             const NovaML::Core::TensorModule::Tensor<T> &target);
 
-        // Backward: compute gradient w.r.t. prediction
+        // Backward: compute gradient w.r.t. prediction (same shape as pred)
         NovaML::Core::TensorModule::Tensor<T> backward();
 
     private:
+        Reduction reduction;
         NovaML::Core::TensorModule::Tensor<T> last_pred;
         NovaML::Core::TensorModule::Tensor<T> last_target;
     };
 
 } // namespace NovaML::Core::LossModule
 
-#include "mse.tpp"
\ No newline at end of file
+#include "mse.tpp"
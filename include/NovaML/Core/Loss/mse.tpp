@@ -4,8 +4,8 @@
 namespace NovaML::Core::LossModule
 {
     template <typename T>
-    MSELoss<T>::MSELoss()
-        : last_pred(0), last_target(0)
+    MSELoss<T>::MSELoss(Reduction reduction)
+        : reduction(reduction), last_pred(0), last_target(0)
     {}
 
     template <typename T>
@@ -13,25 +13,34 @@ namespace NovaML::Core::LossModule
         const NovaML::Core::TensorModule::Tensor<T> &pred,
         const NovaML::Core::TensorModule::Tensor<T> &target)
     {
+        if (pred.size() != target.size())
+            throw std::invalid_argument("MSELoss: prediction " + shape_to_string(pred.shape()) +
+                                        " and target " + shape_to_string(target.shape()) + " differ in size");
         last_pred = pred;
         last_target = target;
 
-        T loss = 0;
+        // 16-bit types accumulate in fp32
+        using Acc = accumulate_t<T>;
+        Acc loss = 0;
         for (size_t i = 0; i < pred.size(); ++i)
-            loss += (pred[i] - target[i]) * (pred[i] - target[i]);
-        return loss / static_cast<T>(pred.size());
+        {
+            Acc d = Acc(pred[i]) - Acc(target[i]);
+            loss += d * d;
+        }
+        return T(reduction == Reduction::Mean ? loss / static_cast<Acc>(pred.size()) : loss);
     }
 
     template <typename T>
     NovaML::Core::TensorModule::Tensor<T> MSELoss<T>::backward()
     {
-        NovaML::Core::TensorModule::Tensor<T> grad(last_pred.size());
-        T inv_size = T(1) / static_cast<T>(last_pred.size());
+        auto grad = NovaML::Core::TensorModule::Tensor<T>::zeros(last_pred.shape());
+        using Acc = accumulate_t<T>;
+        Acc scale = reduction == Reduction::Mean ? Acc(2) / static_cast<Acc>(last_pred.size()) : Acc(2);
 
         for (size_t i = 0; i < last_pred.size(); ++i)
-            grad[i] = 2 * (last_pred[i] - last_target[i]) * inv_size;
+            grad[i] = T(scale * (Acc(last_pred[i]) - Acc(last_target[i])));
 
         return grad;
     }
 
-}
\ No newline at end of file
+}
@@ -1,9 +1,13 @@
 #pragma once
 #include "../Tensor/tensor.hpp"
+#include "../../Profiler/profiler.hpp"
+#include "../Kernel/activation.hpp"
+#include "parameters.hpp"
 #include <vector>
 #include <memory>
 #include <string>
 #include <sstream>
+#include <stdexcept>
 #include <iostream>
 
 namespace TensorNS = NovaML::Core::TensorModule;
@@ -18,17 +22,70 @@ namespace NovaML::Core::Module
         // Pure virtual for module description
         virtual std::string info(std::ostream &os) const = 0;
 
+        // Forward / backward process a whole mini-batch per call: inputs are
+        // [batch, features] (a plain [features] sample is a batch of one) and
+        // parameter gradients are summed over the batch.
         virtual TensorNS::Tensor<T> forward(const TensorNS::Tensor<T> &input) = 0;
         virtual TensorNS::Tensor<T> backward(const TensorNS::Tensor<T> &grad_output);
         virtual void update(T lr);
         virtual size_t num_params() const;
 
+        // Inference only: what forward() computes with gradients off, but
+        // the module is only read, so one instance can serve concurrent
+        // callers (see Serving::InferenceServer). Containers run their
+        // submodules in order; a leaf module without it throws
+        // std::logic_error.
+        virtual TensorNS::Tensor<T> infer(const TensorNS::Tensor<T> &input) const;
+
+        // Training / eval mode, on by default. Only modules that compute
+        // differently in training (BatchNorm's batch statistics) read it;
+        // containers forward it to their submodules. It is separate from
+        // GradMode, which only decides whether forward keeps what backward needs.
+        virtual void set_training(bool training);
+
+        // Drop the tensors kept from the last training forward for backward
+        // (gradient checkpointing frees them segment by segment).
+        virtual void release_activations();
+
+        // Epilogue fusion (see Sequential): a point-wise activation module
+        // reports what it computes, a layer ending in a GEMM may absorb it.
+        virtual Kernel::Activation fusable_activation() const { return Kernel::Activation::None; }
+        virtual bool fuse_activation(Kernel::Activation) { return false; }
+
+        // Inference folding (see Sequential::fold_batch_norm): a normalization
+        // module with fixed statistics reports the per-channel map
+        // y = scale * x + shift it applies; a layer producing those channels,
+        // with no activation of its own, may absorb it into its weights and bias.
+        virtual bool channel_affine(std::vector<T> &, std::vector<T> &) const { return false; }
+        virtual bool fold_channel_affine(const std::vector<T> &, const std::vector<T> &) { return false; }
+
+        // Flat parameters (see flatten_parameters): the number of elements
+        // this module occupies in a ParameterBuffer, padding included, and
+        // moving its parameters (values and gradients kept) into `buffer`
+        // at `offset`. Containers forward both to their submodules.
+        virtual size_t parameter_size() const;
+        virtual void bind_parameters(const std::shared_ptr<ParameterBuffer<T>> &buffer, size_t offset);
+
     protected:
         std::vector<std::shared_ptr<BaseModule<T>>> submodules;
 
         template <typename U>
         friend std::ostream &operator<<(std::ostream &os, const BaseModule<U> &module);
     };
+
+    /// Short display name of a module (its info() line), e.g. for profiler events.
+    template <typename T>
+    std::string module_name(const BaseModule<T> &module);
+
+    /**
+     * @brief Move every parameter of `module` into one new ParameterBuffer.
+     *
+     * Values and gradients are preserved; afterwards the module's layers
+     * read and write their parameters inside the returned buffer, so an
+     * optimizer can update the whole model in one pass over it.
+     */
+    template <typename T>
+    std::shared_ptr<ParameterBuffer<T>> flatten_parameters(BaseModule<T> &module);
 }
 
 #include "module.tpp"
@@ -11,6 +11,17 @@ namespace NovaML::Core::Module
         return grad;
     }
 
+    template <typename T>
+    TensorModule::Tensor<T> BaseModule<T>::infer(const TensorModule::Tensor<T> &input) const
+    {
+        if (this->submodules.empty())
+            throw std::logic_error(module_name(*this) + ": no stateless inference path");
+        auto x = input;
+        for (const auto &m : this->submodules)
+            x = m->infer(x);
+        return x;
+    }
+
     template <typename T>
     void BaseModule<T>::update(T lr)
     {
@@ -27,6 +38,55 @@ namespace NovaML::Core::Module
         return total;
     }
 
+    template <typename T>
+    void BaseModule<T>::set_training(bool training)
+    {
+        for (auto &m : this->submodules)
+            m->set_training(training);
+    }
+
+    template <typename T>
+    void BaseModule<T>::release_activations()
+    {
+        for (auto &m : this->submodules)
+            m->release_activations();
+    }
+
+    template <typename T>
+    size_t BaseModule<T>::parameter_size() const
+    {
+        size_t total = 0;
+        for (auto &m : this->submodules)
+            total += m->parameter_size();
+        return total;
+    }
+
+    template <typename T>
+    void BaseModule<T>::bind_parameters(const std::shared_ptr<ParameterBuffer<T>> &buffer, size_t offset)
+    {
+        for (auto &m : this->submodules)
+        {
+            m->bind_parameters(buffer, offset);
+            offset += m->parameter_size();
+        }
+    }
+
+    template <typename T>
+    std::shared_ptr<ParameterBuffer<T>> flatten_parameters(BaseModule<T> &module)
+    {
+        auto buffer = std::make_shared<ParameterBuffer<T>>(module.parameter_size());
+        module.bind_parameters(buffer, 0);
+        return buffer;
+    }
+
+    template <typename T>
+    std::string module_name(const BaseModule<T> &module)
+    {
+        std::ostringstream scratch; // containers describe their children here
+        std::string name = module.info(scratch);
+        return name.empty() ? "Sequential" : name;
+    }
+
     template <typename T>
     std::ostream &operator<<(std::ostream &os, const BaseModule<T> &module)
     {
@@ -0,0 +1,75 @@
+#pragma once
+#include "../Tensor/storage.hpp"
+#include "../../Memory/allocator.hpp"
+#include <memory>
+
+namespace NovaML::Core::Module
+{
+    /**
+     * @brief Fixed-size parameter array: an owned zeroed buffer, or a view
+     * of memory that `owner` keeps alive (e.g. a mapped checkpoint).
+     */
+    template <typename T>
+    class ParameterArray
+    {
+    public:
+        explicit ParameterArray(size_t size) : owned(size, T(0)), ptr(owned.data()), count(size) {}
+        ParameterArray(T *memory, size_t size, std::shared_ptr<void> owner)
+            : ptr(memory), count(size), owner(std::move(owner)) {}
+
+        ParameterArray(const ParameterArray &) = delete;
+        ParameterArray &operator=(const ParameterArray &) = delete;
+
+        T *data() { return ptr; }
+        const T *data() const { return ptr; }
+        size_t size() const { return count; }
+
+        T *begin() { return ptr; }
+        T *end() { return ptr + count; }
+        const T *begin() const { return ptr; }
+        const T *end() const { return ptr + count; }
+
+        T &operator[](size_t i) { return ptr[i]; }
+        const T &operator[](size_t i) const { return ptr[i]; }
+
+        /// Whether the elements live in memory this array does not own.
+        bool is_view() const { return owner != nullptr; }
+
+    private:
+        Buffer<T> owned;
+        T *ptr;
+        size_t count;
+        std::shared_ptr<void> owner;
+    };
+
+    /**
+     * @brief Parameters and their gradients for any number of modules, as two flat buffers.
+     *
+     * Both buffers have the same layout: module k owns
+     * [offset_k, offset_k + parameter_size_k) in each. Blocks start on a
+     * cache line and padding is zero in both, so optimizers can treat the
+     * whole buffer as one vector. Modules bound to a buffer keep it alive.
+     */
+    template <typename T>
+    struct ParameterBuffer
+    {
+        explicit ParameterBuffer(size_t size) : data(size), grad(size) {}
+
+        /// Adopt existing memory (see SerializationModule::load); both arrays must have the same size.
+        ParameterBuffer(T *values, T *gradients, size_t size, std::shared_ptr<void> owner)
+            : data(values, size, owner), grad(gradients, size, owner) {}
+
+        size_t size() const { return data.size(); }
+
+        ParameterArray<T> data;
+        ParameterArray<T> grad;
+    };
+
+    /// Round an element count up to a whole number of cache lines.
+    template <typename T>
+    constexpr size_t aligned_elements(size_t n)
+    {
+        constexpr size_t line = Memory::buffer_alignment / sizeof(T);
+        return (n + line - 1) / line * line;
+    }
+}
@@ -6,18 +6,95 @@
 
 namespace NovaML::Core::Module {
 
+/**
+ * @brief Where a checkpointed Sequential keeps activations (see Sequential::set_checkpointing).
+ *
+ * The modules are split into segments; a training forward keeps only each
+ * segment's input and backward recomputes the segment from it. Segments
+ * either span a fixed number of modules, or grow until the activations
+ * their modules produce exceed a byte budget (measured as the forward
+ * runs, so it adapts to the batch size).
+ */
+struct CheckpointPolicy {
+    size_t every = 0;        ///< modules per segment (0: not used)
+    size_t budget_bytes = 0; ///< activation bytes per segment (0: not used)
+
+    static CheckpointPolicy none() { return {}; }
+    static CheckpointPolicy every_k(size_t k) { return {k, 0}; }
+    static CheckpointPolicy memory_budget(size_t bytes) { return {0, bytes}; }
+
+    bool enabled() const { return every != 0 || budget_bytes != 0; }
+};
+
+/**
+ * @brief Runs modules in order.
+ *
+ * With fusion on (the default), an activation module added right after a
+ * layer that can absorb it (Dense, Conv2D) becomes that layer's GEMM epilogue: the
+ * layer computes act(x W^T + b) in one pass and the activation module is
+ * skipped. The layer object itself is changed, so share it with other
+ * containers only when that is intended.
+ *
+ * With checkpointing on, a training forward runs the modules without
+ * keeping their activations and backward recomputes them one segment at
+ * a time, trading about one extra forward pass for peak memory.
+ */
 template <typename T = float>
 class Sequential : public BaseModule<T> {
 public:
-    Sequential() = default;
+    explicit Sequential(bool fuse_activations = true) : fuse_activations(fuse_activations) {}
 
     void add(std::shared_ptr<BaseModule<T>> module);
 
+    size_t size() const { return this->submodules.size(); }
+    const std::shared_ptr<BaseModule<T>> &at(size_t i) const { return this->submodules.at(i); }
+
+    bool fuses_activations() const { return fuse_activations; }
+
+    /// Whether module i was fused into the module before it (and is skipped).
+    bool is_fused(size_t i) const { return fused.at(i); }
+
+    /**
+     * @brief Fold normalization modules with fixed statistics (BatchNorm)
+     * into the Conv2D / Dense right before them, for inference.
+     *
+     * The layer's weights and bias absorb the per-channel scale and shift
+     * and the normalization module is skipped from then on; with fusion on,
+     * an activation module that now directly follows the layer becomes its
+     * epilogue too. Folding changes what training would compute, so call it
+     * on a trained model only. Returns the number of modules folded.
+     */
+    size_t fold_batch_norm();
+
+    void set_checkpointing(const CheckpointPolicy &policy);
+    const CheckpointPolicy &get_checkpointing() const { return checkpointing; }
+
+    /// Segments kept by the last checkpointed training forward (0 when not checkpointing).
+    size_t num_segments() const { return segments.size(); }
+
     NovaML::Core::TensorModule::Tensor<T> forward(const NovaML::Core::TensorModule::Tensor<T> &input) override;
+    /// Runs the unfused submodules' infer(): no segments, no saved activations.
+    NovaML::Core::TensorModule::Tensor<T> infer(const NovaML::Core::TensorModule::Tensor<T> &input) const override;
     NovaML::Core::TensorModule::Tensor<T> backward(const NovaML::Core::TensorModule::Tensor<T> &grad_output) override;
     void update(T lr) override;
     std::string info(std::ostream &os) const override;
     size_t num_params() const override;
+    void release_activations() override;
+
+private:
+    struct Segment {
+        size_t begin; ///< first submodule
+        size_t end;   ///< one past the last submodule
+        NovaML::Core::TensorModule::Tensor<T> input;
+    };
+
+    NovaML::Core::TensorModule::Tensor<T> checkpointed_forward(const NovaML::Core::TensorModule::Tensor<T> &input);
+    NovaML::Core::TensorModule::Tensor<T> checkpointed_backward(const NovaML::Core::TensorModule::Tensor<T> &grad_output);
+
+    bool fuse_activations;
+    std::vector<bool> fused; ///< per submodule: absorbed by its predecessor
+    CheckpointPolicy checkpointing;
+    std::vector<Segment> segments; ///< from the last checkpointed training forward
 };
 
 template <typename T>
@@ -6,32 +6,192 @@ namespace NovaML::Core::Module
     template <typename T>
     void Sequential<T>::add(std::shared_ptr<BaseModule<T>> module)
     {
+        bool absorbed = false;
+        if (fuse_activations && !this->submodules.empty() && !fused.back())
+        {
+            Kernel::Activation act = module->fusable_activation();
+            absorbed = act != Kernel::Activation::None && this->submodules.back()->fuse_activation(act);
+        }
         this->submodules.push_back(module);
+        fused.push_back(absorbed);
+    }
+
+    template <typename T>
+    size_t Sequential<T>::fold_batch_norm()
+    {
+        size_t folded = 0;
+        std::vector<T> scale, shift;
+        for (size_t i = 1; i < this->submodules.size(); ++i)
+        {
+            if (fused[i] || !this->submodules[i]->channel_affine(scale, shift))
+                continue;
+            size_t layer = i; // nearest module still running before i
+            while (layer-- > 0 && fused[layer])
+                ;
+            if (!this->submodules[layer]->fold_channel_affine(scale, shift))
+                continue;
+            fused[i] = true;
+            folded++;
+
+            size_t next = i + 1;
+            if (fuse_activations && next < this->submodules.size() && !fused[next])
+            {
+                Kernel::Activation act = this->submodules[next]->fusable_activation();
+                if (act != Kernel::Activation::None && this->submodules[layer]->fuse_activation(act))
+                    fused[next] = true;
+            }
+        }
+        segments.clear();
+        return folded;
+    }
+
+    template <typename T>
+    void Sequential<T>::set_checkpointing(const CheckpointPolicy &policy)
+    {
+        checkpointing = policy;
+        segments.clear();
     }
 
     template <typename T>
     TensorModule::Tensor<T> Sequential<T>::forward(const TensorModule::Tensor<T> &input)
     {
+        segments.clear();
+        if (checkpointing.enabled() && GradMode::is_enabled())
+            return checkpointed_forward(input);
+
         TensorModule::Tensor<T> x = input;
-        for (auto &m : this->submodules)
+        for (size_t i = 0; i < this->submodules.size(); ++i)
+        {
+            if (fused[i])
+                continue;
+            auto &m = this->submodules[i];
+            Profiler::RecordScope scope([&m]
+                                        { return module_name(*m) + ".forward"; }, Profiler::Category::Module);
             x = m->forward(x);
+        }
+        return x;
+    }
+
+    template <typename T>
+    TensorModule::Tensor<T> Sequential<T>::infer(const TensorModule::Tensor<T> &input) const
+    {
+        TensorModule::Tensor<T> x = input;
+        for (size_t i = 0; i < this->submodules.size(); ++i)
+        {
+            if (fused[i])
+                continue;
+            const auto &m = this->submodules[i];
+            Profiler::RecordScope scope([&m]
+                                        { return module_name(*m) + ".infer"; }, Profiler::Category::Module);
+            x = m->infer(x);
+        }
         return x;
     }
 
     template <typename T>
     TensorModule::Tensor<T> Sequential<T>::backward(const TensorModule::Tensor<T> &grad_output)
     {
+        if (!segments.empty())
+            return checkpointed_backward(grad_output);
+
         TensorModule::Tensor<T> grad = grad_output;
-        for (auto it = this->submodules.rbegin(); it != this->submodules.rend(); ++it)
-            grad = (*it)->backward(grad);
+        for (size_t i = this->submodules.size(); i-- > 0;)
+        {
+            if (fused[i])
+                continue;
+            auto &m = this->submodules[i];
+            Profiler::RecordScope scope([&m]
+                                        { return module_name(*m) + ".backward"; }, Profiler::Category::Module);
+            grad = m->backward(grad);
+        }
         return grad;
     }
 
+    // -------------------------
+    // Checkpointing: forward keeps segment inputs only, backward recomputes
+    // -------------------------
+    template <typename T>
+    TensorModule::Tensor<T> Sequential<T>::checkpointed_forward(const TensorModule::Tensor<T> &input)
+    {
+        TensorModule::Tensor<T> x = input;
+        size_t modules = 0, bytes = 0;
+        for (size_t i = 0; i < this->submodules.size(); ++i)
+        {
+            if (fused[i])
+                continue;
+            const bool full = segments.empty() ||
+                              (checkpointing.every && modules == checkpointing.every) ||
+                              (checkpointing.budget_bytes && bytes >= checkpointing.budget_bytes);
+            if (full)
+            {
+                if (!segments.empty())
+                    segments.back().end = i;
+                segments.push_back({i, this->submodules.size(), x});
+                modules = bytes = 0;
+            }
+
+            auto &m = this->submodules[i];
+            Profiler::RecordScope scope([&m]
+                                        { return module_name(*m) + ".forward"; }, Profiler::Category::Module);
+            NoGradGuard no_grad; // nothing is kept for backward
+            x = m->forward(x);
+            modules++;
+            bytes += x.size() * sizeof(T);
+        }
+        return x;
+    }
+
+    template <typename T>
+    TensorModule::Tensor<T> Sequential<T>::checkpointed_backward(const TensorModule::Tensor<T> &grad_output)
+    {
+        TensorModule::Tensor<T> grad = grad_output;
+        for (size_t s = segments.size(); s-- > 0;)
+        {
+            Segment &segment = segments[s];
+            TensorModule::Tensor<T> x = segment.input;
+            for (size_t i = segment.begin; i < segment.end; ++i)
+            {
+                if (fused[i])
+                    continue;
+                auto &m = this->submodules[i];
+                Profiler::RecordScope scope([&m]
+                                            { return module_name(*m) + ".recompute"; }, Profiler::Category::Module);
+                x = m->forward(x);
+            }
+            for (size_t i = segment.end; i-- > segment.begin;)
+            {
+                if (fused[i])
+                    continue;
+                auto &m = this->submodules[i];
+                Profiler::RecordScope scope([&m]
+                                            { return module_name(*m) + ".backward"; }, Profiler::Category::Module);
+                grad = m->backward(grad);
+                m->release_activations();
+            }
+            segments.pop_back(); // frees the boundary activation
+        }
+        return grad;
+    }
+
+    template <typename T>
+    void Sequential<T>::release_activations()
+    {
+        segments.clear();
+        BaseModule<T>::release_activations();
+    }
+
     template <typename T>
     void Sequential<T>::update(T lr)
     {
-        for (auto &m : this->submodules)
+        for (size_t i = 0; i < this->submodules.size(); ++i)
+        {
+            if (fused[i])
+                continue;
+            auto &m = this->submodules[i];
+            Profiler::RecordScope scope([&m]
+                                        { return module_name(*m) + ".update"; }, Profiler::Category::Module);
             m->update(lr);
+        }
     }
 
     template <typename T>
@@ -39,7 +199,7 @@ namespace NovaML::Core::Module
     {
         os << "Sequential with " << this->submodules.size() << " modules\n";
         for (size_t i = 0; i < this->submodules.size(); ++i)
-            os << " [" << i << "] " << this->submodules[i]->info(os) << "\n";
+            os << " [" << i << "] " << this->submodules[i]->info(os) << (fused[i] ? " (fused into previous)" : "") << "\n";
         return ""; // or some string summary if you want
     }
 
@@ -0,0 +1,61 @@
+#pragma once
+#include "optimizer.hpp"
+#include "../Kernel/optimizer.hpp"
+
+namespace NovaML::Core::OptimizerModule
+{
+    /**
+     * @brief Adam with bias-corrected moment estimates.
+     *
+     * weight_decay is an L2 penalty added to the gradient; use AdamW for
+     * decoupled decay. Both moment buffers start at zero and share the
+     * parameter buffer's layout.
+     */
+    template <typename T = float>
+    class Adam : public Optimizer<T>
+    {
+    public:
+        Adam(NovaML::Core::Module::BaseModule<T> &module, T lr = T(1e-3), T beta1 = T(0.9), T beta2 = T(0.999),
+             T eps = T(1e-8), T weight_decay = T(0));
+        Adam(std::shared_ptr<NovaML::Core::Module::ParameterBuffer<T>> parameters, T lr = T(1e-3), T beta1 = T(0.9),
+             T beta2 = T(0.999), T eps = T(1e-8), T weight_decay = T(0));
+
+        void step() override;
+
+        const T *first_moment() const { return m.data(); }
+        const T *second_moment() const { return v.data(); }
+
+    protected:
+        Adam(std::shared_ptr<NovaML::Core::Module::ParameterBuffer<T>> parameters, T lr, T beta1, T beta2,
+             T eps, T weight_decay, bool decoupled);
+
+    private:
+        T beta1;
+        T beta2;
+        T eps;
+        T weight_decay;
+        bool decoupled;
+        Buffer<T> m;
+        Buffer<T> v;
+    };
+
+    /**
+     * @brief Adam with decoupled weight decay (Loshchilov & Hutter):
+     * parameters shrink by lr * weight_decay each step, independently of
+     * the adaptive gradient scaling.
+     */
+    template <typename T = float>
+    class AdamW : public Adam<T>
+    {
+    public:
+        AdamW(NovaML::Core::Module::BaseModule<T> &module, T lr = T(1e-3), T beta1 = T(0.9), T beta2 = T(0.999),
+              T eps = T(1e-8), T weight_decay = T(1e-2))
+            : AdamW(NovaML::Core::Module::flatten_parameters(module), lr, beta1, beta2, eps, weight_decay) {}
+
+        AdamW(std::shared_ptr<NovaML::Core::Module::ParameterBuffer<T>> parameters, T lr = T(1e-3), T beta1 = T(0.9),
+              T beta2 = T(0.999), T eps = T(1e-8), T weight_decay = T(1e-2))
+            : Adam<T>(std::move(parameters), lr, beta1, beta2, eps, weight_decay, true) {}
+    };
+}
+
+#include "adam.tpp"
@@ -0,0 +1,42 @@
+#pragma once
+#include "adam.hpp"
+
+namespace NovaML::Core::OptimizerModule
+{
+    template <typename T>
+    Adam<T>::Adam(NovaML::Core::Module::BaseModule<T> &module, T lr, T beta1, T beta2, T eps, T weight_decay)
+        : Adam(NovaML::Core::Module::flatten_parameters(module), lr, beta1, beta2, eps, weight_decay, false)
+    {}
+
+    template <typename T>
+    Adam<T>::Adam(std::shared_ptr<NovaML::Core::Module::ParameterBuffer<T>> parameters, T lr, T beta1, T beta2,
+                  T eps, T weight_decay)
+        : Adam(std::move(parameters), lr, beta1, beta2, eps, weight_decay, false)
+    {}
+
+    template <typename T>
+    Adam<T>::Adam(std::shared_ptr<NovaML::Core::Module::ParameterBuffer<T>> parameters, T lr, T beta1, T beta2,
+                  T eps, T weight_decay, bool decoupled)
+        : Optimizer<T>(std::move(parameters), lr),
+          beta1(beta1),
+          beta2(beta2),
+          eps(eps),
+          weight_decay(weight_decay),
+          decoupled(decoupled),
+          m(this->params->size(), T(0)),
+          v(this->params->size(), T(0))
+    {
+        if (!(beta1 >= T(0) && beta1 < T(1) && beta2 >= T(0) && beta2 < T(1)))
+            throw std::invalid_argument("Adam: betas must be in [0, 1)");
+        if (!(eps > T(0)) || weight_decay < T(0))
+            throw std::invalid_argument("Adam: eps must be positive and weight decay non-negative");
+    }
+
+    template <typename T>
+    void Adam<T>::step()
+    {
+        ++this->step_count;
+        Kernel::adam_step(this->params->size(), this->params->data.data(), this->params->grad.data(), m.data(), v.data(),
+                          Kernel::AdamStep<T>{this->lr, beta1, beta2, eps, weight_decay, decoupled, this->step_count});
+    }
+}
@@ -0,0 +1,76 @@
+#pragma once
+#include "optimizer.hpp"
+#include "../Kernel/convert.hpp"
+#include "../Tensor/half.hpp"
+#include <functional>
+#include <memory>
+
+namespace NovaML::Core::OptimizerModule
+{
+    /**
+     * @brief Loss scaling for 16-bit gradients.
+     *
+     * The gradient entering backward is multiplied by the scale so small
+     * gradients do not flush to zero in 16 bits. With `dynamic`, a step
+     * whose gradients overflow is skipped and the scale shrinks by
+     * `backoff`; after `growth_interval` clean steps it grows by `growth`.
+     */
+    struct LossScaling
+    {
+        float scale = 65536.0f;
+        bool dynamic = true;
+        float growth = 2.0f;
+        float backoff = 0.5f;
+        size_t growth_interval = 2000;
+    };
+
+    /**
+     * @brief Mixed-precision training: 16-bit model, fp32 master weights.
+     *
+     * The model's parameters are flattened into a 16-bit ParameterBuffer for
+     * forward / backward; an fp32 copy of that buffer is what the wrapped
+     * fp32 optimizer (created by `make_optimizer` over the master buffer)
+     * actually updates. step() widens and unscales the 16-bit gradients into
+     * the master buffer, checks them for Inf / NaN, runs the optimizer and
+     * rounds the master weights back into the model:
+     *
+     *     MixedPrecision<bfloat16> amp(model, [](auto master)
+     *                                  { return std::make_unique<AdamW<float>>(master, 1e-3f); });
+     *     model.backward(amp.scale_grad(criterion.backward()));
+     *     amp.step();
+     */
+    template <typename T>
+    class MixedPrecision
+    {
+        static_assert(is_reduced_precision_v<T>, "MixedPrecision: the model must use a 16-bit element type");
+
+    public:
+        using MasterBuffer = NovaML::Core::Module::ParameterBuffer<float>;
+        using OptimizerFactory = std::function<std::unique_ptr<Optimizer<float>>(std::shared_ptr<MasterBuffer>)>;
+
+        MixedPrecision(NovaML::Core::Module::BaseModule<T> &module, const OptimizerFactory &make_optimizer,
+                       const LossScaling &scaling = {});
+
+        /// grad_output * scale, to pass to the model's backward.
+        NovaML::Core::TensorModule::Tensor<T> scale_grad(const NovaML::Core::TensorModule::Tensor<T> &grad_output) const;
+
+        /// Update from the current (scaled) gradients; false when the step was skipped on overflow.
+        bool step();
+
+        float get_scale() const { return scaling.scale; }
+        size_t skipped_steps() const { return skipped; }
+
+        Optimizer<float> &optimizer() { return *inner; }
+        const MasterBuffer &master() const { return *master_params; }
+
+    private:
+        std::shared_ptr<NovaML::Core::Module::ParameterBuffer<T>> params;
+        std::shared_ptr<MasterBuffer> master_params;
+        std::unique_ptr<Optimizer<float>> inner;
+        LossScaling scaling;
+        size_t clean_steps = 0;
+        size_t skipped = 0;
+    };
+}
+
+#include "mixed_precision.tpp"
@@ -0,0 +1,75 @@
+#pragma once
+#include "mixed_precision.hpp"
+#include "../../Parallel/thread_pool.hpp"
+
+namespace NovaML::Core::OptimizerModule
+{
+    template <typename T>
+    MixedPrecision<T>::MixedPrecision(NovaML::Core::Module::BaseModule<T> &module, const OptimizerFactory &make_optimizer,
+                                      const LossScaling &scaling)
+        : params(NovaML::Core::Module::flatten_parameters(module)),
+          master_params(std::make_shared<MasterBuffer>(params->size())),
+          scaling(scaling)
+    {
+        if (!(scaling.scale > 0.0f) || !(scaling.growth >= 1.0f) || !(scaling.backoff > 0.0f && scaling.backoff <= 1.0f))
+            throw std::invalid_argument("MixedPrecision: invalid loss scaling");
+        Kernel::widen(params->size(), params->data.data(), master_params->data.data());
+        inner = make_optimizer(master_params);
+        if (!inner)
+            throw std::invalid_argument("MixedPrecision: the optimizer factory returned nothing");
+    }
+
+    template <typename T>
+    NovaML::Core::TensorModule::Tensor<T> MixedPrecision<T>::scale_grad(const NovaML::Core::TensorModule::Tensor<T> &grad_output) const
+    {
+        const float s = scaling.scale;
+        Buffer<T> scaled(grad_output.size());
+        visit_elements(grad_output, [&](size_t i, T g)
+                       { scaled[i] = T(float(g) * s); });
+        return NovaML::Core::TensorModule::Tensor<T>(std::make_shared<Storage<T>>(std::move(scaled)),
+                                                     Layout::contiguous(grad_output.shape()));
+    }
+
+    template <typename T>
+    bool MixedPrecision<T>::step()
+    {
+        const size_t n = params->size();
+        float *g = master_params->grad.data();
+        Kernel::widen(n, params->grad.data(), g);
+
+        // Unscale in place; g * 0 is NaN exactly for Inf / NaN, so the sum flags any overflow.
+        const float inv_scale = 1.0f / scaling.scale;
+        float poison = Parallel::parallel_reduce(
+            0, n, Parallel::elementwise_grain, 0.0f,
+            [&](size_t begin, size_t end)
+            {
+                float acc = 0.0f;
+                for (size_t i = begin; i < end; i++)
+                {
+                    g[i] *= inv_scale;
+                    acc += g[i] * 0.0f;
+                }
+                return acc;
+            },
+            [](float a, float b)
+            { return a + b; });
+
+        if (poison != 0.0f)
+        {
+            ++skipped;
+            clean_steps = 0;
+            if (scaling.dynamic)
+                scaling.scale *= scaling.backoff;
+            return false;
+        }
+
+        inner->step();
+        Kernel::narrow(n, master_params->data.data(), params->data.data());
+        if (scaling.dynamic && ++clean_steps == scaling.growth_interval)
+        {
+            scaling.scale *= scaling.growth;
+            clean_steps = 0;
+        }
+        return true;
+    }
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include "../Module/module.hpp"
+#include "../Module/parameters.hpp"
+#include <memory>
+#include <stdexcept>
+
+namespace NovaML::Core::OptimizerModule
+{
+    /**
+     * @brief Base class of the optimizers: owns a model's flat parameter buffer.
+     *
+     * Constructing from a module moves all of its parameters into one
+     * ParameterBuffer (see Module::flatten_parameters), so step() is a
+     * single fused pass over that buffer and its gradients, with any
+     * optimizer state kept in buffers of the same layout. Typical loop:
+     *
+     *     model.backward(criterion.backward());
+     *     optimizer.step();
+     *
+     * Layers overwrite their gradients in every backward, so zero_grad() is
+     * only needed when gradients are accumulated by hand.
+     */
+    template <typename T = float>
+    class Optimizer
+    {
+    public:
+        Optimizer(NovaML::Core::Module::BaseModule<T> &module, T lr)
+            : Optimizer(NovaML::Core::Module::flatten_parameters(module), lr) {}
+
+        Optimizer(std::shared_ptr<NovaML::Core::Module::ParameterBuffer<T>> parameters, T lr)
+            : params(std::move(parameters)), lr(lr)
+        {
+            if (!params)
+                throw std::invalid_argument("Optimizer: no parameter buffer");
+            if (!(lr >= T(0)))
+                throw std::invalid_argument("Optimizer: learning rate must be non-negative");
+        }
+
+        virtual ~Optimizer() = default;
+
+        /// Apply one update from the current gradients.
+        virtual void step() = 0;
+
+        void zero_grad() { std::fill(params->grad.begin(), params->grad.end(), T(0)); }
+
+        T get_lr() const { return lr; }
+        void set_lr(T value) { lr = value; }
+
+        /// Number of step() calls so far.
+        size_t steps() const { return step_count; }
+
+        const NovaML::Core::Module::ParameterBuffer<T> &parameters() const { return *params; }
+
+    protected:
+        std::shared_ptr<NovaML::Core::Module::ParameterBuffer<T>> params;
+        T lr;
+        size_t step_count = 0;
+    };
+}
@@ -0,0 +1,36 @@
+#pragma once
+#include "optimizer.hpp"
+#include "../Kernel/optimizer.hpp"
+
+namespace NovaML::Core::OptimizerModule
+{
+    /**
+     * @brief Stochastic gradient descent with optional momentum, dampening,
+     * Nesterov momentum and L2 weight decay (see Kernel::SgdStep).
+     *
+     * The velocity buffer starts at zero and is only allocated when
+     * momentum is used.
+     */
+    template <typename T = float>
+    class SGD : public Optimizer<T>
+    {
+    public:
+        SGD(NovaML::Core::Module::BaseModule<T> &module, T lr, T momentum = T(0), T weight_decay = T(0),
+            T dampening = T(0), bool nesterov = false);
+        SGD(std::shared_ptr<NovaML::Core::Module::ParameterBuffer<T>> parameters, T lr, T momentum = T(0),
+            T weight_decay = T(0), T dampening = T(0), bool nesterov = false);
+
+        void step() override;
+
+        const T *velocity() const { return velocity_buffer.data(); }
+
+    private:
+        T momentum;
+        T weight_decay;
+        T dampening;
+        bool nesterov;
+        Buffer<T> velocity_buffer;
+    };
+}
+
+#include "sgd.tpp"
@@ -0,0 +1,36 @@
+#pragma once
+#include "sgd.hpp"
+
+namespace NovaML::Core::OptimizerModule
+{
+    template <typename T>
+    SGD<T>::SGD(NovaML::Core::Module::BaseModule<T> &module, T lr, T momentum, T weight_decay, T dampening, bool nesterov)
+        : SGD(NovaML::Core::Module::flatten_parameters(module), lr, momentum, weight_decay, dampening, nesterov)
+    {}
+
+    template <typename T>
+    SGD<T>::SGD(std::shared_ptr<NovaML::Core::Module::ParameterBuffer<T>> parameters, T lr, T momentum,
+                T weight_decay, T dampening, bool nesterov)
+        : Optimizer<T>(std::move(parameters), lr),
+          momentum(momentum),
+          weight_decay(weight_decay),
+          dampening(dampening),
+          nesterov(nesterov)
+    {
+        if (momentum < T(0) || weight_decay < T(0))
+            throw std::invalid_argument("SGD: momentum and weight decay must be non-negative");
+        if (nesterov && (momentum == T(0) || dampening != T(0)))
+            throw std::invalid_argument("SGD: Nesterov momentum needs momentum > 0 and no dampening");
+        if (momentum != T(0))
+            velocity_buffer = Buffer<T>(this->params->size(), T(0));
+    }
+
+    template <typename T>
+    void SGD<T>::step()
+    {
+        ++this->step_count;
+        Kernel::sgd_step(this->params->size(), this->params->data.data(), this->params->grad.data(),
+                         velocity_buffer.data(),
+                         Kernel::SgdStep<T>{this->lr, momentum, dampening, weight_decay, nesterov, this->step_count == 1});
+    }
+}
@@ -0,0 +1,138 @@
+#pragma once
+#include "../Module/sequential.hpp"
+#include "../Layer/dense.hpp"
+#include "../Kernel/qgemm.hpp"
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace NovaML::Core::QuantizationModule
+{
+    /**
+     * @brief Affine uint8 encoding of a real range: real = scale * (q - zero_point).
+     */
+    struct QuantParams
+    {
+        float scale = 1.0f;
+        int32_t zero_point = 0;
+
+        /// Encoding of [lo, hi] widened to contain 0, so that zero (ReLU's floor) is exact.
+        static QuantParams from_range(float lo, float hi);
+
+        float dequantize(uint8_t q) const { return scale * float(int32_t(q) - zero_point); }
+    };
+
+    /// Running min / max of every value observed during calibration.
+    struct RangeObserver
+    {
+        float lo = std::numeric_limits<float>::infinity();
+        float hi = -std::numeric_limits<float>::infinity();
+
+        template <typename T>
+        void observe(const T *x, size_t n);
+
+        bool empty() const { return lo > hi; }
+    };
+
+    /**
+     * @brief Inference-only int8 version of a Dense + activation Sequential.
+     *
+     * Each layer keeps int8 weights with one scale per output channel
+     * (symmetric, [-127, 127]) packed for Kernel::qgemm, and reads uint8
+     * activations with one scale / zero point per tensor. forward()
+     * quantizes its input once; between layers the int32 sums are
+     * requantized straight into the next layer's uint8 input inside the
+     * GEMM epilogue, and only the last layer writes real values. forward()
+     * keeps no state, so one instance can serve concurrent callers.
+     *
+     * Build one with Calibrator (or quantize()) from a trained model.
+     */
+    template <typename T = float>
+    class QuantizedSequential : public NovaML::Core::Module::BaseModule<T>
+    {
+    public:
+        /**
+         * @brief Append a quantized copy of `dense` followed by `activation`.
+         *
+         * `input` encodes the layer's input; it also becomes the output
+         * encoding of the layer before.
+         *
+         * @throws std::invalid_argument if `dense` does not take the previous layer's outputs.
+         */
+        void add(const LayerModule::Dense<T> &dense, Kernel::Activation activation, const QuantParams &input);
+
+        NovaML::Core::TensorModule::Tensor<T> forward(const NovaML::Core::TensorModule::Tensor<T> &input) override;
+        NovaML::Core::TensorModule::Tensor<T> infer(const NovaML::Core::TensorModule::Tensor<T> &input) const override;
+        /// @throws std::logic_error: quantized models are inference-only
+        NovaML::Core::TensorModule::Tensor<T> backward(const NovaML::Core::TensorModule::Tensor<T> &grad_output) override;
+        /// @throws std::logic_error: quantized models are inference-only
+        void update(T lr) override;
+        std::string info(std::ostream &) const override;
+        size_t num_params() const override;
+
+        size_t num_layers() const { return layers.size(); }
+        const QuantParams &input_params(size_t layer) const { return layers.at(layer).input; }
+
+        /// Resident bytes of the packed weights, requantization tables and biases.
+        size_t weight_bytes() const;
+
+    private:
+        struct Layer
+        {
+            size_t in_features;
+            size_t out_features;
+            Kernel::PackedInt8 weights;
+            std::vector<float> scale;    ///< input scale * channel weight scale
+            std::vector<int32_t> offset; ///< -input zero point * channel weight sum
+            std::vector<float> bias;
+            Kernel::Activation activation;
+            QuantParams input;
+        };
+
+        std::vector<Layer> layers;
+    };
+
+    /**
+     * @brief Post-training calibration of a float Sequential for int8 inference.
+     *
+     * The model must be Dense layers, each optionally followed by an
+     * activation (fused into it or as a separate module). observe() runs
+     * sample batches through the float model and records the range of
+     * every layer input; quantize() then builds the QuantizedSequential.
+     * The float model is only read.
+     */
+    template <typename T = float>
+    class Calibrator
+    {
+    public:
+        /// @throws std::invalid_argument if the model holds anything else than Dense layers and activations.
+        explicit Calibrator(NovaML::Core::Module::Sequential<T> &model);
+
+        void observe(const NovaML::Core::TensorModule::Tensor<T> &batch);
+        size_t batches() const { return observed; }
+
+        /// @throws std::invalid_argument if no batch was observed yet.
+        std::shared_ptr<QuantizedSequential<T>> quantize() const;
+
+    private:
+        struct Stage
+        {
+            std::shared_ptr<LayerModule::Dense<T>> dense;
+            std::shared_ptr<NovaML::Core::Module::BaseModule<T>> activation_module; ///< unfused activation, may be null
+            Kernel::Activation activation;                                         ///< of the whole stage
+        };
+
+        std::vector<Stage> stages;
+        std::vector<RangeObserver> ranges; ///< per stage: its input
+        size_t observed = 0;
+    };
+
+    /// Calibrate `model` on `batches` and quantize it.
+    template <typename T>
+    std::shared_ptr<QuantizedSequential<T>> quantize(NovaML::Core::Module::Sequential<T> &model,
+                                                     const std::vector<NovaML::Core::TensorModule::Tensor<T>> &batches);
+}
+
+#include "quantized_sequential.tpp"
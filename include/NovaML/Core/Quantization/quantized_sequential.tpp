@@ -0,0 +1,251 @@
+#pragma once
+#include "quantized_sequential.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <type_traits>
+
+namespace NovaML::Core::QuantizationModule
+{
+    inline QuantParams QuantParams::from_range(float lo, float hi)
+    {
+        lo = std::min(lo, 0.0f);
+        hi = std::max(hi, 0.0f);
+        QuantParams params;
+        if (hi > lo)
+        {
+            params.scale = (hi - lo) / 255.0f;
+            params.zero_point = std::clamp(int32_t(std::lround(-lo / params.scale)), 0, 255);
+        }
+        return params;
+    }
+
+    template <typename T>
+    void RangeObserver::observe(const T *x, size_t n)
+    {
+        for (size_t i = 0; i < n; i++)
+        {
+            const float v = float(x[i]);
+            lo = std::min(lo, v);
+            hi = std::max(hi, v);
+        }
+    }
+
+    // -------------------------
+    // QuantizedSequential
+    // -------------------------
+    template <typename T>
+    void QuantizedSequential<T>::add(const LayerModule::Dense<T> &dense, Kernel::Activation activation, const QuantParams &input)
+    {
+        const size_t in = dense.input_size(), out = dense.output_size();
+        if (!layers.empty() && layers.back().out_features != in)
+            throw std::invalid_argument("QuantizedSequential: " + std::to_string(in) + " inputs after a layer with " +
+                                        std::to_string(layers.back().out_features) + " outputs");
+
+        // Symmetric per output channel: the largest weight maps to 127.
+        std::vector<int8_t> q(out * in);
+        std::vector<float> scale(out), bias(out);
+        const T *w = dense.weights();
+        for (size_t o = 0; o < out; o++)
+        {
+            float max_abs = 0.0f;
+            for (size_t i = 0; i < in; i++)
+                max_abs = std::max(max_abs, std::abs(float(w[o * in + i])));
+            const float w_scale = max_abs > 0.0f ? max_abs / 127.0f : 1.0f;
+            for (size_t i = 0; i < in; i++)
+                q[o * in + i] = static_cast<int8_t>(std::clamp(std::lround(float(w[o * in + i]) / w_scale), -127L, 127L));
+            scale[o] = input.scale * w_scale;
+            bias[o] = float(dense.bias()[o]);
+        }
+        Kernel::PackedInt8 weights = Kernel::pack_int8(out, in, q.data(), in);
+        std::vector<int32_t> offset(out);
+        for (size_t o = 0; o < out; o++)
+            offset[o] = -input.zero_point * weights.row_sums[o];
+
+        layers.push_back(Layer{in, out, std::move(weights), std::move(scale), std::move(offset), std::move(bias), activation, input});
+    }
+
+    template <typename T>
+    TensorModule::Tensor<T> QuantizedSequential<T>::forward(const TensorModule::Tensor<T> &input)
+    {
+        return infer(input);
+    }
+
+    template <typename T>
+    TensorModule::Tensor<T> QuantizedSequential<T>::infer(const TensorModule::Tensor<T> &input) const
+    {
+        if (layers.empty())
+            throw std::invalid_argument("QuantizedSequential: no layers");
+        const size_t features = layers.front().in_features;
+        if (input.ndim() == 0 || input.ndim() > 2 || input.shape().back() != features)
+            throw std::invalid_argument("QuantizedSequential: expected input of shape [batch, " + std::to_string(features) +
+                                        "] or [" + std::to_string(features) + "], got " + shape_to_string(input.shape()));
+
+        TensorModule::Tensor<T> x = input.is_contiguous() ? input : TensorModule::Tensor<T>(input.get_data(), input.shape());
+        const size_t batch = input.ndim() == 2 ? input.dim(0) : 1;
+
+        // Activations travel as uint8 rows padded to whole 4-byte groups (see Kernel::qgemm).
+        auto padded = [](size_t n)
+        { return (n + 3) / 4 * 4; };
+        auto fresh = [&](size_t cols)
+        {
+            Buffer<uint8_t> a(batch * padded(cols));
+            if (padded(cols) != cols)
+                for (size_t b = 0; b < batch; b++)
+                    std::fill(a.data() + b * padded(cols) + cols, a.data() + (b + 1) * padded(cols), uint8_t(0));
+            return a;
+        };
+
+        Buffer<uint8_t> a = fresh(features);
+        const QuantParams &in = layers.front().input;
+        if constexpr (std::is_same_v<T, float>)
+            for (size_t b = 0; b < batch; b++)
+                Kernel::quantize(features, x.data_ptr() + b * features, in.scale, in.zero_point, a.data() + b * padded(features));
+        else
+        {
+            Buffer<float> row(features);
+            for (size_t b = 0; b < batch; b++)
+            {
+                std::copy(x.data_ptr() + b * features, x.data_ptr() + (b + 1) * features, row.begin());
+                Kernel::quantize(features, row.data(), in.scale, in.zero_point, a.data() + b * padded(features));
+            }
+        }
+
+        for (size_t l = 0; l + 1 < layers.size(); l++)
+        {
+            const Layer &layer = layers[l];
+            const QuantParams &out = layers[l + 1].input;
+            Kernel::Requantize rq{layer.scale.data(), layer.offset.data(), layer.bias.data(), layer.activation,
+                                  out.scale, out.zero_point};
+            Buffer<uint8_t> next = fresh(layer.out_features);
+            Kernel::qgemm(batch, a.data(), padded(layer.in_features), layer.weights, rq, next.data(), padded(layer.out_features));
+            a = std::move(next);
+        }
+
+        const Layer &last = layers.back();
+        Kernel::Requantize rq{last.scale.data(), last.offset.data(), last.bias.data(), last.activation};
+        Shape out_shape = input.shape();
+        out_shape.back() = last.out_features;
+        TensorModule::Tensor<T> output(std::make_shared<Storage<T>>(Buffer<T>(numel(out_shape))), Layout::contiguous(out_shape));
+        if constexpr (std::is_same_v<T, float>)
+            Kernel::qgemm(batch, a.data(), padded(last.in_features), last.weights, rq, output.data_ptr(), last.out_features);
+        else
+        {
+            Buffer<float> y(output.size());
+            Kernel::qgemm(batch, a.data(), padded(last.in_features), last.weights, rq, y.data(), last.out_features);
+            std::copy(y.begin(), y.end(), output.data_ptr());
+        }
+        return output;
+    }
+
+    template <typename T>
+    TensorModule::Tensor<T> QuantizedSequential<T>::backward(const TensorModule::Tensor<T> &)
+    {
+        throw std::logic_error("QuantizedSequential: quantized models are inference-only");
+    }
+
+    template <typename T>
+    void QuantizedSequential<T>::update(T)
+    {
+        throw std::logic_error("QuantizedSequential: quantized models are inference-only");
+    }
+
+    template <typename T>
+    std::string QuantizedSequential<T>::info(std::ostream &) const
+    {
+        std::string name = "QuantizedSequential(int8:";
+        for (size_t l = 0; l < layers.size(); l++)
+        {
+            name += (l ? ", Dense(" : " Dense(") + std::to_string(layers[l].in_features) + "->" +
+                    std::to_string(layers[l].out_features) + ")";
+            if (layers[l].activation != Kernel::Activation::None)
+                name += "+" + Kernel::activation_name(layers[l].activation);
+        }
+        return name + ")";
+    }
+
+    template <typename T>
+    size_t QuantizedSequential<T>::num_params() const
+    {
+        size_t total = 0;
+        for (const Layer &layer : layers)
+            total += layer.out_features * layer.in_features + layer.out_features;
+        return total;
+    }
+
+    template <typename T>
+    size_t QuantizedSequential<T>::weight_bytes() const
+    {
+        size_t total = 0;
+        for (const Layer &layer : layers)
+            total += layer.weights.bytes() + (layer.scale.size() + layer.bias.size()) * sizeof(float) +
+                     layer.offset.size() * sizeof(int32_t);
+        return total;
+    }
+
+    // -------------------------
+    // Calibration
+    // -------------------------
+    template <typename T>
+    Calibrator<T>::Calibrator(Module::Sequential<T> &model)
+    {
+        for (size_t i = 0; i < model.size(); i++)
+        {
+            if (model.is_fused(i))
+                continue;
+            const auto &m = model.at(i);
+            if (auto dense = std::dynamic_pointer_cast<LayerModule::Dense<T>>(m))
+            {
+                stages.push_back({dense, nullptr, dense->get_activation()});
+                continue;
+            }
+            const Kernel::Activation act = m->fusable_activation();
+            if (act == Kernel::Activation::None)
+                throw std::invalid_argument("Calibrator: cannot quantize " + Module::module_name(*m) +
+                                            ", only Dense layers and activations");
+            if (stages.empty() || stages.back().activation != Kernel::Activation::None)
+                throw std::invalid_argument("Calibrator: " + Module::module_name(*m) + " must directly follow a Dense layer");
+            stages.back().activation_module = m;
+            stages.back().activation = act;
+        }
+        if (stages.empty())
+            throw std::invalid_argument("Calibrator: the model has no Dense layer");
+        ranges.resize(stages.size());
+    }
+
+    template <typename T>
+    void Calibrator<T>::observe(const TensorModule::Tensor<T> &batch)
+    {
+        NoGradGuard no_grad;
+        TensorModule::Tensor<T> x = batch.is_contiguous() ? batch : TensorModule::Tensor<T>(batch.get_data(), batch.shape());
+        for (size_t s = 0; s < stages.size(); s++)
+        {
+            ranges[s].observe(x.data_ptr(), x.size());
+            x = stages[s].dense->forward(x);
+            if (stages[s].activation_module)
+                x = stages[s].activation_module->forward(x);
+        }
+        observed++;
+    }
+
+    template <typename T>
+    std::shared_ptr<QuantizedSequential<T>> Calibrator<T>::quantize() const
+    {
+        if (observed == 0)
+            throw std::invalid_argument("Calibrator: observe at least one batch before quantizing");
+        auto model = std::make_shared<QuantizedSequential<T>>();
+        for (size_t s = 0; s < stages.size(); s++)
+            model->add(*stages[s].dense, stages[s].activation, QuantParams::from_range(ranges[s].lo, ranges[s].hi));
+        return model;
+    }
+
+    template <typename T>
+    std::shared_ptr<QuantizedSequential<T>> quantize(Module::Sequential<T> &model,
+                                                     const std::vector<TensorModule::Tensor<T>> &batches)
+    {
+        Calibrator<T> calibrator(model);
+        for (const auto &batch : batches)
+            calibrator.observe(batch);
+        return calibrator.quantize();
+    }
+}
@@ -0,0 +1,152 @@
+#pragma once
+#include "../Module/sequential.hpp"
+#include "../Layer/dense.hpp"
+#include "../Layer/conv2d.hpp"
+#include "../Layer/normalization.hpp"
+#include "../Layer/pool2d.hpp"
+#include "../Layer/flatten.hpp"
+#include "../Activation/relu.hpp"
+#include "../Activation/sigmoid.hpp"
+#include "../Activation/gelu.hpp"
+#include "../../Memory/mapped_file.hpp"
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace NovaML::Core::SerializationModule
+{
+    constexpr uint32_t checkpoint_version = 2;
+
+    /// Parameter data starts on a page boundary, so a mapped file hands it out aligned.
+    constexpr size_t checkpoint_data_alignment = 4096;
+
+    /**
+     * @brief Fixed-size header at the start of every checkpoint.
+     *
+     * File layout (version 2, native byte order, checked on load):
+     *
+     *   CheckpointHeader                       64 bytes
+     *   ModuleRecord x record_count            the module tree in pre-order
+     *   zero padding up to data_offset         a multiple of 4096
+     *   parameter data                         data_elements x element_size
+     *   module state                           state_elements x element_size
+     *
+     * The parameter data is the model's flat ParameterBuffer layout (see
+     * Module::flatten_parameters): every layer's block starts on a cache
+     * line, so after mapping the file it is used in place. Module state is
+     * what a layer keeps outside its parameters (BatchNorm's running mean
+     * and variance); it is copied out on load and never trained.
+     *
+     * Version 1 files (Sequential, Dense and activations) still load: their
+     * 32-byte records hold kind, flags, a, b and offset, and state_elements
+     * was a reserved zero.
+     */
+    struct CheckpointHeader
+    {
+        char magic[8];       ///< "NOVAMLCK"
+        uint32_t version;    ///< checkpoint_version
+        uint32_t byte_order; ///< 0x01020304 as stored by the writer
+        uint32_t dtype;      ///< DType<T>::code
+        uint32_t element_size;
+        uint64_t record_count;
+        uint64_t data_offset; ///< bytes from the start of the file
+        uint64_t data_elements;
+        uint64_t state_elements; ///< directly after the parameter data
+        uint64_t reserved;
+    };
+
+    enum class ModuleKind : uint32_t
+    {
+        Sequential = 1,
+        Dense = 2,
+        ReLU = 3,
+        Sigmoid = 4,
+        GELU = 5,
+        Conv2D = 6,
+        BatchNorm = 7,
+        LayerNorm = 8,
+        MaxPool2D = 9,
+        AvgPool2D = 10,
+        Flatten = 11
+    };
+
+    /**
+     * @brief One module of the tree; containers are followed by their children.
+     *
+     * BatchNorm's momentum and LayerNorm's / BatchNorm's eps are stored as
+     * the bits of a double. A BatchNorm folded into the layer before it
+     * (Sequential::fold_batch_norm) is not stored: its map is in that
+     * layer's weights.
+     */
+    struct ModuleRecord
+    {
+        uint32_t kind;   ///< ModuleKind
+        uint32_t flags;  ///< Sequential: fuses activations; Dense: Kernel::Activation;
+                         ///< Conv2D: activation | format << 8 | algorithm << 16; BatchNorm, pools: DataFormat
+        uint64_t a;      ///< Sequential: child count; Dense, Conv2D: inputs; BatchNorm, LayerNorm: channels; pools: kernel
+        uint64_t b;      ///< Dense, Conv2D: outputs; pools: stride
+        uint64_t c;      ///< Conv2D: kernel; BatchNorm: momentum; pools: padding
+        uint64_t d;      ///< Conv2D: stride; BatchNorm, LayerNorm: eps
+        uint64_t e;      ///< Conv2D: padding
+        uint64_t offset; ///< layers with parameters: first element of their block
+        uint64_t state;  ///< BatchNorm: first element of [running mean | padding | running var] in the module state
+    };
+
+    static_assert(sizeof(CheckpointHeader) == 64 && sizeof(ModuleRecord) == 64, "checkpoint records are fixed-size");
+
+    /// Element type tag stored in the header.
+    template <typename T>
+    struct DType;
+    template <>
+    struct DType<float>
+    {
+        static constexpr uint32_t code = 1;
+    };
+    template <>
+    struct DType<double>
+    {
+        static constexpr uint32_t code = 2;
+    };
+    template <>
+    struct DType<bfloat16>
+    {
+        static constexpr uint32_t code = 3;
+    };
+    template <>
+    struct DType<float16>
+    {
+        static constexpr uint32_t code = 4;
+    };
+
+    /**
+     * @brief Write `model` (Sequential, Dense, Conv2D, normalization, pooling, Flatten and activation trees) to `path`.
+     *
+     * The file is written next to `path` and renamed over it, so readers
+     * never see a partial checkpoint and processes that mapped the old file
+     * keep their copy.
+     *
+     * @throws std::invalid_argument for modules the format cannot describe.
+     * @throws std::runtime_error if the file cannot be written.
+     */
+    template <typename T>
+    void save(const NovaML::Core::Module::BaseModule<T> &model, const std::string &path);
+
+    /**
+     * @brief Rebuild the model stored at `path`, mapping its parameters in place.
+     *
+     * Nothing proportional to the parameter count is read, copied or
+     * allocated (BatchNorm's running statistics, one value per channel,
+     * are copied): the layers' weights point into the copy-on-write mapping
+     * and their gradients into lazily zeroed memory, so loading takes about
+     * the same time for any model size and pages are faulted in by the
+     * first forward. Training the loaded model is allowed and never changes
+     * the file.
+     *
+     * @throws std::runtime_error if the file is missing, truncated, of an
+     *         unknown format version or stores another element type.
+     */
+    template <typename T>
+    std::shared_ptr<NovaML::Core::Module::BaseModule<T>> load(const std::string &path);
+}
+
+#include "checkpoint.tpp"
@@ -0,0 +1,402 @@
+#pragma once
+#include "checkpoint.hpp"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace NovaML::Core::SerializationModule
+{
+    namespace detail
+    {
+        constexpr char checkpoint_magic[8] = {'N', 'O', 'V', 'A', 'M', 'L', 'C', 'K'};
+        constexpr uint32_t byte_order_mark = 0x01020304;
+        /// Version-1 record: Sequential, Dense and activations only, no module state.
+        struct ModuleRecordV1
+        {
+            uint32_t kind;
+            uint32_t flags;
+            uint64_t a;
+            uint64_t b;
+            uint64_t offset;
+        };
+
+        static_assert(sizeof(ModuleRecordV1) == 32, "version-1 records are 32 bytes");
+
+        /// Deepest Sequential nesting load() follows; TreeReader recurses once per level.
+        constexpr size_t max_nesting = 256;
+
+        inline uint64_t double_bits(double value)
+        {
+            uint64_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            return bits;
+        }
+
+        inline double from_bits(uint64_t bits)
+        {
+            double value;
+            std::memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+
+        /// Pre-order records plus the parameter blocks and module state to write, in file order.
+        template <typename T>
+        struct TreeWriter
+        {
+            std::vector<ModuleRecord> records;
+            std::vector<std::pair<const T *, size_t>> blocks;
+            size_t elements = 0;
+            std::vector<T> state;
+
+            static ModuleRecord record(ModuleKind kind, uint32_t flags = 0)
+            {
+                ModuleRecord r{};
+                r.kind = uint32_t(kind);
+                r.flags = flags;
+                return r;
+            }
+
+            void add_block(ModuleRecord &r, const T *data, size_t n)
+            {
+                r.offset = elements;
+                blocks.emplace_back(data, n);
+                elements += n;
+            }
+
+            void add(const Module::BaseModule<T> &module, bool drop_activation = false)
+            {
+                using Kernel::Activation;
+                if (auto *seq = dynamic_cast<const Module::Sequential<T> *>(&module))
+                {
+                    // A fused module that is no activation was folded into the layer before it.
+                    auto folded = [seq](size_t i)
+                    { return seq->is_fused(i) && seq->at(i)->fusable_activation() == Activation::None; };
+                    ModuleRecord r = record(ModuleKind::Sequential, seq->fuses_activations() ? 1u : 0u);
+                    for (size_t i = 0; i < seq->size(); i++)
+                        r.a += folded(i) ? 0 : 1;
+                    records.push_back(r);
+                    // An activation fused into a layer is stored as its own module again: add() re-fuses it on load.
+                    for (size_t i = 0; i < seq->size(); i++)
+                    {
+                        if (folded(i))
+                            continue;
+                        size_t next = i + 1;
+                        while (next < seq->size() && folded(next))
+                            next++;
+                        add(*seq->at(i), next < seq->size() && seq->is_fused(next));
+                    }
+                }
+                else if (auto *dense = dynamic_cast<const LayerModule::Dense<T> *>(&module))
+                {
+                    const Activation act = drop_activation ? Activation::None : dense->get_activation();
+                    ModuleRecord r = record(ModuleKind::Dense, uint32_t(act));
+                    r.a = dense->input_size();
+                    r.b = dense->output_size();
+                    add_block(r, dense->weights(), dense->parameter_size());
+                    records.push_back(r);
+                }
+                else if (auto *conv = dynamic_cast<const LayerModule::Conv2D<T> *>(&module))
+                {
+                    const LayerModule::Conv2DOptions o = conv->options();
+                    const Activation act = drop_activation ? Activation::None : o.activation;
+                    ModuleRecord r = record(ModuleKind::Conv2D, uint32_t(act) | uint32_t(o.format) << 8 | uint32_t(o.algorithm) << 16);
+                    r.a = conv->input_channels();
+                    r.b = conv->output_channels();
+                    r.c = conv->kernel_size();
+                    r.d = o.stride;
+                    r.e = o.padding;
+                    add_block(r, conv->weights(), conv->parameter_size());
+                    records.push_back(r);
+                }
+                else if (auto *bn = dynamic_cast<const LayerModule::BatchNorm<T> *>(&module))
+                {
+                    ModuleRecord r = record(ModuleKind::BatchNorm, uint32_t(bn->format()));
+                    r.a = bn->num_channels();
+                    r.c = double_bits(double(bn->get_momentum()));
+                    r.d = double_bits(double(bn->get_eps()));
+                    add_block(r, bn->gamma(), bn->parameter_size());
+                    // [running mean | padding | running var | padding], like the parameter blocks
+                    const size_t stride = Module::aligned_elements<T>(bn->num_channels());
+                    r.state = state.size();
+                    state.resize(r.state + 2 * stride, T(0));
+                    std::copy(bn->running_mean().begin(), bn->running_mean().end(), state.begin() + r.state);
+                    std::copy(bn->running_var().begin(), bn->running_var().end(), state.begin() + r.state + stride);
+                    records.push_back(r);
+                }
+                else if (auto *ln = dynamic_cast<const LayerModule::LayerNorm<T> *>(&module))
+                {
+                    ModuleRecord r = record(ModuleKind::LayerNorm);
+                    r.a = ln->num_features();
+                    r.d = double_bits(double(ln->get_eps()));
+                    add_block(r, ln->gamma(), ln->parameter_size());
+                    records.push_back(r);
+                }
+                else if (auto *pool = dynamic_cast<const LayerModule::Pool2D<T> *>(&module))
+                {
+                    const bool max = dynamic_cast<const LayerModule::MaxPool2D<T> *>(&module) != nullptr;
+                    if (!max && !dynamic_cast<const LayerModule::AvgPool2D<T> *>(&module))
+                        throw std::invalid_argument("save: cannot serialize " + Module::module_name(module));
+                    ModuleRecord r = record(max ? ModuleKind::MaxPool2D : ModuleKind::AvgPool2D, uint32_t(pool->options().format));
+                    r.a = pool->kernel_size();
+                    r.b = pool->options().stride;
+                    r.c = pool->options().padding;
+                    records.push_back(r);
+                }
+                else if (dynamic_cast<const LayerModule::Flatten<T> *>(&module))
+                    records.push_back(record(ModuleKind::Flatten));
+                else if (dynamic_cast<const ActivationModule::ReLU<T> *>(&module))
+                    records.push_back(record(ModuleKind::ReLU));
+                else if (dynamic_cast<const ActivationModule::Sigmoid<T> *>(&module))
+                    records.push_back(record(ModuleKind::Sigmoid));
+                else if (dynamic_cast<const ActivationModule::GELU<T> *>(&module))
+                    records.push_back(record(ModuleKind::GELU));
+                else
+                    throw std::invalid_argument("save: cannot serialize " + Module::module_name(module));
+            }
+        };
+
+        template <typename T>
+        struct TreeReader
+        {
+            const ModuleRecord *records;
+            size_t count;
+            size_t next = 0;
+            std::shared_ptr<Module::ParameterBuffer<T>> parameters;
+            const T *state;
+            size_t state_elements;
+            const std::string &path;
+            size_t depth = 0;
+
+            [[noreturn]] void corrupt(const std::string &what) const
+            {
+                throw std::runtime_error("load: " + path + ": " + what);
+            }
+
+            /// Whether x * y stays within the parameter count (so it cannot wrap).
+            bool product_fits(uint64_t x, uint64_t y) const
+            {
+                const size_t n = parameters->size();
+                return x <= n && y <= n && (y == 0 || x <= n / y);
+            }
+
+            /// Whether a [rows x cols | rows] block (Dense, Conv2D; the norms with cols = 1) at `offset` lies inside the parameters.
+            /// The fields come from the file: every product and sum is checked before it is formed.
+            bool block_fits(uint64_t offset, uint64_t rows, uint64_t cols) const
+            {
+                const size_t n = parameters->size();
+                if (offset > n || !product_fits(rows, cols))
+                    return false;
+                return Module::aligned_elements<T>(Module::aligned_elements<T>(rows * cols) + rows) <= n - offset;
+            }
+
+            static bool valid_format(uint32_t format) { return format <= uint32_t(LayerModule::DataFormat::NHWC); }
+
+            std::shared_ptr<Module::BaseModule<T>> read()
+            {
+                if (next >= count)
+                    corrupt("module table ends early");
+                const ModuleRecord &r = records[next++];
+                // Layer constructors reject settings the layer cannot run with.
+                try
+                {
+                    return build(r);
+                }
+                catch (const std::invalid_argument &err)
+                {
+                    corrupt(err.what());
+                }
+            }
+
+            std::shared_ptr<Module::BaseModule<T>> build(const ModuleRecord &r)
+            {
+                switch (ModuleKind(r.kind))
+                {
+                case ModuleKind::Sequential:
+                {
+                    if (depth == max_nesting)
+                        corrupt("modules nested too deeply");
+                    auto seq = std::make_shared<Module::Sequential<T>>(r.flags != 0);
+                    depth++;
+                    for (uint64_t i = 0; i < r.a; i++)
+                        seq->add(read());
+                    depth--;
+                    return seq;
+                }
+                case ModuleKind::Dense:
+                {
+                    if (r.flags > uint32_t(Kernel::Activation::GELU))
+                        corrupt("unknown activation");
+                    if (r.a == 0 || r.b == 0 || !block_fits(r.offset, r.b, r.a))
+                        corrupt("Dense parameters out of range");
+                    return std::make_shared<LayerModule::Dense<T>>(r.a, r.b, Kernel::Activation(r.flags), parameters, r.offset);
+                }
+                case ModuleKind::Conv2D:
+                {
+                    const uint32_t act = r.flags & 0xff, format = r.flags >> 8 & 0xff, algorithm = r.flags >> 16;
+                    if (act > uint32_t(Kernel::Activation::GELU) || !valid_format(format) ||
+                        algorithm > uint32_t(LayerModule::ConvAlgorithm::Winograd))
+                        corrupt("unknown Conv2D options");
+                    if (r.a == 0 || r.b == 0 || r.c == 0 || !product_fits(r.c, r.c) || !product_fits(r.a, r.c * r.c) ||
+                        !block_fits(r.offset, r.b, r.a * r.c * r.c))
+                        corrupt("Conv2D parameters out of range");
+                    const LayerModule::Conv2DOptions options{r.d, r.e, LayerModule::DataFormat(format), Kernel::Activation(act),
+                                                             LayerModule::ConvAlgorithm(algorithm)};
+                    return std::make_shared<LayerModule::Conv2D<T>>(r.a, r.b, r.c, options, parameters, r.offset);
+                }
+                case ModuleKind::BatchNorm:
+                {
+                    if (!valid_format(r.flags))
+                        corrupt("unknown BatchNorm format");
+                    if (r.a == 0 || !block_fits(r.offset, r.a, 1))
+                        corrupt("BatchNorm parameters out of range");
+                    const size_t stride = Module::aligned_elements<T>(r.a);
+                    if (r.state > state_elements || stride > (state_elements - r.state) / 2)
+                        corrupt("BatchNorm running statistics out of range");
+                    auto bn = std::make_shared<LayerModule::BatchNorm<T>>(r.a, LayerModule::DataFormat(r.flags), T(from_bits(r.c)),
+                                                                          T(from_bits(r.d)), parameters, r.offset);
+                    const T *mean = state + r.state;
+                    std::copy(mean, mean + r.a, bn->running_mean().begin());
+                    std::copy(mean + stride, mean + stride + r.a, bn->running_var().begin());
+                    return bn;
+                }
+                case ModuleKind::LayerNorm:
+                    if (r.a == 0 || !block_fits(r.offset, r.a, 1))
+                        corrupt("LayerNorm parameters out of range");
+                    return std::make_shared<LayerModule::LayerNorm<T>>(r.a, T(from_bits(r.d)), parameters, r.offset);
+                case ModuleKind::MaxPool2D:
+                case ModuleKind::AvgPool2D:
+                {
+                    if (!valid_format(r.flags))
+                        corrupt("unknown pooling format");
+                    const LayerModule::Pool2DOptions options{r.b, r.c, LayerModule::DataFormat(r.flags)};
+                    if (ModuleKind(r.kind) == ModuleKind::MaxPool2D)
+                        return std::make_shared<LayerModule::MaxPool2D<T>>(r.a, options);
+                    return std::make_shared<LayerModule::AvgPool2D<T>>(r.a, options);
+                }
+                case ModuleKind::Flatten:
+                    return std::make_shared<LayerModule::Flatten<T>>();
+                case ModuleKind::ReLU:
+                    return std::make_shared<ActivationModule::ReLU<T>>();
+                case ModuleKind::Sigmoid:
+                    return std::make_shared<ActivationModule::Sigmoid<T>>();
+                case ModuleKind::GELU:
+                    return std::make_shared<ActivationModule::GELU<T>>();
+                }
+                corrupt("unknown module kind " + std::to_string(r.kind));
+            }
+        };
+    }
+
+    template <typename T>
+    void save(const Module::BaseModule<T> &model, const std::string &path)
+    {
+        detail::TreeWriter<T> tree;
+        tree.add(model);
+
+        CheckpointHeader header{};
+        std::memcpy(header.magic, detail::checkpoint_magic, sizeof(header.magic));
+        header.version = checkpoint_version;
+        header.byte_order = detail::byte_order_mark;
+        header.dtype = DType<T>::code;
+        header.element_size = sizeof(T);
+        header.record_count = tree.records.size();
+        const size_t table_end = sizeof(header) + tree.records.size() * sizeof(ModuleRecord);
+        header.data_offset = (table_end + checkpoint_data_alignment - 1) / checkpoint_data_alignment * checkpoint_data_alignment;
+        header.data_elements = tree.elements;
+        header.state_elements = tree.state.size();
+
+        const std::string tmp = path + ".tmp";
+        {
+            std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+            if (!out)
+                throw std::runtime_error("save: cannot write " + tmp);
+            out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+            out.write(reinterpret_cast<const char *>(tree.records.data()), std::streamsize(tree.records.size() * sizeof(ModuleRecord)));
+            const std::vector<char> padding(header.data_offset - table_end, 0);
+            out.write(padding.data(), std::streamsize(padding.size()));
+            for (auto &[data, n] : tree.blocks)
+                out.write(reinterpret_cast<const char *>(data), std::streamsize(n * sizeof(T)));
+            out.write(reinterpret_cast<const char *>(tree.state.data()), std::streamsize(tree.state.size() * sizeof(T)));
+            if (!out.flush())
+                throw std::runtime_error("save: cannot write " + tmp);
+        }
+        if (std::rename(tmp.c_str(), path.c_str()) != 0)
+        {
+            std::remove(tmp.c_str());
+            throw std::runtime_error("save: cannot replace " + path);
+        }
+    }
+
+    template <typename T>
+    std::shared_ptr<Module::BaseModule<T>> load(const std::string &path)
+    {
+        auto file = Memory::MappedFile::open(path);
+        auto corrupt = [&path](const std::string &what)
+        { return std::runtime_error("load: " + path + ": " + what); };
+
+        CheckpointHeader header;
+        if (file->size() < sizeof(header))
+            throw corrupt("not a checkpoint (too short)");
+        std::memcpy(&header, file->data(), sizeof(header));
+        if (std::memcmp(header.magic, detail::checkpoint_magic, sizeof(header.magic)) != 0)
+            throw corrupt("not a checkpoint (bad magic)");
+        if (header.version != checkpoint_version && header.version != 1)
+            throw corrupt("format version " + std::to_string(header.version) + ", expected 1 to " + std::to_string(checkpoint_version));
+        // Version 1 kept state_elements as a reserved zero field.
+        const bool v1 = header.version == 1;
+        if (v1)
+            header.state_elements = 0;
+        const size_t record_size = v1 ? sizeof(detail::ModuleRecordV1) : sizeof(ModuleRecord);
+        if (header.byte_order != detail::byte_order_mark)
+            throw corrupt("written with another byte order");
+        if (header.dtype != DType<T>::code || header.element_size != sizeof(T))
+            throw corrupt("stores another element type");
+        const uint64_t size = file->size();
+        if (header.record_count == 0 || header.record_count > (size - sizeof(header)) / record_size ||
+            header.data_offset % checkpoint_data_alignment != 0 || header.data_offset > size ||
+            sizeof(header) + header.record_count * record_size > header.data_offset ||
+            header.data_elements > (size - header.data_offset) / sizeof(T) ||
+            header.state_elements > (size - header.data_offset) / sizeof(T) - header.data_elements)
+            throw corrupt("truncated or inconsistent");
+
+        // Gradients start as lazily zeroed pages; the buffer keeps both mappings alive.
+        const size_t n = header.data_elements;
+        auto grads = Memory::map_zeros(n * sizeof(T));
+        T *values = reinterpret_cast<T *>(file->data() + header.data_offset);
+        auto owner = std::make_shared<std::pair<std::shared_ptr<Memory::MappedFile>, std::shared_ptr<void>>>(file, grads);
+        auto parameters = std::make_shared<Module::ParameterBuffer<T>>(values, static_cast<T *>(grads.get()), n, owner);
+
+        // Version-1 records are widened to the current layout; their fields keep their meaning.
+        const char *table = file->data() + sizeof(header);
+        std::vector<ModuleRecord> upgraded;
+        if (v1)
+        {
+            upgraded.resize(header.record_count);
+            for (size_t i = 0; i < upgraded.size(); i++)
+            {
+                detail::ModuleRecordV1 old;
+                std::memcpy(&old, table + i * sizeof(old), sizeof(old));
+                if (old.kind > uint32_t(ModuleKind::GELU))
+                    throw corrupt("unknown module kind " + std::to_string(old.kind) + " in a version 1 file");
+                ModuleRecord &r = upgraded[i];
+                r = ModuleRecord{};
+                r.kind = old.kind;
+                r.flags = old.flags;
+                r.a = old.a;
+                r.b = old.b;
+                r.offset = old.offset;
+            }
+            table = reinterpret_cast<const char *>(upgraded.data());
+        }
+
+        detail::TreeReader<T> reader{reinterpret_cast<const ModuleRecord *>(table),
+                                     header.record_count, 0, parameters, values + n, header.state_elements, path};
+        auto model = reader.read();
+        if (reader.next != reader.count)
+            throw corrupt("records after the root module");
+        return model;
+    }
+}
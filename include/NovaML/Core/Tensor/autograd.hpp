@@ -1,31 +1,348 @@
 #pragma once
+#include <algorithm>
 #include <vector>
+#include <memory>
 #include <functional>
+#include <unordered_map>
+#include <stdexcept>
+#include <string>
 #include "tensor.hpp"
+#include "storage.hpp"
+#include "../../Profiler/profiler.hpp"
 
 namespace NovaML::Core
 {
 
     template <typename T> class Tensor;
 
+    /**
+     * @brief Thread-local switch for graph recording.
+     *
+     * While disabled, ops produce results with requires_grad = false and
+     * record no edges, and modules skip caching activations for backward.
+     */
+    class GradMode
+    {
+    public:
+        static bool is_enabled() { return flag(); }
+        static void set_enabled(bool enabled) { flag() = enabled; }
+
+    private:
+        static bool &flag()
+        {
+            thread_local bool enabled = true;
+            return enabled;
+        }
+    };
+
+    /**
+     * @brief Disable gradient tracking for the current scope (inference mode).
+     *
+     * @code
+     * {
+     *     NoGradGuard no_grad;
+     *     auto y = model.forward(x); // no graph, no gradient buffers
+     * }
+     * @endcode
+     */
+    class NoGradGuard
+    {
+    public:
+        NoGradGuard() : previous(GradMode::is_enabled()) { GradMode::set_enabled(false); }
+        ~NoGradGuard() { GradMode::set_enabled(previous); }
+
+        NoGradGuard(const NoGradGuard &) = delete;
+        NoGradGuard &operator=(const NoGradGuard &) = delete;
+
+    private:
+        bool previous;
+    };
+
+    /**
+     * @brief Records the ops run while a Graph is being captured (see graph.hpp).
+     *
+     * Every op that writes a new result registers a step that recomputes it
+     * in place from the op's inputs; views need none, they share storage.
+     * Ops count their results through make_result, so a capture can tell
+     * when one of them did not register a step.
+     */
+    class GraphRecorder
+    {
+    public:
+        /// Recorder of the capture running on this thread, if any.
+        static GraphRecorder *active() { return slot(); }
+
+        /// Whether a captured graph is being replayed on this thread.
+        static bool replaying() { return replay_flag(); }
+
+        void record(std::function<void()> step) { steps.push_back(std::move(step)); }
+        void count_result() { results++; }
+
+        std::vector<std::function<void()>> steps;
+        size_t results = 0; ///< tensors produced through make_result
+
+        static GraphRecorder *&slot()
+        {
+            thread_local GraphRecorder *recorder = nullptr;
+            return recorder;
+        }
+
+        static bool &replay_flag()
+        {
+            thread_local bool flag = false;
+            return flag;
+        }
+    };
+
     enum class OperatorType
     {
         Add,       // tensor + tensor
         Sub,       // tensor - tensor
         Mul,       // tensor * tensor (element-wise)
+        Div,       // tensor / tensor (element-wise)
         Pow,       // tensor ^ scalar
         Neg,       // -tensor
+        Exp,       // e^tensor
+        Log,       // log(tensor)
+        Tanh,      // tanh(tensor)
+        Sigmoid,   // 1 / (1 + e^-tensor)
+        Sum,       // reduce to scalar
+        Mean,      // reduce to scalar
+        Max,       // max along dimensions
+        Min,       // min along dimensions
+        Var,       // variance along dimensions
+        Std,       // standard deviation along dimensions
+        LogSumExp, // log(sum(exp)) along dimensions
+        Norm,      // p-norm along dimensions
         AddScalar, // tensor + scalar
         SubScalar, // tensor - scalar or scalar - tensor
-        MulScalar  // tensor * scalar or scalar * tensor
+        MulScalar, // tensor * scalar or scalar * tensor
+        Reshape,   // view with a new shape (view, reshape, squeeze, unsqueeze)
+        Transpose, // view with two dimensions swapped
+        Slice,     // strided sub-view
+        Contiguous, // dense copy of a strided view
+        Expand,     // broadcast view (stride 0 along expanded dimensions)
+        Fused       // fused element-wise expression (see expression.hpp)
     };
 
+    /**
+     * @brief A single input of a recorded operation.
+     *
+     * `backward_fn(grad_output, grad_input)` adds the contribution of this
+     * edge to `grad_input`, the gradient buffer of `parent`. It must not call
+     * back into the engine: the tape decides when each node runs.
+     */
     template <typename T>
     struct Edge
     {
         OperatorType op;
-        std::weak_ptr<Tensor<T>> parent;
-        std::function<void(const std::vector<T> &)> backward_fn;
+        std::shared_ptr<Tensor<T>> parent;
+        std::function<void(const Buffer<T> &, Buffer<T> &)> backward_fn;
+    };
+
+    /// Throws if an in-place op has written `tensor` since it was saved at `saved_version`.
+    template <typename T>
+    void check_version(const Tensor<T> &tensor, size_t saved_version, const std::string &op)
+    {
+        // A replay has just recomputed every saved value from the current inputs.
+        if (GraphRecorder::replaying())
+            return;
+        if (tensor.version() != saved_version)
+            throw std::runtime_error(op + ": a tensor needed for gradient computation was modified by an in-place "
+                                          "operation (version " + std::to_string(saved_version) + ", now " +
+                                     std::to_string(tensor.version()) + ")");
+    }
+
+    /**
+     * @brief A tensor captured by a backward function, together with its version at capture time.
+     *
+     * unpack() throws if an in-place op has written the tensor's storage
+     * since, instead of letting backward read the new values.
+     */
+    template <typename T>
+    class SavedTensor
+    {
+    public:
+        SavedTensor(std::shared_ptr<Tensor<T>> tensor)
+            : tensor(std::move(tensor)), version(this->tensor->version()) {}
+
+        const Tensor<T> &unpack(const std::string &op) const
+        {
+            check_version(*tensor, version, op);
+            return *tensor;
+        }
+
+    private:
+        std::shared_ptr<Tensor<T>> tensor;
+        size_t version;
+    };
+
+    /**
+     * @brief Backward of a node that produces the gradients of all its inputs at once.
+     *
+     * Used by fused kernels, which compute every input gradient in a single
+     * pass. `grad_inputs[e]` is the gradient buffer of the parent of edge
+     * `e`, or nullptr when that parent does not take a gradient.
+     */
+    template <typename T>
+    using FusedBackward = std::function<void(const Buffer<T> &grad_output, const std::vector<Buffer<T> *> &grad_inputs)>;
+
+    /**
+     * @brief Linear schedule of the graph reachable from a root tensor.
+     *
+     * Nodes are stored in reverse topological order (root first), so every
+     * node is visited after all of its consumers and its gradient is complete
+     * before being pushed upstream. Each node runs exactly once per backward
+     * pass regardless of how many paths lead to it.
+     */
+    template <typename T>
+    class GradTape
+    {
+    public:
+        static GradTape record(Tensor<T> *root)
+        {
+            GradTape tape;
+            if (!root->get_requires_grad())
+                return tape;
+
+            // Iterative post-order DFS: avoids recursion depth limits on long chains.
+            std::vector<std::pair<Tensor<T> *, size_t>> stack;
+            std::unordered_map<const Tensor<T> *, bool> visited;
+            std::vector<Tensor<T> *> post_order;
+
+            stack.push_back({root, 0});
+            visited[root] = true;
+            while (!stack.empty())
+            {
+                auto &[node, next] = stack.back();
+                const auto &edges = node->get_edges();
+                if (next < edges.size())
+                {
+                    Tensor<T> *parent = edges[next++].parent.get();
+                    if (parent && parent->get_requires_grad() && !visited[parent])
+                    {
+                        visited[parent] = true;
+                        stack.push_back({parent, 0});
+                    }
+                    continue;
+                }
+                post_order.push_back(node);
+                stack.pop_back();
+            }
+
+            tape.nodes.assign(post_order.rbegin(), post_order.rend());
+            for (size_t i = 0; i < tape.nodes.size(); i++)
+                tape.index[tape.nodes[i]] = i;
+            return tape;
+        }
+
+        void run(Buffer<T> seed)
+        {
+            if (nodes.empty())
+                return;
+
+            std::vector<Buffer<T>> pending(nodes.size());
+            pending[0] = std::move(seed);
+
+            for (size_t k = 0; k < nodes.size(); k++)
+            {
+                if (pending[k].empty())
+                    continue;
+
+                Tensor<T> *node = nodes[k];
+                const auto &edges = node->get_edges();
+                Profiler::RecordScope scope([node]
+                                            { return node->get_grad_fn_name(); }, Profiler::Category::Backward);
+                std::vector<Buffer<T> *> grad_inputs(edges.size(), nullptr);
+                for (size_t e = 0; e < edges.size(); e++)
+                {
+                    Tensor<T> *parent = edges[e].parent.get();
+                    if (!parent || !parent->get_requires_grad())
+                        continue;
+                    auto &grad_in = pending[index.at(parent)];
+                    if (grad_in.empty())
+                        grad_in.assign(parent->size(), T(0));
+                    grad_inputs[e] = &grad_in;
+                }
+
+                if (const auto &fused = node->get_fused_backward())
+                    fused(pending[k], grad_inputs);
+                else
+                    for (size_t e = 0; e < edges.size(); e++)
+                        if (grad_inputs[e])
+                            edges[e].backward_fn(pending[k], *grad_inputs[e]);
+
+                // Hand the finished buffer to the node: the first gradient a
+                // tensor receives becomes its grad storage without a copy.
+                node->accumulate_grad(std::move(pending[k]));
+                Buffer<T>().swap(pending[k]);
+            }
+        }
+
+        /**
+         * @brief Like run(), but into gradient buffers planned by the first call and reused after.
+         *
+         * Used to replay a captured Graph: nothing is allocated once the
+         * buffers exist. Leaves accumulate their gradient as usual; interior
+         * nodes swap in this pass's gradient, as they would get it as fresh
+         * tensors, and their previous buffer is planned for the next pass.
+         */
+        void replay(const Buffer<T> &seed)
+        {
+            if (nodes.empty())
+                return;
+            if (planned.empty())
+                plan();
+            else // a buffer handed back empty is allocated again, once
+                for (size_t k = 0; k < nodes.size(); k++)
+                    planned[k].assign(nodes[k]->size(), T(0));
+            std::copy(seed.begin(), seed.end(), planned[0].begin());
+
+            for (size_t k = 0; k < nodes.size(); k++)
+            {
+                Tensor<T> *node = nodes[k];
+                const auto &edges = node->get_edges();
+                const auto &grad_inputs = sinks[k];
+                if (const auto &fused = node->get_fused_backward())
+                    fused(planned[k], grad_inputs);
+                else
+                    for (size_t e = 0; e < edges.size(); e++)
+                        if (grad_inputs[e])
+                            edges[e].backward_fn(planned[k], *grad_inputs[e]);
+
+                if (edges.empty())
+                    node->accumulate_grad(planned[k]);
+                else
+                    node->swap_grad(planned[k]);
+            }
+        }
+
+        size_t size() const { return nodes.size(); }
+        Tensor<T> *node(size_t k) const { return nodes[k]; }
+
+    private:
+        void plan()
+        {
+            for (Tensor<T> *node : nodes)
+                planned.emplace_back(node->size(), T(0));
+            for (Tensor<T> *node : nodes)
+            {
+                const auto &edges = node->get_edges();
+                std::vector<Buffer<T> *> grad_inputs(edges.size(), nullptr);
+                for (size_t e = 0; e < edges.size(); e++)
+                {
+                    Tensor<T> *parent = edges[e].parent.get();
+                    if (parent && parent->get_requires_grad())
+                        grad_inputs[e] = &planned[index.at(parent)];
+                }
+                sinks.push_back(std::move(grad_inputs));
+            }
+        }
+
+        std::vector<Tensor<T> *> nodes; ///< Reverse topological order, root first
+        std::unordered_map<const Tensor<T> *, size_t> index;
+        std::vector<Buffer<T>> planned;                 ///< replay(): one gradient buffer per node
+        std::vector<std::vector<Buffer<T> *>> sinks;    ///< replay(): per node, the buffers of its edges' parents
     };
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,441 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+#include "tensor.hpp"
+#include "../Kernel/vmath.hpp"
+
+namespace NovaML::Core::Expr
+{
+    // -------------------------
+    // Fused element-wise expressions
+    //
+    // Operators on lazy() operands build an expression tree instead of
+    // tensors; evaluate() then runs the whole tree in one pass that reads
+    // every input once and writes one output, with no intermediate tensors,
+    // gradient buffers or closures. Backward is fused the same way: one pass
+    // recomputes the tree and writes the gradients of all inputs.
+    // The tree runs a tile of elements at a time: each node's Cache holds its
+    // values over the tile and its children's, filled by one forward() sweep
+    // so grad() reads node values instead of re-evaluating whole subtrees at
+    // every level, and unary ops see whole tiles (log checks its domain once
+    // per tile, inner loops stay branch-free).
+    //
+    //     auto y = Expr::evaluate((Expr::lazy(a) * b + c) / d);
+    // -------------------------
+
+    /// Marker base of all expression nodes.
+    struct ExprTag
+    {
+    };
+
+    template <typename E>
+    constexpr bool is_expr_v = std::is_base_of_v<ExprTag, E>;
+
+    /// Elements a node processes per forward() / grad() call.
+    constexpr size_t tile = 256;
+
+    // -------------------------
+    // Operators: value and local derivative(s), matching the eager ops.
+    // Binary ops apply per element, unary ops over a tile y[0, n) = f(x[0, n))
+    // through the same vmath kernels (and accuracy tier) as the eager ops;
+    // a unary derivative d(x, y, p, g) also sees its own cached output y.
+    // -------------------------
+    struct AddOp
+    {
+        template <typename T> static T apply(T x, T y) { return x + y; }
+        template <typename T> static T dl(T, T, T g) { return g; }
+        template <typename T> static T dr(T, T, T g) { return g; }
+    };
+
+    struct SubOp
+    {
+        template <typename T> static T apply(T x, T y) { return x - y; }
+        template <typename T> static T dl(T, T, T g) { return g; }
+        template <typename T> static T dr(T, T, T g) { return -g; }
+    };
+
+    struct MulOp
+    {
+        template <typename T> static T apply(T x, T y) { return x * y; }
+        template <typename T> static T dl(T, T y, T g) { return g * y; }
+        template <typename T> static T dr(T x, T, T g) { return g * x; }
+    };
+
+    struct DivOp
+    {
+        template <typename T> static T apply(T x, T y) { return x / y; }
+        template <typename T> static T dl(T, T y, T g) { return g / y; }
+        template <typename T> static T dr(T x, T y, T g) { return -(g * x / (y * y)); }
+    };
+
+    struct NegOp
+    {
+        template <typename T>
+        static void apply(size_t n, const T *x, T, T *y)
+        {
+            for (size_t k = 0; k < n; k++)
+                y[k] = -x[k];
+        }
+        template <typename T> static T d(T, T, T, T g) { return -g; }
+    };
+
+    struct ExpOp
+    {
+        template <typename T>
+        static void apply(size_t n, const T *x, T, T *y) { Kernel::vexp(n, x, y); }
+        template <typename T> static T d(T, T y, T, T g) { return g * y; } // d/dx e^x = e^x
+    };
+
+    struct LogOp
+    {
+        template <typename T>
+        static void apply(size_t n, const T *x, T, T *y)
+        {
+            if (!Kernel::all_positive(n, x))
+                throw std::runtime_error("log: input must be positive");
+            Kernel::vlog(n, x, y);
+        }
+        template <typename T> static T d(T x, T, T, T g) { return g / x; }
+    };
+
+    struct PowOp
+    {
+        template <typename T>
+        static void apply(size_t n, const T *x, T p, T *y) { Kernel::vpow(n, x, p, y); }
+        template <typename T> static T d(T x, T, T p, T g) { return g * p * std::pow(x, p - 1); }
+    };
+
+    // -------------------------
+    // Nodes
+    // -------------------------
+    template <typename T>
+    struct Leaf : ExprTag
+    {
+        using value_type = T;
+        static constexpr bool tracks = true;
+
+        struct Cache
+        {
+            const T *value; ///< Points into the input
+        };
+
+        explicit Leaf(std::shared_ptr<Tensor<T>> tensor) : tensor(std::move(tensor)) {}
+
+        void forward(size_t i, size_t, Cache &c) const { c.value = data + i; }
+
+        template <typename Sink>
+        void grad(size_t i, size_t n, const T *g, const Cache &, Sink &sink) const { sink(slot, i, n, g); }
+
+        template <typename F>
+        void for_each_leaf(F &&f) { f(*this); }
+
+        std::shared_ptr<Tensor<T>> tensor;
+        const T *data = nullptr; ///< Bound by evaluate()
+        size_t slot = 0;         ///< Index among the distinct input tensors
+    };
+
+    template <typename T>
+    struct Scalar : ExprTag
+    {
+        using value_type = T;
+        static constexpr bool tracks = false;
+
+        struct Cache
+        {
+            T value[tile];
+        };
+
+        explicit Scalar(T value) : value(value) {}
+
+        void forward(size_t, size_t n, Cache &c) const { std::fill(c.value, c.value + n, value); }
+
+        template <typename Sink>
+        void grad(size_t, size_t, const T *, const Cache &, Sink &) const {}
+
+        template <typename F>
+        void for_each_leaf(F &&) {}
+
+        T value;
+    };
+
+    template <typename Op, typename E>
+    struct Unary : ExprTag
+    {
+        using value_type = typename E::value_type;
+        using T = value_type;
+        static constexpr bool tracks = E::tracks;
+
+        struct Cache
+        {
+            typename E::Cache e;
+            T value[tile];
+        };
+
+        Unary(E e, T param) : e(std::move(e)), param(param) {}
+
+        void forward(size_t i, size_t n, Cache &c) const
+        {
+            e.forward(i, n, c.e);
+            Op::apply(n, &c.e.value[0], param, c.value);
+        }
+
+        template <typename Sink>
+        void grad(size_t i, size_t n, const T *g, const Cache &c, Sink &sink) const
+        {
+            if constexpr (E::tracks)
+            {
+                T ge[tile];
+                for (size_t k = 0; k < n; k++)
+                    ge[k] = Op::d(c.e.value[k], c.value[k], param, g[k]);
+                e.grad(i, n, ge, c.e, sink);
+            }
+        }
+
+        template <typename F>
+        void for_each_leaf(F &&f) { e.for_each_leaf(f); }
+
+        E e;
+        T param;
+    };
+
+    template <typename Op, typename L, typename R>
+    struct Binary : ExprTag
+    {
+        using value_type = typename L::value_type;
+        using T = value_type;
+        static constexpr bool tracks = L::tracks || R::tracks;
+
+        struct Cache
+        {
+            typename L::Cache l;
+            typename R::Cache r;
+            T value[tile];
+        };
+
+        Binary(L l, R r) : l(std::move(l)), r(std::move(r)) {}
+
+        void forward(size_t i, size_t n, Cache &c) const
+        {
+            l.forward(i, n, c.l);
+            r.forward(i, n, c.r);
+            for (size_t k = 0; k < n; k++)
+                c.value[k] = Op::apply(c.l.value[k], c.r.value[k]);
+        }
+
+        template <typename Sink>
+        void grad(size_t i, size_t n, const T *g, const Cache &c, Sink &sink) const
+        {
+            T gc[tile];
+            if constexpr (L::tracks)
+            {
+                for (size_t k = 0; k < n; k++)
+                    gc[k] = Op::dl(c.l.value[k], c.r.value[k], g[k]);
+                l.grad(i, n, gc, c.l, sink);
+            }
+            if constexpr (R::tracks)
+            {
+                for (size_t k = 0; k < n; k++)
+                    gc[k] = Op::dr(c.l.value[k], c.r.value[k], g[k]);
+                r.grad(i, n, gc, c.r, sink);
+            }
+        }
+
+        template <typename F>
+        void for_each_leaf(F &&f)
+        {
+            l.for_each_leaf(f);
+            r.for_each_leaf(f);
+        }
+
+        L l;
+        R r;
+    };
+
+    // -------------------------
+    // Operands: expressions, tensors and scalars mix freely
+    // -------------------------
+    template <typename X>
+    struct operand_value
+    {
+        using type = void;
+    };
+
+    template <typename T>
+    struct operand_value<std::shared_ptr<Tensor<T>>>
+    {
+        using type = T;
+    };
+
+    template <typename X, bool = is_expr_v<X>>
+    struct value_of
+    {
+        using type = typename operand_value<X>::type;
+    };
+
+    template <typename X>
+    struct value_of<X, true>
+    {
+        using type = typename X::value_type;
+    };
+
+    template <typename L, typename R>
+    using binary_value_t = typename std::conditional_t<is_expr_v<L>, value_of<L>, value_of<R>>::type;
+
+    template <typename X>
+    constexpr bool is_operand_v = is_expr_v<X> || std::is_arithmetic_v<X> ||
+                                  !std::is_void_v<typename operand_value<X>::type>;
+
+    template <typename L, typename R>
+    constexpr bool is_expr_pair_v = (is_expr_v<L> || is_expr_v<R>) && is_operand_v<L> && is_operand_v<R>;
+
+    template <typename T, typename X>
+    auto as_expr(const X &x)
+    {
+        if constexpr (is_expr_v<X>)
+            return x;
+        else if constexpr (std::is_arithmetic_v<X>)
+            return Scalar<T>(static_cast<T>(x));
+        else
+            return Leaf<T>(x);
+    }
+
+    /// Start a fused expression from a tensor.
+    template <typename T>
+    Leaf<T> lazy(const std::shared_ptr<Tensor<T>> &tensor) { return Leaf<T>(tensor); }
+
+#define NOVAML_EXPR_BINARY(symbol, Op)                                                           \
+    template <typename L, typename R, std::enable_if_t<is_expr_pair_v<L, R>, int> = 0>          \
+    auto operator symbol(const L &l, const R &r)                                                \
+    {                                                                                           \
+        using T = binary_value_t<L, R>;                                                         \
+        using LE = decltype(as_expr<T>(l));                                                     \
+        using RE = decltype(as_expr<T>(r));                                                     \
+        return Binary<Op, LE, RE>(as_expr<T>(l), as_expr<T>(r));                                \
+    }
+
+    NOVAML_EXPR_BINARY(+, AddOp)
+    NOVAML_EXPR_BINARY(-, SubOp)
+    NOVAML_EXPR_BINARY(*, MulOp)
+    NOVAML_EXPR_BINARY(/, DivOp)
+#undef NOVAML_EXPR_BINARY
+
+    template <typename E, std::enable_if_t<is_expr_v<E>, int> = 0>
+    Unary<NegOp, E> operator-(const E &e) { return {e, typename E::value_type(0)}; }
+
+    template <typename E, std::enable_if_t<is_expr_v<E>, int> = 0>
+    Unary<ExpOp, E> exp(const E &e) { return {e, typename E::value_type(0)}; }
+
+    template <typename E, std::enable_if_t<is_expr_v<E>, int> = 0>
+    Unary<LogOp, E> log(const E &e) { return {e, typename E::value_type(0)}; }
+
+    template <typename E, std::enable_if_t<is_expr_v<E>, int> = 0>
+    Unary<PowOp, E> pow(const E &e, typename E::value_type exponent) { return {e, exponent}; }
+
+    // -------------------------
+    // Evaluation
+    // -------------------------
+    /**
+     * @brief Run an expression in a single fused pass and return the result tensor.
+     *
+     * All tensor inputs must have the same shape; strided inputs are made
+     * contiguous first. When any input requires a gradient the result gets
+     * one edge per distinct input and a fused backward that computes all of
+     * their gradients in one pass, recomputing intermediates instead of
+     * storing them. Throws std::invalid_argument when the expression has no
+     * tensor operand.
+     */
+    template <typename E, std::enable_if_t<is_expr_v<E>, int> = 0>
+    std::shared_ptr<Tensor<typename E::value_type>> evaluate(E expr)
+    {
+        using T = typename E::value_type;
+
+        std::vector<std::shared_ptr<Tensor<T>>> inputs;
+        std::unordered_map<const Tensor<T> *, size_t> slots;
+        expr.for_each_leaf([&](Leaf<T> &leaf)
+                           {
+                               auto it = slots.find(leaf.tensor.get());
+                               if (it == slots.end())
+                               {
+                                   it = slots.emplace(leaf.tensor.get(), inputs.size()).first;
+                                   inputs.push_back(contiguous(leaf.tensor));
+                               }
+                               leaf.slot = it->second;
+                               leaf.tensor = inputs[leaf.slot];
+                               leaf.data = leaf.tensor->data_ptr(); });
+
+        if (inputs.empty())
+            throw std::invalid_argument("evaluate: expression has no tensor operand");
+        const Shape &shape = inputs.front()->shape();
+        bool requires_grad = false;
+        for (const auto &input : inputs)
+        {
+            if (input->shape() != shape)
+                throw std::invalid_argument("evaluate: expression inputs have shapes " + shape_to_string(shape) +
+                                            " and " + shape_to_string(input->shape()));
+            requires_grad = requires_grad || input->get_requires_grad();
+        }
+
+        const size_t n = numel(shape);
+        Profiler::RecordScope scope("fused", Profiler::Category::Op, 0, (inputs.size() + 1.0) * n * sizeof(T));
+        // Each tile is evaluated in the node caches and copied out whole, so
+        // an operand outside a domain (log) throws before its tile is written.
+        auto run = [expr, n](T *o)
+        {
+            Parallel::parallel_for(0, n, Parallel::elementwise_grain, [&](size_t begin, size_t end)
+                                   {
+                                       typename E::Cache cache;
+                                       for (size_t i = begin; i < end; i += tile)
+                                       {
+                                           const size_t m = std::min(tile, end - i);
+                                           expr.forward(i, m, cache);
+                                           std::copy(&cache.value[0], &cache.value[0] + m, o + i);
+                                       } });
+        };
+        Buffer<T> result(n);
+        run(result.data());
+
+        auto output = make_result(std::move(result), shape, requires_grad);
+        // Leaves point at the inputs' storage, which a replay refreshes first.
+        record_step(output, run);
+        if (output->get_requires_grad())
+        {
+            std::vector<SavedTensor<T>> saved;
+            for (const auto &input : inputs)
+            {
+                output->add_edge({OperatorType::Fused, input, nullptr});
+                saved.emplace_back(input);
+            }
+            output->set_fused_backward([expr, saved](const Buffer<T> &grad_output, const std::vector<Buffer<T> *> &grad_inputs)
+                                       {
+                                           for (const auto &input : saved)
+                                               input.unpack("<FusedBackward>");
+                                           std::vector<T *> sinks(grad_inputs.size(), nullptr);
+                                           for (size_t k = 0; k < grad_inputs.size(); k++)
+                                               if (grad_inputs[k])
+                                                   sinks[k] = grad_inputs[k]->data();
+                                           auto sink = [&](size_t slot, size_t i, size_t n, const T *g)
+                                           {
+                                               if (T *p = sinks[slot])
+                                                   for (size_t k = 0; k < n; k++)
+                                                       p[i + k] += g[k];
+                                           };
+                                           const size_t total = grad_output.size();
+                                           Parallel::parallel_for(0, total, Parallel::elementwise_grain, [&](size_t begin, size_t end)
+                                                                  {
+                                                                      typename E::Cache cache;
+                                                                      for (size_t i = begin; i < end; i += tile)
+                                                                      {
+                                                                          const size_t m = std::min(tile, end - i);
+                                                                          expr.forward(i, m, cache);
+                                                                          expr.grad(i, m, grad_output.data() + i, cache, sink);
+                                                                      } }); });
+            output->set_grad_fn_name("<FusedBackward>");
+        }
+        return output;
+    }
+}
@@ -0,0 +1,125 @@
+#pragma once
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+#include "tensor.hpp"
+#include "autograd.hpp"
+#include "../../Profiler/profiler.hpp"
+
+namespace NovaML::Core
+{
+    /**
+     * @brief One training (or inference) step captured once and replayed many times.
+     *
+     * capture() runs `step` eagerly while recording, for every op, how to
+     * recompute its result in place, then runs the backward pass of the
+     * returned tensor and plans one gradient buffer per graph node. The
+     * graph, its intermediate tensors and those buffers are kept. replay()
+     * then redoes forward and backward over the same buffers: no tensors,
+     * edges or closures are built and nothing is allocated.
+     *
+     * Inputs are the tensors the step read; write new values into them
+     * between replays (copy_() under a NoGradGuard, or through data_ptr()),
+     * and update parameters the same way. Everything is recomputed from the
+     * current values, so the version checks that guard saved tensors in an
+     * eager backward are skipped during a replay. Leaf gradients accumulate
+     * as after backward(); zero them between steps as usual.
+     *
+     * The captured step must keep its shapes and control flow fixed, and
+     * use tensor ops only: in-place ops and nested backward() calls are
+     * refused while capturing. Modules run their own kernels and are not
+     * recorded.
+     *
+     * @code
+     * auto x = std::make_shared<Tensor<float>>(Tensor<float>::zeros({64, 16}));
+     * auto graph = Graph<float>::capture([&] { return mean((x * w - y) ^ 2.0f); });
+     * for (...)
+     * {
+     *     copy_(x, next_batch);
+     *     graph.replay();
+     *     ... update w from w->get_grad(), then w->zero_grad()
+     * }
+     * @endcode
+     */
+    template <typename T = float>
+    class Graph
+    {
+    public:
+        /**
+         * @brief Run `step` once, recording it, followed by its backward pass.
+         *
+         * @throws std::runtime_error if an op without capture support ran.
+         */
+        static Graph capture(const std::function<std::shared_ptr<Tensor<T>>()> &step)
+        {
+            GraphRecorder recorder;
+            GraphRecorder *outer = GraphRecorder::slot();
+            GraphRecorder::slot() = &recorder;
+            std::shared_ptr<Tensor<T>> result;
+            try
+            {
+                result = step();
+            }
+            catch (...)
+            {
+                GraphRecorder::slot() = outer;
+                throw;
+            }
+            GraphRecorder::slot() = outer;
+
+            if (!result)
+                throw std::invalid_argument("Graph::capture: the step returned no tensor");
+            if (recorder.steps.size() != recorder.results)
+                throw std::runtime_error("Graph::capture: " + std::to_string(recorder.results - recorder.steps.size()) +
+                                         " op(s) in the step cannot be replayed");
+
+            Graph graph;
+            graph.steps = std::move(recorder.steps);
+            graph.result = result;
+            if (result->get_requires_grad())
+            {
+                graph.tape = GradTape<T>::record(result.get());
+                graph.seed = Buffer<T>(result->size(), T(1));
+                for (size_t k = 0; k < graph.tape.size(); k++)
+                    graph.nodes.push_back(graph.tape.node(k)->shared_from_this());
+                Profiler::RecordScope scope("backward", Profiler::Category::Backward);
+                graph.tape.replay(graph.seed);
+            }
+            return graph;
+        }
+
+        /// Recompute the captured forward pass, then its backward pass, in place.
+        void replay()
+        {
+            Profiler::RecordScope scope("graph.replay", Profiler::Category::Op);
+            struct ReplayFlag
+            {
+                bool previous = GraphRecorder::replay_flag();
+                ReplayFlag() { GraphRecorder::replay_flag() = true; }
+                ~ReplayFlag() { GraphRecorder::replay_flag() = previous; }
+            } flag;
+            for (auto &step : steps)
+                step();
+            tape.replay(seed);
+        }
+
+        /// The tensor the step returned; a replay rewrites its values.
+        const std::shared_ptr<Tensor<T>> &output() const { return result; }
+
+        /// Recorded forward ops.
+        size_t num_steps() const { return steps.size(); }
+
+        /// Nodes the backward pass visits.
+        size_t num_nodes() const { return tape.size(); }
+
+    private:
+        Graph() = default;
+
+        std::vector<std::function<void()>> steps; ///< forward ops in execution order
+        std::shared_ptr<Tensor<T>> result;
+        GradTape<T> tape;
+        Buffer<T> seed;                                  ///< d result / d result = 1
+        std::vector<std::shared_ptr<Tensor<T>>> nodes;   ///< keeps the tape's nodes alive
+    };
+}
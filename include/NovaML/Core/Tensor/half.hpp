@@ -0,0 +1,142 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace NovaML::Core
+{
+    // -------------------------
+    // 16-bit floating point storage types
+    // -------------------------
+    //
+    // Both convert implicitly to and from float, so any templated code
+    // computes in fp32 and rounds (to nearest even) when it stores a result.
+    // Sums over many elements should accumulate in accumulate_t<T>.
+
+    namespace detail
+    {
+        inline uint32_t float_bits(float f)
+        {
+            uint32_t u;
+            std::memcpy(&u, &f, sizeof(u));
+            return u;
+        }
+
+        inline float bits_float(uint32_t u)
+        {
+            float f;
+            std::memcpy(&f, &u, sizeof(f));
+            return f;
+        }
+
+        inline uint16_t float_to_bf16(float f)
+        {
+            uint32_t u = float_bits(f);
+            if ((u & 0x7fffffffu) > 0x7f800000u)
+                return static_cast<uint16_t>((u >> 16) | 0x40u); // quiet NaN
+            u += 0x7fffu + ((u >> 16) & 1u);
+            return static_cast<uint16_t>(u >> 16);
+        }
+
+        inline float bf16_to_float(uint16_t h) { return bits_float(uint32_t(h) << 16); }
+
+        inline uint16_t float_to_fp16(float f)
+        {
+            uint32_t u = float_bits(f);
+            const uint32_t sign = u & 0x80000000u;
+            u ^= sign;
+            uint32_t h;
+            if (u >= (127u + 16u) << 23) // overflows: Inf, or NaN kept quiet
+                h = u > 0x7f800000u ? 0x7e00u : 0x7c00u;
+            else if (u < 113u << 23) // subnormal or zero: let the FPU round
+                h = float_bits(bits_float(u) + 0.5f) - float_bits(0.5f);
+            else
+            {
+                const uint32_t mantissa_odd = (u >> 13) & 1u;
+                u += ((15u - 127u) << 23) + 0xfffu + mantissa_odd;
+                h = u >> 13;
+            }
+            return static_cast<uint16_t>(h | (sign >> 16));
+        }
+
+        inline float fp16_to_float(uint16_t h)
+        {
+            const uint32_t shifted_exp = 0x7c00u << 13;
+            uint32_t u = uint32_t(h & 0x7fffu) << 13;
+            const uint32_t exp = shifted_exp & u;
+            u += (127u - 15u) << 23;
+            float f;
+            if (exp == shifted_exp) // Inf / NaN
+                f = bits_float(u + ((128u - 16u) << 23));
+            else if (exp == 0) // subnormal
+                f = bits_float(u + (1u << 23)) - bits_float(113u << 23);
+            else
+                f = bits_float(u);
+            return bits_float(float_bits(f) | (uint32_t(h & 0x8000u) << 16));
+        }
+    }
+
+    /// Brain float: fp32's exponent range with an 8-bit significand.
+    struct bfloat16
+    {
+        uint16_t bits = 0;
+
+        bfloat16() = default;
+        bfloat16(float value) : bits(detail::float_to_bf16(value)) {}
+        operator float() const { return detail::bf16_to_float(bits); }
+
+        static bfloat16 from_bits(uint16_t b)
+        {
+            bfloat16 h;
+            h.bits = b;
+            return h;
+        }
+
+        bfloat16 &operator+=(float x) { return *this = float(*this) + x; }
+        bfloat16 &operator-=(float x) { return *this = float(*this) - x; }
+        bfloat16 &operator*=(float x) { return *this = float(*this) * x; }
+        bfloat16 &operator/=(float x) { return *this = float(*this) / x; }
+    };
+
+    /// IEEE 754 binary16: 11-bit significand, largest finite value 65504.
+    struct float16
+    {
+        uint16_t bits = 0;
+
+        float16() = default;
+        float16(float value) : bits(detail::float_to_fp16(value)) {}
+        operator float() const { return detail::fp16_to_float(bits); }
+
+        static float16 from_bits(uint16_t b)
+        {
+            float16 h;
+            h.bits = b;
+            return h;
+        }
+
+        float16 &operator+=(float x) { return *this = float(*this) + x; }
+        float16 &operator-=(float x) { return *this = float(*this) - x; }
+        float16 &operator*=(float x) { return *this = float(*this) * x; }
+        float16 &operator/=(float x) { return *this = float(*this) / x; }
+    };
+
+    template <typename T>
+    struct is_reduced_precision : std::false_type
+    {
+    };
+    template <>
+    struct is_reduced_precision<bfloat16> : std::true_type
+    {
+    };
+    template <>
+    struct is_reduced_precision<float16> : std::true_type
+    {
+    };
+
+    template <typename T>
+    constexpr bool is_reduced_precision_v = is_reduced_precision<T>::value;
+
+    /// Type to accumulate sums of T in: fp32 for the 16-bit types, T itself otherwise.
+    template <typename T>
+    using accumulate_t = std::conditional_t<is_reduced_precision_v<T>, float, T>;
+}
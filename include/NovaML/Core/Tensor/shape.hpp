@@ -0,0 +1,295 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <sstream>
+#include <stdexcept>
+#include <cstddef>
+#include <algorithm>
+
+namespace NovaML::Core
+{
+    using Shape = std::vector<size_t>;
+
+    inline size_t numel(const Shape &shape)
+    {
+        size_t n = 1;
+        for (auto d : shape)
+            n *= d;
+        return n;
+    }
+
+    /// Row-major strides for a densely packed tensor of the given shape.
+    inline Shape contiguous_strides(const Shape &shape)
+    {
+        Shape strides(shape.size(), 1);
+        for (size_t i = shape.size(); i-- > 1;)
+            strides[i - 1] = strides[i] * shape[i];
+        return strides;
+    }
+
+    inline std::string shape_to_string(const Shape &shape)
+    {
+        std::ostringstream oss;
+        oss << "(";
+        for (size_t i = 0; i < shape.size(); i++)
+        {
+            oss << shape[i];
+            if (i + 1 < shape.size())
+                oss << ", ";
+        }
+        oss << ")";
+        return oss.str();
+    }
+
+    /**
+     * @brief Maps logical (row-major) element indices onto a flat buffer.
+     *
+     * A layout is the pure index arithmetic behind a tensor: the same
+     * transform can be applied to the data layout of a view and to the
+     * contiguous layout of its base, which is how view gradients are routed.
+     */
+    struct Layout
+    {
+        Shape shape;
+        Shape strides;
+        size_t offset = 0;
+
+        static Layout contiguous(const Shape &shape) { return {shape, contiguous_strides(shape), 0}; }
+
+        size_t numel() const { return NovaML::Core::numel(shape); }
+        size_t ndim() const { return shape.size(); }
+
+        bool operator==(const Layout &other) const
+        {
+            return shape == other.shape && strides == other.strides && offset == other.offset;
+        }
+        bool operator!=(const Layout &other) const { return !(*this == other); }
+
+        bool is_contiguous() const
+        {
+            size_t expected = 1;
+            for (size_t i = shape.size(); i-- > 0;)
+            {
+                if (shape[i] != 1 && strides[i] != expected)
+                    return false;
+                expected *= shape[i];
+            }
+            return true;
+        }
+
+        /// Buffer position of the i-th element in row-major order.
+        size_t offset_of(size_t i) const
+        {
+            size_t pos = offset;
+            for (size_t d = shape.size(); d-- > 0;)
+            {
+                pos += (i % shape[d]) * strides[d];
+                i /= shape[d];
+            }
+            return pos;
+        }
+
+        /// Calls fn(i, pos) for every element in row-major order without per-element division.
+        template <typename F>
+        void for_each(F &&fn) const
+        {
+            for_each_range(0, numel(), fn);
+        }
+
+        /// Same as for_each, restricted to logical elements [begin, end).
+        template <typename F>
+        void for_each_range(size_t begin, size_t end, F &&fn) const
+        {
+            if (end <= begin)
+                return;
+            if (is_contiguous())
+            {
+                for (size_t i = begin; i < end; i++)
+                    fn(i, offset + i);
+                return;
+            }
+            Shape index(shape.size(), 0);
+            size_t pos = offset;
+            for (size_t d = shape.size(), rem = begin; d-- > 0;)
+            {
+                index[d] = rem % shape[d];
+                pos += index[d] * strides[d];
+                rem /= shape[d];
+            }
+            for (size_t i = begin; i < end; i++)
+            {
+                fn(i, pos);
+                for (size_t d = shape.size(); d-- > 0;)
+                {
+                    pos += strides[d];
+                    if (++index[d] < shape[d])
+                        break;
+                    pos -= strides[d] * shape[d];
+                    index[d] = 0;
+                }
+            }
+        }
+    };
+
+    /**
+     * @brief Walk two layouts of the same shape in lockstep over logical elements [begin, end).
+     *
+     * Calls fn(i, pos_a, pos_b) with the buffer position of element i in
+     * each layout; used to combine strided or broadcast (stride 0) operands
+     * without materializing them.
+     */
+    template <typename F>
+    void for_each_zip(const Layout &a, const Layout &b, size_t begin, size_t end, F &&fn)
+    {
+        if (end <= begin)
+            return;
+        const size_t nd = a.ndim();
+        Shape index(nd, 0);
+        size_t pa = a.offset, pb = b.offset;
+        for (size_t d = nd, rem = begin; d-- > 0;)
+        {
+            index[d] = rem % a.shape[d];
+            pa += index[d] * a.strides[d];
+            pb += index[d] * b.strides[d];
+            rem /= a.shape[d];
+        }
+        const size_t inner = nd ? a.shape[nd - 1] : 1;
+        const size_t sa = nd ? a.strides[nd - 1] : 0, sb = nd ? b.strides[nd - 1] : 0;
+        size_t i = begin;
+        while (i < end)
+        {
+            // Innermost dimension as a tight loop, then carry into the outer ones.
+            size_t run = std::min(end - i, inner - (nd ? index[nd - 1] : 0));
+            for (size_t k = 0; k < run; k++)
+                fn(i + k, pa + k * sa, pb + k * sb);
+            i += run;
+            if (nd == 0 || i >= end)
+                break;
+            pa += run * sa;
+            pb += run * sb;
+            index[nd - 1] += run;
+            for (size_t d = nd; d-- > 0;)
+            {
+                if (index[d] < a.shape[d])
+                    break;
+                pa -= a.strides[d] * a.shape[d];
+                pb -= b.strides[d] * b.shape[d];
+                index[d] = 0;
+                if (d == 0)
+                    break;
+                index[d - 1]++;
+                pa += a.strides[d - 1];
+                pb += b.strides[d - 1];
+            }
+        }
+    }
+
+    // -------------------------
+    // Broadcasting (NumPy rules): dimensions are aligned from the right and
+    // must be equal or 1; missing leading dimensions count as 1.
+    // -------------------------
+    inline Shape broadcast_shapes(const Shape &a, const Shape &b)
+    {
+        Shape out(std::max(a.size(), b.size()), 1);
+        for (size_t k = 0; k < out.size(); k++)
+        {
+            size_t da = k < a.size() ? a[a.size() - 1 - k] : 1;
+            size_t db = k < b.size() ? b[b.size() - 1 - k] : 1;
+            if (da != db && da != 1 && db != 1)
+                throw std::invalid_argument("broadcast: shapes " + shape_to_string(a) + " and " +
+                                            shape_to_string(b) + " are not compatible");
+            out[out.size() - 1 - k] = da == 1 ? db : da;
+        }
+        return out;
+    }
+
+    /// Whether `src` broadcasts to exactly `shape` (without growing `shape`).
+    inline bool broadcastable_to(const Shape &src, const Shape &shape)
+    {
+        if (src.size() > shape.size())
+            return false;
+        const size_t lead = shape.size() - src.size();
+        for (size_t d = 0; d < src.size(); d++)
+            if (src[d] != shape[lead + d] && src[d] != 1)
+                return false;
+        return true;
+    }
+
+    // -------------------------
+    // Layout transforms shared by all view operations
+    // -------------------------
+    /// View `src` as `shape` by giving broadcast dimensions a stride of 0.
+    inline Layout expand_layout(const Layout &src, const Shape &shape)
+    {
+        if (!broadcastable_to(src.shape, shape))
+            throw std::invalid_argument("expand: cannot expand " + shape_to_string(src.shape) + " to " + shape_to_string(shape));
+        Layout out{shape, Shape(shape.size(), 0), src.offset};
+        const size_t lead = shape.size() - src.ndim();
+        for (size_t d = 0; d < src.ndim(); d++)
+            if (src.shape[d] == shape[lead + d])
+                out.strides[lead + d] = src.strides[d];
+        return out;
+    }
+
+    inline Layout view_layout(const Layout &src, const Shape &shape)
+    {
+        if (!src.is_contiguous())
+            throw std::invalid_argument("view: tensor is not contiguous, use reshape");
+        if (numel(shape) != src.numel())
+            throw std::invalid_argument("view: cannot view " + shape_to_string(src.shape) + " as " + shape_to_string(shape));
+        return {shape, contiguous_strides(shape), src.offset};
+    }
+
+    inline Layout transpose_layout(const Layout &src, size_t dim0, size_t dim1)
+    {
+        if (dim0 >= src.ndim() || dim1 >= src.ndim())
+            throw std::out_of_range("transpose: dimension out of range");
+        Layout out = src;
+        std::swap(out.shape[dim0], out.shape[dim1]);
+        std::swap(out.strides[dim0], out.strides[dim1]);
+        return out;
+    }
+
+    inline Layout slice_layout(const Layout &src, size_t dim, size_t start, size_t end, size_t step)
+    {
+        if (dim >= src.ndim())
+            throw std::out_of_range("slice: dimension out of range");
+        if (step == 0)
+            throw std::invalid_argument("slice: step must be positive");
+        end = std::min(end, src.shape[dim]);
+        start = std::min(start, end);
+        Layout out = src;
+        out.offset += start * src.strides[dim];
+        out.shape[dim] = (end - start + step - 1) / step;
+        out.strides[dim] *= step;
+        return out;
+    }
+
+    inline Layout squeeze_layout(const Layout &src, long dim = -1)
+    {
+        if (dim >= static_cast<long>(src.ndim()))
+            throw std::out_of_range("squeeze: dimension out of range");
+        Layout out{{}, {}, src.offset};
+        for (size_t d = 0; d < src.ndim(); d++)
+        {
+            bool drop = src.shape[d] == 1 && (dim < 0 || static_cast<size_t>(dim) == d);
+            if (!drop)
+            {
+                out.shape.push_back(src.shape[d]);
+                out.strides.push_back(src.strides[d]);
+            }
+        }
+        return out;
+    }
+
+    inline Layout unsqueeze_layout(const Layout &src, size_t dim)
+    {
+        if (dim > src.ndim())
+            throw std::out_of_range("unsqueeze: dimension out of range");
+        Layout out = src;
+        size_t stride = dim < src.ndim() ? src.strides[dim] * src.shape[dim] : 1;
+        out.shape.insert(out.shape.begin() + dim, 1);
+        out.strides.insert(out.strides.begin() + dim, stride);
+        return out;
+    }
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include <vector>
+#include <cstddef>
+#include "../../Memory/allocator.hpp"
+
+namespace NovaML::Core
+{
+    using Memory::Buffer;
+
+    /**
+     * @brief Contiguous element buffer shared by a tensor and all of its views.
+     *
+     * Always held through std::shared_ptr; views keep the storage alive.
+     * Memory comes from the NovaML allocator (see Memory/allocator.hpp), so
+     * buffers freed by one iteration are reused by the next.
+     *
+     * The version counter is bumped by every in-place write, through any
+     * view, so autograd can tell when a value it saved has been overwritten.
+     */
+    template <typename T>
+    class Storage
+    {
+    public:
+        explicit Storage(size_t size) : buffer(size, T(0)) {}
+        explicit Storage(const std::vector<T> &values) : buffer(values.begin(), values.end()) {}
+        explicit Storage(Buffer<T> values) : buffer(std::move(values)) {}
+
+        T *data() { return buffer.data(); }
+        const T *data() const { return buffer.data(); }
+        size_t size() const { return buffer.size(); }
+
+        T &operator[](size_t i) { return buffer[i]; }
+        const T &operator[](size_t i) const { return buffer[i]; }
+
+        size_t version() const { return version_counter; }
+        void bump_version() { ++version_counter; }
+
+    private:
+        Buffer<T> buffer;
+        size_t version_counter = 0;
+    };
+}
@@ -1,13 +1,27 @@
 #pragma once
 #include <vector>
+#include <memory>
+#include <type_traits>
 #include "utils.hpp"
+#include "shape.hpp"
+#include "storage.hpp"
+#include "half.hpp"
+#include "../../Profiler/profiler.hpp"
 #include "autograd.hpp"
 #include "tensor_ops.hpp"
+#include "tensor_view.hpp"
+#include "tensor_inplace.hpp"
 
 namespace NovaML::Core
 {
     /**
-     * @brief A simple Tensor class that supports automatic differentiation.
+     * @brief A strided N-dimensional Tensor that supports automatic differentiation.
+     *
+     * Elements live in a refcounted Storage; the tensor itself is a shape,
+     * strides and offset into it. Views (reshape, transpose, slice, ...)
+     * share the storage of their base, and so do copies of a Tensor object.
+     * Gradients are kept densely in row-major order of `shape()` and are
+     * only allocated once a gradient actually reaches the tensor.
      *
      * @tparam T Data type of elements (default: float).
      */
@@ -25,75 +39,194 @@ namespace NovaML::Core
          * @param requires_grad Whether this tensor should track gradients (default: false).
          */
         Tensor(size_t size, bool requires_grad = false)
-            : data(size, T(0)), // tensor data initialized to 0
-              grad(size, T(0)), // gradient vector initialized to 0
-              requires_grad(requires_grad)
+            : Tensor(std::make_shared<Storage<T>>(size), Layout::contiguous(Shape{size}), requires_grad) {}
+
+        Tensor(std::vector<T> vec, bool requires_grad = false)
+            : Tensor(std::move(vec), Shape{0}, requires_grad, true) {}
+
+        /**
+         * @brief Construct a tensor of the given shape from row-major values.
+         */
+        Tensor(std::vector<T> vec, const Shape &shape, bool requires_grad = false)
+            : Tensor(std::move(vec), shape, requires_grad, false) {}
+
+        /**
+         * @brief Construct a view over existing storage (no copy).
+         */
+        Tensor(std::shared_ptr<Storage<T>> storage, const Layout &layout, bool requires_grad = false)
+            : storage(std::move(storage)), layout(layout), contiguous(layout.is_contiguous()),
+              count(layout.numel()), requires_grad(requires_grad) {}
+
+        static Tensor zeros(const Shape &shape, bool requires_grad = false)
         {
-        } ///< Initialize vector with zeros
+            return Tensor(std::make_shared<Storage<T>>(numel(shape)), Layout::contiguous(shape), requires_grad);
+        }
+
+        Tensor(const Tensor &) = default;
+        Tensor(Tensor &&) = default;
+        Tensor &operator=(const Tensor &) = default;
+        Tensor &operator=(Tensor &&) = default;
 
-        Tensor(const std::vector<T> &vec, bool requires_grad = false)
-            : data(vec), grad(vec.size(), T(0)), requires_grad(requires_grad) {}
         /**
-         * @brief Access
+         * @brief Release the graph behind this tensor iteratively.
+         *
+         * Parents owned only by this graph are unlinked one at a time, so
+         * dropping a very deep graph does not recurse once per node.
          */
-        T &operator[](size_t i) { return data[i]; }
-        const T &operator[](size_t i) const { return data[i]; }
+        ~Tensor()
+        {
+            std::vector<std::shared_ptr<Tensor<T>>> pending;
+            release_edges(edges, fused_backward, pending);
+            while (!pending.empty())
+            {
+                auto node = std::move(pending.back());
+                pending.pop_back();
+                release_edges(node->edges, node->fused_backward, pending);
+            }
+        }
+        /**
+         * @brief Access by logical (row-major) element index.
+         */
+        T &operator[](size_t i) { return (*storage)[position(i)]; }
+        const T &operator[](size_t i) const { return (*storage)[position(i)]; }
 
-        const std::vector<T> &get_data() const { return data; }
-        const std::vector<T> &get_grad() const { return grad; }
+        /// Row-major copy of the elements.
+        std::vector<T> get_data() const
+        {
+            if (contiguous)
+                return std::vector<T>(data_ptr(), data_ptr() + size());
+            std::vector<T> values(size());
+            layout.for_each([&](size_t i, size_t pos)
+                            { values[i] = (*storage)[pos]; });
+            return values;
+        }
+        /// Accumulated gradient; empty until a gradient has reached this tensor.
+        const Buffer<T> &get_grad() const { return grad; }
+        bool has_grad() const { return !grad.empty(); }
         const bool get_requires_grad() const { return requires_grad; }
 
-        size_t size() const { return data.size(); }
-        T at(size_t i) const { return data[i]; }
+        size_t size() const { return count; }
+        T at(size_t i) const { return (*storage)[position(i)]; }
         void set_grad_fn_name(const std::string &name) { grad_fn_name = name; }
+        const std::string &get_grad_fn_name() const { return grad_fn_name; }
+
+        // -------------------------
+        // Layout
+        // -------------------------
+        const Shape &shape() const { return layout.shape; }
+        const Shape &strides() const { return layout.strides; }
+        size_t offset() const { return layout.offset; }
+        size_t ndim() const { return layout.ndim(); }
+        size_t dim(size_t d) const { return layout.shape.at(d); }
+        bool is_contiguous() const { return contiguous; }
+        const Layout &get_layout() const { return layout; }
+        const std::shared_ptr<Storage<T>> &get_storage() const { return storage; }
+
+        /// Number of in-place writes to the underlying storage (shared with views).
+        size_t version() const { return storage->version(); }
+        void bump_version() { storage->bump_version(); }
+
+        /// Pointer to the first element; only dense when is_contiguous().
+        T *data_ptr() { return storage->data() + layout.offset; }
+        const T *data_ptr() const { return storage->data() + layout.offset; }
 
         void zero_grad()
         {
             std::fill(grad.begin(), grad.end(), T(0));
             edges.clear();
+            fused_backward = nullptr;
         }
 
-        void accumulate_grad(const std::vector<T> &g)
+        void accumulate_grad(const Buffer<T> &g)
         {
-            check_size_match(grad, g, "accumulate_grad: gradient size mismatch");
+            if (g.size() != count)
+                throw std::invalid_argument("accumulate_grad: gradient size mismatch");
+            if (grad.empty())
+            {
+                grad = g;
+                return;
+            }
             for (size_t i = 0; i < grad.size(); i++)
             {
                 grad[i] += g[i];
             }
         }
 
+        /// Replace the gradient with `g`, handing the previous buffer back in `g` (no copy).
+        void swap_grad(Buffer<T> &g)
+        {
+            if (g.size() != count)
+                throw std::invalid_argument("swap_grad: gradient size mismatch");
+            grad.swap(g);
+        }
+
+        /// Like accumulate_grad, but adopts `g` as the gradient buffer when none exists yet.
+        void accumulate_grad(Buffer<T> &&g)
+        {
+            if (grad.empty() && g.size() == count)
+                grad = std::move(g);
+            else
+                accumulate_grad(static_cast<const Buffer<T> &>(g));
+        }
+
+        /// Record an input of the op that produced this tensor (ignored while grad mode is off).
         void add_edge(const Edge<T> &edge)
         {
-            edges.push_back(edge);
+            if (GradMode::is_enabled())
+                edges.push_back(edge);
+        }
+
+        const std::vector<Edge<T>> &get_edges() const { return edges; }
+
+        /// Replace the per-edge backward functions with one pass over all inputs.
+        void set_fused_backward(FusedBackward<T> fn)
+        {
+            if (GradMode::is_enabled())
+                fused_backward = std::move(fn);
         }
 
+        const FusedBackward<T> &get_fused_backward() const { return fused_backward; }
+
+        /**
+         * @brief Backpropagate from this tensor.
+         *
+         * The reachable graph is linearized onto a GradTape and every node is
+         * processed once, in reverse topological order, after the gradients
+         * from all of its consumers have been summed.
+         */
         void backward(const std::vector<T> &grad_output = {})
         {
             if (!requires_grad)
                 return;
-            std::vector<T> g = grad_output.empty() ? std::vector<T>(data.size(), 1) : grad_output;
-            accumulate_grad(g);
-            for (auto &edge : edges)
-                edge.backward_fn(g);
+            if (GraphRecorder::active())
+                throw std::runtime_error("backward: Graph::capture runs the backward pass itself");
+            Profiler::RecordScope scope("backward", Profiler::Category::Backward);
+            Buffer<T> g = grad_output.empty() ? Buffer<T>(size(), T(1)) : Buffer<T>(grad_output.begin(), grad_output.end());
+            if (g.size() != count)
+                throw std::invalid_argument("backward: gradient size mismatch");
+            GradTape<T>::record(this).run(std::move(g));
         }
 
         friend std::ostream &operator<<(std::ostream &os, const Tensor<T> &t)
         {
             os << "Tensor(data=[";
-            for (size_t i = 0; i < t.data.size(); i++)
+            for (size_t i = 0; i < t.size(); i++)
             {
-                os << t.data[i];
-                if (i != t.data.size() - 1)
+                os << t.at(i);
+                if (i != t.size() - 1)
                     os << ", ";
             }
             os << "], grad=[";
-            for (size_t i = 0; i < t.grad.size(); i++)
+            for (size_t i = 0; i < t.size(); i++)
             {
-                os << t.grad[i];
-                if (i != t.grad.size() - 1)
+                os << (t.grad.empty() ? T(0) : t.grad[i]);
+                if (i != t.size() - 1)
                     os << ", ";
             }
-            os << "], requires_grad=" << (t.requires_grad ? "true" : "false");
+            os << "]";
+            if (t.ndim() != 1)
+                os << ", shape=" << shape_to_string(t.shape());
+            os << ", requires_grad=" << (t.requires_grad ? "true" : "false");
             if (!t.grad_fn_name.empty())
                 os << ", grad_fn=" << t.grad_fn_name;
             os << ")";
@@ -101,13 +234,52 @@ namespace NovaML::Core
         }
 
     private:
-        std::vector<T> data;        ///< Stores tensor values
-        std::vector<T> grad;        ///< Gradient values (same size as data)
+        Tensor(std::vector<T> vec, Shape shape, bool requires_grad, bool flat)
+        {
+            if (flat)
+                shape = Shape{vec.size()};
+            if (numel(shape) != vec.size())
+                throw std::invalid_argument("Tensor: " + std::to_string(vec.size()) +
+                                            " values do not fill shape " + shape_to_string(shape));
+            this->storage = std::make_shared<Storage<T>>(vec);
+            this->layout = Layout::contiguous(shape);
+            this->contiguous = true;
+            this->count = layout.numel();
+            this->requires_grad = requires_grad;
+        }
+
+        size_t position(size_t i) const { return contiguous ? layout.offset + i : layout.offset_of(i); }
+
+        static void release_edges(std::vector<Edge<T>> &edge_list, FusedBackward<T> &fused,
+                                  std::vector<std::shared_ptr<Tensor<T>>> &pending)
+        {
+            std::vector<std::shared_ptr<Tensor<T>>> parents;
+            for (auto &edge : edge_list)
+                parents.push_back(std::move(edge.parent));
+            edge_list.clear(); // drops closure captures as well
+            fused = nullptr;
+            for (auto &parent : parents)
+                if (parent && parent.use_count() == 1)
+                    pending.push_back(std::move(parent));
+        }
+
+        std::shared_ptr<Storage<T>> storage; ///< Stores tensor values, shared with views
+        Layout layout;                       ///< Shape, strides and offset into storage
+        bool contiguous = true;              ///< Cached layout.is_contiguous()
+        size_t count = 0;                    ///< Number of elements (layout.numel())
+        Buffer<T> grad;                      ///< Gradient values (row-major); empty until first accumulated
         std::vector<Edge<T>> edges; ///< Computational graph edges (for autograd)
+        FusedBackward<T> fused_backward; ///< Set by fused kernels instead of per-edge backward_fn
         bool requires_grad;         ///< Flag to enable/disable gradient tracking
         std::string grad_fn_name = "";
     };
 
+    // The module layer (Module, Layer, Activation, Loss) refers to tensors through this namespace.
+    namespace TensorModule
+    {
+        using NovaML::Core::Tensor;
+    }
+
     // Friend operators
     template <typename T>
     std::shared_ptr<Tensor<T>> operator+(const std::shared_ptr<Tensor<T>> &a, const std::shared_ptr<Tensor<T>> &b) { return add(a, b); }
@@ -124,28 +296,28 @@ namespace NovaML::Core
 
 
     // Tensor-Scalar
-    template <typename T, typename U>
+    template <typename T, typename U, std::enable_if_t<std::is_arithmetic_v<U>, int> = 0>
     std::shared_ptr<Tensor<T>> operator+(const std::shared_ptr<Tensor<T>> &a, const U &scalar) { return add_scalar(a, static_cast<T>(scalar)); }
 
-    template <typename T, typename U>
+    template <typename T, typename U, std::enable_if_t<std::is_arithmetic_v<U>, int> = 0>
     std::shared_ptr<Tensor<T>> operator+(const U &scalar, const std::shared_ptr<Tensor<T>> &a) { return add_scalar(a, static_cast<T>(scalar)); }
 
-    template <typename T, typename U>
+    template <typename T, typename U, std::enable_if_t<std::is_arithmetic_v<U>, int> = 0>
     std::shared_ptr<Tensor<T>> operator-(const std::shared_ptr<Tensor<T>> &a, const U &scalar) { return sub_scalar(a, static_cast<T>(scalar)); }
 
-    template <typename T, typename U>
+    template <typename T, typename U, std::enable_if_t<std::is_arithmetic_v<U>, int> = 0>
     std::shared_ptr<Tensor<T>> operator-(const U &scalar, const std::shared_ptr<Tensor<T>> &a) { return rsub_scalar(static_cast<T>(scalar), a); }
 
-    template <typename T, typename U>
+    template <typename T, typename U, std::enable_if_t<std::is_arithmetic_v<U>, int> = 0>
     std::shared_ptr<Tensor<T>> operator*(const std::shared_ptr<Tensor<T>> &a, const U &scalar) { return mul_scalar(a, static_cast<T>(scalar)); }
 
-    template <typename T, typename U>
+    template <typename T, typename U, std::enable_if_t<std::is_arithmetic_v<U>, int> = 0>
     std::shared_ptr<Tensor<T>> operator*(const U &scalar, const std::shared_ptr<Tensor<T>> &a) { return rmul_scalar(static_cast<T>(scalar), a); }
 
-    template <typename T, typename U>
+    template <typename T, typename U, std::enable_if_t<std::is_arithmetic_v<U>, int> = 0>
     std::shared_ptr<Tensor<T>> operator/(const std::shared_ptr<Tensor<T>> &a, const U &scalar) { return div_scalar(a, static_cast<T>(scalar)); }
 
-    template <typename T, typename U>
+    template <typename T, typename U, std::enable_if_t<std::is_arithmetic_v<U>, int> = 0>
     std::shared_ptr<Tensor<T>> operator/(const U &scalar, const std::shared_ptr<Tensor<T>> &a) { return rdiv_scalar(static_cast<T>(scalar), a); }
 
 }
\ No newline at end of file
@@ -0,0 +1,279 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include "tensor.hpp"
+#include "../Kernel/vmath.hpp"
+
+namespace NovaML::Core
+{
+    // -------------------------
+    // In-place variants (trailing underscore): write into the existing
+    // storage instead of allocating a result.
+    //
+    // They never record autograd history. Updating a tensor that takes part
+    // in a recorded graph is refused while grad mode is on; run parameter
+    // updates under a NoGradGuard. Every write bumps the storage version, so
+    // a backward pass that saved the old values raises instead of silently
+    // using the new ones. A view where several elements share one storage
+    // slot (an expand()ed tensor) cannot be written in place; copy it with
+    // contiguous() first.
+    // -------------------------
+    template <typename T>
+    void check_inplace(const std::string &op, const Tensor<T> &a, const Tensor<T> *b = nullptr)
+    {
+        if (GraphRecorder::active())
+            throw std::runtime_error(op + ": in-place ops cannot be captured in a Graph");
+        const Layout &layout = a.get_layout();
+        for (size_t d = 0; d < layout.shape.size(); d++)
+            if (layout.strides[d] == 0 && layout.shape[d] > 1)
+                throw std::invalid_argument(op + ": more than one element of the written-to tensor "
+                                                 "refers to a single memory location; call contiguous() first");
+        if (GradMode::is_enabled() && (a.get_requires_grad() || (b && b->get_requires_grad())))
+            throw std::runtime_error(op + ": in-place update of a tensor that requires grad; "
+                                          "use the out-of-place op or a NoGradGuard");
+        if (b && b->shape() != a.shape() && !broadcastable_to(b->shape(), a.shape()))
+            throw std::invalid_argument(op + ": shape " + shape_to_string(b->shape()) +
+                                        " cannot be broadcast to " + shape_to_string(a.shape()));
+    }
+
+    /// Apply f(i, element&) to every element of `a` in row-major order, then bump its version.
+    template <typename T, typename F>
+    void update_elements(Tensor<T> &a, F f)
+    {
+        const size_t n = a.size();
+        if (a.is_contiguous())
+        {
+            T *p = a.data_ptr();
+            parallel_elements(n, [&](size_t i)
+                              { f(i, p[i]); });
+        }
+        else
+        {
+            T *base = a.get_storage()->data();
+            Parallel::parallel_for(0, n, Parallel::elementwise_grain, [&](size_t begin, size_t end)
+                                   { a.get_layout().for_each_range(begin, end, [&](size_t i, size_t pos)
+                                                                   { f(i, base[pos]); }); });
+        }
+        a.bump_version();
+    }
+
+    /// Combine `a` element-wise with `b` in place: a[i] = f(a[i], b[i]); `b` may broadcast to `a`.
+    template <typename T, typename F>
+    void update_with(Tensor<T> &a, const Tensor<T> &b, F f)
+    {
+        if (b.shape() != a.shape())
+        {
+            Tensor<T> expanded(b.get_storage(), expand_layout(b.get_layout(), a.shape()));
+            update_with(a, expanded, f);
+            return;
+        }
+        // A differently laid out view of the same storage would be read after
+        // being overwritten; snapshot it first.
+        if (a.get_storage() == b.get_storage() && a.get_layout() != b.get_layout())
+        {
+            Tensor<T> copy(b.get_data(), b.shape());
+            update_with(a, copy, f);
+            return;
+        }
+        if (b.is_contiguous())
+        {
+            const T *pb = b.data_ptr();
+            update_elements(a, [&](size_t i, T &x)
+                            { x = f(x, pb[i]); });
+        }
+        else
+        {
+            const T *base = b.get_storage()->data();
+            const Layout &lb = b.get_layout();
+            if (a.is_contiguous())
+            {
+                T *pa = a.data_ptr();
+                Parallel::parallel_for(0, a.size(), Parallel::elementwise_grain, [&](size_t begin, size_t end)
+                                       { lb.for_each_range(begin, end, [&](size_t i, size_t pos)
+                                                           { pa[i] = f(pa[i], base[pos]); }); });
+            }
+            else
+            {
+                T *base_a = a.get_storage()->data();
+                Parallel::parallel_for(0, a.size(), Parallel::elementwise_grain, [&](size_t begin, size_t end)
+                                       { for_each_zip(a.get_layout(), lb, begin, end, [&](size_t, size_t pa, size_t pb)
+                                                      { base_a[pa] = f(base_a[pa], base[pb]); }); });
+            }
+            a.bump_version();
+        }
+    }
+
+    // -------------------------
+    // Tensor-tensor
+    // -------------------------
+    /// a += alpha * b
+    template <typename T>
+    Tensor<T> &add_(Tensor<T> &a, const Tensor<T> &b, T alpha = T(1))
+    {
+        check_inplace("add_", a, &b);
+        if (alpha == T(1))
+            update_with(a, b, [](T x, T y)
+                        { return x + y; });
+        else
+            update_with(a, b, [alpha](T x, T y)
+                        { return x + alpha * y; });
+        return a;
+    }
+
+    template <typename T>
+    Tensor<T> &sub_(Tensor<T> &a, const Tensor<T> &b)
+    {
+        check_inplace("sub_", a, &b);
+        update_with(a, b, [](T x, T y)
+                    { return x - y; });
+        return a;
+    }
+
+    template <typename T>
+    Tensor<T> &mul_(Tensor<T> &a, const Tensor<T> &b)
+    {
+        check_inplace("mul_", a, &b);
+        update_with(a, b, [](T x, T y)
+                    { return x * y; });
+        return a;
+    }
+
+    template <typename T>
+    Tensor<T> &div_(Tensor<T> &a, const Tensor<T> &b)
+    {
+        check_inplace("div_", a, &b);
+        update_with(a, b, [](T x, T y)
+                    { return x / y; });
+        return a;
+    }
+
+    /// Overwrite the elements of `a` with those of `src` (broadcast to `a`'s shape).
+    template <typename T>
+    Tensor<T> &copy_(Tensor<T> &a, const Tensor<T> &src)
+    {
+        check_inplace("copy_", a, &src);
+        update_with(a, src, [](T, T y)
+                    { return y; });
+        return a;
+    }
+
+    // -------------------------
+    // Tensor-scalar and unary
+    // -------------------------
+    template <typename T>
+    Tensor<T> &add_scalar_(Tensor<T> &a, T scalar)
+    {
+        check_inplace("add_scalar_", a);
+        update_elements(a, [scalar](size_t, T &x)
+                        { x += scalar; });
+        return a;
+    }
+
+    template <typename T>
+    Tensor<T> &mul_scalar_(Tensor<T> &a, T scalar)
+    {
+        check_inplace("mul_scalar_", a);
+        update_elements(a, [scalar](size_t, T &x)
+                        { x *= scalar; });
+        return a;
+    }
+
+    template <typename T>
+    Tensor<T> &fill_(Tensor<T> &a, T value)
+    {
+        check_inplace("fill_", a);
+        update_elements(a, [value](size_t, T &x)
+                        { x = value; });
+        return a;
+    }
+
+    template <typename T>
+    Tensor<T> &zero_(Tensor<T> &a) { return fill_(a, T(0)); }
+
+    template <typename T>
+    Tensor<T> &clamp_(Tensor<T> &a, T lo, T hi)
+    {
+        if (lo > hi)
+            throw std::invalid_argument("clamp_: lower bound exceeds upper bound");
+        check_inplace("clamp_", a);
+        update_elements(a, [lo, hi](size_t, T &x)
+                        { x = std::min(std::max(x, lo), hi); });
+        return a;
+    }
+
+    template <typename T>
+    Tensor<T> &relu_(Tensor<T> &a)
+    {
+        check_inplace("relu_", a);
+        update_elements(a, [](size_t, T &x)
+                        { x = x > T(0) ? x : T(0); });
+        return a;
+    }
+
+    template <typename T>
+    Tensor<T> &sigmoid_(Tensor<T> &a)
+    {
+        check_inplace("sigmoid_", a);
+        if (a.is_contiguous())
+        {
+            T *p = a.data_ptr();
+            Parallel::parallel_for(0, a.size(), Parallel::elementwise_grain, [p](size_t begin, size_t end)
+                                   { Kernel::vsigmoid(end - begin, p + begin, p + begin); });
+            a.bump_version();
+            return a;
+        }
+        update_elements(a, [](size_t, T &x)
+                        { x = T(1) / (T(1) + std::exp(-x)); });
+        return a;
+    }
+
+    template <typename T>
+    Tensor<T> &exp_(Tensor<T> &a)
+    {
+        check_inplace("exp_", a);
+        if (a.is_contiguous())
+        {
+            T *p = a.data_ptr();
+            Parallel::parallel_for(0, a.size(), Parallel::elementwise_grain, [p](size_t begin, size_t end)
+                                   { Kernel::vexp(end - begin, p + begin, p + begin); });
+            a.bump_version();
+            return a;
+        }
+        update_elements(a, [](size_t, T &x)
+                        { x = std::exp(x); });
+        return a;
+    }
+
+    // -------------------------
+    // shared_ptr overloads, matching the out-of-place API
+    // -------------------------
+    template <typename T>
+    std::shared_ptr<Tensor<T>> add_(const std::shared_ptr<Tensor<T>> &a, const std::shared_ptr<Tensor<T>> &b, T alpha = T(1)) { add_(*a, *b, alpha); return a; }
+    template <typename T>
+    std::shared_ptr<Tensor<T>> sub_(const std::shared_ptr<Tensor<T>> &a, const std::shared_ptr<Tensor<T>> &b) { sub_(*a, *b); return a; }
+    template <typename T>
+    std::shared_ptr<Tensor<T>> mul_(const std::shared_ptr<Tensor<T>> &a, const std::shared_ptr<Tensor<T>> &b) { mul_(*a, *b); return a; }
+    template <typename T>
+    std::shared_ptr<Tensor<T>> div_(const std::shared_ptr<Tensor<T>> &a, const std::shared_ptr<Tensor<T>> &b) { div_(*a, *b); return a; }
+    template <typename T>
+    std::shared_ptr<Tensor<T>> copy_(const std::shared_ptr<Tensor<T>> &a, const std::shared_ptr<Tensor<T>> &src) { copy_(*a, *src); return a; }
+    template <typename T>
+    std::shared_ptr<Tensor<T>> add_scalar_(const std::shared_ptr<Tensor<T>> &a, T scalar) { add_scalar_(*a, scalar); return a; }
+    template <typename T>
+    std::shared_ptr<Tensor<T>> mul_scalar_(const std::shared_ptr<Tensor<T>> &a, T scalar) { mul_scalar_(*a, scalar); return a; }
+    template <typename T>
+    std::shared_ptr<Tensor<T>> fill_(const std::shared_ptr<Tensor<T>> &a, T value) { fill_(*a, value); return a; }
+    template <typename T>
+    std::shared_ptr<Tensor<T>> zero_(const std::shared_ptr<Tensor<T>> &a) { zero_(*a); return a; }
+    template <typename T>
+    std::shared_ptr<Tensor<T>> clamp_(const std::shared_ptr<Tensor<T>> &a, T lo, T hi) { clamp_(*a, lo, hi); return a; }
+    template <typename T>
+    std::shared_ptr<Tensor<T>> relu_(const std::shared_ptr<Tensor<T>> &a) { relu_(*a); return a; }
+    template <typename T>
+    std::shared_ptr<Tensor<T>> sigmoid_(const std::shared_ptr<Tensor<T>> &a) { sigmoid_(*a); return a; }
+    template <typename T>
+    std::shared_ptr<Tensor<T>> exp_(const std::shared_ptr<Tensor<T>> &a) { exp_(*a); return a; }
+}
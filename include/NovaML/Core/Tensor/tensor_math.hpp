@@ -5,27 +5,58 @@
 #include "tensor.hpp"
 #include "autograd.hpp"
 #include "utils.hpp"
+#include "tensor_reduce.hpp"
 
 namespace NovaML::Core
 {
+    // -------------------------
+    // Whole-tensor sum, split over the thread pool in fixed-size chunks
+    // (16-bit types accumulate in fp32). Dense chunks are summed pairwise,
+    // strided ones with Kahan compensation.
+    // -------------------------
+    template <typename T>
+    accumulate_t<T> reduce_sum(const Tensor<T> &a)
+    {
+        using Acc = accumulate_t<T>;
+        const T *base = a.get_storage()->data();
+        return Parallel::parallel_reduce(
+            0, a.size(), Parallel::elementwise_grain, Acc(0),
+            [&](size_t begin, size_t end)
+            {
+                if (a.is_contiguous())
+                    return pairwise_sum<Acc>(a.data_ptr() + begin, end - begin);
+                Acc partial = 0, compensation = 0;
+                a.get_layout().for_each_range(begin, end, [&](size_t, size_t pos)
+                                              {
+                                                  const Acc y = Acc(base[pos]) - compensation;
+                                                  const Acc t = partial + y;
+                                                  compensation = (t - partial) - y;
+                                                  partial = t; });
+                return partial;
+            },
+            [](Acc x, Acc y)
+            { return x + y; });
+    }
+
     // -------------------------
     // Sum: reduces a tensor to a scalar
     // -------------------------
     template <typename T>
     std::shared_ptr<Tensor<T>> sum(const std::shared_ptr<Tensor<T>> &a)
     {
-        T result = 0;
-        for (const auto &v : a->get_data())
-            result += v;
+        Profiler::RecordScope scope("sum", Profiler::Category::Op, a->size(), a->size() * sizeof(T));
+        T result = reduce_sum(*a);
 
-        auto out = std::make_shared<Tensor<T>>(std::vector<T>{result}, a->get_requires_grad());
+        auto out = make_result(Buffer<T>(1, result), Shape{1}, a->get_requires_grad());
+        record_step(out, [a](T *o)
+                    { o[0] = T(reduce_sum(*a)); });
 
         if (out->get_requires_grad())
         {
-            out->add_edge({OperatorType::Add, a, [a](const std::vector<T> &grad_output)
+            out->add_edge({OperatorType::Sum, a, [](const Buffer<T> &grad_output, Buffer<T> &grad_input)
                            {
-                               std::vector<T> grad_vec(a->size(), grad_output[0]);
-                               a->backward(grad_vec);
+                               parallel_elements(grad_input.size(), [&](size_t i)
+                                                 { grad_input[i] += grad_output[0]; });
                            }});
             out->set_grad_fn_name("<SumBackward>");
         }
@@ -39,19 +70,20 @@ namespace NovaML::Core
     template <typename T>
     std::shared_ptr<Tensor<T>> mean(const std::shared_ptr<Tensor<T>> &a)
     {
-        T result = 0;
-        for (const auto &v : a->get_data())
-            result += v;
-        result /= a->size();
+        Profiler::RecordScope scope("mean", Profiler::Category::Op, a->size(), a->size() * sizeof(T));
+        T result = T(reduce_sum(*a) / static_cast<accumulate_t<T>>(a->size()));
 
-        auto out = std::make_shared<Tensor<T>>(std::vector<T>{result}, a->get_requires_grad());
+        auto out = make_result(Buffer<T>(1, result), Shape{1}, a->get_requires_grad());
+        record_step(out, [a](T *o)
+                    { o[0] = T(reduce_sum(*a) / static_cast<accumulate_t<T>>(a->size())); });
 
         if (out->get_requires_grad())
         {
-            out->add_edge({OperatorType::MulScalar, a, [a](const std::vector<T> &grad_output)
+            out->add_edge({OperatorType::Mean, a, [](const Buffer<T> &grad_output, Buffer<T> &grad_input)
                            {
-                               std::vector<T> grad_vec(a->size(), grad_output[0] / a->size());
-                               a->backward(grad_vec);
+                               T g_mean = grad_output[0] / static_cast<T>(grad_input.size());
+                               parallel_elements(grad_input.size(), [&](size_t i)
+                                                 { grad_input[i] += g_mean; });
                            }});
             out->set_grad_fn_name("<MeanBackward>");
         }
@@ -65,20 +97,24 @@ namespace NovaML::Core
     template <typename T>
     std::shared_ptr<Tensor<T>> exp(const std::shared_ptr<Tensor<T>> &a)
     {
-        std::vector<T> result(a->size());
-        for (size_t i = 0; i < a->size(); i++)
-            result[i] = std::exp(a->at(i));
+        Profiler::RecordScope scope("exp", Profiler::Category::Op, a->size(), 2.0 * a->size() * sizeof(T));
+        auto kernel = [](size_t n, const T *x, T *y) { Kernel::vexp(n, x, y); };
+        Buffer<T> result = map_kernel(*a, kernel);
 
-        auto out = std::make_shared<Tensor<T>>(result, a->get_requires_grad());
+        auto out = make_result(std::move(result), a->shape(), a->get_requires_grad());
+        record_kernel(out, a, kernel);
 
         if (out->get_requires_grad())
         {
-            out->add_edge({OperatorType::Pow, a, [a, out](const std::vector<T> &grad_output)
+            // Weak reference: the edge is owned by `out`, a strong capture would leak it.
+            std::weak_ptr<Tensor<T>> weak_out = out;
+            const size_t version = out->version();
+            out->add_edge({OperatorType::Exp, a, [weak_out, version](const Buffer<T> &grad_output, Buffer<T> &grad_input)
                            {
-                               std::vector<T> grad_vec(a->size());
-                               for (size_t i = 0; i < a->size(); i++)
-                                   grad_vec[i] = grad_output[i] * out->at(i); // d/dx e^x = e^x
-                               a->backward(grad_vec);
+                               auto result = weak_out.lock();
+                               check_version(*result, version, "<ExpBackward>");
+                               visit_elements(*result, [&](size_t i, T y)
+                                              { grad_input[i] += grad_output[i] * y; }); // d/dx e^x = e^x
                            }});
             out->set_grad_fn_name("<ExpBackward>");
         }
@@ -92,28 +128,88 @@ namespace NovaML::Core
     template <typename T>
     std::shared_ptr<Tensor<T>> log(const std::shared_ptr<Tensor<T>> &a)
     {
-        std::vector<T> result(a->size());
-        for (size_t i = 0; i < a->size(); i++)
+        Profiler::RecordScope scope("log", Profiler::Category::Op, a->size(), 2.0 * a->size() * sizeof(T));
+        // The domain check is one branch-free pass per block, not a branch per element.
+        auto kernel = [](size_t n, const T *x, T *y)
         {
-            if (a->at(i) <= 0)
-                throw std::runtime_error("log: input must be positive");
-            result[i] = std::log(a->at(i));
-        }
+            Parallel::parallel_for(0, n, Parallel::elementwise_grain, [&](size_t begin, size_t end)
+                                   {
+                                       if (!Kernel::all_positive(end - begin, x + begin))
+                                           throw std::runtime_error("log: input must be positive");
+                                       Kernel::vlog(end - begin, x + begin, y + begin); });
+        };
+        Buffer<T> result = map_kernel(*a, kernel);
 
-        auto out = std::make_shared<Tensor<T>>(result, a->get_requires_grad());
+        auto out = make_result(std::move(result), a->shape(), a->get_requires_grad());
+        record_kernel(out, a, kernel);
 
         if (out->get_requires_grad())
         {
-            out->add_edge({OperatorType::Pow, a, [a](const std::vector<T> &grad_output)
+            out->add_edge({OperatorType::Log, a, [a = SavedTensor<T>(a)](const Buffer<T> &grad_output, Buffer<T> &grad_input)
                            {
-                               std::vector<T> grad_vec(a->size());
-                               for (size_t i = 0; i < a->size(); i++)
-                                   grad_vec[i] = grad_output[i] / a->at(i); // d/dx log(x) = 1/x
-                               a->backward(grad_vec);
+                               const Tensor<T> &av = a.unpack("<LogBackward>");
+                               visit_elements(av, [&](size_t i, T x)
+                                              { grad_input[i] += grad_output[i] / x; }); // d/dx log(x) = 1/x
                            }});
             out->set_grad_fn_name("<LogBackward>");
         }
 
+        return out;
+    }
+    // -------------------------
+    // Element-wise tanh and logistic sigmoid; both backwards reuse the output
+    // -------------------------
+    template <typename T>
+    std::shared_ptr<Tensor<T>> tanh(const std::shared_ptr<Tensor<T>> &a)
+    {
+        Profiler::RecordScope scope("tanh", Profiler::Category::Op, a->size(), 2.0 * a->size() * sizeof(T));
+        auto kernel = [](size_t n, const T *x, T *y) { Kernel::vtanh(n, x, y); };
+        Buffer<T> result = map_kernel(*a, kernel);
+
+        auto out = make_result(std::move(result), a->shape(), a->get_requires_grad());
+        record_kernel(out, a, kernel);
+
+        if (out->get_requires_grad())
+        {
+            std::weak_ptr<Tensor<T>> weak_out = out;
+            const size_t version = out->version();
+            out->add_edge({OperatorType::Tanh, a, [weak_out, version](const Buffer<T> &grad_output, Buffer<T> &grad_input)
+                           {
+                               auto result = weak_out.lock();
+                               check_version(*result, version, "<TanhBackward>");
+                               visit_elements(*result, [&](size_t i, T y)
+                                              { grad_input[i] += grad_output[i] * (T(1) - y * y); });
+                           }});
+            out->set_grad_fn_name("<TanhBackward>");
+        }
+
+        return out;
+    }
+
+    template <typename T>
+    std::shared_ptr<Tensor<T>> sigmoid(const std::shared_ptr<Tensor<T>> &a)
+    {
+        Profiler::RecordScope scope("sigmoid", Profiler::Category::Op, a->size(), 2.0 * a->size() * sizeof(T));
+        auto kernel = [](size_t n, const T *x, T *y) { Kernel::vsigmoid(n, x, y); };
+        Buffer<T> result = map_kernel(*a, kernel);
+
+        auto out = make_result(std::move(result), a->shape(), a->get_requires_grad());
+        record_kernel(out, a, kernel);
+
+        if (out->get_requires_grad())
+        {
+            std::weak_ptr<Tensor<T>> weak_out = out;
+            const size_t version = out->version();
+            out->add_edge({OperatorType::Sigmoid, a, [weak_out, version](const Buffer<T> &grad_output, Buffer<T> &grad_input)
+                           {
+                               auto result = weak_out.lock();
+                               check_version(*result, version, "<SigmoidBackward>");
+                               visit_elements(*result, [&](size_t i, T y)
+                                              { grad_input[i] += grad_output[i] * y * (T(1) - y); });
+                           }});
+            out->set_grad_fn_name("<SigmoidBackward>");
+        }
+
         return out;
     }
 }
\ No newline at end of file
@@ -1,50 +1,241 @@
 #pragma once
 #include <memory>
 #include <cmath>
+#include <tuple>
+#include <utility>
 #include "tensor.hpp"
 #include "autograd.hpp"
+#include "../Kernel/vmath.hpp"
+#include "../../Parallel/thread_pool.hpp"
+#include "../../Profiler/profiler.hpp"
 
 namespace NovaML::Core
 {
+    // -------------------------
+    // Element-wise kernels: read (possibly strided) inputs, write a dense row-major result.
+    // Large tensors are split across the intra-op thread pool.
+    // -------------------------
+    template <typename F>
+    void parallel_elements(size_t n, F &&fn)
+    {
+        Parallel::parallel_for(0, n, Parallel::elementwise_grain, [&](size_t begin, size_t end)
+                               {
+                                   for (size_t i = begin; i < end; i++)
+                                       fn(i); });
+    }
+
+    /// Call fn(i, a_i) for every element of `a` in row-major order.
+    template <typename T, typename F>
+    void visit_elements(const Tensor<T> &a, F &&fn)
+    {
+        if (a.is_contiguous())
+        {
+            const T *pa = a.data_ptr();
+            parallel_elements(a.size(), [&](size_t i)
+                              { fn(i, pa[i]); });
+        }
+        else
+        {
+            const T *base = a.get_storage()->data();
+            Parallel::parallel_for(0, a.size(), Parallel::elementwise_grain, [&](size_t begin, size_t end)
+                                   { a.get_layout().for_each_range(begin, end, [&](size_t i, size_t pos)
+                                                                   { fn(i, base[pos]); }); });
+        }
+    }
+
+    /// Call fn(i, a_i, b_i) for every element of two same-shaped tensors (strided or broadcast views allowed).
+    template <typename T, typename F>
+    void visit_elements(const Tensor<T> &a, const Tensor<T> &b, F &&fn)
+    {
+        if (a.is_contiguous() && b.is_contiguous())
+        {
+            const T *pa = a.data_ptr();
+            const T *pb = b.data_ptr();
+            parallel_elements(a.size(), [&](size_t i)
+                              { fn(i, pa[i], pb[i]); });
+        }
+        else
+        {
+            const T *base_a = a.get_storage()->data();
+            const T *base_b = b.get_storage()->data();
+            Parallel::parallel_for(0, a.size(), Parallel::elementwise_grain, [&](size_t begin, size_t end)
+                                   { for_each_zip(a.get_layout(), b.get_layout(), begin, end, [&](size_t i, size_t pa, size_t pb)
+                                                  { fn(i, base_a[pa], base_b[pb]); }); });
+        }
+    }
+
+    template <typename T, typename F>
+    Buffer<T> map_elements(const Tensor<T> &a, F f)
+    {
+        Buffer<T> result(a.size());
+        T *out = result.data();
+        visit_elements(a, [&](size_t i, T x)
+                       { out[i] = f(x); });
+        return result;
+    }
+
+    template <typename T, typename F>
+    Buffer<T> zip_elements(const Tensor<T> &a, const Tensor<T> &b, F f)
+    {
+        Buffer<T> result(a.size());
+        T *out = result.data();
+        visit_elements(a, b, [&](size_t i, T x, T y)
+                       { out[i] = f(x, y); });
+        return result;
+    }
+
+    /**
+     * @brief Write kernel(n, x, y) over the elements of `a` into the dense `out`.
+     *
+     * For array kernels (Kernel::vexp and friends) that vectorize over a
+     * flat input: contiguous tensors feed it directly, strided views are
+     * gathered into `out` first and transformed there in place.
+     */
+    template <typename T, typename K>
+    void apply_kernel(const Tensor<T> &a, T *out, K &&kernel)
+    {
+        if (a.is_contiguous())
+        {
+            kernel(a.size(), a.data_ptr(), out);
+            return;
+        }
+        visit_elements(a, [&](size_t i, T x)
+                       { out[i] = x; });
+        kernel(a.size(), out, out);
+    }
+
+    template <typename T, typename K>
+    Buffer<T> map_kernel(const Tensor<T> &a, K kernel)
+    {
+        Buffer<T> result(a.size());
+        apply_kernel(a, result.data(), kernel);
+        return result;
+    }
+
+    /**
+     * @brief Bring two operands to their common broadcast shape.
+     *
+     * Operands that already have that shape are returned as is; the others
+     * become zero-copy expand() views whose backward sums the gradient over
+     * the broadcast dimensions.
+     */
     template <typename T>
-    std::shared_ptr<Tensor<T>> add(const std::shared_ptr<Tensor<T>> &a, const std::shared_ptr<Tensor<T>> &b)
+    std::pair<std::shared_ptr<Tensor<T>>, std::shared_ptr<Tensor<T>>> broadcast_operands(
+        const std::shared_ptr<Tensor<T>> &a, const std::shared_ptr<Tensor<T>> &b)
     {
-        std::vector<T> result(a->size());
-        for (size_t i = 0; i < result.size(); i++)
-            result[i] = a->at(i) + b->at(i);
+        if (a->shape() == b->shape())
+            return {a, b};
+        Shape shape = broadcast_shapes(a->shape(), b->shape());
+        return {expand(a, shape), expand(b, shape)};
+    }
+
+    /**
+     * @brief Wrap a freshly computed row-major buffer as a contiguous tensor (no copy).
+     *
+     * Op results only track gradients while grad mode is enabled, so under a
+     * NoGradGuard no edge or backward closure is ever built.
+     */
+    template <typename T>
+    std::shared_ptr<Tensor<T>> make_result(Buffer<T> values, const Shape &shape, bool requires_grad)
+    {
+        if (GraphRecorder *recorder = GraphRecorder::active())
+            recorder->count_result();
+        return std::make_shared<Tensor<T>>(std::make_shared<Storage<T>>(std::move(values)),
+                                           Layout::contiguous(shape), requires_grad && GradMode::is_enabled());
+    }
+
+    /**
+     * @brief While a Graph is being captured, record how to recompute `out` in place.
+     *
+     * `step(out_data)` rewrites every element of `out` (dense, row-major)
+     * from the current values of the inputs it captured.
+     */
+    template <typename T, typename Step>
+    void record_step(const std::shared_ptr<Tensor<T>> &out, Step step)
+    {
+        if (GraphRecorder *recorder = GraphRecorder::active())
+            recorder->record([out, step]
+                             { step(out->data_ptr()); });
+    }
 
-        auto out = std::make_shared<Tensor<T>>(result, a->get_requires_grad() || b->get_requires_grad());
+    /// record_step for out = map_elements(a, f).
+    template <typename T, typename F>
+    void record_map(const std::shared_ptr<Tensor<T>> &out, const std::shared_ptr<Tensor<T>> &a, F f)
+    {
+        record_step(out, [a, f](T *o)
+                    { visit_elements(*a, [&](size_t i, T x)
+                                     { o[i] = f(x); }); });
+    }
+
+    /// record_step for out = map_kernel(a, kernel).
+    template <typename T, typename K>
+    void record_kernel(const std::shared_ptr<Tensor<T>> &out, const std::shared_ptr<Tensor<T>> &a, K kernel)
+    {
+        record_step(out, [a, kernel](T *o)
+                    { apply_kernel(*a, o, kernel); });
+    }
+
+    /// record_step for out = zip_elements(a, b, f).
+    template <typename T, typename F>
+    void record_zip(const std::shared_ptr<Tensor<T>> &out, const std::shared_ptr<Tensor<T>> &a,
+                    const std::shared_ptr<Tensor<T>> &b, F f)
+    {
+        record_step(out, [a, b, f](T *o)
+                    { visit_elements(*a, *b, [&](size_t i, T x, T y)
+                                     { o[i] = f(x, y); }); });
+    }
+
+    template <typename T>
+    std::shared_ptr<Tensor<T>> add(const std::shared_ptr<Tensor<T>> &lhs, const std::shared_ptr<Tensor<T>> &rhs)
+    {
+        std::shared_ptr<Tensor<T>> a, b;
+        std::tie(a, b) = broadcast_operands(lhs, rhs);
+        Profiler::RecordScope scope("add", Profiler::Category::Op, a->size(), 3.0 * a->size() * sizeof(T));
+
+        auto f = [](T x, T y) { return x + y; };
+        Buffer<T> result = zip_elements(*a, *b, f);
+
+        auto out = make_result(std::move(result), a->shape(), a->get_requires_grad() || b->get_requires_grad());
+        record_zip(out, a, b, f);
 
         if (out->get_requires_grad())
         {
-            out->add_edge({OperatorType::Add, a, [a, b](const std::vector<T> &grad_output)
-                           {
-                               a->backward(grad_output);
-                               b->backward(grad_output);
-                           }});
+            auto pass = [](const Buffer<T> &grad_output, Buffer<T> &grad_input)
+            {
+                parallel_elements(grad_output.size(), [&](size_t i)
+                                  { grad_input[i] += grad_output[i]; });
+            };
+            out->add_edge({OperatorType::Add, a, pass});
+            out->add_edge({OperatorType::Add, b, pass});
             out->set_grad_fn_name("<AddBackward>");
         }
         return out;
     }
 
     template <typename T>
-    std::shared_ptr<Tensor<T>> sub(const std::shared_ptr<Tensor<T>> &a, const std::shared_ptr<Tensor<T>> &b)
+    std::shared_ptr<Tensor<T>> sub(const std::shared_ptr<Tensor<T>> &lhs, const std::shared_ptr<Tensor<T>> &rhs)
     {
-        std::vector<T> result(a->size());
-        for (size_t i = 0; i < result.size(); i++)
-            result[i] = a->at(i) - b->at(i);
+        std::shared_ptr<Tensor<T>> a, b;
+        std::tie(a, b) = broadcast_operands(lhs, rhs);
+        Profiler::RecordScope scope("sub", Profiler::Category::Op, a->size(), 3.0 * a->size() * sizeof(T));
+
+        auto f = [](T x, T y) { return x - y; };
+        Buffer<T> result = zip_elements(*a, *b, f);
 
-        auto out = std::make_shared<Tensor<T>>(result, a->get_requires_grad() || b->get_requires_grad());
+        auto out = make_result(std::move(result), a->shape(), a->get_requires_grad() || b->get_requires_grad());
+        record_zip(out, a, b, f);
 
         if (out->get_requires_grad())
         {
-            out->add_edge({OperatorType::Sub, a, [a, b](const std::vector<T> &grad_output)
+            out->add_edge({OperatorType::Sub, a, [](const Buffer<T> &grad_output, Buffer<T> &grad_input)
                            {
-                               a->backward(grad_output);
-                               std::vector<T> neg_grad = grad_output;
-                               for (auto &g : neg_grad)
-                                   g = -g;
-                               b->backward(neg_grad);
+                               parallel_elements(grad_output.size(), [&](size_t i)
+                                                 { grad_input[i] += grad_output[i]; });
+                           }});
+            out->add_edge({OperatorType::Sub, b, [](const Buffer<T> &grad_output, Buffer<T> &grad_input)
+                           {
+                               parallel_elements(grad_output.size(), [&](size_t i)
+                                                 { grad_input[i] -= grad_output[i]; });
                            }});
             out->set_grad_fn_name("<SubBackward>");
         }
@@ -52,26 +243,31 @@ namespace NovaML::Core
     }
 
     template <typename T>
-    std::shared_ptr<Tensor<T>> mul(const std::shared_ptr<Tensor<T>> &a, const std::shared_ptr<Tensor<T>> &b)
+    std::shared_ptr<Tensor<T>> mul(const std::shared_ptr<Tensor<T>> &lhs, const std::shared_ptr<Tensor<T>> &rhs)
     {
-        std::vector<T> result(a->size());
-        for (size_t i = 0; i < result.size(); i++)
-            result[i] = a->at(i) * b->at(i);
+        std::shared_ptr<Tensor<T>> a, b;
+        std::tie(a, b) = broadcast_operands(lhs, rhs);
+        Profiler::RecordScope scope("mul", Profiler::Category::Op, a->size(), 3.0 * a->size() * sizeof(T));
 
-        auto out = std::make_shared<Tensor<T>>(result, a->get_requires_grad() || b->get_requires_grad());
+        auto f = [](T x, T y) { return x * y; };
+        Buffer<T> result = zip_elements(*a, *b, f);
+
+        auto out = make_result(std::move(result), a->shape(), a->get_requires_grad() || b->get_requires_grad());
+        record_zip(out, a, b, f);
 
         if (out->get_requires_grad())
         {
-            out->add_edge({OperatorType::Mul, a, [a, b](const std::vector<T> &grad_output)
+            out->add_edge({OperatorType::Mul, a, [b = SavedTensor<T>(b)](const Buffer<T> &grad_output, Buffer<T> &grad_input)
                            {
-                               std::vector<T> grad_a(grad_output.size()), grad_b(grad_output.size());
-                               for (size_t i = 0; i < grad_output.size(); i++)
-                               {
-                                   grad_a[i] = grad_output[i] * b->at(i);
-                                   grad_b[i] = grad_output[i] * a->at(i);
-                               }
-                               a->backward(grad_a);
-                               b->backward(grad_b);
+                               const Tensor<T> &bv = b.unpack("<MulBackward>");
+                               visit_elements(bv, [&](size_t i, T y)
+                                              { grad_input[i] += grad_output[i] * y; });
+                           }});
+            out->add_edge({OperatorType::Mul, b, [a = SavedTensor<T>(a)](const Buffer<T> &grad_output, Buffer<T> &grad_input)
+                           {
+                               const Tensor<T> &av = a.unpack("<MulBackward>");
+                               visit_elements(av, [&](size_t i, T x)
+                                              { grad_input[i] += grad_output[i] * x; });
                            }});
             out->set_grad_fn_name("<MulBackward>");
         }
@@ -81,19 +277,19 @@ namespace NovaML::Core
     template <typename T>
     std::shared_ptr<Tensor<T>> pow(const std::shared_ptr<Tensor<T>> &a, T exponent)
     {
-        std::vector<T> result(a->size());
-        for (size_t i = 0; i < result.size(); i++)
-            result[i] = std::pow(a->at(i), exponent);
+        Profiler::RecordScope scope("pow", Profiler::Category::Op, a->size(), 2.0 * a->size() * sizeof(T));
+        auto kernel = [exponent](size_t n, const T *x, T *y) { Kernel::vpow(n, x, exponent, y); };
+        Buffer<T> result = map_kernel(*a, kernel);
 
-        auto out = std::make_shared<Tensor<T>>(result, a->get_requires_grad());
+        auto out = make_result(std::move(result), a->shape(), a->get_requires_grad());
+        record_kernel(out, a, kernel);
         if (out->get_requires_grad())
         {
-            out->add_edge({OperatorType::Pow, a, [a, exponent](const std::vector<T> &grad_output)
+            out->add_edge({OperatorType::Pow, a, [a = SavedTensor<T>(a), exponent](const Buffer<T> &grad_output, Buffer<T> &grad_input)
                            {
-                               std::vector<T> grad_vec(grad_output.size());
-                               for (size_t i = 0; i < grad_output.size(); i++)
-                                   grad_vec[i] = grad_output[i] * exponent * std::pow(a->at(i), exponent - 1);
-                               a->backward(grad_vec);
+                               const Tensor<T> &av = a.unpack("<PowBackward>");
+                               visit_elements(av, [&](size_t i, T x)
+                                              { grad_input[i] += grad_output[i] * exponent * std::pow(x, exponent - 1); });
                            }});
             out->set_grad_fn_name("<PowBackward>");
         }
@@ -103,19 +299,18 @@ namespace NovaML::Core
     template <typename T>
     std::shared_ptr<Tensor<T>> neg(const std::shared_ptr<Tensor<T>> &a)
     {
-        std::vector<T> result(a->size());
-        for (size_t i = 0; i < result.size(); i++)
-            result[i] = -a->at(i);
+        Profiler::RecordScope scope("neg", Profiler::Category::Op, a->size(), 2.0 * a->size() * sizeof(T));
+        auto f = [](T x) { return -x; };
+        Buffer<T> result = map_elements(*a, f);
 
-        auto out = std::make_shared<Tensor<T>>(result, a->get_requires_grad());
+        auto out = make_result(std::move(result), a->shape(), a->get_requires_grad());
+        record_map(out, a, f);
         if (out->get_requires_grad())
         {
-            out->add_edge({OperatorType::Neg, a, [a](const std::vector<T> &grad_output)
+            out->add_edge({OperatorType::Neg, a, [](const Buffer<T> &grad_output, Buffer<T> &grad_input)
                            {
-                               std::vector<T> neg_grad = grad_output;
-                               for (auto &g : neg_grad)
-                                   g = -g;
-                               a->backward(neg_grad);
+                               parallel_elements(grad_output.size(), [&](size_t i)
+                                                 { grad_input[i] -= grad_output[i]; });
                            }});
             out->set_grad_fn_name("<NegBackward>");
         }
@@ -127,16 +322,18 @@ namespace NovaML::Core
         const std::shared_ptr<Tensor<T>> &a,
         const T &scalar)
     {
-        std::vector<T> result(a->size());
-        for (size_t i = 0; i < result.size(); i++)
-            result[i] = a->at(i) + scalar;
+        Profiler::RecordScope scope("add_scalar", Profiler::Category::Op, a->size(), 2.0 * a->size() * sizeof(T));
+        auto f = [scalar](T x) { return x + scalar; };
+        Buffer<T> result = map_elements(*a, f);
 
-        auto out = std::make_shared<Tensor<T>>(result, a->get_requires_grad());
+        auto out = make_result(std::move(result), a->shape(), a->get_requires_grad());
+        record_map(out, a, f);
         if (out->get_requires_grad())
         {
-            out->add_edge({OperatorType::AddScalar, a, [a](const std::vector<T> &grad_output)
+            out->add_edge({OperatorType::AddScalar, a, [](const Buffer<T> &grad_output, Buffer<T> &grad_input)
                            {
-                               a->backward(grad_output); // gradient w.r.t tensor is 1
+                               parallel_elements(grad_output.size(), [&](size_t i)
+                                                 { grad_input[i] += grad_output[i]; }); // gradient w.r.t tensor is 1
                            }});
             out->set_grad_fn_name("<AddScalarBackward>");
         }
@@ -149,16 +346,18 @@ namespace NovaML::Core
         const std::shared_ptr<Tensor<T>> &a,
         const T &scalar)
     {
-        std::vector<T> result(a->size());
-        for (size_t i = 0; i < result.size(); i++)
-            result[i] = a->at(i) - scalar;
+        Profiler::RecordScope scope("sub_scalar", Profiler::Category::Op, a->size(), 2.0 * a->size() * sizeof(T));
+        auto f = [scalar](T x) { return x - scalar; };
+        Buffer<T> result = map_elements(*a, f);
 
-        auto out = std::make_shared<Tensor<T>>(result, a->get_requires_grad());
+        auto out = make_result(std::move(result), a->shape(), a->get_requires_grad());
+        record_map(out, a, f);
         if (out->get_requires_grad())
         {
-            out->add_edge({OperatorType::SubScalar, a, [a](const std::vector<T> &grad_output)
+            out->add_edge({OperatorType::SubScalar, a, [](const Buffer<T> &grad_output, Buffer<T> &grad_input)
                            {
-                               a->backward(grad_output); // gradient w.r.t tensor is 1
+                               parallel_elements(grad_output.size(), [&](size_t i)
+                                                 { grad_input[i] += grad_output[i]; }); // gradient w.r.t tensor is 1
                            }});
             out->set_grad_fn_name("<SubScalarBackward>");
         }
@@ -171,19 +370,18 @@ namespace NovaML::Core
         const T &scalar,
         const std::shared_ptr<Tensor<T>> &a)
     {
-        std::vector<T> result(a->size());
-        for (size_t i = 0; i < result.size(); i++)
-            result[i] = scalar - a->at(i);
+        Profiler::RecordScope scope("rsub_scalar", Profiler::Category::Op, a->size(), 2.0 * a->size() * sizeof(T));
+        auto f = [scalar](T x) { return scalar - x; };
+        Buffer<T> result = map_elements(*a, f);
 
-        auto out = std::make_shared<Tensor<T>>(result, a->get_requires_grad());
+        auto out = make_result(std::move(result), a->shape(), a->get_requires_grad());
+        record_map(out, a, f);
         if (out->get_requires_grad())
         {
-            out->add_edge({OperatorType::SubScalar, a, [a](const std::vector<T> &grad_output)
+            out->add_edge({OperatorType::SubScalar, a, [](const Buffer<T> &grad_output, Buffer<T> &grad_input)
                            {
-                               std::vector<T> neg_grad = grad_output;
-                               for (auto &g : neg_grad)
-                                   g = -g;
-                               a->backward(neg_grad);
+                               parallel_elements(grad_output.size(), [&](size_t i)
+                                                 { grad_input[i] -= grad_output[i]; });
                            }});
             out->set_grad_fn_name("<RSubScalarBackward>");
         }
@@ -196,19 +394,18 @@ namespace NovaML::Core
         const std::shared_ptr<Tensor<T>> &a,
         const T &scalar)
     {
-        std::vector<T> result(a->size());
-        for (size_t i = 0; i < result.size(); i++)
-            result[i] = a->at(i) * scalar;
+        Profiler::RecordScope scope("mul_scalar", Profiler::Category::Op, a->size(), 2.0 * a->size() * sizeof(T));
+        auto f = [scalar](T x) { return x * scalar; };
+        Buffer<T> result = map_elements(*a, f);
 
-        auto out = std::make_shared<Tensor<T>>(result, a->get_requires_grad());
+        auto out = make_result(std::move(result), a->shape(), a->get_requires_grad());
+        record_map(out, a, f);
         if (out->get_requires_grad())
         {
-            out->add_edge({OperatorType::MulScalar, a, [a, scalar](const std::vector<T> &grad_output)
+            out->add_edge({OperatorType::MulScalar, a, [scalar](const Buffer<T> &grad_output, Buffer<T> &grad_input)
                            {
-                               std::vector<T> grad_vec = grad_output;
-                               for (size_t i = 0; i < grad_vec.size(); i++)
-                                   grad_vec[i] *= scalar;
-                               a->backward(grad_vec);
+                               parallel_elements(grad_output.size(), [&](size_t i)
+                                                 { grad_input[i] += grad_output[i] * scalar; });
                            }});
             out->set_grad_fn_name("<MulScalarBackward>");
         }
@@ -225,34 +422,35 @@ namespace NovaML::Core
 
     template <typename T>
     std::shared_ptr<Tensor<T>> div(
-        const std::shared_ptr<Tensor<T>> &a,
-        const std::shared_ptr<Tensor<T>> &b)
+        const std::shared_ptr<Tensor<T>> &lhs,
+        const std::shared_ptr<Tensor<T>> &rhs)
     {
-        check_size_match(a->get_data(), b->get_data(), "div: size mismatch");
+        std::shared_ptr<Tensor<T>> a, b;
+        std::tie(a, b) = broadcast_operands(lhs, rhs);
+        Profiler::RecordScope scope("div", Profiler::Category::Op, a->size(), 3.0 * a->size() * sizeof(T));
 
-        std::vector<T> result(a->size());
-        for (size_t i = 0; i < result.size(); i++)
-            result[i] = a->at(i) / b->at(i);
+        auto f = [](T x, T y) { return x / y; };
+        Buffer<T> result = zip_elements(*a, *b, f);
 
-        auto out = std::make_shared<Tensor<T>>(result, a->get_requires_grad() || b->get_requires_grad());
+        auto out = make_result(std::move(result), a->shape(), a->get_requires_grad() || b->get_requires_grad());
+        record_zip(out, a, b, f);
 
         if (out->get_requires_grad())
         {
-            out->add_edge({OperatorType::Mul, a, [a, b](const std::vector<T> &grad_output)
+            out->add_edge({OperatorType::Div, a, [b = SavedTensor<T>(b)](const Buffer<T> &grad_output, Buffer<T> &grad_input)
                            {
+                               const Tensor<T> &bv = b.unpack("<DivBackward>");
                                // da = grad_output / b
-                               std::vector<T> grad_a(grad_output.size());
-                               for (size_t i = 0; i < grad_output.size(); i++)
-                                   grad_a[i] = grad_output[i] / b->at(i);
-                               a->backward(grad_a);
+                               visit_elements(bv, [&](size_t i, T y)
+                                              { grad_input[i] += grad_output[i] / y; });
                            }});
-            out->add_edge({OperatorType::Mul, b, [a, b](const std::vector<T> &grad_output)
+            out->add_edge({OperatorType::Div, b, [a = SavedTensor<T>(a), b = SavedTensor<T>(b)](const Buffer<T> &grad_output, Buffer<T> &grad_input)
                            {
+                               const Tensor<T> &av = a.unpack("<DivBackward>");
+                               const Tensor<T> &bv = b.unpack("<DivBackward>");
                                // db = -grad_output * a / (b^2)
-                               std::vector<T> grad_b(grad_output.size());
-                               for (size_t i = 0; i < grad_output.size(); i++)
-                                   grad_b[i] = -grad_output[i] * a->at(i) / (b->at(i) * b->at(i));
-                               b->backward(grad_b);
+                               visit_elements(av, bv, [&](size_t i, T x, T y)
+                                              { grad_input[i] -= grad_output[i] * x / (y * y); });
                            }});
             out->set_grad_fn_name("<DivBackward>");
         }
@@ -265,20 +463,19 @@ namespace NovaML::Core
         const std::shared_ptr<Tensor<T>> &a,
         const T &scalar)
     {
-        std::vector<T> result(a->size());
-        for (size_t i = 0; i < result.size(); i++)
-            result[i] = a->at(i) / scalar;
+        Profiler::RecordScope scope("div_scalar", Profiler::Category::Op, a->size(), 2.0 * a->size() * sizeof(T));
+        auto f = [scalar](T x) { return x / scalar; };
+        Buffer<T> result = map_elements(*a, f);
 
-        auto out = std::make_shared<Tensor<T>>(result, a->get_requires_grad());
+        auto out = make_result(std::move(result), a->shape(), a->get_requires_grad());
+        record_map(out, a, f);
 
         if (out->get_requires_grad())
         {
-            out->add_edge({OperatorType::MulScalar, a, [a, scalar](const std::vector<T> &grad_output)
+            out->add_edge({OperatorType::MulScalar, a, [scalar](const Buffer<T> &grad_output, Buffer<T> &grad_input)
                            {
-                               std::vector<T> grad_vec = grad_output;
-                               for (auto &g : grad_vec)
-                                   g /= scalar; // derivative w.r.t tensor
-                               a->backward(grad_vec);
+                               parallel_elements(grad_output.size(), [&](size_t i)
+                                                 { grad_input[i] += grad_output[i] / scalar; }); // derivative w.r.t tensor
                            }});
             out->set_grad_fn_name("<DivScalarBackward>");
         }
@@ -291,20 +488,20 @@ namespace NovaML::Core
         const T &scalar,
         const std::shared_ptr<Tensor<T>> &a)
     {
-        std::vector<T> result(a->size());
-        for (size_t i = 0; i < result.size(); i++)
-            result[i] = scalar / a->at(i);
+        Profiler::RecordScope scope("rdiv_scalar", Profiler::Category::Op, a->size(), 2.0 * a->size() * sizeof(T));
+        auto f = [scalar](T x) { return scalar / x; };
+        Buffer<T> result = map_elements(*a, f);
 
-        auto out = std::make_shared<Tensor<T>>(result, a->get_requires_grad());
+        auto out = make_result(std::move(result), a->shape(), a->get_requires_grad());
+        record_map(out, a, f);
 
         if (out->get_requires_grad())
         {
-            out->add_edge({OperatorType::MulScalar, a, [a, scalar](const std::vector<T> &grad_output)
+            out->add_edge({OperatorType::MulScalar, a, [a = SavedTensor<T>(a), scalar](const Buffer<T> &grad_output, Buffer<T> &grad_input)
                            {
-                               std::vector<T> grad_vec(grad_output.size());
-                               for (size_t i = 0; i < grad_output.size(); i++)
-                                   grad_vec[i] = -grad_output[i] * scalar / (a->at(i) * a->at(i));
-                               a->backward(grad_vec);
+                               const Tensor<T> &av = a.unpack("<RDivScalarBackward>");
+                               visit_elements(av, [&](size_t i, T x)
+                                              { grad_input[i] -= grad_output[i] * scalar / (x * x); });
                            }});
             out->set_grad_fn_name("<RDivScalarBackward>");
         }
@@ -0,0 +1,539 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "tensor.hpp"
+#include "autograd.hpp"
+#include "shape.hpp"
+#include "../Kernel/vmath.hpp"
+#include "../../Parallel/thread_pool.hpp"
+#include "../../Profiler/profiler.hpp"
+
+namespace NovaML::Core
+{
+    // -------------------------
+    // Accumulation
+    // -------------------------
+
+    /**
+     * @brief Pairwise (cascade) sum of n values in Acc precision.
+     *
+     * Blocks of up to 256 values are summed in eight independent lanes,
+     * which the compiler vectorizes; blocks are combined as a balanced tree,
+     * so the rounding error grows with log n instead of n.
+     */
+    template <typename Acc, typename T>
+    Acc pairwise_sum(const T *x, size_t n)
+    {
+        if (n <= 256)
+        {
+            Acc lanes[8] = {};
+            size_t i = 0;
+            for (; i + 8 <= n; i += 8)
+                for (size_t k = 0; k < 8; k++)
+                    lanes[k] += Acc(x[i + k]);
+            Acc s = ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) + ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7]));
+            for (; i < n; i++)
+                s += Acc(x[i]);
+            return s;
+        }
+        const size_t half = n / 16 * 8;
+        return pairwise_sum<Acc>(x, half) + pairwise_sum<Acc>(x + half, n - half);
+    }
+
+    // -------------------------
+    // Reductions along dimensions
+    // -------------------------
+
+    /**
+     * @brief Where the slices of a reduction live in the input.
+     *
+     * Output element o reduces one slice of `extent` input elements. `outer`
+     * walks the kept dimensions (its positions are the slice starts),
+     * `inner` the reduced ones (positions relative to a slice start); both
+     * address the input's storage. The *_index twins address the dense
+     * row-major index instead, which is how gradient buffers are laid out.
+     */
+    struct ReducePlan
+    {
+        Shape out_shape;
+        size_t outputs = 1, extent = 1;
+        Layout outer, inner;
+        Layout outer_index, inner_index;
+        bool column = false; ///< dense input reduced over leading dimensions: slice r of output o is at r * outputs + o
+    };
+
+    /// Plan reducing `dims` (negative values count from the end; empty means all) of a tensor laid out as `layout`.
+    inline ReducePlan reduce_plan(const Layout &layout, const std::vector<long> &dims, bool keepdim)
+    {
+        const size_t nd = layout.ndim();
+        std::vector<bool> reduced(nd, dims.empty());
+        for (long d : dims)
+        {
+            const long k = d < 0 ? d + long(nd) : d;
+            if (k < 0 || k >= long(nd))
+                throw std::out_of_range("reduce: dimension " + std::to_string(d) + " out of range for shape " +
+                                        shape_to_string(layout.shape));
+            if (reduced[k])
+                throw std::invalid_argument("reduce: dimension " + std::to_string(d) + " listed twice");
+            reduced[k] = true;
+        }
+
+        ReducePlan plan;
+        const Shape dense = contiguous_strides(layout.shape);
+        plan.outer.offset = layout.offset;
+        for (size_t d = 0; d < nd; d++)
+        {
+            Layout &phys = reduced[d] ? plan.inner : plan.outer;
+            Layout &index = reduced[d] ? plan.inner_index : plan.outer_index;
+            phys.shape.push_back(layout.shape[d]);
+            phys.strides.push_back(layout.strides[d]);
+            index.shape.push_back(layout.shape[d]);
+            index.strides.push_back(dense[d]);
+            if (!reduced[d] || keepdim)
+                plan.out_shape.push_back(reduced[d] ? 1 : layout.shape[d]);
+        }
+        if (plan.out_shape.empty())
+            plan.out_shape = {1};
+        plan.outputs = plan.outer.numel();
+        plan.extent = plan.inner.numel();
+
+        const size_t leading = size_t(std::find(reduced.begin(), reduced.end(), false) - reduced.begin());
+        plan.column = layout.is_contiguous() && leading > 0 && leading < nd &&
+                      std::none_of(reduced.begin() + leading, reduced.end(), [](bool r)
+                                   { return r; });
+        return plan;
+    }
+
+    /// Outputs per parallel_for chunk: about elementwise_grain input elements each.
+    inline size_t reduce_grain(const ReducePlan &plan)
+    {
+        return std::max<size_t>(1, Parallel::elementwise_grain / std::max<size_t>(plan.extent, 1));
+    }
+
+    /// Calls fn(o, index, pos) for every input element reduced into outputs [begin, end).
+    template <typename F>
+    void for_each_slice_element(const ReducePlan &plan, size_t begin, size_t end, F &&fn)
+    {
+        for_each_zip(plan.outer_index, plan.outer, begin, end, [&](size_t o, size_t index, size_t pos)
+                     { for_each_zip(plan.inner_index, plan.inner, 0, plan.extent, [&](size_t, size_t qi, size_t qp)
+                                    { fn(o, index + qi, pos + qp); }); });
+    }
+
+    /// No array transform: sum_slices adds f(x, o) as is.
+    struct NoPost
+    {
+        template <typename Acc>
+        void operator()(Acc *, size_t) const {}
+    };
+
+    /**
+     * @brief emit(o, sum of post(f(x, o)) over slice o), accumulated in accumulate_t<T>.
+     *
+     * `post(values, n)` is an optional in-place array transform (a
+     * Kernel::vexp, say) applied to f's results before they are summed.
+     * Slices are gathered and summed pairwise, in parallel over outputs.
+     * Column plans instead stream the input once, row by row, keeping a
+     * Kahan-compensated running sum per output.
+     */
+    template <typename T, typename F, typename Emit, typename Post = NoPost>
+    void sum_slices(const Tensor<T> &a, const ReducePlan &plan, F f, Emit emit, Post post = Post())
+    {
+        using Acc = accumulate_t<T>;
+        const T *base = a.get_storage()->data();
+        if (plan.column)
+        {
+            Parallel::parallel_for(0, plan.outputs, std::max<size_t>(64, reduce_grain(plan)), [&](size_t begin, size_t end)
+                                   {
+                                       // Per task, not thread_local: post() may run its own parallel_for,
+                                       // and the waiting thread can pick up a sibling slice task meanwhile.
+                                       const size_t m = end - begin;
+                                       Buffer<Acc> scratch(3 * m, Acc(0));
+                                       Acc *s = scratch.data(), *c = s + m, *values = c + m;
+                                       for (size_t r = 0; r < plan.extent; r++)
+                                       {
+                                           const T *row = base + plan.outer.offset + r * plan.outputs + begin;
+                                           for (size_t j = 0; j < m; j++)
+                                               values[j] = Acc(f(row[j], begin + j));
+                                           post(values, m);
+                                           for (size_t j = 0; j < m; j++)
+                                           {
+                                               const Acc y = values[j] - c[j];
+                                               const Acc t = s[j] + y;
+                                               c[j] = (t - s[j]) - y;
+                                               s[j] = t;
+                                           }
+                                       }
+                                       for (size_t j = 0; j < m; j++)
+                                           emit(begin + j, s[j]); });
+            return;
+        }
+        Parallel::parallel_for(0, plan.outputs, reduce_grain(plan), [&](size_t begin, size_t end)
+                               {
+                                   Buffer<Acc> scratch(plan.extent); // per task, as above
+                                   Acc *values = scratch.data();
+                                   plan.outer.for_each_range(begin, end, [&](size_t o, size_t pos)
+                                                             {
+                                                                 plan.inner.for_each([&](size_t r, size_t q)
+                                                                                     { values[r] = Acc(f(base[pos + q], o)); });
+                                                                 post(values, plan.extent);
+                                                                 emit(o, pairwise_sum<Acc>(values, plan.extent)); }); });
+    }
+
+    /// emit(o, value, index) for the first element of slice o that no other beats; `index` is its dense input index.
+    template <typename T, typename Better, typename Emit>
+    void extreme_slices(const char *op, const Tensor<T> &a, const ReducePlan &plan, Better better, Emit emit)
+    {
+        if (plan.extent == 0)
+            throw std::invalid_argument(std::string(op) + ": cannot reduce an empty dimension");
+        const T *base = a.get_storage()->data();
+        Parallel::parallel_for(0, plan.outputs, reduce_grain(plan), [&](size_t begin, size_t end)
+                               { for_each_zip(plan.outer_index, plan.outer, begin, end, [&](size_t o, size_t index, size_t pos)
+                                              {
+                                                  T best = base[pos];
+                                                  size_t arg = 0;
+                                                  plan.inner.for_each([&](size_t r, size_t q)
+                                                                      {
+                                                                          const T x = base[pos + q];
+                                                                          if (better(x, best))
+                                                                          {
+                                                                              best = x;
+                                                                              arg = r;
+                                                                          } });
+                                                  emit(o, best, index + plan.inner_index.offset_of(arg)); }); });
+    }
+
+    /// grad_input[i] += grad_output[o] * d(o, pos) for every input element i (storage position pos) of slice o.
+    template <typename T, typename D>
+    void reduce_backward(const ReducePlan &plan, const Buffer<T> &grad_output, Buffer<T> &grad_input, D d)
+    {
+        Parallel::parallel_for(0, plan.outputs, reduce_grain(plan), [&](size_t begin, size_t end)
+                               { for_each_slice_element(plan, begin, end, [&](size_t o, size_t i, size_t pos)
+                                                        { grad_input[i] += grad_output[o] * d(o, pos); }); });
+    }
+
+    // NaN wins, so it propagates like in the element-wise ops.
+    template <typename T>
+    bool greater_or_nan(T x, T best) { return x > best || (x != x && best == best); }
+    template <typename T>
+    bool less_or_nan(T x, T best) { return x < best || (x != x && best == best); }
+
+    /**
+     * @brief Sum over `dims` (all when empty).
+     *
+     * With keepdim the reduced dimensions stay as size 1, so the result
+     * broadcasts against the input; otherwise they are dropped (a full
+     * reduction gives shape {1}).
+     */
+    template <typename T>
+    std::shared_ptr<Tensor<T>> sum(const std::shared_ptr<Tensor<T>> &a, const std::vector<long> &dims, bool keepdim = false)
+    {
+        Profiler::RecordScope scope("sum_dim", Profiler::Category::Op, a->size(), a->size() * sizeof(T));
+        const ReducePlan plan = reduce_plan(a->get_layout(), dims, keepdim);
+        auto compute = [a, plan](T *o)
+        {
+            sum_slices(*a, plan, [](T x, size_t) { return x; }, [o](size_t k, accumulate_t<T> s)
+                       { o[k] = T(s); });
+        };
+        Buffer<T> result(plan.outputs);
+        compute(result.data());
+
+        auto out = make_result(std::move(result), plan.out_shape, a->get_requires_grad());
+        record_step(out, compute);
+        if (out->get_requires_grad())
+        {
+            out->add_edge({OperatorType::Sum, a, [plan](const Buffer<T> &grad_output, Buffer<T> &grad_input)
+                           { reduce_backward(plan, grad_output, grad_input, [](size_t, size_t)
+                                             { return T(1); }); }});
+            out->set_grad_fn_name("<SumBackward>");
+        }
+        return out;
+    }
+
+    template <typename T>
+    std::shared_ptr<Tensor<T>> mean(const std::shared_ptr<Tensor<T>> &a, const std::vector<long> &dims, bool keepdim = false)
+    {
+        Profiler::RecordScope scope("mean_dim", Profiler::Category::Op, a->size(), a->size() * sizeof(T));
+        const ReducePlan plan = reduce_plan(a->get_layout(), dims, keepdim);
+        auto compute = [a, plan](T *o)
+        {
+            const accumulate_t<T> n = accumulate_t<T>(plan.extent);
+            sum_slices(*a, plan, [](T x, size_t) { return x; }, [o, n](size_t k, accumulate_t<T> s)
+                       { o[k] = T(s / n); });
+        };
+        Buffer<T> result(plan.outputs);
+        compute(result.data());
+
+        auto out = make_result(std::move(result), plan.out_shape, a->get_requires_grad());
+        record_step(out, compute);
+        if (out->get_requires_grad())
+        {
+            out->add_edge({OperatorType::Mean, a, [plan](const Buffer<T> &grad_output, Buffer<T> &grad_input)
+                           {
+                               const T scale = T(1) / T(plan.extent);
+                               reduce_backward(plan, grad_output, grad_input, [scale](size_t, size_t)
+                                               { return scale; }); }});
+            out->set_grad_fn_name("<MeanBackward>");
+        }
+        return out;
+    }
+
+    // -------------------------
+    // max / min: the gradient flows to the first extreme element of each slice
+    // -------------------------
+    template <typename T, typename Better>
+    std::shared_ptr<Tensor<T>> reduce_extreme(const char *op, OperatorType type, const char *grad_fn, const std::shared_ptr<Tensor<T>> &a,
+                                              const std::vector<long> &dims, bool keepdim, Better better)
+    {
+        Profiler::RecordScope scope(op, Profiler::Category::Op, a->size(), a->size() * sizeof(T));
+        const ReducePlan plan = reduce_plan(a->get_layout(), dims, keepdim);
+        auto argmax = std::make_shared<std::vector<size_t>>(plan.outputs);
+        auto compute = [a, plan, argmax, better, op](T *o)
+        {
+            size_t *arg = argmax->data();
+            extreme_slices(op, *a, plan, better, [o, arg](size_t k, T value, size_t index)
+                           {
+                               o[k] = value;
+                               arg[k] = index; });
+        };
+        Buffer<T> result(plan.outputs);
+        compute(result.data());
+
+        auto out = make_result(std::move(result), plan.out_shape, a->get_requires_grad());
+        record_step(out, compute);
+        if (out->get_requires_grad())
+        {
+            out->add_edge({type, a, [argmax](const Buffer<T> &grad_output, Buffer<T> &grad_input)
+                           {
+                               const size_t *arg = argmax->data();
+                               parallel_elements(grad_output.size(), [&](size_t k)
+                                                 { grad_input[arg[k]] += grad_output[k]; }); }});
+            out->set_grad_fn_name(grad_fn);
+        }
+        return out;
+    }
+
+    template <typename T>
+    std::shared_ptr<Tensor<T>> max(const std::shared_ptr<Tensor<T>> &a, const std::vector<long> &dims, bool keepdim = false)
+    {
+        return reduce_extreme("max", OperatorType::Max, "<MaxBackward>", a, dims, keepdim, greater_or_nan<T>);
+    }
+
+    template <typename T>
+    std::shared_ptr<Tensor<T>> min(const std::shared_ptr<Tensor<T>> &a, const std::vector<long> &dims, bool keepdim = false)
+    {
+        return reduce_extreme("min", OperatorType::Min, "<MinBackward>", a, dims, keepdim, less_or_nan<T>);
+    }
+
+    /**
+     * @brief Index of the first maximum along `dim`, stored as T (exact below 2^24 for float).
+     *
+     * Indices are not differentiable: the result never requires grad.
+     */
+    template <typename T, typename Better>
+    std::shared_ptr<Tensor<T>> reduce_arg(const char *op, const std::shared_ptr<Tensor<T>> &a, long dim, bool keepdim, Better better)
+    {
+        Profiler::RecordScope scope(op, Profiler::Category::Op, a->size(), a->size() * sizeof(T));
+        const ReducePlan plan = reduce_plan(a->get_layout(), {dim}, keepdim);
+        auto compute = [a, plan, better, op](T *o)
+        {
+            // Dense input index back to the position along the reduced dimension
+            const size_t stride = plan.inner_index.strides[0], size = plan.inner_index.shape[0];
+            // Straight to float / double; bf16 and fp16 only convert from float
+            extreme_slices(op, *a, plan, better, [o, stride, size](size_t k, T, size_t index)
+                           { o[k] = T(static_cast<accumulate_t<T>>(index / stride % size)); });
+        };
+        Buffer<T> result(plan.outputs);
+        compute(result.data());
+
+        auto out = make_result(std::move(result), plan.out_shape, false);
+        record_step(out, compute);
+        return out;
+    }
+
+    template <typename T>
+    std::shared_ptr<Tensor<T>> argmax(const std::shared_ptr<Tensor<T>> &a, long dim, bool keepdim = false)
+    {
+        return reduce_arg("argmax", a, dim, keepdim, greater_or_nan<T>);
+    }
+
+    template <typename T>
+    std::shared_ptr<Tensor<T>> argmin(const std::shared_ptr<Tensor<T>> &a, long dim, bool keepdim = false)
+    {
+        return reduce_arg("argmin", a, dim, keepdim, less_or_nan<T>);
+    }
+
+    // -------------------------
+    // var / stddev: two passes (mean, then squared deviations), divided by extent - correction
+    // -------------------------
+    template <typename T>
+    std::shared_ptr<Tensor<T>> reduce_moment(const char *op, const std::shared_ptr<Tensor<T>> &a, const std::vector<long> &dims,
+                                             size_t correction, bool keepdim, bool root)
+    {
+        using Acc = accumulate_t<T>;
+        Profiler::RecordScope scope(op, Profiler::Category::Op, 3.0 * a->size(), 2.0 * a->size() * sizeof(T));
+        const ReducePlan plan = reduce_plan(a->get_layout(), dims, keepdim);
+        const Acc divisor = Acc(plan.extent > correction ? plan.extent - correction : 0);
+        auto means = std::make_shared<std::vector<Acc>>(plan.outputs);
+        auto compute = [a, plan, means, divisor, root](T *o)
+        {
+            Acc *m = means->data();
+            const Acc n = Acc(plan.extent);
+            sum_slices(*a, plan, [](T x, size_t) { return x; }, [m, n](size_t k, Acc s)
+                       { m[k] = s / n; });
+            sum_slices(*a, plan, [m](T x, size_t k)
+                       {
+                           const Acc d = Acc(x) - m[k];
+                           return d * d; }, [o, divisor, root](size_t k, Acc s)
+                       { o[k] = T(root ? std::sqrt(s / divisor) : s / divisor); });
+        };
+        Buffer<T> result(plan.outputs);
+        compute(result.data());
+
+        auto out = make_result(std::move(result), plan.out_shape, a->get_requires_grad());
+        record_step(out, compute);
+        if (out->get_requires_grad())
+        {
+            // d var / dx = 2 (x - mean) / divisor;  d std / dx = (x - mean) / (divisor * std)
+            std::weak_ptr<Tensor<T>> weak_out = out;
+            const size_t version = out->version();
+            const char *grad_fn = root ? "<StdBackward>" : "<VarBackward>";
+            out->add_edge({root ? OperatorType::Std : OperatorType::Var, a,
+                           [a = SavedTensor<T>(a), plan, means, divisor, root, weak_out, version, grad_fn](const Buffer<T> &grad_output, Buffer<T> &grad_input)
+                           {
+                               const T *base = a.unpack(grad_fn).get_storage()->data();
+                               const Acc *m = means->data();
+                               if (!root)
+                               {
+                                   reduce_backward(plan, grad_output, grad_input, [&](size_t k, size_t pos)
+                                                   { return T(Acc(2) * (Acc(base[pos]) - m[k]) / divisor); });
+                                   return;
+                               }
+                               auto result = weak_out.lock();
+                               check_version(*result, version, grad_fn);
+                               const T *s = result->data_ptr();
+                               reduce_backward(plan, grad_output, grad_input, [&](size_t k, size_t pos)
+                                               { return Acc(s[k]) > Acc(0) ? T((Acc(base[pos]) - m[k]) / (divisor * Acc(s[k]))) : T(0); });
+                           }});
+            out->set_grad_fn_name(grad_fn);
+        }
+        return out;
+    }
+
+    /// Variance over `dims`; correction = 1 is the unbiased estimate, 0 the population variance.
+    template <typename T>
+    std::shared_ptr<Tensor<T>> var(const std::shared_ptr<Tensor<T>> &a, const std::vector<long> &dims, size_t correction = 1, bool keepdim = false)
+    {
+        return reduce_moment("var", a, dims, correction, keepdim, false);
+    }
+
+    /// Standard deviation: sqrt(var(a, dims, correction)).
+    template <typename T>
+    std::shared_ptr<Tensor<T>> stddev(const std::shared_ptr<Tensor<T>> &a, const std::vector<long> &dims, size_t correction = 1, bool keepdim = false)
+    {
+        return reduce_moment("stddev", a, dims, correction, keepdim, true);
+    }
+
+    // -------------------------
+    // logsumexp: max + log(sum(exp(x - max))), which never overflows
+    // -------------------------
+    template <typename T>
+    std::shared_ptr<Tensor<T>> logsumexp(const std::shared_ptr<Tensor<T>> &a, const std::vector<long> &dims, bool keepdim = false)
+    {
+        using Acc = accumulate_t<T>;
+        Profiler::RecordScope scope("logsumexp", Profiler::Category::Op, 4.0 * a->size(), 2.0 * a->size() * sizeof(T));
+        const ReducePlan plan = reduce_plan(a->get_layout(), dims, keepdim);
+        auto shifts = std::make_shared<std::vector<Acc>>(plan.outputs);
+        auto compute = [a, plan, shifts](T *o)
+        {
+            Acc *shift = shifts->data();
+            extreme_slices("logsumexp", *a, plan, greater_or_nan<T>, [shift](size_t k, T value, size_t)
+                           { shift[k] = std::isfinite(Acc(value)) ? Acc(value) : Acc(0); });
+            sum_slices(*a, plan, [shift](T x, size_t k)
+                       { return Acc(x) - shift[k]; }, [o, shift](size_t k, Acc s)
+                       { o[k] = T(shift[k] + std::log(s)); }, [](Acc *values, size_t n)
+                       { Kernel::vexp(n, values, values); });
+        };
+        Buffer<T> result(plan.outputs);
+        compute(result.data());
+
+        auto out = make_result(std::move(result), plan.out_shape, a->get_requires_grad());
+        record_step(out, compute);
+        if (out->get_requires_grad())
+        {
+            // d/dx logsumexp = softmax(x) = exp(x - logsumexp)
+            std::weak_ptr<Tensor<T>> weak_out = out;
+            const size_t version = out->version();
+            out->add_edge({OperatorType::LogSumExp, a, [a = SavedTensor<T>(a), plan, weak_out, version](const Buffer<T> &grad_output, Buffer<T> &grad_input)
+                           {
+                               const T *base = a.unpack("<LogsumexpBackward>").get_storage()->data();
+                               auto result = weak_out.lock();
+                               check_version(*result, version, "<LogsumexpBackward>");
+                               const T *lse = result->data_ptr();
+                               reduce_backward(plan, grad_output, grad_input, [&](size_t k, size_t pos)
+                                               { return T(std::exp(Acc(base[pos]) - Acc(lse[k]))); });
+                           }});
+            out->set_grad_fn_name("<LogsumexpBackward>");
+        }
+        return out;
+    }
+
+    // -------------------------
+    // p-norm: (sum |x|^p)^(1/p); p = 2 and p = 1 avoid pow
+    // -------------------------
+    template <typename T>
+    std::shared_ptr<Tensor<T>> norm(const std::shared_ptr<Tensor<T>> &a, const std::vector<long> &dims, double p = 2.0, bool keepdim = false)
+    {
+        using Acc = accumulate_t<T>;
+        if (!(p > 0))
+            throw std::invalid_argument("norm: p must be positive");
+        Profiler::RecordScope scope("norm", Profiler::Category::Op, 2.0 * a->size(), a->size() * sizeof(T));
+        const ReducePlan plan = reduce_plan(a->get_layout(), dims, keepdim);
+        const Acc ap = Acc(p);
+        auto compute = [a, plan, ap](T *o)
+        {
+            auto power = [ap](T x, size_t)
+            {
+                const Acc v = std::abs(Acc(x));
+                return ap == Acc(2) ? v * v : ap == Acc(1) ? v : std::pow(v, ap);
+            };
+            sum_slices(*a, plan, power, [o, ap](size_t k, Acc s)
+                       { o[k] = T(ap == Acc(2) ? std::sqrt(s) : ap == Acc(1) ? s : std::pow(s, Acc(1) / ap)); });
+        };
+        Buffer<T> result(plan.outputs);
+        compute(result.data());
+
+        auto out = make_result(std::move(result), plan.out_shape, a->get_requires_grad());
+        record_step(out, compute);
+        if (out->get_requires_grad())
+        {
+            // d/dx ||x||_p = sign(x) |x|^(p-1) / ||x||_p^(p-1); zero where the norm is zero
+            std::weak_ptr<Tensor<T>> weak_out = out;
+            const size_t version = out->version();
+            out->add_edge({OperatorType::Norm, a, [a = SavedTensor<T>(a), plan, ap, weak_out, version](const Buffer<T> &grad_output, Buffer<T> &grad_input)
+                           {
+                               const T *base = a.unpack("<NormBackward>").get_storage()->data();
+                               auto result = weak_out.lock();
+                               check_version(*result, version, "<NormBackward>");
+                               const T *nrm = result->data_ptr();
+                               reduce_backward(plan, grad_output, grad_input, [&](size_t k, size_t pos)
+                                               {
+                                                   const Acc x = Acc(base[pos]), n = Acc(nrm[k]);
+                                                   if (!(n > Acc(0)))
+                                                       return T(0);
+                                                   if (ap == Acc(2))
+                                                       return T(x / n);
+                                                   const Acc sign = x > Acc(0) ? Acc(1) : x < Acc(0) ? Acc(-1) : Acc(0);
+                                                   if (ap == Acc(1))
+                                                       return T(sign);
+                                                   return T(sign * std::pow(std::abs(x) / n, ap - Acc(1))); });
+                           }});
+            out->set_grad_fn_name("<NormBackward>");
+        }
+        return out;
+    }
+}
@@ -0,0 +1,145 @@
+#pragma once
+#include <memory>
+#include "tensor.hpp"
+#include "autograd.hpp"
+#include "shape.hpp"
+
+namespace NovaML::Core
+{
+    // -------------------------
+    // Shared helper: build a view and route its gradient back to the base.
+    //
+    // `data_layout` indexes the shared storage; `grad_layout` is the same
+    // transform applied to the base's dense row-major gradient buffer.
+    // -------------------------
+    template <typename T>
+    std::shared_ptr<Tensor<T>> make_view(
+        const std::shared_ptr<Tensor<T>> &a,
+        const Layout &data_layout,
+        const Layout &grad_layout,
+        OperatorType op,
+        const std::string &grad_fn_name)
+    {
+        auto out = std::make_shared<Tensor<T>>(a->get_storage(), data_layout,
+                                               a->get_requires_grad() && GradMode::is_enabled());
+
+        if (out->get_requires_grad())
+        {
+            out->add_edge({op, a, [grad_layout](const Buffer<T> &grad_output, Buffer<T> &grad_input)
+                           {
+                               grad_layout.for_each([&](size_t i, size_t pos)
+                                                    { grad_input[pos] += grad_output[i]; });
+                           }});
+            out->set_grad_fn_name(grad_fn_name);
+        }
+        return out;
+    }
+
+    // -------------------------
+    // Contiguous: dense copy when needed, otherwise the tensor itself
+    // -------------------------
+    template <typename T>
+    std::shared_ptr<Tensor<T>> contiguous(const std::shared_ptr<Tensor<T>> &a)
+    {
+        if (a->is_contiguous())
+            return a;
+
+        Profiler::RecordScope scope("contiguous", Profiler::Category::Op, 0, 2.0 * a->size() * sizeof(T));
+        auto copy = [](T x)
+        { return x; };
+        auto out = make_result(map_elements(*a, copy), a->shape(), a->get_requires_grad());
+        record_map(out, a, copy);
+        if (out->get_requires_grad())
+        {
+            out->add_edge({OperatorType::Contiguous, a, [](const Buffer<T> &grad_output, Buffer<T> &grad_input)
+                           {
+                               parallel_elements(grad_output.size(), [&](size_t i)
+                                                 { grad_input[i] += grad_output[i]; });
+                           }});
+            out->set_grad_fn_name("<ContiguousBackward>");
+        }
+        return out;
+    }
+
+    // -------------------------
+    // View: same elements, new shape (requires a contiguous tensor)
+    // -------------------------
+    template <typename T>
+    std::shared_ptr<Tensor<T>> view(const std::shared_ptr<Tensor<T>> &a, const Shape &shape)
+    {
+        return make_view(a, view_layout(a->get_layout(), shape),
+                         view_layout(Layout::contiguous(a->shape()), shape),
+                         OperatorType::Reshape, "<ViewBackward>");
+    }
+
+    // -------------------------
+    // Reshape: a view when possible, a contiguous copy otherwise
+    // -------------------------
+    template <typename T>
+    std::shared_ptr<Tensor<T>> reshape(const std::shared_ptr<Tensor<T>> &a, const Shape &shape)
+    {
+        auto base = contiguous(a);
+        return make_view(base, view_layout(base->get_layout(), shape),
+                         view_layout(Layout::contiguous(base->shape()), shape),
+                         OperatorType::Reshape, "<ReshapeBackward>");
+    }
+
+    // -------------------------
+    // Transpose: swap two dimensions
+    // -------------------------
+    template <typename T>
+    std::shared_ptr<Tensor<T>> transpose(const std::shared_ptr<Tensor<T>> &a, size_t dim0 = 0, size_t dim1 = 1)
+    {
+        return make_view(a, transpose_layout(a->get_layout(), dim0, dim1),
+                         transpose_layout(Layout::contiguous(a->shape()), dim0, dim1),
+                         OperatorType::Transpose, "<TransposeBackward>");
+    }
+
+    // -------------------------
+    // Slice: elements [start, end) with step along one dimension
+    // -------------------------
+    template <typename T>
+    std::shared_ptr<Tensor<T>> slice(const std::shared_ptr<Tensor<T>> &a, size_t dim, size_t start, size_t end, size_t step = 1)
+    {
+        return make_view(a, slice_layout(a->get_layout(), dim, start, end, step),
+                         slice_layout(Layout::contiguous(a->shape()), dim, start, end, step),
+                         OperatorType::Slice, "<SliceBackward>");
+    }
+
+    // -------------------------
+    // Squeeze: drop size-1 dimensions (all of them when dim < 0)
+    // -------------------------
+    template <typename T>
+    std::shared_ptr<Tensor<T>> squeeze(const std::shared_ptr<Tensor<T>> &a, long dim = -1)
+    {
+        return make_view(a, squeeze_layout(a->get_layout(), dim),
+                         squeeze_layout(Layout::contiguous(a->shape()), dim),
+                         OperatorType::Reshape, "<SqueezeBackward>");
+    }
+
+    // -------------------------
+    // Expand: broadcast to a larger shape without copying (stride 0).
+    // The gradient of every broadcast element lands on the same base
+    // element, so backward sums over the expanded dimensions.
+    // -------------------------
+    template <typename T>
+    std::shared_ptr<Tensor<T>> expand(const std::shared_ptr<Tensor<T>> &a, const Shape &shape)
+    {
+        if (a->shape() == shape)
+            return a;
+        return make_view(a, expand_layout(a->get_layout(), shape),
+                         expand_layout(Layout::contiguous(a->shape()), shape),
+                         OperatorType::Expand, "<ExpandBackward>");
+    }
+
+    // -------------------------
+    // Unsqueeze: insert a size-1 dimension at position dim
+    // -------------------------
+    template <typename T>
+    std::shared_ptr<Tensor<T>> unsqueeze(const std::shared_ptr<Tensor<T>> &a, size_t dim)
+    {
+        return make_view(a, unsqueeze_layout(a->get_layout(), dim),
+                         unsqueeze_layout(Layout::contiguous(a->shape()), dim),
+                         OperatorType::Reshape, "<UnsqueezeBackward>");
+    }
+}
@@ -2,11 +2,12 @@
 #include <vector>
 #include <string>
 #include <sstream>
+#include <stdexcept>
 
 namespace NovaML::Core
 {
-    template <typename T>
-    std::string vector_to_string(const std::vector<T> &vec)
+    template <typename T, typename Alloc>
+    std::string vector_to_string(const std::vector<T, Alloc> &vec)
     {
         std::ostringstream oss;
         oss << "[";
@@ -20,8 +21,8 @@ namespace NovaML::Core
         return oss.str();
     }
 
-    template <typename T>
-    void check_size_match(const std::vector<T> &a, const std::vector<T> &b, const std::string &msg = "")
+    template <typename A, typename B>
+    void check_size_match(const A &a, const B &b, const std::string &msg = "")
     {
         if (a.size() != b.size())
         {
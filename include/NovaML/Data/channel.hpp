@@ -0,0 +1,76 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <utility>
+
+namespace NovaML::Data
+{
+    /**
+     * @brief Bounded blocking queue between the stages of a data pipeline.
+     *
+     * push() waits while `capacity` items are queued, pop() waits while
+     * none are. close() wakes everyone: pushes are refused from then on and
+     * pops drain what is left, then report the end of the stream.
+     */
+    template <typename Item>
+    class Channel
+    {
+    public:
+        explicit Channel(size_t capacity) : capacity(capacity == 0 ? 1 : capacity) {}
+
+        Channel(const Channel &) = delete;
+        Channel &operator=(const Channel &) = delete;
+
+        /// @return false if the channel was closed (the item is dropped).
+        bool push(Item item)
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            not_full.wait(lock, [this]
+                          { return closed || items.size() < capacity; });
+            if (closed)
+                return false;
+            items.push_back(std::move(item));
+            not_empty.notify_one();
+            return true;
+        }
+
+        /// @return false once the channel is closed and empty.
+        bool pop(Item &item)
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            not_empty.wait(lock, [this]
+                           { return closed || !items.empty(); });
+            if (items.empty())
+                return false;
+            item = std::move(items.front());
+            items.pop_front();
+            not_full.notify_one();
+            return true;
+        }
+
+        void close()
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            closed = true;
+            not_empty.notify_all();
+            not_full.notify_all();
+        }
+
+        /// Items ready to pop right now.
+        size_t size() const
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            return items.size();
+        }
+
+    private:
+        size_t capacity;
+        mutable std::mutex mutex;
+        std::condition_variable not_empty;
+        std::condition_variable not_full;
+        std::deque<Item> items;
+        bool closed = false;
+    };
+}
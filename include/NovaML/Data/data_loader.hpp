@@ -0,0 +1,127 @@
+#pragma once
+#include "../Core/Tensor/tensor.hpp"
+#include "channel.hpp"
+#include "data_source.hpp"
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace NovaML::Data
+{
+    struct DataLoaderOptions
+    {
+        size_t batch_size = 32;
+        size_t shuffle_buffer = 0;   ///< records held for shuffling (0: keep source order)
+        size_t prefetch = 2;         ///< collated batches kept ready ahead of the consumer
+        size_t num_workers = 1;      ///< reader threads; the sources are split between them
+        size_t chunk_records = 1024; ///< records per DataSource::read
+        bool drop_last = false;      ///< drop a final batch smaller than batch_size
+        uint64_t seed = 0;           ///< epoch e shuffles with seed + e
+    };
+
+    /// One mini-batch: contiguous [batch, input_size] inputs and [batch, target_size] targets.
+    template <typename T>
+    struct Batch
+    {
+        Core::Tensor<T> inputs = Core::Tensor<T>(0);
+        Core::Tensor<T> targets = Core::Tensor<T>(0);
+
+        size_t size() const { return inputs.ndim() == 2 ? inputs.dim(0) : 0; }
+    };
+
+    /**
+     * @brief Streams mini-batches from one or more record sources on background threads.
+     *
+     * Reader threads pull chunks of records from the sources (source i is
+     * read by worker i % num_workers). One batcher thread passes them
+     * through a bounded shuffle buffer, as in a streaming shuffle: once the
+     * buffer is full, every incoming record replaces a uniformly chosen one,
+     * which is emitted. Emitted records are collated straight into the
+     * contiguous input and target tensors of the next batch, and finished
+     * batches wait in a queue of `prefetch` entries, so reading, shuffling
+     * and collating overlap with the training step that consumes them.
+     * Memory use is bounded by the shuffle buffer and the queues, never by
+     * the dataset size.
+     *
+     * Epochs start as soon as the previous one ends (the first one on
+     * construction). With one worker the batch order depends only on the
+     * seed and the epoch; more workers interleave sources as they are read.
+     *
+     * @code
+     * Data::DataLoaderOptions options;
+     * options.batch_size = 256;
+     * options.shuffle_buffer = 1 << 16;
+     * // 16 inputs and 1 target per record
+     * Data::DataLoader<float> loader(std::make_shared<Data::BinaryFileSource<float>>("train.bin", 17), 16, options);
+     * Data::Batch<float> batch;
+     * while (loader.next(batch))
+     *     train_step(batch.inputs, batch.targets);
+     * @endcode
+     */
+    template <typename T = float>
+    class DataLoader
+    {
+    public:
+        /// Records of every source are `input_size` inputs followed by the targets.
+        DataLoader(std::vector<std::shared_ptr<DataSource<T>>> sources, size_t input_size,
+                   DataLoaderOptions options = {});
+        DataLoader(std::shared_ptr<DataSource<T>> source, size_t input_size, DataLoaderOptions options = {});
+        ~DataLoader();
+
+        DataLoader(const DataLoader &) = delete;
+        DataLoader &operator=(const DataLoader &) = delete;
+
+        /**
+         * @brief Take the next batch of the current epoch.
+         *
+         * Blocks until one is ready.
+         * @return false at the end of the epoch (the next one starts prefetching).
+         * @throws whatever a source threw while reading the epoch.
+         */
+        bool next(Batch<T> &batch);
+
+        /// Abandon the current epoch and start the next one.
+        void reset();
+
+        /// Epochs started so far (the current one is epoch() - 1).
+        size_t epoch() const { return epochs; }
+
+        size_t input_size() const { return inputs; }
+        size_t target_size() const { return record - inputs; }
+        const DataLoaderOptions &options() const { return opts; }
+
+    private:
+        struct Chunk
+        {
+            Memory::Buffer<T> values;
+            size_t records = 0;
+        };
+
+        void start();
+        void stop();
+        void read_sources(size_t worker);
+        void make_batches(uint64_t seed);
+        void fail(std::exception_ptr error);
+
+        std::vector<std::shared_ptr<DataSource<T>>> sources;
+        size_t inputs;
+        size_t record; ///< values per record
+        DataLoaderOptions opts;
+
+        std::unique_ptr<Channel<Chunk>> chunks;
+        std::unique_ptr<Channel<Batch<T>>> batches;
+        std::vector<std::thread> readers;
+        std::thread batcher;
+        std::atomic<size_t> readers_left{0};
+        std::mutex error_mutex;
+        std::exception_ptr error;
+        bool running = false;
+        size_t epochs = 0;
+    };
+}
+
+#include "data_loader.tpp"
@@ -0,0 +1,219 @@
+#pragma once
+#include "data_loader.hpp"
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+
+namespace NovaML::Data
+{
+    template <typename T>
+    DataLoader<T>::DataLoader(std::vector<std::shared_ptr<DataSource<T>>> sources, size_t input_size,
+                              DataLoaderOptions options)
+        : sources(std::move(sources)), inputs(input_size), opts(options)
+    {
+        if (this->sources.empty())
+            throw std::invalid_argument("DataLoader: no sources");
+        record = this->sources.front()->record_size();
+        for (const auto &source : this->sources)
+            if (!source || source->record_size() != record)
+                throw std::invalid_argument("DataLoader: sources must all have " + std::to_string(record) + "-value records");
+        if (inputs == 0 || inputs > record)
+            throw std::invalid_argument("DataLoader: input size " + std::to_string(inputs) + " does not fit a " +
+                                        std::to_string(record) + "-value record");
+        if (opts.batch_size == 0)
+            throw std::invalid_argument("DataLoader: batch size must be positive");
+        opts.num_workers = std::clamp<size_t>(opts.num_workers, 1, this->sources.size());
+        opts.chunk_records = std::max<size_t>(opts.chunk_records, 1);
+        start();
+    }
+
+    template <typename T>
+    DataLoader<T>::DataLoader(std::shared_ptr<DataSource<T>> source, size_t input_size, DataLoaderOptions options)
+        : DataLoader(std::vector<std::shared_ptr<DataSource<T>>>{std::move(source)}, input_size, options) {}
+
+    template <typename T>
+    DataLoader<T>::~DataLoader()
+    {
+        stop();
+    }
+
+    template <typename T>
+    bool DataLoader<T>::next(Batch<T> &batch)
+    {
+        if (!running)
+            start();
+        if (batches->pop(batch))
+            return true;
+
+        stop();
+        std::exception_ptr failure;
+        {
+            std::lock_guard<std::mutex> lock(error_mutex);
+            std::swap(failure, error);
+        }
+        if (failure)
+            std::rethrow_exception(failure); // the next call retries with a new epoch
+        start();
+        return false;
+    }
+
+    template <typename T>
+    void DataLoader<T>::reset()
+    {
+        stop();
+        start();
+    }
+
+    template <typename T>
+    void DataLoader<T>::start()
+    {
+        // Two chunks per reader keep every reader busy while the batcher works.
+        chunks = std::make_unique<Channel<Chunk>>(2 * opts.num_workers);
+        batches = std::make_unique<Channel<Batch<T>>>(opts.prefetch);
+        readers_left = opts.num_workers;
+        for (size_t w = 0; w < opts.num_workers; w++)
+            readers.emplace_back([this, w]
+                                 { read_sources(w); });
+        batcher = std::thread([this, seed = opts.seed + epochs]
+                              { make_batches(seed); });
+        running = true;
+        epochs++;
+    }
+
+    template <typename T>
+    void DataLoader<T>::stop()
+    {
+        if (!running)
+            return;
+        // Closing both queues makes every blocked push fail, so all stages return.
+        chunks->close();
+        batches->close();
+        for (auto &reader : readers)
+            reader.join();
+        readers.clear();
+        batcher.join();
+        running = false;
+    }
+
+    template <typename T>
+    void DataLoader<T>::fail(std::exception_ptr failure)
+    {
+        {
+            std::lock_guard<std::mutex> lock(error_mutex);
+            if (!error)
+                error = failure;
+        }
+        chunks->close();
+        batches->close();
+    }
+
+    // -------------------------
+    // Reader: chunks of records from this worker's sources, in order
+    // -------------------------
+    template <typename T>
+    void DataLoader<T>::read_sources(size_t worker)
+    {
+        try
+        {
+            for (size_t s = worker; s < sources.size(); s += opts.num_workers)
+            {
+                DataSource<T> &source = *sources[s];
+                source.rewind();
+                for (;;)
+                {
+                    Chunk chunk{Memory::Buffer<T>(opts.chunk_records * record)};
+                    chunk.records = source.read(chunk.values.data(), opts.chunk_records);
+                    if (chunk.records == 0 || !chunks->push(std::move(chunk)))
+                        break;
+                }
+            }
+        }
+        catch (...)
+        {
+            fail(std::current_exception());
+        }
+        if (--readers_left == 0)
+            chunks->close(); // lets the batcher drain its buffer
+    }
+
+    // -------------------------
+    // Batcher: streaming shuffle, then collation into contiguous batch tensors
+    // -------------------------
+    template <typename T>
+    void DataLoader<T>::make_batches(uint64_t seed)
+    {
+        try
+        {
+            const size_t targets = record - inputs;
+            const size_t capacity = opts.shuffle_buffer;
+            std::mt19937_64 rng(seed);
+            Memory::Buffer<T> pool(capacity * record);
+            size_t pooled = 0;
+
+            Memory::Buffer<T> batch_inputs, batch_targets;
+            size_t rows = 0;
+            auto finish = [&]
+            {
+                batch_inputs.resize(rows * inputs);
+                batch_targets.resize(rows * targets);
+                Batch<T> batch;
+                batch.inputs = Core::Tensor<T>(std::make_shared<Core::Storage<T>>(std::move(batch_inputs)),
+                                               Core::Layout::contiguous(Core::Shape{rows, inputs}));
+                batch.targets = Core::Tensor<T>(std::make_shared<Core::Storage<T>>(std::move(batch_targets)),
+                                                Core::Layout::contiguous(Core::Shape{rows, targets}));
+                rows = 0;
+                return batches->push(std::move(batch));
+            };
+            // Collate one record into the next row of the batch being built.
+            auto emit = [&](const T *values)
+            {
+                if (rows == 0)
+                {
+                    batch_inputs = Memory::Buffer<T>(opts.batch_size * inputs);
+                    batch_targets = Memory::Buffer<T>(opts.batch_size * targets);
+                }
+                std::copy(values, values + inputs, batch_inputs.data() + rows * inputs);
+                std::copy(values + inputs, values + record, batch_targets.data() + rows * targets);
+                return ++rows < opts.batch_size || finish();
+            };
+
+            Chunk chunk;
+            while (chunks->pop(chunk))
+                for (size_t r = 0; r < chunk.records; r++)
+                {
+                    const T *values = chunk.values.data() + r * record;
+                    if (capacity == 0)
+                    {
+                        if (!emit(values))
+                            return;
+                        continue;
+                    }
+                    if (pooled < capacity)
+                    {
+                        std::copy(values, values + record, pool.data() + pooled++ * record);
+                        continue;
+                    }
+                    T *slot = pool.data() + std::uniform_int_distribution<size_t>(0, capacity - 1)(rng) * record;
+                    if (!emit(slot))
+                        return;
+                    std::copy(values, values + record, slot);
+                }
+
+            // End of the epoch: the buffered records in random order.
+            for (; pooled > 0; pooled--)
+            {
+                T *slot = pool.data() + std::uniform_int_distribution<size_t>(0, pooled - 1)(rng) * record;
+                if (!emit(slot))
+                    return;
+                std::copy(pool.data() + (pooled - 1) * record, pool.data() + pooled * record, slot);
+            }
+            if (rows > 0 && !opts.drop_last)
+                finish();
+        }
+        catch (...)
+        {
+            fail(std::current_exception());
+        }
+        batches->close();
+    }
+}
@@ -0,0 +1,242 @@
+#pragma once
+#include "../Memory/mapped_file.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace NovaML::Data
+{
+    /**
+     * @brief A sequential stream of fixed-size records (one sample each).
+     *
+     * A record is `record_size()` values of T: the sample's inputs followed
+     * by its targets (DataLoader splits them). A source is only ever read
+     * by one thread at a time, so implementations need no locking.
+     */
+    template <typename T>
+    class DataSource
+    {
+    public:
+        virtual ~DataSource() = default;
+
+        /// Values per record.
+        virtual size_t record_size() const = 0;
+
+        /**
+         * @brief Copy up to `max_records` records into `out` (row-major).
+         * @return Records written; 0 once the source is exhausted.
+         */
+        virtual size_t read(T *out, size_t max_records) = 0;
+
+        /// Start over from the first record (next epoch).
+        virtual void rewind() = 0;
+    };
+
+    /// Records already in memory (tests, small datasets).
+    template <typename T>
+    class MemorySource : public DataSource<T>
+    {
+    public:
+        MemorySource(std::vector<T> values, size_t record_size)
+            : values(std::move(values)), record(record_size)
+        {
+            if (record == 0 || this->values.size() % record != 0)
+                throw std::invalid_argument("MemorySource: " + std::to_string(this->values.size()) +
+                                            " values are not a whole number of " + std::to_string(record) + "-value records");
+        }
+
+        size_t record_size() const override { return record; }
+
+        size_t read(T *out, size_t max_records) override
+        {
+            const size_t n = std::min(max_records, (values.size() - position) / record);
+            std::copy(values.begin() + position, values.begin() + position + n * record, out);
+            position += n * record;
+            return n;
+        }
+
+        void rewind() override { position = 0; }
+
+    private:
+        std::vector<T> values;
+        size_t record;
+        size_t position = 0;
+    };
+
+    enum class ReadMode
+    {
+        Mapped,   // map the whole file; pages are faulted in as records are read
+        Streaming // read the file in chunks through a stream buffer
+    };
+
+    /**
+     * @brief Headerless binary file of records: raw T values, native byte order.
+     *
+     * Mapped mode costs nothing up front and lets the page cache decide what
+     * stays resident; streaming mode keeps only one chunk in memory (files on
+     * filesystems that cannot be mapped, or on non-POSIX systems).
+     *
+     * @throws std::runtime_error if the file cannot be opened or its size is
+     *         not a whole number of records.
+     */
+    template <typename T>
+    class BinaryFileSource : public DataSource<T>
+    {
+    public:
+        BinaryFileSource(const std::string &path, size_t record_size, ReadMode mode = ReadMode::Mapped)
+            : path(path), record(record_size), mode(mode)
+        {
+            if (record == 0)
+                throw std::invalid_argument("BinaryFileSource: record size must be positive");
+            size_t bytes;
+            if (mode == ReadMode::Mapped)
+            {
+                file = Memory::MappedFile::open(path);
+                bytes = file->size();
+            }
+            else
+            {
+                stream.open(path, std::ios::binary | std::ios::ate);
+                if (!stream)
+                    throw std::runtime_error("BinaryFileSource: cannot open " + path);
+                bytes = static_cast<size_t>(stream.tellg());
+                stream.seekg(0);
+            }
+            if (bytes % (record * sizeof(T)) != 0)
+                throw std::runtime_error("BinaryFileSource: " + path + " (" + std::to_string(bytes) +
+                                         " bytes) is not a whole number of " + std::to_string(record * sizeof(T)) + "-byte records");
+            records = bytes / (record * sizeof(T));
+        }
+
+        size_t record_size() const override { return record; }
+        size_t num_records() const { return records; }
+
+        size_t read(T *out, size_t max_records) override
+        {
+            const size_t n = std::min(max_records, records - next);
+            const size_t bytes = n * record * sizeof(T);
+            if (n == 0)
+                return 0;
+            if (mode == ReadMode::Mapped)
+                std::memcpy(out, file->data() + next * record * sizeof(T), bytes);
+            else if (!stream.read(reinterpret_cast<char *>(out), static_cast<std::streamsize>(bytes)))
+                throw std::runtime_error("BinaryFileSource: cannot read " + path);
+            next += n;
+            return n;
+        }
+
+        void rewind() override
+        {
+            next = 0;
+            if (mode == ReadMode::Streaming)
+            {
+                stream.clear();
+                stream.seekg(0);
+            }
+        }
+
+    private:
+        std::string path;
+        size_t record;
+        ReadMode mode;
+        std::shared_ptr<Memory::MappedFile> file;
+        std::ifstream stream;
+        size_t records = 0;
+        size_t next = 0; ///< index of the next record to read
+    };
+
+    /**
+     * @brief Text file with one record per line, values separated by `delimiter`.
+     *
+     * Read as a stream: memory use does not depend on the file size. Blank
+     * lines are skipped; with `header` the first line is too.
+     *
+     * @throws std::runtime_error if the file cannot be opened, or (from read)
+     *         on a line that does not hold exactly record_size numbers.
+     */
+    template <typename T>
+    class CsvFileSource : public DataSource<T>
+    {
+    public:
+        CsvFileSource(const std::string &path, size_t record_size, bool header = false, char delimiter = ',')
+            : path(path), record(record_size), header(header), delimiter(delimiter), stream(path)
+        {
+            if (record == 0)
+                throw std::invalid_argument("CsvFileSource: record size must be positive");
+            if (!stream)
+                throw std::runtime_error("CsvFileSource: cannot open " + path);
+            rewind();
+        }
+
+        size_t record_size() const override { return record; }
+
+        size_t read(T *out, size_t max_records) override
+        {
+            size_t n = 0;
+            while (n < max_records && std::getline(stream, line))
+            {
+                ++line_number;
+                if (line.find_first_not_of(" \t\r") == std::string::npos)
+                    continue;
+                parse(line, out + n * record);
+                ++n;
+            }
+            return n;
+        }
+
+        void rewind() override
+        {
+            stream.clear();
+            stream.seekg(0);
+            line_number = 0;
+            if (header && std::getline(stream, line))
+                ++line_number;
+        }
+
+    private:
+        // 16-bit types convert from float
+        using Real = std::conditional_t<std::is_same_v<T, double>, double, float>;
+
+        void parse(const std::string &text, T *out) const
+        {
+            const char *p = text.c_str();
+            size_t column = 0;
+            for (;; ++column)
+            {
+                char *end;
+                const double value = std::strtod(p, &end);
+                if (end == p || column == record)
+                    break;
+                out[column] = static_cast<T>(static_cast<Real>(value));
+                p = end;
+                while (*p == ' ' || *p == '\t')
+                    ++p;
+                if (*p != delimiter)
+                {
+                    ++column;
+                    break;
+                }
+                ++p;
+            }
+            while (*p == ' ' || *p == '\t' || *p == '\r')
+                ++p;
+            if (column != record || *p != '\0')
+                throw std::runtime_error("CsvFileSource: " + path + ":" + std::to_string(line_number) + ": expected " +
+                                         std::to_string(record) + " numbers separated by '" + delimiter + "'");
+        }
+
+        std::string path;
+        size_t record;
+        bool header;
+        char delimiter;
+        std::ifstream stream;
+        std::string line;
+        size_t line_number = 0;
+    };
+}
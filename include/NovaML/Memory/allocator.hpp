@@ -0,0 +1,195 @@
+#pragma once
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace NovaML::Memory
+{
+    /// Alignment of every buffer handed out (one cache line, a full AVX-512 vector).
+    constexpr size_t buffer_alignment = 64;
+
+    /**
+     * @brief Counters describing how tensor memory was obtained.
+     *
+     * Byte counts are in rounded (bucket) sizes, i.e. what the allocator
+     * actually holds rather than what was requested.
+     */
+    struct AllocatorStats
+    {
+        size_t allocations = 0;        ///< allocate() calls
+        size_t deallocations = 0;      ///< deallocate() calls
+        size_t cache_hits = 0;         ///< allocations served from a free list
+        size_t system_allocations = 0; ///< allocations that reached the system allocator
+        size_t system_frees = 0;       ///< blocks returned to the system allocator
+        size_t bytes_in_use = 0;       ///< live bytes handed out to buffers
+        size_t peak_bytes_in_use = 0;  ///< high-water mark of bytes_in_use
+        size_t bytes_cached = 0;       ///< freed bytes kept for reuse
+    };
+
+    /**
+     * @brief Source of raw memory for tensor data and gradient buffers.
+     *
+     * Implementations must be thread-safe: buffers are created and released
+     * from any thread. Every block is aligned to buffer_alignment.
+     */
+    class Allocator
+    {
+    public:
+        virtual ~Allocator() = default;
+
+        virtual void *allocate(size_t bytes) = 0;
+        virtual void deallocate(void *ptr, size_t bytes) = 0;
+
+        virtual AllocatorStats stats() const = 0;
+        virtual void reset_stats() = 0;
+
+        /// Return cached but unused memory to the system (no-op when nothing is cached).
+        virtual void empty_cache() {}
+    };
+
+    /**
+     * @brief Caching allocator with size-bucketed free lists.
+     *
+     * Requests are rounded up to a size class (powers of two up to 1 MiB,
+     * then multiples of 1 MiB) and freed blocks are parked on the free list
+     * of their class, so the steady state of a training loop reuses the
+     * same blocks every iteration and never reaches malloc. Once more than
+     * `max_cached_bytes` are parked, further frees go straight back to the
+     * system.
+     */
+    class CachingAllocator : public Allocator
+    {
+    public:
+        explicit CachingAllocator(size_t max_cached_bytes = size_t(1) << 30);
+        ~CachingAllocator() override;
+
+        void *allocate(size_t bytes) override;
+        void deallocate(void *ptr, size_t bytes) override;
+
+        AllocatorStats stats() const override;
+        void reset_stats() override;
+        void empty_cache() override;
+
+        void set_max_cached_bytes(size_t bytes);
+
+        /// Size class a request of `bytes` is served from.
+        static size_t round_size(size_t bytes);
+
+    private:
+        struct Impl;
+        Impl *impl;
+    };
+
+    /// Uncached allocator: every request goes to the system (aligned new/delete).
+    class SystemAllocator : public Allocator
+    {
+    public:
+        SystemAllocator();
+        ~SystemAllocator() override;
+
+        void *allocate(size_t bytes) override;
+        void deallocate(void *ptr, size_t bytes) override;
+
+        AllocatorStats stats() const override;
+        void reset_stats() override;
+
+    private:
+        struct Impl;
+        Impl *impl;
+    };
+
+    /// Process-wide caching allocator (the default).
+    CachingAllocator &caching_allocator();
+
+    /// Process-wide uncached allocator.
+    SystemAllocator &system_allocator();
+
+    /**
+     * @brief Allocator used by buffers created from now on.
+     *
+     * Defaults to caching_allocator(), or system_allocator() when the
+     * environment sets NOVAML_ALLOCATOR=system. Existing buffers keep the
+     * allocator they were created with, so switching is always safe.
+     */
+    Allocator *get_allocator();
+    void set_allocator(Allocator *allocator);
+
+    /// Allocations made by one thread, through any allocator, since it started.
+    struct ThreadAllocations
+    {
+        size_t allocations = 0;
+        size_t bytes = 0;
+    };
+
+    /// Running totals for the calling thread; unaffected by reset_stats() (the profiler diffs them).
+    ThreadAllocations thread_allocations();
+
+    /// Shorthands for the current allocator.
+    inline AllocatorStats get_stats() { return get_allocator()->stats(); }
+    inline void reset_stats() { get_allocator()->reset_stats(); }
+    inline void empty_cache() { get_allocator()->empty_cache(); }
+
+    /**
+     * @brief Standard allocator adaptor over a NovaML Allocator.
+     *
+     * Captures the current allocator at construction. Elements are
+     * default-initialized, so `Buffer<T>(n)` leaves arithmetic values
+     * uninitialized for kernels that overwrite every element anyway;
+     * use `Buffer<T>(n, T(0))` when zeros are needed.
+     */
+    template <typename T>
+    class BufferAllocator
+    {
+    public:
+        using value_type = T;
+        using propagate_on_container_copy_assignment = std::true_type;
+        using propagate_on_container_move_assignment = std::true_type;
+        using propagate_on_container_swap = std::true_type;
+
+        BufferAllocator() noexcept : source(get_allocator()) {}
+        explicit BufferAllocator(Allocator *source) noexcept : source(source) {}
+        template <typename U>
+        BufferAllocator(const BufferAllocator<U> &other) noexcept : source(other.source) {}
+
+        T *allocate(size_t n)
+        {
+            return static_cast<T *>(source->allocate(n * sizeof(T)));
+        }
+
+        void deallocate(T *ptr, size_t n) noexcept
+        {
+            source->deallocate(ptr, n * sizeof(T));
+        }
+
+        template <typename U>
+        void construct(U *ptr) noexcept(std::is_nothrow_default_constructible_v<U>)
+        {
+            ::new (static_cast<void *>(ptr)) U;
+        }
+
+        template <typename U, typename... Args>
+        void construct(U *ptr, Args &&...args)
+        {
+            ::new (static_cast<void *>(ptr)) U(std::forward<Args>(args)...);
+        }
+
+        Allocator *resource() const { return source; }
+
+        template <typename U>
+        bool operator==(const BufferAllocator<U> &other) const { return source == other.source; }
+        template <typename U>
+        bool operator!=(const BufferAllocator<U> &other) const { return source != other.source; }
+
+    private:
+        template <typename U>
+        friend class BufferAllocator;
+
+        Allocator *source;
+    };
+
+    /// Contiguous element buffer backed by the current NovaML allocator.
+    template <typename T>
+    using Buffer = std::vector<T, BufferAllocator<T>>;
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace NovaML::Memory
+{
+    /**
+     * @brief A whole file mapped into memory, copy-on-write.
+     *
+     * Opening costs the same for any file size: pages are read from the
+     * file (or shared with the page cache) on first access. Writes go to
+     * private copies of the touched pages and never reach the file. The
+     * mapping starts on a page boundary. Without mmap (non-POSIX systems)
+     * the file is read into an aligned buffer instead.
+     */
+    class MappedFile
+    {
+    public:
+        /// @throws std::runtime_error if the file cannot be opened or mapped.
+        static std::shared_ptr<MappedFile> open(const std::string &path);
+
+        ~MappedFile();
+        MappedFile(const MappedFile &) = delete;
+        MappedFile &operator=(const MappedFile &) = delete;
+
+        char *data() { return base; }
+        const char *data() const { return base; }
+        size_t size() const { return length; }
+
+    private:
+        MappedFile(char *base, size_t length, bool mapped) : base(base), length(length), mapped(mapped) {}
+
+        char *base;
+        size_t length;
+        bool mapped; ///< false: heap copy
+    };
+
+    /**
+     * @brief `bytes` of zero-initialized memory that costs nothing until written.
+     *
+     * An anonymous mapping: the OS hands out zero pages on first touch, so
+     * a large, mostly unused buffer (inference-time gradients) is free.
+     * Falls back to a zeroed heap buffer without mmap.
+     */
+    std::shared_ptr<void> map_zeros(size_t bytes);
+}
@@ -0,0 +1,112 @@
+#pragma once
+#include "thread_pool.hpp"
+#include "../Core/Module/sequential.hpp"
+#include "../Core/Layer/normalization.hpp"
+#include "../Core/Loss/mse.hpp"
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace NovaML::Parallel
+{
+    struct DataParallelOptions
+    {
+        size_t replicas = 0;             ///< model copies, one per task (0: one per thread of the global pool)
+        size_t bucket_bytes = 256 << 10; ///< gradient bytes summed per all-reduce bucket
+        Core::LossModule::Reduction reduction = Core::LossModule::Reduction::Mean;
+    };
+
+    /**
+     * @brief Data-parallel training of one Sequential on the global thread pool.
+     *
+     * The model is copied into `replicas` instances built by `make_replica`;
+     * all of them read the model's flat parameters (one ParameterBuffer, see
+     * parameters()) and each writes its own gradients. backward() splits the
+     * batch row-wise into one shard per replica and runs each replica's
+     * forward, loss and backward as a task of the pool.
+     *
+     * Gradients are summed into parameters()->grad by a bucketed all-reduce
+     * that overlaps the backward passes. The buffer is cut into buckets of
+     * bucket_bytes. Backward finishes the layers from last to first, so
+     * buckets become ready from the end of the buffer towards its start. A
+     * bucket is summed over every replica as soon as all replicas are past
+     * it, by whichever task gets there first, while the others are still
+     * computing earlier layers. With a Mean loss each shard's gradient is
+     * weighted by its share of the rows, so the result equals the gradient
+     * of the whole batch on one model. Then one optimizer step over
+     * parameters() updates every replica at once:
+     *
+     * @code
+     * Parallel::DataParallel<float> trainer(model, make_model);
+     * OptimizerModule::Adam<float> optimizer(trainer.parameters(), 1e-3f);
+     * while (loader.next(batch))
+     * {
+     *     trainer.backward(batch.inputs, batch.targets);
+     *     optimizer.step();
+     * }
+     * @endcode
+     *
+     * Construct the optimizer from parameters() after the trainer: the
+     * trainer flattens the model's parameters into a new buffer.
+     *
+     * Each replica's BatchNorm layers normalize with their own shard's
+     * statistics (no synchronized batch norm). Their running statistics are
+     * merged after every step, as if one model had seen the whole batch,
+     * and copied to every replica, so the model's running statistics match
+     * single-process training.
+     */
+    template <typename T = float, typename Loss = Core::LossModule::MSELoss<T>>
+    class DataParallel
+    {
+    public:
+        using Model = Core::Module::Sequential<T>;
+        /// Builds a model with the same layers as the one being trained (the weights are replaced).
+        using Factory = std::function<std::shared_ptr<Model>()>;
+
+        /// @throws std::invalid_argument if a replica's parameters do not match the model's
+        DataParallel(std::shared_ptr<Model> model, const Factory &make_replica, DataParallelOptions options = {});
+
+        /**
+         * @brief Forward and backward of one batch, gradients all-reduced into parameters()->grad.
+         *
+         * `inputs` is [batch, features] and `targets` has `batch` rows too.
+         * A batch smaller than the replica count uses only the first replicas.
+         *
+         * @return the loss of the whole batch
+         */
+        T backward(const Core::Tensor<T> &inputs, const Core::Tensor<T> &targets);
+
+        /// The model's parameters, shared by every replica, and the reduced gradients.
+        const std::shared_ptr<Core::Module::ParameterBuffer<T>> &parameters() const { return params; }
+
+        size_t num_replicas() const { return replicas.size(); }
+        size_t num_buckets() const { return bucket_begin.size(); }
+
+    private:
+        /// Gradient memory of a replica; its ParameterBuffer reads the model's values.
+        struct ReplicaGradients;
+
+        void run_replica(size_t r, const Core::Tensor<T> &inputs, const Core::Tensor<T> &targets, size_t active);
+        /// Sum the buckets every active replica is past; the last replica to finish gets the rest.
+        void reduce_ready(size_t active);
+        void reduce_bucket(size_t b, size_t active);
+        void merge_batch_norms(size_t active, const std::vector<std::vector<T>> &mean0, const std::vector<std::vector<T>> &var0);
+
+        std::vector<std::shared_ptr<Model>> replicas; ///< replicas[0] is the model itself
+        std::vector<Loss> losses;
+        std::vector<T> shard_loss;
+        std::shared_ptr<Core::Module::ParameterBuffer<T>> params;
+        std::vector<T *> grads;           ///< per replica, the gradient array (grads[0] is params->grad)
+        std::vector<size_t> module_begin; ///< per submodule, its first element in the buffer
+        std::vector<size_t> bucket_begin; ///< buckets cover [bucket_begin[b], bucket_begin[b + 1] or the end)
+        std::vector<std::vector<Core::LayerModule::BatchNorm<T> *>> batch_norms; ///< per replica, in model order
+        DataParallelOptions opts;
+
+        /// Per replica, the start of the gradients its backward has finished so far.
+        std::unique_ptr<std::atomic<size_t>[]> frontier;
+        std::atomic<size_t> unclaimed{0}; ///< buckets [0, unclaimed) are not reduced yet
+    };
+}
+
+#include "data_parallel.tpp"
@@ -0,0 +1,221 @@
+#pragma once
+#include "data_parallel.hpp"
+#include "../Profiler/profiler.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace NovaML::Parallel
+{
+    namespace detail
+    {
+        /// BatchNorm layers of `module` in forward order, nested containers included.
+        template <typename T>
+        void collect_batch_norms(Core::Module::BaseModule<T> &module, std::vector<Core::LayerModule::BatchNorm<T> *> &out)
+        {
+            if (auto *bn = dynamic_cast<Core::LayerModule::BatchNorm<T> *>(&module))
+                out.push_back(bn);
+            else if (auto *seq = dynamic_cast<Core::Module::Sequential<T> *>(&module))
+                for (size_t i = 0; i < seq->size(); i++)
+                    collect_batch_norms(*seq->at(i), out);
+        }
+    }
+
+    template <typename T, typename Loss>
+    struct DataParallel<T, Loss>::ReplicaGradients
+    {
+        std::shared_ptr<Core::Module::ParameterBuffer<T>> values; ///< keeps the shared values alive
+        Core::Module::ParameterArray<T> grad;
+
+        ReplicaGradients(std::shared_ptr<Core::Module::ParameterBuffer<T>> values, size_t size)
+            : values(std::move(values)), grad(size) {}
+    };
+
+    template <typename T, typename Loss>
+    DataParallel<T, Loss>::DataParallel(std::shared_ptr<Model> model, const Factory &make_replica, DataParallelOptions options)
+        : opts(options)
+    {
+        if (!model)
+            throw std::invalid_argument("DataParallel: no model");
+        if (opts.replicas == 0)
+            opts.replicas = get_num_threads();
+
+        params = Core::Module::flatten_parameters(*model);
+        const size_t size = params->size();
+        replicas.push_back(model);
+        grads.push_back(params->grad.data());
+
+        // Binding copies a replica's own values into the shared buffer: put the model's back afterwards.
+        const Memory::Buffer<T> values(params->data.begin(), params->data.end());
+        for (size_t r = 1; r < opts.replicas; r++)
+        {
+            auto replica = make_replica();
+            if (!replica || replica->parameter_size() != size || replica->size() != model->size())
+                throw std::invalid_argument("DataParallel: replica " + std::to_string(r) + " does not have the model's parameters");
+            auto gradients = std::make_shared<ReplicaGradients>(params, size);
+            T *grad = gradients->grad.data();
+            replica->bind_parameters(std::make_shared<Core::Module::ParameterBuffer<T>>(params->data.data(), grad, size, gradients), 0);
+            replicas.push_back(replica);
+            grads.push_back(grad);
+        }
+        std::copy(values.begin(), values.end(), params->data.begin());
+
+        // Submodule blocks follow each other in the buffer (see BaseModule::bind_parameters).
+        size_t offset = 0;
+        for (size_t i = 0; i < model->size(); i++)
+        {
+            module_begin.push_back(offset);
+            offset += model->at(i)->parameter_size();
+        }
+
+        const size_t per_bucket = Core::Module::aligned_elements<T>(std::max<size_t>(opts.bucket_bytes / sizeof(T), 1));
+        for (size_t b = 0; b < size; b += per_bucket)
+            bucket_begin.push_back(b);
+
+        batch_norms.resize(replicas.size());
+        for (size_t r = 0; r < replicas.size(); r++)
+            detail::collect_batch_norms<T>(*replicas[r], batch_norms[r]);
+
+        losses.assign(replicas.size(), Loss(opts.reduction));
+        shard_loss.assign(replicas.size(), T(0));
+        frontier = std::make_unique<std::atomic<size_t>[]>(replicas.size());
+    }
+
+    template <typename T, typename Loss>
+    T DataParallel<T, Loss>::backward(const Core::Tensor<T> &inputs, const Core::Tensor<T> &targets)
+    {
+        if (inputs.ndim() != 2 || targets.ndim() == 0 || targets.dim(0) != inputs.dim(0) || inputs.dim(0) == 0)
+            throw std::invalid_argument("DataParallel: expected [batch, features] inputs and targets with the same rows, got " +
+                                        Core::shape_to_string(inputs.shape()) + " and " + Core::shape_to_string(targets.shape()));
+        Profiler::RecordScope scope("DataParallel.backward", Profiler::Category::Module);
+        const auto contiguous = [](const Core::Tensor<T> &t)
+        { return t.is_contiguous() ? t : Core::Tensor<T>(t.get_data(), t.shape()); };
+        const Core::Tensor<T> x = contiguous(inputs), y = contiguous(targets);
+
+        const size_t active = std::min(replicas.size(), inputs.dim(0));
+        // Every replica holds the same running statistics here (see merge_batch_norms).
+        std::vector<std::vector<T>> mean0, var0;
+        for (auto *bn : batch_norms[0])
+        {
+            mean0.push_back(bn->running_mean());
+            var0.push_back(bn->running_var());
+        }
+        for (size_t r = 0; r < active; r++)
+            frontier[r].store(params->size(), std::memory_order_relaxed);
+        unclaimed.store(bucket_begin.size(), std::memory_order_relaxed);
+
+        parallel_for(0, active, 1, [&](size_t begin, size_t end)
+                     {
+            for (size_t r = begin; r < end; r++)
+                run_replica(r, x, y, active); });
+        merge_batch_norms(active, mean0, var0);
+
+        T loss = T(0);
+        for (size_t r = 0; r < active; r++)
+            loss += shard_loss[r];
+        return loss;
+    }
+
+    template <typename T, typename Loss>
+    void DataParallel<T, Loss>::run_replica(size_t r, const Core::Tensor<T> &inputs, const Core::Tensor<T> &targets, size_t active)
+    {
+        // Rows [begin, end) of the batch, as views of the same storage.
+        const size_t batch = inputs.dim(0);
+        const size_t begin = r * batch / active, end = (r + 1) * batch / active, rows = end - begin;
+        auto shard = [&](const Core::Tensor<T> &t)
+        {
+            Core::Shape shape = t.shape();
+            const size_t row = t.size() / batch;
+            shape.front() = rows;
+            Core::Layout layout = Core::Layout::contiguous(shape);
+            layout.offset = t.get_layout().offset + begin * row;
+            return Core::Tensor<T>(t.get_storage(), layout);
+        };
+
+        Model &model = *replicas[r];
+        Loss &criterion = losses[r];
+        const T weight = opts.reduction == Core::LossModule::Reduction::Mean ? T(double(rows) / double(batch)) : T(1);
+        shard_loss[r] = weight * criterion.forward(model.forward(shard(inputs)), shard(targets));
+
+        Core::Tensor<T> grad = criterion.backward();
+        if (!grad.is_contiguous())
+            grad = Core::Tensor<T>(grad.get_data(), grad.shape());
+        if (weight != T(1))
+        {
+            T *g = grad.data_ptr();
+            for (size_t i = 0; i < grad.size(); i++)
+                g[i] *= weight;
+        }
+
+        if (model.num_segments() > 0)
+            grad = model.backward(grad); // checkpointed: the segments recompute inside
+        else
+            for (size_t i = model.size(); i-- > 0;)
+            {
+                if (model.is_fused(i))
+                    continue;
+                const auto &m = model.at(i);
+                {
+                    Profiler::RecordScope scope([&m]
+                                                { return Core::Module::module_name(*m) + ".backward"; }, Profiler::Category::Module);
+                    grad = m->backward(grad);
+                }
+                frontier[r].store(module_begin[i], std::memory_order_release);
+                reduce_ready(active);
+            }
+        frontier[r].store(0, std::memory_order_release);
+        reduce_ready(active);
+    }
+
+    template <typename T, typename Loss>
+    void DataParallel<T, Loss>::reduce_ready(size_t active)
+    {
+        for (;;)
+        {
+            size_t b = unclaimed.load(std::memory_order_acquire);
+            if (b == 0)
+                return;
+            // Buckets become ready from the last one down, so only the next one needs checking.
+            for (size_t r = 0; r < active; r++)
+                if (frontier[r].load(std::memory_order_acquire) > bucket_begin[b - 1])
+                    return;
+            if (unclaimed.compare_exchange_weak(b, b - 1, std::memory_order_acq_rel))
+                reduce_bucket(b - 1, active);
+        }
+    }
+
+    template <typename T, typename Loss>
+    void DataParallel<T, Loss>::reduce_bucket(size_t b, size_t active)
+    {
+        Profiler::RecordScope scope("DataParallel.all_reduce", Profiler::Category::Kernel);
+        const size_t begin = bucket_begin[b];
+        const size_t end = b + 1 < bucket_begin.size() ? bucket_begin[b + 1] : params->size();
+        T *dst = grads[0];
+        for (size_t r = 1; r < active; r++)
+        {
+            const T *src = grads[r];
+            for (size_t i = begin; i < end; i++)
+                dst[i] += src[i];
+        }
+    }
+
+    template <typename T, typename Loss>
+    void DataParallel<T, Loss>::merge_batch_norms(size_t active, const std::vector<std::vector<T>> &mean0,
+                                                  const std::vector<std::vector<T>> &var0)
+    {
+        for (size_t k = 0; k < batch_norms[0].size(); k++)
+        {
+            Core::LayerModule::BatchNorm<T> &master = *batch_norms[0][k];
+            if (!master.is_training())
+                continue;
+            std::vector<const Core::LayerModule::BatchNorm<T> *> shards;
+            for (size_t r = 0; r < active; r++)
+                shards.push_back(batch_norms[r][k]);
+            master.merge_shard_statistics(shards, mean0[k], var0[k]);
+            for (size_t r = 1; r < replicas.size(); r++)
+            {
+                batch_norms[r][k]->running_mean() = master.running_mean();
+                batch_norms[r][k]->running_var() = master.running_var();
+            }
+        }
+    }
+}
@@ -0,0 +1,115 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+#include <type_traits>
+
+namespace NovaML::Parallel
+{
+    /// Element count below which element-wise kernels stay on the calling thread.
+    constexpr size_t elementwise_grain = 1 << 15;
+
+    /**
+     * @brief Persistent work-stealing thread pool used for intra-op parallelism.
+     *
+     * Every worker owns a task deque: it pops its own work LIFO and steals
+     * FIFO from the others when idle. The thread that submits a range also
+     * executes tasks until the range is finished, so nested parallel_for
+     * calls from inside a task cannot deadlock.
+     */
+    class ThreadPool
+    {
+    public:
+        using RangeFn = void (*)(void *ctx, size_t begin, size_t end);
+
+        /// Process-wide pool, sized from NOVAML_NUM_THREADS or the hardware concurrency.
+        static ThreadPool &instance();
+
+        explicit ThreadPool(size_t num_threads);
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool &) = delete;
+        ThreadPool &operator=(const ThreadPool &) = delete;
+
+        /// Threads that execute work, including the submitting thread.
+        size_t num_threads() const;
+
+        /**
+         * @brief Stop the current workers and start num_threads - 1 new ones.
+         *
+         * @throws std::logic_error while any thread is inside run() (or a
+         *         parallel_for on this pool), including from inside a task.
+         */
+        void resize(size_t num_threads);
+
+        /**
+         * @brief Run fn(ctx, b, e) over chunks of [begin, end) of at least `grain` elements.
+         *
+         * Blocks until every chunk is done. The first exception thrown by a
+         * chunk is rethrown here after the remaining chunks have finished.
+         */
+        void run(size_t begin, size_t end, size_t grain, RangeFn fn, void *ctx);
+
+    private:
+        struct Impl;
+        Impl *impl;
+    };
+
+    /// Number of threads intra-op kernels split work across.
+    size_t get_num_threads();
+
+    /// Resize the global pool; 0 selects the hardware concurrency. Throws while a parallel range is running.
+    void set_num_threads(size_t num_threads);
+
+    /**
+     * @brief Run fn(begin, end) over sub-ranges of [begin, end) on the global pool.
+     *
+     * Ranges of at most `grain` elements (or a single-threaded pool) run
+     * inline on the calling thread with no synchronization at all.
+     */
+    template <typename F>
+    void parallel_for(size_t begin, size_t end, size_t grain, F &&fn)
+    {
+        if (end <= begin)
+            return;
+        if (end - begin <= grain || get_num_threads() <= 1)
+        {
+            fn(begin, end);
+            return;
+        }
+        using Fn = std::remove_reference_t<F>;
+        ThreadPool::instance().run(begin, end, grain, [](void *ctx, size_t b, size_t e)
+                                   { (*static_cast<Fn *>(ctx))(b, e); },
+                                   const_cast<void *>(static_cast<const void *>(&fn)));
+    }
+
+    /**
+     * @brief Reduce [begin, end) with map(b, e) -> R over chunks, then fold with combine.
+     *
+     * Chunk boundaries depend only on the range and `grain`, and partials are
+     * combined in order, so the result is identical for any thread count.
+     */
+    template <typename R, typename Map, typename Combine>
+    R parallel_reduce(size_t begin, size_t end, size_t grain, R identity, Map &&map, Combine &&combine)
+    {
+        if (end <= begin)
+            return identity;
+        grain = grain == 0 ? 1 : grain;
+        const size_t chunks = (end - begin + grain - 1) / grain;
+        if (chunks == 1)
+            return combine(identity, map(begin, end));
+
+        std::vector<R> partials(chunks, identity);
+        parallel_for(0, chunks, 1, [&](size_t c0, size_t c1)
+                     {
+                         for (size_t c = c0; c < c1; c++)
+                         {
+                             size_t b = begin + c * grain;
+                             partials[c] = map(b, b + grain < end ? b + grain : end);
+                         } });
+
+        R result = identity;
+        for (const auto &p : partials)
+            result = combine(result, p);
+        return result;
+    }
+}
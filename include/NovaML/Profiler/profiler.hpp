@@ -0,0 +1,180 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+#include "../Memory/allocator.hpp"
+
+namespace NovaML::Profiler
+{
+    // -------------------------
+    // Op-level profiler
+    //
+    // Tensor ops, autograd backward nodes and module forward/backward calls
+    // open a RecordScope. While the profiler is disabled a scope costs one
+    // relaxed atomic load; while enabled it records wall time, the FLOPs and
+    // bytes the op reports, the allocations it made and the thread it ran
+    // on. Events go to per-thread buffers and are merged on demand into an
+    // aggregated table or a Chrome / Perfetto trace.
+    //
+    //     Profiler::enable();
+    //     model.forward(x);
+    //     Profiler::disable();
+    //     std::cout << Profiler::summary_table();
+    //     Profiler::export_chrome_trace("trace.json");
+    //
+    // Setting NOVAML_PROFILE=<path> profiles the whole process and writes the
+    // trace to <path> (and the table to stderr) at exit. Building with
+    // NOVAML_DISABLE_PROFILER compiles every scope away.
+    // -------------------------
+
+    enum class Category
+    {
+        Op,       // forward tensor op
+        Backward, // autograd node in a backward pass
+        Module,   // module forward / backward / update
+        Kernel,   // low-level kernel (GEMM, ...)
+        User      // scopes opened by application code
+    };
+
+    std::string category_name(Category category);
+
+    /// One completed scope.
+    struct Event
+    {
+        std::string name;
+        Category category = Category::User;
+        uint64_t start_ns = 0;    ///< since the profiler was enabled
+        uint64_t duration_ns = 0; ///< inclusive wall time
+        uint64_t self_ns = 0;     ///< duration minus directly nested scopes on the same thread
+        uint32_t thread = 0;      ///< small sequential thread id
+        uint32_t depth = 0;       ///< nesting level on its thread
+        double flops = 0;
+        double bytes = 0;
+        size_t allocations = 0;
+        size_t allocated_bytes = 0;
+    };
+
+    /// Events with the same name and category, added up.
+    struct OpSummary
+    {
+        std::string name;
+        Category category = Category::User;
+        size_t calls = 0;
+        uint64_t total_ns = 0;
+        uint64_t self_ns = 0;
+        double flops = 0;
+        double bytes = 0;
+        size_t allocations = 0;
+    };
+
+    namespace detail
+    {
+        extern std::atomic<bool> enabled;
+
+        /// Push a scope on the calling thread's stack; returns its start time.
+        uint64_t begin_scope();
+        void end_scope(std::string name, Category category, uint64_t start_ns,
+                       double flops, double bytes, const Memory::ThreadAllocations &before);
+    }
+
+    /// Start recording (keeps events recorded earlier; see clear()).
+    void enable();
+    void disable();
+    inline bool is_enabled() { return detail::enabled.load(std::memory_order_relaxed); }
+
+    /// Drop every recorded event and restart the clock.
+    void clear();
+
+    /// All events recorded so far, ordered by thread then start time.
+    std::vector<Event> events();
+
+    /// Per (name, category) totals, sorted by self time, largest first.
+    std::vector<OpSummary> summarize();
+
+    /// Human-readable table of summarize(): calls, total/self time, share, GFLOP/s, GB/s, allocations.
+    std::string summary_table(size_t max_rows = 30);
+
+    /// Write a Chrome trace-event JSON file (chrome://tracing, ui.perfetto.dev).
+    void export_chrome_trace(const std::string &path);
+
+    /**
+     * @brief Record the enclosing block as one event.
+     *
+     * The name is only materialized when the profiler is enabled, so pass a
+     * literal or a callable producing the string for dynamic names.
+     */
+#ifndef NOVAML_DISABLE_PROFILER
+    class RecordScope
+    {
+    public:
+        RecordScope(const char *name, Category category = Category::User)
+        {
+            if (is_enabled())
+                start(name, category);
+        }
+
+        /// Scope with known work, e.g. RecordScope("add", Category::Op, n, 3 * n * sizeof(T)).
+        RecordScope(const char *name, Category category, double op_flops, double op_bytes)
+            : RecordScope(name, category)
+        {
+            set_counters(op_flops, op_bytes);
+        }
+
+        template <typename NameFn, typename = decltype(std::string(std::declval<NameFn>()()))>
+        RecordScope(NameFn &&name_fn, Category category = Category::User)
+        {
+            if (is_enabled())
+                start(name_fn(), category);
+        }
+
+        ~RecordScope()
+        {
+            if (active)
+                detail::end_scope(std::move(name), category, start_ns, flops, bytes, allocations);
+        }
+
+        RecordScope(const RecordScope &) = delete;
+        RecordScope &operator=(const RecordScope &) = delete;
+
+        /// Work done inside the scope, for GFLOP/s and GB/s.
+        void set_counters(double op_flops, double op_bytes)
+        {
+            flops = op_flops;
+            bytes = op_bytes;
+        }
+
+        bool recording() const { return active; }
+
+    private:
+        void start(std::string scope_name, Category scope_category)
+        {
+            active = true;
+            name = std::move(scope_name);
+            category = scope_category;
+            allocations = Memory::thread_allocations();
+            start_ns = detail::begin_scope();
+        }
+
+        bool active = false;
+        std::string name;
+        Category category = Category::User;
+        uint64_t start_ns = 0;
+        double flops = 0;
+        double bytes = 0;
+        Memory::ThreadAllocations allocations;
+    };
+#else
+    class RecordScope
+    {
+    public:
+        template <typename Name>
+        RecordScope(Name &&, Category = Category::User) {}
+        RecordScope(const char *, Category, double, double) {}
+        void set_counters(double, double) {}
+        bool recording() const { return false; }
+    };
+#endif
+}
@@ -0,0 +1,129 @@
+#pragma once
+#include "../Core/Module/module.hpp"
+#include "../Core/Tensor/tensor.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace NovaML::Serving
+{
+    struct ServerOptions
+    {
+        size_t max_batch_size = 32;                ///< rows merged into one model call
+        std::chrono::microseconds max_delay{1000}; ///< longest the oldest request waits for its batch to fill
+        size_t num_workers = 1;                    ///< threads running batches
+        size_t queue_capacity = 4096;              ///< queued rows before submit() blocks
+    };
+
+    struct ServerStats
+    {
+        size_t requests = 0;     ///< answered, with a result or an exception
+        size_t batches = 0;      ///< model calls
+        size_t rows = 0;         ///< rows over all batches
+        size_t full_batches = 0; ///< dispatched because max_batch_size rows were queued (the others hit the deadline)
+        size_t failed = 0;       ///< requests answered with an exception
+
+        double mean_batch_size() const { return batches ? double(rows) / double(batches) : 0.0; }
+    };
+
+    /**
+     * @brief In-process model server with dynamic batching.
+     *
+     * submit() queues a request and returns a future for its output.
+     * Workers take requests from the queue in arrival order and merge them
+     * into one [rows, input_size] batch: a worker dispatches as soon as
+     * max_batch_size rows are queued, or when the oldest queued request has
+     * waited max_delay, whichever comes first. So under load the model runs
+     * on full batches, and at low load no request waits for its batch longer
+     * than max_delay (plus the time for a worker to become free).
+     *
+     * The batch goes through the model's infer(), which only reads the
+     * model, so every worker shares the one instance. Row r of the output
+     * goes back to the request that contributed input row r. If the model
+     * throws, every request of that batch receives the exception.
+     *
+     * @code
+     * Serving::ServerOptions options;
+     * options.max_batch_size = 64;
+     * options.max_delay = std::chrono::microseconds(500);
+     * Serving::InferenceServer<float> server(model, 784, options);
+     * std::future<Core::Tensor<float>> y = server.submit(sample); // [784] -> [10]
+     * @endcode
+     */
+    template <typename T = float>
+    class InferenceServer
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        /// `model` must not be modified while the server runs.
+        InferenceServer(std::shared_ptr<const Core::Module::BaseModule<T>> model, size_t input_size,
+                        ServerOptions options = {});
+        /// Answers every queued request, then stops the workers.
+        ~InferenceServer();
+
+        InferenceServer(const InferenceServer &) = delete;
+        InferenceServer &operator=(const InferenceServer &) = delete;
+
+        /**
+         * @brief Queue one sample [input_size] or a block of rows [rows, input_size].
+         *
+         * Blocks while queue_capacity rows are already queued. The rows are
+         * copied before submit() returns, so the caller may overwrite `input`
+         * right away. The output of a sample drops the batch dimension; a
+         * block keeps it.
+         *
+         * @throws std::invalid_argument if the input has the wrong shape
+         * @throws std::logic_error after shutdown()
+         */
+        std::future<Core::Tensor<T>> submit(const Core::Tensor<T> &input);
+
+        /// Refuse new requests, answer the queued ones and join the workers.
+        void shutdown();
+
+        ServerStats stats() const;
+
+        /// Requests queued and not yet taken by a worker.
+        size_t pending() const;
+
+        const ServerOptions &options() const { return opts; }
+
+    private:
+        struct Request
+        {
+            Core::Tensor<T> input; ///< contiguous copy of the submitted rows
+            size_t rows;
+            bool sample; ///< a single [input_size] row: the output drops the batch dimension
+            Clock::time_point deadline;
+            std::promise<Core::Tensor<T>> result;
+        };
+
+        void work();
+        /// Wait for the next batch to be due and move its requests out of the queue.
+        bool next_batch(std::vector<Request> &batch, bool &full);
+        void run(std::vector<Request> &batch);
+
+        std::shared_ptr<const Core::Module::BaseModule<T>> model;
+        size_t input_size;
+        ServerOptions opts;
+
+        mutable std::mutex mutex;
+        std::condition_variable not_empty;
+        std::condition_variable not_full;
+        std::deque<Request> queue;
+        size_t queued_rows = 0;
+        bool stopping = false;
+        std::vector<std::thread> workers;
+
+        std::atomic<size_t> requests{0}, batches{0}, rows{0}, full_batches{0}, failed{0};
+    };
+}
+
+#include "inference_server.tpp"
@@ -0,0 +1,216 @@
+#pragma once
+#include "inference_server.hpp"
+#include "../Profiler/profiler.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace NovaML::Serving
+{
+    template <typename T>
+    InferenceServer<T>::InferenceServer(std::shared_ptr<const Core::Module::BaseModule<T>> model, size_t input_size,
+                                        ServerOptions options)
+        : model(std::move(model)), input_size(input_size), opts(options)
+    {
+        if (!this->model)
+            throw std::invalid_argument("InferenceServer: no model");
+        if (input_size == 0)
+            throw std::invalid_argument("InferenceServer: input size must be positive");
+        opts.max_batch_size = std::max<size_t>(opts.max_batch_size, 1);
+        opts.num_workers = std::max<size_t>(opts.num_workers, 1);
+        opts.queue_capacity = std::max(opts.queue_capacity, opts.max_batch_size);
+        for (size_t w = 0; w < opts.num_workers; w++)
+            workers.emplace_back([this]
+                                 { work(); });
+    }
+
+    template <typename T>
+    InferenceServer<T>::~InferenceServer()
+    {
+        shutdown();
+    }
+
+    template <typename T>
+    std::future<Core::Tensor<T>> InferenceServer<T>::submit(const Core::Tensor<T> &input)
+    {
+        const bool sample = input.ndim() == 1;
+        if ((input.ndim() != 1 && input.ndim() != 2) || input.shape().back() != input_size || input.size() == 0)
+            throw std::invalid_argument("InferenceServer: expected input of shape [rows, " + std::to_string(input_size) +
+                                        "] or [" + std::to_string(input_size) + "], got " + Core::shape_to_string(input.shape()));
+        // Snapshot the rows: the caller may reuse its tensor as soon as submit() returns.
+        Memory::Buffer<T> values(input.size());
+        if (input.is_contiguous())
+            std::copy(input.data_ptr(), input.data_ptr() + input.size(), values.data());
+        else
+        {
+            const std::vector<T> data = input.get_data();
+            std::copy(data.begin(), data.end(), values.data());
+        }
+        Core::Tensor<T> rows_copy(std::make_shared<Core::Storage<T>>(std::move(values)), Core::Layout::contiguous(input.shape()));
+        Request request{std::move(rows_copy), sample ? 1 : input.dim(0), sample, Clock::now() + opts.max_delay, {}};
+        auto result = request.result.get_future();
+
+        std::unique_lock<std::mutex> lock(mutex);
+        // A block larger than the capacity still goes in once the queue is empty.
+        not_full.wait(lock, [&]
+                      { return stopping || queued_rows == 0 || queued_rows + request.rows <= opts.queue_capacity; });
+        if (stopping)
+            throw std::logic_error("InferenceServer: submit after shutdown");
+        queued_rows += request.rows;
+        queue.push_back(std::move(request));
+        not_empty.notify_one();
+        return result;
+    }
+
+    template <typename T>
+    void InferenceServer<T>::shutdown()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+            not_empty.notify_all();
+            not_full.notify_all();
+        }
+        for (auto &worker : workers)
+            worker.join();
+        workers.clear();
+    }
+
+    template <typename T>
+    ServerStats InferenceServer<T>::stats() const
+    {
+        ServerStats s;
+        s.requests = requests;
+        s.batches = batches;
+        s.rows = rows;
+        s.full_batches = full_batches;
+        s.failed = failed;
+        return s;
+    }
+
+    template <typename T>
+    size_t InferenceServer<T>::pending() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return queue.size();
+    }
+
+    template <typename T>
+    void InferenceServer<T>::work()
+    {
+        std::vector<Request> batch;
+        bool full = false;
+        while (next_batch(batch, full))
+        {
+            if (full)
+                full_batches++;
+            run(batch);
+            batch.clear();
+        }
+    }
+
+    template <typename T>
+    bool InferenceServer<T>::next_batch(std::vector<Request> &batch, bool &full)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;)
+        {
+            not_empty.wait(lock, [this]
+                           { return stopping || !queue.empty(); });
+            if (queue.empty())
+                return false; // stopping, and everything is answered
+            full = queued_rows >= opts.max_batch_size;
+            // On shutdown the queue is drained without waiting for deadlines.
+            if (full || stopping)
+                break;
+            const Clock::time_point deadline = queue.front().deadline;
+            if (Clock::now() >= deadline)
+                break;
+            not_empty.wait_until(lock, deadline);
+        }
+
+        // Whole requests in arrival order; one larger than a batch goes alone.
+        size_t taken = 0;
+        while (!queue.empty() && (batch.empty() || taken + queue.front().rows <= opts.max_batch_size))
+        {
+            taken += queue.front().rows;
+            batch.push_back(std::move(queue.front()));
+            queue.pop_front();
+        }
+        queued_rows -= taken;
+        not_full.notify_all();
+        if (!queue.empty())
+            not_empty.notify_one(); // the rest may be due already
+        return true;
+    }
+
+    template <typename T>
+    void InferenceServer<T>::run(std::vector<Request> &batch)
+    {
+        Profiler::RecordScope scope("InferenceServer.batch", Profiler::Category::User);
+        size_t total = 0;
+        for (const Request &r : batch)
+            total += r.rows;
+        // Counted before any answer, so a caller holding a result sees its batch in stats().
+        requests += batch.size();
+        batches++;
+        rows += total;
+
+        size_t answered = 0;
+        try
+        {
+            // Collate [total, input_size]; a lone block is used as is.
+            Core::Tensor<T> x(0);
+            if (batch.size() == 1 && !batch.front().sample)
+                x = batch.front().input;
+            else
+            {
+                Memory::Buffer<T> values(total * input_size);
+                T *dst = values.data();
+                for (const Request &r : batch)
+                {
+                    const size_t n = r.rows * input_size;
+                    std::copy(r.input.data_ptr(), r.input.data_ptr() + n, dst);
+                    dst += n;
+                }
+                x = Core::Tensor<T>(std::make_shared<Core::Storage<T>>(std::move(values)),
+                                    Core::Layout::contiguous(Core::Shape{total, input_size}));
+            }
+
+            Core::Tensor<T> y(0);
+            {
+                Core::NoGradGuard no_grad;
+                y = model->infer(x);
+            }
+            if (y.ndim() < 2 || y.dim(0) != total)
+                throw std::runtime_error("InferenceServer: model returned " + Core::shape_to_string(y.shape()) +
+                                         " for a batch of " + std::to_string(total) + " rows");
+            if (!y.is_contiguous())
+                y = Core::Tensor<T>(y.get_data(), y.shape());
+
+            // Split the output rows back into the requests.
+            const size_t row = y.size() / total;
+            const T *src = y.data_ptr();
+            for (Request &r : batch)
+            {
+                Core::Shape shape = y.shape();
+                if (r.sample)
+                    shape.erase(shape.begin());
+                else
+                    shape.front() = r.rows;
+                Memory::Buffer<T> values(r.rows * row);
+                std::copy(src, src + r.rows * row, values.data());
+                src += r.rows * row;
+                r.result.set_value(Core::Tensor<T>(std::make_shared<Core::Storage<T>>(std::move(values)),
+                                                   Core::Layout::contiguous(shape)));
+                answered++;
+            }
+        }
+        catch (...)
+        {
+            const std::exception_ptr error = std::current_exception();
+            failed += batch.size() - answered;
+            for (size_t i = answered; i < batch.size(); i++)
+                batch[i].result.set_exception(error);
+        }
+    }
+}
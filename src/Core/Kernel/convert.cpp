@@ -0,0 +1,335 @@
+#include "NovaML/Core/Kernel/convert.hpp"
+#include "NovaML/Core/Kernel/cpu_features.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define NOVAML_HAS_X86_KERNELS 1
+#endif
+
+namespace NovaML::Core::Kernel
+{
+    namespace
+    {
+        // -------------------------
+        // Portable loops (bf16 vectorizes as integer shifts, fp16 scalar)
+        // -------------------------
+        namespace scalar
+        {
+            void widen_bf16(size_t n, const uint16_t *src, float *dst)
+            {
+                for (size_t i = 0; i < n; i++)
+                {
+                    uint32_t u = uint32_t(src[i]) << 16;
+                    std::memcpy(dst + i, &u, sizeof(float));
+                }
+            }
+
+            void narrow_bf16(size_t n, const float *src, uint16_t *dst)
+            {
+                for (size_t i = 0; i < n; i++)
+                    dst[i] = detail::float_to_bf16(src[i]);
+            }
+
+            void widen_fp16(size_t n, const uint16_t *src, float *dst)
+            {
+                for (size_t i = 0; i < n; i++)
+                    dst[i] = detail::fp16_to_float(src[i]);
+            }
+
+            void narrow_fp16(size_t n, const float *src, uint16_t *dst)
+            {
+                for (size_t i = 0; i < n; i++)
+                    dst[i] = detail::float_to_fp16(src[i]);
+            }
+
+            template <float (*Widen)(uint16_t)>
+            float dot(size_t n, const float *x, const uint16_t *h)
+            {
+                float acc = 0;
+                for (size_t i = 0; i < n; i++)
+                    acc += x[i] * Widen(h[i]);
+                return acc;
+            }
+
+            template <float (*Widen)(uint16_t)>
+            void axpy(size_t n, float a, const uint16_t *h, float *y)
+            {
+                for (size_t i = 0; i < n; i++)
+                    y[i] += a * Widen(h[i]);
+            }
+        }
+
+#ifdef NOVAML_HAS_X86_KERNELS
+        // -------------------------
+        // AVX2 + F16C
+        // -------------------------
+#pragma GCC push_options
+#pragma GCC target("avx2,fma,f16c")
+#ifdef __clang__
+#pragma clang attribute push(__attribute__((target("avx2,fma,f16c"))), apply_to = function)
+#endif
+        namespace avx2
+        {
+            void widen_bf16(size_t n, const uint16_t *src, float *dst)
+            {
+                size_t i = 0;
+                for (; i + 8 <= n; i += 8)
+                {
+                    __m256i h = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i)));
+                    _mm256_storeu_ps(dst + i, _mm256_castsi256_ps(_mm256_slli_epi32(h, 16)));
+                }
+                scalar::widen_bf16(n - i, src + i, dst + i);
+            }
+
+            void narrow_bf16(size_t n, const float *src, uint16_t *dst)
+            {
+                size_t i = 0;
+                const __m256i bias = _mm256_set1_epi32(0x7fff), one = _mm256_set1_epi32(1);
+                for (; i + 8 <= n; i += 8)
+                {
+                    __m256 f = _mm256_loadu_ps(src + i);
+                    __m256i u = _mm256_castps_si256(f);
+                    __m256i rounded = _mm256_add_epi32(u, _mm256_add_epi32(bias, _mm256_and_si256(_mm256_srli_epi32(u, 16), one)));
+                    // NaN keeps its top bits, made quiet
+                    __m256i nan = _mm256_or_si256(u, _mm256_set1_epi32(0x400000));
+                    __m256 is_nan = _mm256_cmp_ps(f, f, _CMP_UNORD_Q);
+                    __m256i r = _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(rounded), _mm256_castsi256_ps(nan), is_nan));
+                    r = _mm256_srli_epi32(r, 16);
+                    __m128i packed = _mm_packus_epi32(_mm256_castsi256_si128(r), _mm256_extracti128_si256(r, 1));
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), packed);
+                }
+                scalar::narrow_bf16(n - i, src + i, dst + i);
+            }
+
+            void widen_fp16(size_t n, const uint16_t *src, float *dst)
+            {
+                size_t i = 0;
+                for (; i + 8 <= n; i += 8)
+                    _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i))));
+                scalar::widen_fp16(n - i, src + i, dst + i);
+            }
+
+            void narrow_fp16(size_t n, const float *src, uint16_t *dst)
+            {
+                size_t i = 0;
+                for (; i + 8 <= n; i += 8)
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i),
+                                     _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+                scalar::narrow_fp16(n - i, src + i, dst + i);
+            }
+
+            inline __m256 load_bf16(const uint16_t *p)
+            {
+                __m256i h = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p)));
+                return _mm256_castsi256_ps(_mm256_slli_epi32(h, 16));
+            }
+
+            inline __m256 load_fp16(const uint16_t *p)
+            {
+                return _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p)));
+            }
+
+            template <__m256 (*Load)(const uint16_t *), float (*Widen)(uint16_t)>
+            float dot(size_t n, const float *x, const uint16_t *h)
+            {
+                __m256 acc0 = _mm256_setzero_ps(), acc1 = _mm256_setzero_ps();
+                size_t i = 0;
+                for (; i + 16 <= n; i += 16)
+                {
+                    acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(x + i), Load(h + i), acc0);
+                    acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(x + i + 8), Load(h + i + 8), acc1);
+                }
+                for (; i + 8 <= n; i += 8)
+                    acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(x + i), Load(h + i), acc0);
+                __m256 v = _mm256_add_ps(acc0, acc1);
+                __m128 s = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+                s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+                s = _mm_add_ss(s, _mm_shuffle_ps(s, s, 1));
+                return _mm_cvtss_f32(s) + scalar::dot<Widen>(n - i, x + i, h + i);
+            }
+
+            template <__m256 (*Load)(const uint16_t *), float (*Widen)(uint16_t)>
+            void axpy(size_t n, float a, const uint16_t *h, float *y)
+            {
+                const __m256 va = _mm256_set1_ps(a);
+                size_t i = 0;
+                for (; i + 8 <= n; i += 8)
+                    _mm256_storeu_ps(y + i, _mm256_fmadd_ps(va, Load(h + i), _mm256_loadu_ps(y + i)));
+                scalar::axpy<Widen>(n - i, a, h + i, y + i);
+            }
+        }
+#ifdef __clang__
+#pragma clang attribute pop
+#endif
+#pragma GCC pop_options
+
+        // -------------------------
+        // AVX-512F: 16-wide dot / axpy for matrix-vector shapes
+        // -------------------------
+#pragma GCC push_options
+#pragma GCC target("avx512f")
+#ifdef __clang__
+#pragma clang attribute push(__attribute__((target("avx512f"))), apply_to = function)
+#else
+        // GCC 12 reports the _mm512_undefined_*() placeholders inside
+        // avx512fintrin.h as uninitialized (GCC bug 105593, fixed in 13).
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+        namespace avx512
+        {
+            inline __m512 load_bf16(const uint16_t *p)
+            {
+                __m512i h = _mm512_cvtepu16_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(p)));
+                return _mm512_castsi512_ps(_mm512_slli_epi32(h, 16));
+            }
+
+            inline __m512 load_fp16(const uint16_t *p)
+            {
+                return _mm512_cvtph_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(p)));
+            }
+
+            template <__m512 (*Load)(const uint16_t *), float (*Widen)(uint16_t)>
+            float dot(size_t n, const float *x, const uint16_t *h)
+            {
+                __m512 acc0 = _mm512_setzero_ps(), acc1 = _mm512_setzero_ps();
+                size_t i = 0;
+                for (; i + 32 <= n; i += 32)
+                {
+                    acc0 = _mm512_fmadd_ps(_mm512_loadu_ps(x + i), Load(h + i), acc0);
+                    acc1 = _mm512_fmadd_ps(_mm512_loadu_ps(x + i + 16), Load(h + i + 16), acc1);
+                }
+                for (; i + 16 <= n; i += 16)
+                    acc0 = _mm512_fmadd_ps(_mm512_loadu_ps(x + i), Load(h + i), acc0);
+                return _mm512_reduce_add_ps(_mm512_add_ps(acc0, acc1)) + scalar::dot<Widen>(n - i, x + i, h + i);
+            }
+
+            template <__m512 (*Load)(const uint16_t *), float (*Widen)(uint16_t)>
+            void axpy(size_t n, float a, const uint16_t *h, float *y)
+            {
+                const __m512 va = _mm512_set1_ps(a);
+                size_t i = 0;
+                for (; i + 16 <= n; i += 16)
+                    _mm512_storeu_ps(y + i, _mm512_fmadd_ps(va, Load(h + i), _mm512_loadu_ps(y + i)));
+                scalar::axpy<Widen>(n - i, a, h + i, y + i);
+            }
+        }
+#ifdef __clang__
+#pragma clang attribute pop
+#else
+#pragma GCC diagnostic pop
+#endif
+#pragma GCC pop_options
+#endif // NOVAML_HAS_X86_KERNELS
+
+        // Bulk conversions are bound by memory: AVX2 + F16C serves AVX-512 CPUs too.
+        bool use_avx512()
+        {
+#ifdef NOVAML_HAS_X86_KERNELS
+            return active_isa() == Isa::Avx512;
+#else
+            return false;
+#endif
+        }
+
+        bool use_avx2()
+        {
+#ifdef NOVAML_HAS_X86_KERNELS
+            return active_isa() == Isa::Avx2 || active_isa() == Isa::Avx512;
+#else
+            return false;
+#endif
+        }
+
+        const uint16_t *bits(const bfloat16 *p) { return reinterpret_cast<const uint16_t *>(p); }
+        const uint16_t *bits(const float16 *p) { return reinterpret_cast<const uint16_t *>(p); }
+        uint16_t *bits(bfloat16 *p) { return reinterpret_cast<uint16_t *>(p); }
+        uint16_t *bits(float16 *p) { return reinterpret_cast<uint16_t *>(p); }
+    }
+
+    static_assert(sizeof(bfloat16) == 2 && sizeof(float16) == 2, "16-bit types must be bare bit patterns");
+
+    void widen(size_t n, const bfloat16 *src, float *dst)
+    {
+#ifdef NOVAML_HAS_X86_KERNELS
+        if (use_avx2())
+            return avx2::widen_bf16(n, bits(src), dst);
+#endif
+        scalar::widen_bf16(n, bits(src), dst);
+    }
+
+    void widen(size_t n, const float16 *src, float *dst)
+    {
+#ifdef NOVAML_HAS_X86_KERNELS
+        if (use_avx2())
+            return avx2::widen_fp16(n, bits(src), dst);
+#endif
+        scalar::widen_fp16(n, bits(src), dst);
+    }
+
+    void narrow(size_t n, const float *src, bfloat16 *dst)
+    {
+#ifdef NOVAML_HAS_X86_KERNELS
+        if (use_avx2())
+            return avx2::narrow_bf16(n, src, bits(dst));
+#endif
+        scalar::narrow_bf16(n, src, bits(dst));
+    }
+
+    void narrow(size_t n, const float *src, float16 *dst)
+    {
+#ifdef NOVAML_HAS_X86_KERNELS
+        if (use_avx2())
+            return avx2::narrow_fp16(n, src, bits(dst));
+#endif
+        scalar::narrow_fp16(n, src, bits(dst));
+    }
+
+    float dot(size_t n, const float *x, const bfloat16 *h)
+    {
+#ifdef NOVAML_HAS_X86_KERNELS
+        if (use_avx512())
+            return avx512::dot<avx512::load_bf16, detail::bf16_to_float>(n, x, bits(h));
+        if (use_avx2())
+            return avx2::dot<avx2::load_bf16, detail::bf16_to_float>(n, x, bits(h));
+#endif
+        return scalar::dot<detail::bf16_to_float>(n, x, bits(h));
+    }
+
+    float dot(size_t n, const float *x, const float16 *h)
+    {
+#ifdef NOVAML_HAS_X86_KERNELS
+        if (use_avx512())
+            return avx512::dot<avx512::load_fp16, detail::fp16_to_float>(n, x, bits(h));
+        if (use_avx2())
+            return avx2::dot<avx2::load_fp16, detail::fp16_to_float>(n, x, bits(h));
+#endif
+        return scalar::dot<detail::fp16_to_float>(n, x, bits(h));
+    }
+
+    void axpy(size_t n, float a, const bfloat16 *h, float *y)
+    {
+#ifdef NOVAML_HAS_X86_KERNELS
+        if (use_avx512())
+            return avx512::axpy<avx512::load_bf16, detail::bf16_to_float>(n, a, bits(h), y);
+        if (use_avx2())
+            return avx2::axpy<avx2::load_bf16, detail::bf16_to_float>(n, a, bits(h), y);
+#endif
+        scalar::axpy<detail::bf16_to_float>(n, a, bits(h), y);
+    }
+
+    void axpy(size_t n, float a, const float16 *h, float *y)
+    {
+#ifdef NOVAML_HAS_X86_KERNELS
+        if (use_avx512())
+            return avx512::axpy<avx512::load_fp16, detail::fp16_to_float>(n, a, bits(h), y);
+        if (use_avx2())
+            return avx2::axpy<avx2::load_fp16, detail::fp16_to_float>(n, a, bits(h), y);
+#endif
+        scalar::axpy<detail::fp16_to_float>(n, a, bits(h), y);
+    }
+}
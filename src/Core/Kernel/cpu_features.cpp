@@ -0,0 +1,102 @@
+#include "NovaML/Core/Kernel/cpu_features.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+namespace NovaML::Core::Kernel
+{
+    namespace
+    {
+        Isa probe_isa()
+        {
+#if defined(__x86_64__) || defined(__i386__)
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512f"))
+                return Isa::Avx512;
+            if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+                return Isa::Avx2;
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+            return Isa::Neon;
+#endif
+            return Isa::Scalar;
+        }
+
+        // NOVAML_ISA=scalar|avx2|avx512|neon caps the dispatch path at startup.
+        Isa initial_isa()
+        {
+            Isa isa = detected_isa();
+            if (const char *env = std::getenv("NOVAML_ISA"))
+            {
+                for (Isa candidate : {Isa::Scalar, Isa::Avx2, Isa::Avx512, Isa::Neon})
+                    if (isa_name(candidate) == env && isa_supported(candidate))
+                        isa = candidate;
+            }
+            return isa;
+        }
+
+        std::atomic<Isa> &active()
+        {
+            static std::atomic<Isa> isa{initial_isa()};
+            return isa;
+        }
+    }
+
+    Isa detected_isa()
+    {
+        static const Isa isa = probe_isa();
+        return isa;
+    }
+
+    Isa active_isa() { return active().load(std::memory_order_relaxed); }
+
+    bool isa_supported(Isa isa)
+    {
+        Isa best = detected_isa();
+        switch (isa)
+        {
+        case Isa::Scalar:
+            return true;
+        case Isa::Avx2:
+            return best == Isa::Avx2 || best == Isa::Avx512;
+        case Isa::Avx512:
+            return best == Isa::Avx512;
+        case Isa::Neon:
+            return best == Isa::Neon;
+        }
+        return false;
+    }
+
+    bool has_avx512_vnni()
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        static const bool vnni = isa_supported(Isa::Avx512) && __builtin_cpu_supports("avx512vnni");
+        return vnni;
+#else
+        return false;
+#endif
+    }
+
+    void set_active_isa(Isa isa)
+    {
+        if (!isa_supported(isa))
+            throw std::invalid_argument("set_active_isa: " + isa_name(isa) + " is not supported on this CPU");
+        active().store(isa, std::memory_order_relaxed);
+    }
+
+    std::string isa_name(Isa isa)
+    {
+        switch (isa)
+        {
+        case Isa::Scalar:
+            return "scalar";
+        case Isa::Avx2:
+            return "avx2";
+        case Isa::Avx512:
+            return "avx512";
+        case Isa::Neon:
+            return "neon";
+        }
+        return "unknown";
+    }
+}
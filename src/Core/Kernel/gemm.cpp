@@ -0,0 +1,613 @@
+#include "NovaML/Core/Kernel/gemm.hpp"
+#include "NovaML/Core/Kernel/cpu_features.hpp"
+#include "NovaML/Core/Kernel/convert.hpp"
+#include "NovaML/Memory/allocator.hpp"
+#include "NovaML/Parallel/thread_pool.hpp"
+#include "NovaML/Profiler/profiler.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define NOVAML_HAS_X86_KERNELS 1
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define NOVAML_HAS_NEON_KERNELS 1
+#endif
+
+namespace NovaML::Core::Kernel
+{
+    namespace
+    {
+        // -------------------------
+        // Portable reference kernels
+        // -------------------------
+        namespace scalar
+        {
+            template <typename T>
+            struct Vec
+            {
+                using type = T;
+                static constexpr size_t width = 1;
+                static type zero() { return T(0); }
+                static type load(const T *p) { return *p; }
+                static void store(T *p, type v) { *p = v; }
+                static type bcast(T v) { return v; }
+                static type fma(type a, type b, type c) { return a * b + c; }
+                static type add(type a, type b) { return a + b; }
+                static T hsum(type v) { return v; }
+            };
+
+#define NOVAML_SIMD_NS scalar
+#include "gemm_simd.inl"
+#undef NOVAML_SIMD_NS
+        }
+
+#ifdef NOVAML_HAS_X86_KERNELS
+        // -------------------------
+        // AVX2 + FMA: 6 x 16 (float), 6 x 8 (double)
+        // -------------------------
+#pragma GCC push_options
+#pragma GCC target("avx2,fma")
+#ifdef __clang__
+#pragma clang attribute push(__attribute__((target("avx2,fma"))), apply_to = function)
+#endif
+        namespace avx2
+        {
+            template <typename T>
+            struct Vec;
+
+            template <>
+            struct Vec<float>
+            {
+                using type = __m256;
+                static constexpr size_t width = 8;
+                static type zero() { return _mm256_setzero_ps(); }
+                static type load(const float *p) { return _mm256_loadu_ps(p); }
+                static void store(float *p, type v) { _mm256_storeu_ps(p, v); }
+                static type bcast(float v) { return _mm256_set1_ps(v); }
+                static type fma(type a, type b, type c) { return _mm256_fmadd_ps(a, b, c); }
+                static type add(type a, type b) { return _mm256_add_ps(a, b); }
+                static float hsum(type v)
+                {
+                    __m128 s = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+                    s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+                    s = _mm_add_ss(s, _mm_shuffle_ps(s, s, 1));
+                    return _mm_cvtss_f32(s);
+                }
+            };
+
+            template <>
+            struct Vec<double>
+            {
+                using type = __m256d;
+                static constexpr size_t width = 4;
+                static type zero() { return _mm256_setzero_pd(); }
+                static type load(const double *p) { return _mm256_loadu_pd(p); }
+                static void store(double *p, type v) { _mm256_storeu_pd(p, v); }
+                static type bcast(double v) { return _mm256_set1_pd(v); }
+                static type fma(type a, type b, type c) { return _mm256_fmadd_pd(a, b, c); }
+                static type add(type a, type b) { return _mm256_add_pd(a, b); }
+                static double hsum(type v)
+                {
+                    __m128d s = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+                    s = _mm_add_sd(s, _mm_unpackhi_pd(s, s));
+                    return _mm_cvtsd_f64(s);
+                }
+            };
+
+#define NOVAML_SIMD_NS avx2
+#include "gemm_simd.inl"
+#undef NOVAML_SIMD_NS
+        }
+#ifdef __clang__
+#pragma clang attribute pop
+#endif
+#pragma GCC pop_options
+
+        // -------------------------
+        // AVX-512F: 6 x 32 (float), 6 x 16 (double)
+        // -------------------------
+#pragma GCC push_options
+#pragma GCC target("avx512f")
+#ifdef __clang__
+#pragma clang attribute push(__attribute__((target("avx512f"))), apply_to = function)
+#else
+        // GCC 12 reports the _mm512_undefined_*() placeholders behind
+        // _mm512_reduce_add_* as uninitialized (GCC bug 105593, fixed in 13).
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+        namespace avx512
+        {
+            template <typename T>
+            struct Vec;
+
+            template <>
+            struct Vec<float>
+            {
+                using type = __m512;
+                static constexpr size_t width = 16;
+                static type zero() { return _mm512_setzero_ps(); }
+                static type load(const float *p) { return _mm512_loadu_ps(p); }
+                static void store(float *p, type v) { _mm512_storeu_ps(p, v); }
+                static type bcast(float v) { return _mm512_set1_ps(v); }
+                static type fma(type a, type b, type c) { return _mm512_fmadd_ps(a, b, c); }
+                static type add(type a, type b) { return _mm512_add_ps(a, b); }
+                static float hsum(type v) { return _mm512_reduce_add_ps(v); }
+            };
+
+            template <>
+            struct Vec<double>
+            {
+                using type = __m512d;
+                static constexpr size_t width = 8;
+                static type zero() { return _mm512_setzero_pd(); }
+                static type load(const double *p) { return _mm512_loadu_pd(p); }
+                static void store(double *p, type v) { _mm512_storeu_pd(p, v); }
+                static type bcast(double v) { return _mm512_set1_pd(v); }
+                static type fma(type a, type b, type c) { return _mm512_fmadd_pd(a, b, c); }
+                static type add(type a, type b) { return _mm512_add_pd(a, b); }
+                static double hsum(type v) { return _mm512_reduce_add_pd(v); }
+            };
+
+#define NOVAML_SIMD_NS avx512
+#include "gemm_simd.inl"
+#undef NOVAML_SIMD_NS
+        }
+#ifdef __clang__
+#pragma clang attribute pop
+#else
+#pragma GCC diagnostic pop
+#endif
+#pragma GCC pop_options
+#endif // NOVAML_HAS_X86_KERNELS
+
+#ifdef NOVAML_HAS_NEON_KERNELS
+        // -------------------------
+        // NEON: 6 x 8 (float), 6 x 4 (double)
+        // -------------------------
+        namespace neon
+        {
+            template <typename T>
+            struct Vec;
+
+            template <>
+            struct Vec<float>
+            {
+                using type = float32x4_t;
+                static constexpr size_t width = 4;
+                static type zero() { return vdupq_n_f32(0.0f); }
+                static type load(const float *p) { return vld1q_f32(p); }
+                static void store(float *p, type v) { vst1q_f32(p, v); }
+                static type bcast(float v) { return vdupq_n_f32(v); }
+                static type fma(type a, type b, type c) { return vfmaq_f32(c, a, b); }
+                static type add(type a, type b) { return vaddq_f32(a, b); }
+                static float hsum(type v) { return vaddvq_f32(v); }
+            };
+
+            template <>
+            struct Vec<double>
+            {
+                using type = float64x2_t;
+                static constexpr size_t width = 2;
+                static type zero() { return vdupq_n_f64(0.0); }
+                static type load(const double *p) { return vld1q_f64(p); }
+                static void store(double *p, type v) { vst1q_f64(p, v); }
+                static type bcast(double v) { return vdupq_n_f64(v); }
+                static type fma(type a, type b, type c) { return vfmaq_f64(c, a, b); }
+                static type add(type a, type b) { return vaddq_f64(a, b); }
+                static double hsum(type v) { return vaddvq_f64(v); }
+            };
+
+#define NOVAML_SIMD_NS neon
+#include "gemm_simd.inl"
+#undef NOVAML_SIMD_NS
+        }
+#endif // NOVAML_HAS_NEON_KERNELS
+
+        // -------------------------
+        // Dispatch table for one element type
+        // -------------------------
+        template <typename T>
+        struct Kernels
+        {
+            void (*micro)(size_t, const T *, const T *, T *, size_t, size_t, size_t);
+            T (*dot)(size_t, const T *, const T *);
+            void (*axpy)(size_t, T, const T *, T *);
+            size_t nr; ///< Columns per micro-tile (rows are always 6)
+        };
+
+        template <typename T>
+        Kernels<T> select_kernels()
+        {
+            switch (active_isa())
+            {
+#ifdef NOVAML_HAS_X86_KERNELS
+            case Isa::Avx512:
+                return {avx512::micro_kernel<T>, avx512::dot<T>, avx512::axpy<T>, 2 * avx512::Vec<T>::width};
+            case Isa::Avx2:
+                return {avx2::micro_kernel<T>, avx2::dot<T>, avx2::axpy<T>, 2 * avx2::Vec<T>::width};
+#endif
+#ifdef NOVAML_HAS_NEON_KERNELS
+            case Isa::Neon:
+                return {neon::micro_kernel<T>, neon::dot<T>, neon::axpy<T>, 2 * neon::Vec<T>::width};
+#endif
+            default:
+                return {scalar::micro_kernel<T>, scalar::dot<T>, scalar::axpy<T>, 2};
+            }
+        }
+
+        constexpr size_t MR = 6;
+
+        // Cache blocking: a KC x NC panel of B stays in L2/L3, an MC x KC
+        // block of A stays in L2, and one micro-panel of each in L1.
+        template <typename T>
+        struct Blocking
+        {
+            static constexpr size_t KC = 256;
+            static constexpr size_t MC = 120;
+            static constexpr size_t NC = 4096 / sizeof(T) * 2;
+        };
+
+        /// Pack rows [i0, i0+mc) x cols [p0, p0+kc) of alpha*op(A) into MR-row panels.
+        template <typename T>
+        void pack_a(bool trans, const T *A, size_t lda, size_t i0, size_t mc, size_t p0, size_t kc, T alpha, T *out)
+        {
+            for (size_t ir = 0; ir < mc; ir += MR)
+            {
+                size_t rows = std::min(MR, mc - ir);
+                for (size_t k = 0; k < kc; k++)
+                {
+                    for (size_t r = 0; r < rows; r++)
+                    {
+                        size_t i = i0 + ir + r, p = p0 + k;
+                        *out++ = alpha * (trans ? A[p * lda + i] : A[i * lda + p]);
+                    }
+                    for (size_t r = rows; r < MR; r++)
+                        *out++ = T(0);
+                }
+            }
+        }
+
+        /// Pack rows [p0, p0+kc) x cols [j0, j0+nc) of op(B) into NR-column panels [panel0, panel1).
+        template <typename T>
+        void pack_b(bool trans, const T *B, size_t ldb, size_t p0, size_t kc, size_t j0, size_t nc, size_t nr,
+                    size_t panel0, size_t panel1, T *out)
+        {
+            out += panel0 * nr * kc;
+            for (size_t jr = panel0 * nr; jr < std::min(nc, panel1 * nr); jr += nr)
+            {
+                size_t cols = std::min(nr, nc - jr);
+                for (size_t k = 0; k < kc; k++)
+                {
+                    size_t p = p0 + k;
+                    if (!trans)
+                    {
+                        const T *src = B + p * ldb + j0 + jr;
+                        std::copy(src, src + cols, out);
+                    }
+                    else
+                    {
+                        for (size_t c = 0; c < cols; c++)
+                            out[c] = B[(j0 + jr + c) * ldb + p];
+                    }
+                    std::fill(out + cols, out + nr, T(0));
+                    out += nr;
+                }
+            }
+        }
+
+        template <typename T>
+        void scale(size_t M, size_t N, T beta, T *C, size_t ldc)
+        {
+            if (beta == T(1))
+                return;
+            for (size_t i = 0; i < M; i++)
+            {
+                T *c = C + i * ldc;
+                if (beta == T(0))
+                    std::fill(c, c + N, T(0));
+                else
+                    for (size_t j = 0; j < N; j++)
+                        c[j] *= beta;
+            }
+        }
+
+        template <typename T>
+        void gemv_impl(const Kernels<T> &k, bool trans, size_t M, size_t N, T alpha, const T *A, size_t lda,
+                       const T *x, size_t incx, T beta, T *y, size_t incy)
+        {
+            // Strided vectors (a column of a row-major matrix) are gathered once.
+            std::vector<T> x_buf, y_buf;
+            size_t x_len = trans ? M : N, y_len = trans ? N : M;
+            if (incx != 1)
+            {
+                x_buf.resize(x_len);
+                for (size_t i = 0; i < x_len; i++)
+                    x_buf[i] = x[i * incx];
+                x = x_buf.data();
+            }
+            T *yd = y;
+            if (incy != 1)
+            {
+                y_buf.resize(y_len);
+                for (size_t i = 0; i < y_len; i++)
+                    y_buf[i] = y[i * incy];
+                yd = y_buf.data();
+            }
+
+            // Rows (or output columns) are independent: split them over the pool.
+            const size_t grain = std::max<size_t>(1, Parallel::elementwise_grain / std::max<size_t>(1, trans ? M : N));
+            if (!trans)
+            {
+                Parallel::parallel_for(0, M, grain, [&](size_t i0, size_t i1)
+                                       {
+                                           for (size_t i = i0; i < i1; i++)
+                                           {
+                                               T d = alpha * k.dot(N, A + i * lda, x);
+                                               yd[i] = beta == T(0) ? d : beta * yd[i] + d;
+                                           } });
+            }
+            else
+            {
+                Parallel::parallel_for(0, N, grain, [&](size_t j0, size_t j1)
+                                       {
+                                           scale<T>(1, j1 - j0, beta, yd + j0, N);
+                                           for (size_t i = 0; i < M; i++)
+                                               k.axpy(j1 - j0, alpha * x[i], A + i * lda + j0, yd + j0); });
+            }
+
+            if (incy != 1)
+                for (size_t i = 0; i < y_len; i++)
+                    y[i * incy] = yd[i];
+        }
+
+        template <typename T>
+        void gemm_impl(bool trans_a, bool trans_b, size_t M, size_t N, size_t K,
+                       T alpha, const T *A, size_t lda, const T *B, size_t ldb,
+                       T beta, T *C, size_t ldc, const Epilogue<T> &epilogue)
+        {
+            if (M == 0 || N == 0)
+                return;
+            Profiler::RecordScope scope(M == 1 || N == 1 ? "gemv" : "gemm", Profiler::Category::Kernel,
+                                        2.0 * M * N * K, double(M * K + K * N + M * N) * sizeof(T));
+            const Kernels<T> k = select_kernels<T>();
+
+            // Matrix-vector shapes are bandwidth bound: skip packing entirely.
+            if (M == 1)
+            {
+                // C row = op(B)^T applied to the single row of op(A)
+                size_t inc_a = trans_a ? lda : 1;
+                if (trans_b)
+                    gemv_impl(k, false, N, K, alpha, B, ldb, A, inc_a, beta, C, 1);
+                else
+                    gemv_impl(k, true, K, N, alpha, B, ldb, A, inc_a, beta, C, 1);
+                if (epilogue.active())
+                    apply_epilogue(epilogue, C, ldc, 1, 0, N);
+                return;
+            }
+            if (N == 1)
+            {
+                size_t inc_b = trans_b ? 1 : ldb;
+                if (trans_a)
+                    gemv_impl(k, true, K, M, alpha, A, lda, B, inc_b, beta, C, ldc);
+                else
+                    gemv_impl(k, false, M, K, alpha, A, lda, B, inc_b, beta, C, ldc);
+                if (epilogue.active())
+                    apply_epilogue(epilogue, C, ldc, M, 0, 1);
+                return;
+            }
+
+            scale(M, N, beta, C, ldc);
+            if (K == 0 || alpha == T(0))
+            {
+                if (epilogue.active())
+                    apply_epilogue(epilogue, C, ldc, M, 0, N);
+                return;
+            }
+
+            using Blk = Blocking<T>;
+            const size_t nr = k.nr;
+            const size_t nc_max = (Blk::NC + nr - 1) / nr * nr;
+            const size_t a_pack_size = Blk::KC * ((Blk::MC + MR - 1) / MR * MR);
+            // Per call, not thread_local: the panel stays in use across the
+            // parallel_for waits below, and a waiting thread helps with other
+            // queued tasks, which may run a GEMM of their own (e.g. GEMMs
+            // called from inside a pool task). The caching allocator makes
+            // this a free-list pop.
+            Memory::Buffer<T> b_pack(Blk::KC * nc_max);
+            const size_t threads = Parallel::get_num_threads();
+
+            for (size_t jc = 0; jc < N; jc += nc_max)
+            {
+                size_t nc = std::min(nc_max, N - jc);
+                size_t n_panels = (nc + nr - 1) / nr;
+                for (size_t pc = 0; pc < K; pc += Blk::KC)
+                {
+                    size_t kc = std::min(Blk::KC, K - pc);
+                    const bool last_k = pc + kc == K;
+                    T *bp = b_pack.data();
+                    bool serial = M * nc * kc < (size_t(1) << 18);
+
+                    Parallel::parallel_for(0, n_panels, serial ? n_panels : 1, [&](size_t p0, size_t p1)
+                                           { pack_b(trans_b, B, ldb, pc, kc, jc, nc, nr, p0, p1, bp); });
+
+                    // Tasks are (row block, column slice) tiles; slicing the
+                    // columns keeps every thread busy when M is small.
+                    size_t m_blocks = (M + Blk::MC - 1) / Blk::MC;
+                    size_t n_splits = serial ? 1 : std::min(n_panels, std::max<size_t>(1, (2 * threads + m_blocks - 1) / m_blocks));
+                    size_t tasks = m_blocks * n_splits;
+
+                    Parallel::parallel_for(0, tasks, serial ? tasks : 1, [&](size_t t0, size_t t1)
+                                           {
+                                               // Safe as thread_local: nothing in the task waits on the pool.
+                                               thread_local std::vector<T> a_pack;
+                                               a_pack.resize(a_pack_size);
+                                               for (size_t t = t0; t < t1; t++)
+                                               {
+                                                   size_t ic = (t / n_splits) * Blk::MC, split = t % n_splits;
+                                                   size_t mc = std::min(Blk::MC, M - ic);
+                                                   size_t jr0 = split * n_panels / n_splits * nr;
+                                                   size_t jr1 = std::min(nc, (split + 1) * n_panels / n_splits * nr);
+                                                   pack_a(trans_a, A, lda, ic, mc, pc, kc, alpha, a_pack.data());
+
+                                                   for (size_t jr = jr0; jr < jr1; jr += nr)
+                                                       for (size_t ir = 0; ir < mc; ir += MR)
+                                                       {
+                                                           T *c = C + (ic + ir) * ldc + jc + jr;
+                                                           size_t mr = std::min(MR, mc - ir), cols = std::min(nr, nc - jr);
+                                                           k.micro(kc, a_pack.data() + ir * kc, bp + jr * kc, c, ldc, mr, cols);
+                                                           // The tile is final after its last K block: finish it while hot.
+                                                           if (last_k && epilogue.active())
+                                                               apply_epilogue(epilogue, c, ldc, mr, jc + jr, cols);
+                                                       }
+                                               } });
+                }
+            }
+        }
+        // -------------------------
+        // 16-bit storage: fp32 arithmetic, one rounding per output
+        // -------------------------
+
+        /// Widen rows x cols of a 16-bit matrix with row stride ld into a dense fp32 matrix.
+        template <typename H>
+        void widen_matrix(const H *src, size_t ld, size_t rows, size_t cols, float *dst)
+        {
+            Parallel::parallel_for(0, rows, std::max<size_t>(1, Parallel::elementwise_grain / std::max<size_t>(1, cols)),
+                                   [&](size_t r0, size_t r1)
+                                   {
+                                       for (size_t r = r0; r < r1; r++)
+                                           widen(cols, src + r * ld, dst + r * cols);
+                                   });
+        }
+
+        /**
+         * out[o] = sum_l x[l] * mat(o, l) for o < count, l < len, with mat(o, l)
+         * at mat[o * ld + l] (rows) or mat[l * ld + o] (columns). The matrix
+         * is read in 16 bits and widened in registers.
+         */
+        template <typename H>
+        void reduced_gemv(bool rows, size_t count, size_t len, const H *mat, size_t ld, const float *x, float *out)
+        {
+            if (rows)
+            {
+                const size_t grain = std::max<size_t>(1, Parallel::elementwise_grain / std::max<size_t>(1, len));
+                Parallel::parallel_for(0, count, grain, [&](size_t o0, size_t o1)
+                                       {
+                                           for (size_t o = o0; o < o1; o++)
+                                               out[o] = dot(len, x, mat + o * ld); });
+            }
+            else
+            {
+                constexpr size_t block = 1024;
+                Parallel::parallel_for(0, (count + block - 1) / block, 1, [&](size_t b0, size_t b1)
+                                       {
+                                           for (size_t b = b0; b < b1; b++)
+                                           {
+                                               size_t o0 = b * block, n = std::min(block, count - o0);
+                                               std::fill(out + o0, out + o0 + n, 0.0f);
+                                               for (size_t l = 0; l < len; l++)
+                                                   axpy(n, x[l], mat + l * ld + o0, out + o0);
+                                           } });
+            }
+        }
+
+        template <typename H>
+        void gemm_reduced(bool trans_a, bool trans_b, size_t M, size_t N, size_t K,
+                          float alpha, const H *A, size_t lda, const H *B, size_t ldb,
+                          float beta, H *C, size_t ldc, const Epilogue<H> &epilogue)
+        {
+            if (M == 0 || N == 0)
+                return;
+
+            std::vector<float> bias;
+            if (epilogue.bias)
+            {
+                bias.resize(N);
+                widen(N, epilogue.bias, bias.data());
+            }
+            const Epilogue<float> ep{epilogue.bias ? bias.data() : nullptr, epilogue.activation};
+
+            // The fp32 result, then alpha / beta / epilogue, then one rounding into C.
+            Memory::Buffer<float> c(M * N);
+            if (M == 1 || N == 1)
+            {
+                Profiler::RecordScope scope("gemv", Profiler::Category::Kernel, 2.0 * M * N * K,
+                                            double(M * K + K * N + M * N) * sizeof(H));
+                // The vector operand is short: widen it whole (gathering a strided row / column).
+                const H *v = M == 1 ? A : B;
+                const size_t inc = M == 1 ? (trans_a ? lda : 1) : (trans_b ? 1 : ldb);
+                std::vector<float> x(K);
+                for (size_t l = 0; l < K; l++)
+                    x[l] = float(v[l * inc]);
+                if (M == 1)
+                    reduced_gemv(trans_b, N, K, B, ldb, x.data(), c.data());
+                else
+                    reduced_gemv(!trans_a, M, K, A, lda, x.data(), c.data());
+            }
+            else
+            {
+                Memory::Buffer<float> a(M * K), b(K * N);
+                widen_matrix(A, lda, trans_a ? K : M, trans_a ? M : K, a.data());
+                widen_matrix(B, ldb, trans_b ? N : K, trans_b ? K : N, b.data());
+                gemm_impl<float>(trans_a, trans_b, M, N, K, 1.0f, a.data(), trans_a ? M : K,
+                                 b.data(), trans_b ? K : N, 0.0f, c.data(), N, {});
+            }
+
+            for (size_t i = 0; i < M; i++)
+            {
+                float *row = c.data() + i * N;
+                for (size_t j = 0; j < N; j++)
+                    row[j] = alpha * row[j] + (beta == 0.0f ? 0.0f : beta * float(C[i * ldc + j]));
+                if (ep.active())
+                    apply_epilogue(ep, row, N, 1, 0, N);
+                narrow(N, row, C + i * ldc);
+            }
+        }
+    }
+
+    void gemm(bool trans_a, bool trans_b, size_t M, size_t N, size_t K,
+              float alpha, const float *A, size_t lda, const float *B, size_t ldb,
+              float beta, float *C, size_t ldc, const Epilogue<float> &epilogue)
+    {
+        gemm_impl<float>(trans_a, trans_b, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc, epilogue);
+    }
+
+    void gemm(bool trans_a, bool trans_b, size_t M, size_t N, size_t K,
+              double alpha, const double *A, size_t lda, const double *B, size_t ldb,
+              double beta, double *C, size_t ldc, const Epilogue<double> &epilogue)
+    {
+        gemm_impl<double>(trans_a, trans_b, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc, epilogue);
+    }
+
+    void gemv(bool trans, size_t M, size_t N, float alpha, const float *A, size_t lda,
+              const float *x, float beta, float *y)
+    {
+        gemv_impl(select_kernels<float>(), trans, M, N, alpha, A, lda, x, 1, beta, y, 1);
+    }
+
+    void gemv(bool trans, size_t M, size_t N, double alpha, const double *A, size_t lda,
+              const double *x, double beta, double *y)
+    {
+        gemv_impl(select_kernels<double>(), trans, M, N, alpha, A, lda, x, 1, beta, y, 1);
+    }
+
+    void gemm(bool trans_a, bool trans_b, size_t M, size_t N, size_t K,
+              bfloat16 alpha, const bfloat16 *A, size_t lda, const bfloat16 *B, size_t ldb,
+              bfloat16 beta, bfloat16 *C, size_t ldc, const Epilogue<bfloat16> &epilogue)
+    {
+        gemm_reduced(trans_a, trans_b, M, N, K, float(alpha), A, lda, B, ldb, float(beta), C, ldc, epilogue);
+    }
+
+    void gemm(bool trans_a, bool trans_b, size_t M, size_t N, size_t K,
+              float16 alpha, const float16 *A, size_t lda, const float16 *B, size_t ldb,
+              float16 beta, float16 *C, size_t ldc, const Epilogue<float16> &epilogue)
+    {
+        gemm_reduced(trans_a, trans_b, M, N, K, float(alpha), A, lda, B, ldb, float(beta), C, ldc, epilogue);
+    }
+}
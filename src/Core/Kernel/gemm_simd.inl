@@ -0,0 +1,104 @@
+// Vector kernel bodies shared by every instruction set.
+//
+// Included once per ISA by gemm.cpp inside a target region, after the
+// namespace NOVAML_SIMD_NS has been opened and `Vec<float>` / `Vec<double>`
+// wrappers for that ISA have been defined. No include guard on purpose.
+
+// Micro-kernel: c[mr x nr] += a_panel[kc x MR] * b_panel[kc x NR]
+// with MR = 6 rows and NR = two vector registers of columns.
+template <typename T>
+void micro_kernel(size_t kc, const T *a, const T *b, T *c, size_t ldc, size_t mr, size_t nr)
+{
+    using V = Vec<T>;
+    using R = typename V::type;
+    constexpr size_t W = V::width;
+    constexpr size_t MR = 6;
+    constexpr size_t NR = 2 * W;
+
+    R acc[MR][2];
+#pragma GCC unroll 6
+    for (size_t r = 0; r < MR; r++)
+        acc[r][0] = acc[r][1] = V::zero();
+
+    for (size_t k = 0; k < kc; k++)
+    {
+        R b0 = V::load(b);
+        R b1 = V::load(b + W);
+#pragma GCC unroll 6
+        for (size_t r = 0; r < MR; r++)
+        {
+            R ar = V::bcast(a[r]);
+            acc[r][0] = V::fma(ar, b0, acc[r][0]);
+            acc[r][1] = V::fma(ar, b1, acc[r][1]);
+        }
+        a += MR;
+        b += NR;
+    }
+
+    if (mr == MR && nr == NR)
+    {
+#pragma GCC unroll 6
+        for (size_t r = 0; r < MR; r++)
+        {
+            T *cr = c + r * ldc;
+            V::store(cr, V::add(V::load(cr), acc[r][0]));
+            V::store(cr + W, V::add(V::load(cr + W), acc[r][1]));
+        }
+        return;
+    }
+
+    alignas(64) T tile[MR * NR];
+    for (size_t r = 0; r < MR; r++)
+    {
+        V::store(tile + r * NR, acc[r][0]);
+        V::store(tile + r * NR + W, acc[r][1]);
+    }
+    for (size_t r = 0; r < mr; r++)
+        for (size_t j = 0; j < nr; j++)
+            c[r * ldc + j] += tile[r * NR + j];
+}
+
+// Dot product with four independent accumulators.
+template <typename T>
+T dot(size_t n, const T *x, const T *y)
+{
+    using V = Vec<T>;
+    using R = typename V::type;
+    constexpr size_t W = V::width;
+
+    R s0 = V::zero(), s1 = V::zero(), s2 = V::zero(), s3 = V::zero();
+    size_t i = 0;
+    for (; i + 4 * W <= n; i += 4 * W)
+    {
+        s0 = V::fma(V::load(x + i), V::load(y + i), s0);
+        s1 = V::fma(V::load(x + i + W), V::load(y + i + W), s1);
+        s2 = V::fma(V::load(x + i + 2 * W), V::load(y + i + 2 * W), s2);
+        s3 = V::fma(V::load(x + i + 3 * W), V::load(y + i + 3 * W), s3);
+    }
+    for (; i + W <= n; i += W)
+        s0 = V::fma(V::load(x + i), V::load(y + i), s0);
+    T sum = V::hsum(V::add(V::add(s0, s1), V::add(s2, s3)));
+    for (; i < n; i++)
+        sum += x[i] * y[i];
+    return sum;
+}
+
+// y += alpha * x
+template <typename T>
+void axpy(size_t n, T alpha, const T *x, T *y)
+{
+    using V = Vec<T>;
+    constexpr size_t W = V::width;
+
+    auto va = V::bcast(alpha);
+    size_t i = 0;
+    for (; i + 2 * W <= n; i += 2 * W)
+    {
+        V::store(y + i, V::fma(va, V::load(x + i), V::load(y + i)));
+        V::store(y + i + W, V::fma(va, V::load(x + i + W), V::load(y + i + W)));
+    }
+    for (; i + W <= n; i += W)
+        V::store(y + i, V::fma(va, V::load(x + i), V::load(y + i)));
+    for (; i < n; i++)
+        y[i] += alpha * x[i];
+}
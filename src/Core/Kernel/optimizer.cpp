@@ -0,0 +1,154 @@
+#include "NovaML/Core/Kernel/optimizer.hpp"
+#include "NovaML/Core/Kernel/cpu_features.hpp"
+#include "NovaML/Parallel/thread_pool.hpp"
+#include "NovaML/Profiler/profiler.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define NOVAML_HAS_X86_KERNELS 1
+#endif
+
+namespace NovaML::Core::Kernel
+{
+    namespace
+    {
+        // -------------------------
+        // Baseline target (SSE2 on x86-64, NEON on AArch64)
+        // -------------------------
+        namespace scalar
+        {
+#define NOVAML_SIMD_NS scalar
+#include "optimizer_simd.inl"
+#undef NOVAML_SIMD_NS
+        }
+
+#ifdef NOVAML_HAS_X86_KERNELS
+#pragma GCC push_options
+#pragma GCC target("avx2,fma")
+#ifdef __clang__
+#pragma clang attribute push(__attribute__((target("avx2,fma"))), apply_to = function)
+#endif
+        namespace avx2
+        {
+#define NOVAML_SIMD_NS avx2
+#include "optimizer_simd.inl"
+#undef NOVAML_SIMD_NS
+        }
+#ifdef __clang__
+#pragma clang attribute pop
+#endif
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target("avx512f")
+#ifdef __clang__
+#pragma clang attribute push(__attribute__((target("avx512f"))), apply_to = function)
+#endif
+        namespace avx512
+        {
+#define NOVAML_SIMD_NS avx512
+#include "optimizer_simd.inl"
+#undef NOVAML_SIMD_NS
+        }
+#ifdef __clang__
+#pragma clang attribute pop
+#endif
+#pragma GCC pop_options
+#endif // NOVAML_HAS_X86_KERNELS
+
+        // -------------------------
+        // Dispatch table for one element type
+        // -------------------------
+        template <typename T>
+        struct Kernels
+        {
+            void (*sgd_plain)(size_t, T *, const T *, T, T);
+            void (*sgd_momentum)(size_t, T *, const T *, T *, T, T, T, T, T, T);
+            void (*adam)(size_t, T *, const T *, T *, T *, T, T, T, T, T, T, T);
+        };
+
+        template <typename T>
+        Kernels<T> select_kernels()
+        {
+            switch (active_isa())
+            {
+#ifdef NOVAML_HAS_X86_KERNELS
+            case Isa::Avx512:
+                return {avx512::sgd_plain<T>, avx512::sgd_momentum<T>, avx512::adam<T>};
+            case Isa::Avx2:
+                return {avx2::sgd_plain<T>, avx2::sgd_momentum<T>, avx2::adam<T>};
+#endif
+            default:
+                return {scalar::sgd_plain<T>, scalar::sgd_momentum<T>, scalar::adam<T>};
+            }
+        }
+
+        /// Split [0, n) into cache-line aligned chunks over the intra-op pool.
+        template <typename F>
+        void for_chunks(size_t n, F &&fn)
+        {
+            Parallel::parallel_for(0, (n + 15) / 16, Parallel::elementwise_grain / 16, [&](size_t b, size_t e)
+                                   { fn(b * 16, std::min(n, e * 16)); });
+        }
+
+        template <typename T>
+        void sgd_impl(size_t n, T *param, const T *grad, T *velocity, const SgdStep<T> &hp)
+        {
+            if (hp.momentum != T(0) && !velocity)
+                throw std::invalid_argument("sgd_step: momentum needs a velocity buffer");
+            Profiler::RecordScope scope("sgd_step", Profiler::Category::Kernel, (hp.momentum == T(0) ? 3.0 : 7.0) * n,
+                                        double(n) * sizeof(T) * (hp.momentum == T(0) ? 3 : 5));
+            const Kernels<T> k = select_kernels<T>();
+            if (hp.momentum == T(0))
+            {
+                for_chunks(n, [&](size_t b, size_t e)
+                           { k.sgd_plain(e - b, param + b, grad + b, hp.lr, hp.weight_decay); });
+                return;
+            }
+            const T keep = hp.nesterov ? hp.momentum : T(1), direct = hp.nesterov ? T(1) : T(0);
+            const T decay = hp.first_step ? T(0) : hp.momentum, scale = hp.first_step ? T(1) : T(1) - hp.dampening;
+            for_chunks(n, [&](size_t b, size_t e)
+                       { k.sgd_momentum(e - b, param + b, grad + b, velocity + b, hp.lr, hp.weight_decay,
+                                        decay, scale, keep, direct); });
+        }
+
+        template <typename T>
+        void adam_impl(size_t n, T *param, const T *grad, T *m, T *v, const AdamStep<T> &hp)
+        {
+            if (hp.step == 0)
+                throw std::invalid_argument("adam_step: step numbers start at 1");
+            Profiler::RecordScope scope("adam_step", Profiler::Category::Kernel, 14.0 * n, double(n) * sizeof(T) * 7);
+            const Kernels<T> k = select_kernels<T>();
+            const T step_size = hp.lr / (T(1) - std::pow(hp.beta1, T(hp.step)));
+            const T inv_sqrt_correction2 = T(1) / std::sqrt(T(1) - std::pow(hp.beta2, T(hp.step)));
+            const T l2 = hp.decoupled ? T(0) : hp.weight_decay;
+            const T shrink = T(1) - (hp.decoupled ? hp.lr * hp.weight_decay : T(0));
+            for_chunks(n, [&](size_t b, size_t e)
+                       { k.adam(e - b, param + b, grad + b, m + b, v + b, hp.beta1, hp.beta2, hp.eps,
+                                l2, shrink, step_size, inv_sqrt_correction2); });
+        }
+    }
+
+    void sgd_step(size_t n, float *param, const float *grad, float *velocity, const SgdStep<float> &hp)
+    {
+        sgd_impl<float>(n, param, grad, velocity, hp);
+    }
+
+    void sgd_step(size_t n, double *param, const double *grad, double *velocity, const SgdStep<double> &hp)
+    {
+        sgd_impl<double>(n, param, grad, velocity, hp);
+    }
+
+    void adam_step(size_t n, float *param, const float *grad, float *m, float *v, const AdamStep<float> &hp)
+    {
+        adam_impl<float>(n, param, grad, m, v, hp);
+    }
+
+    void adam_step(size_t n, double *param, const double *grad, double *m, double *v, const AdamStep<double> &hp)
+    {
+        adam_impl<double>(n, param, grad, m, v, hp);
+    }
+}
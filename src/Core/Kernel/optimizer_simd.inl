@@ -0,0 +1,46 @@
+// Optimizer update loops shared by every instruction set.
+//
+// Included once per ISA by optimizer.cpp inside a target region, after the
+// namespace NOVAML_SIMD_NS has been opened. The loops are branch-free and
+// written over plain pointers so the compiler vectorizes them for the
+// target of the enclosing region. No include guard on purpose.
+
+// param -= lr * (g + wd * param)
+template <typename T>
+void sgd_plain(size_t n, T *param, const T *grad, T lr, T weight_decay)
+{
+    for (size_t i = 0; i < n; i++)
+        param[i] -= lr * (grad[i] + weight_decay * param[i]);
+}
+
+// velocity = momentum * velocity + scale * g;  param -= lr * (keep * velocity + direct * g)
+template <typename T>
+void sgd_momentum(size_t n, T *param, const T *grad, T *velocity, T lr, T weight_decay,
+                  T momentum, T scale, T keep, T direct)
+{
+    for (size_t i = 0; i < n; i++)
+    {
+        T g = grad[i] + weight_decay * param[i];
+        T vel = momentum * velocity[i] + scale * g;
+        velocity[i] = vel;
+        param[i] -= lr * (keep * vel + direct * g);
+    }
+}
+
+// Adam with L2 (l2) or decoupled (shrink) weight decay, bias correction folded into the scalars.
+template <typename T>
+void adam(size_t n, T *param, const T *grad, T *m, T *v, T beta1, T beta2, T eps,
+          T l2, T shrink, T step_size, T inv_sqrt_correction2)
+{
+    const T one_minus_beta1 = T(1) - beta1, one_minus_beta2 = T(1) - beta2;
+    for (size_t i = 0; i < n; i++)
+    {
+        T p = param[i];
+        T g = grad[i] + l2 * p;
+        T mi = beta1 * m[i] + one_minus_beta1 * g;
+        T vi = beta2 * v[i] + one_minus_beta2 * g * g;
+        m[i] = mi;
+        v[i] = vi;
+        param[i] = shrink * p - step_size * mi / (std::sqrt(vi) * inv_sqrt_correction2 + eps);
+    }
+}
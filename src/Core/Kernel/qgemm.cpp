@@ -0,0 +1,306 @@
+#include "NovaML/Core/Kernel/qgemm.hpp"
+#include "NovaML/Core/Kernel/cpu_features.hpp"
+#include "NovaML/Parallel/thread_pool.hpp"
+#include "NovaML/Profiler/profiler.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define NOVAML_HAS_X86_KERNELS 1
+#endif
+
+namespace NovaML::Core::Kernel
+{
+    namespace
+    {
+        // Micro-kernels compute the int32 sums of an mr x (16 * panels) tile
+        // over the whole depth into acc (row stride 32); store_tile then
+        // requantizes it.
+        using MicroKernel = void (*)(size_t groups, const uint8_t *a, size_t lda, size_t mr,
+                                     const int8_t *b, size_t panel_stride, size_t panels, int32_t *acc);
+
+        constexpr size_t group_bytes = PackedInt8::panel * 4; ///< one group of 4 k in a panel
+
+        inline int32_t load4(const uint8_t *p)
+        {
+            int32_t v;
+            std::memcpy(&v, p, sizeof(v));
+            return v;
+        }
+
+        // -------------------------
+        // Portable loops (baseline SSE2 / NEON auto-vectorization)
+        // -------------------------
+        namespace scalar
+        {
+            constexpr size_t MR = 4, panels = 2;
+
+            void micro(size_t groups, const uint8_t *a, size_t lda, size_t mr,
+                       const int8_t *b, size_t panel_stride, size_t panels, int32_t *acc)
+            {
+                for (size_t r = 0; r < mr; r++)
+                    for (size_t p = 0; p < panels; p++)
+                    {
+                        const uint8_t *ar = a + r * lda;
+                        const int8_t *bp = b + p * panel_stride;
+                        int32_t sum[PackedInt8::panel] = {};
+                        for (size_t g = 0; g < groups; g++)
+                            for (size_t c = 0; c < PackedInt8::panel; c++)
+                                for (size_t kk = 0; kk < 4; kk++)
+                                    sum[c] += int32_t(ar[4 * g + kk]) * int32_t(bp[g * group_bytes + 4 * c + kk]);
+                        std::copy(sum, sum + PackedInt8::panel, acc + r * 32 + p * PackedInt8::panel);
+                    }
+            }
+
+#include "qgemm_simd.inl"
+        }
+
+#ifdef NOVAML_HAS_X86_KERNELS
+        // -------------------------
+        // AVX2: exact 16-bit products (vpmaddubsw would saturate), 4 x 16 tiles
+        // -------------------------
+#pragma GCC push_options
+#pragma GCC target("avx2,fma")
+#ifdef __clang__
+#pragma clang attribute push(__attribute__((target("avx2,fma"))), apply_to = function)
+#endif
+        namespace avx2
+        {
+            constexpr size_t MR = 4, panels = 1;
+
+            inline __m256i widen(const int8_t *p)
+            {
+                return _mm256_cvtepi8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p)));
+            }
+
+            void micro(size_t groups, const uint8_t *a, size_t lda, size_t mr,
+                       const int8_t *b, size_t, size_t, int32_t *acc)
+            {
+                // Sums of 4 channels x 4 k per widened register: madd adds k pairs,
+                // hadd the two halves, leaving channels in the order 0 1 4 5 | 2 3 6 7.
+                __m256i lo[MR], hi[MR];
+#pragma GCC unroll 4
+                for (size_t r = 0; r < MR; r++)
+                    lo[r] = hi[r] = _mm256_setzero_si256();
+
+                const uint8_t *rows[MR];
+                for (size_t r = 0; r < MR; r++)
+                    rows[r] = a + std::min(r, mr - 1) * lda;
+
+                for (size_t g = 0; g < groups; g++)
+                {
+                    const int8_t *bg = b + g * group_bytes;
+                    __m256i w0 = widen(bg), w1 = widen(bg + 16), w2 = widen(bg + 32), w3 = widen(bg + 48);
+#pragma GCC unroll 4
+                    for (size_t r = 0; r < MR; r++)
+                    {
+                        __m256i av = _mm256_cvtepu8_epi16(_mm_set1_epi32(load4(rows[r] + 4 * g)));
+                        lo[r] = _mm256_add_epi32(lo[r], _mm256_hadd_epi32(_mm256_madd_epi16(w0, av), _mm256_madd_epi16(w1, av)));
+                        hi[r] = _mm256_add_epi32(hi[r], _mm256_hadd_epi32(_mm256_madd_epi16(w2, av), _mm256_madd_epi16(w3, av)));
+                    }
+                }
+
+                for (size_t r = 0; r < mr; r++)
+                {
+                    int32_t *out = acc + r * 32;
+                    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out), _mm256_permute4x64_epi64(lo[r], 0xD8));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + 8), _mm256_permute4x64_epi64(hi[r], 0xD8));
+                }
+            }
+
+#include "qgemm_simd.inl"
+        }
+#ifdef __clang__
+#pragma clang attribute pop
+#endif
+#pragma GCC pop_options
+
+        // -------------------------
+        // AVX-512 VNNI: one vpdpbusd per 16 channels x 4 k, 6 x 32 tiles
+        // -------------------------
+#pragma GCC push_options
+#pragma GCC target("avx512f,avx512vnni")
+#ifdef __clang__
+#pragma clang attribute push(__attribute__((target("avx512f,avx512vnni"))), apply_to = function)
+#endif
+        namespace avx512
+        {
+            constexpr size_t MR = 6, panels = 2;
+
+            template <size_t P>
+            void micro_panels(size_t groups, const uint8_t *a, size_t lda, size_t mr,
+                              const int8_t *b, size_t panel_stride, int32_t *acc)
+            {
+                __m512i c[MR][P];
+#pragma GCC unroll 6
+                for (size_t r = 0; r < MR; r++)
+                    for (size_t p = 0; p < P; p++)
+                        c[r][p] = _mm512_setzero_si512();
+
+                const uint8_t *rows[MR];
+                for (size_t r = 0; r < MR; r++)
+                    rows[r] = a + std::min(r, mr - 1) * lda;
+
+                for (size_t g = 0; g < groups; g++)
+                {
+                    __m512i w[P];
+                    for (size_t p = 0; p < P; p++)
+                        w[p] = _mm512_loadu_si512(b + p * panel_stride + g * group_bytes);
+#pragma GCC unroll 6
+                    for (size_t r = 0; r < MR; r++)
+                    {
+                        __m512i av = _mm512_set1_epi32(load4(rows[r] + 4 * g));
+                        for (size_t p = 0; p < P; p++)
+                            c[r][p] = _mm512_dpbusd_epi32(c[r][p], av, w[p]);
+                    }
+                }
+
+                for (size_t r = 0; r < mr; r++)
+                    for (size_t p = 0; p < P; p++)
+                        _mm512_storeu_si512(acc + r * 32 + p * PackedInt8::panel, c[r][p]);
+            }
+
+            void micro(size_t groups, const uint8_t *a, size_t lda, size_t mr,
+                       const int8_t *b, size_t panel_stride, size_t panels, int32_t *acc)
+            {
+                if (panels == 2)
+                    micro_panels<2>(groups, a, lda, mr, b, panel_stride, acc);
+                else
+                    micro_panels<1>(groups, a, lda, mr, b, panel_stride, acc);
+            }
+
+#include "qgemm_simd.inl"
+        }
+#ifdef __clang__
+#pragma clang attribute pop
+#endif
+#pragma GCC pop_options
+#endif // NOVAML_HAS_X86_KERNELS
+
+        // -------------------------
+        // Dispatch
+        // -------------------------
+        struct QKernels
+        {
+            MicroKernel micro;
+            void (*store_u8)(const Requantize &, const int32_t *, size_t, size_t, size_t, uint8_t *, size_t);
+            void (*store_f32)(const Requantize &, const int32_t *, size_t, size_t, size_t, float *, size_t);
+            size_t mr;     ///< rows per tile
+            size_t panels; ///< 16-channel panels per tile
+
+            void store(const Requantize &rq, const int32_t *acc, size_t rows, size_t col0, size_t cols, uint8_t *C, size_t ldc) const
+            {
+                store_u8(rq, acc, rows, col0, cols, C, ldc);
+            }
+            void store(const Requantize &rq, const int32_t *acc, size_t rows, size_t col0, size_t cols, float *C, size_t ldc) const
+            {
+                store_f32(rq, acc, rows, col0, cols, C, ldc);
+            }
+        };
+
+#define NOVAML_QKERNELS(ns) \
+    QKernels { ns::micro, ns::store_tile<uint8_t>, ns::store_tile<float>, ns::MR, ns::panels }
+
+        QKernels select_kernels()
+        {
+#ifdef NOVAML_HAS_X86_KERNELS
+            const Isa isa = active_isa();
+            if (isa == Isa::Avx512 && has_avx512_vnni())
+                return NOVAML_QKERNELS(avx512);
+            if (isa == Isa::Avx2 || isa == Isa::Avx512)
+                return NOVAML_QKERNELS(avx2);
+#endif
+            return NOVAML_QKERNELS(scalar);
+        }
+#undef NOVAML_QKERNELS
+
+        template <typename Out>
+        void qgemm_impl(size_t M, const uint8_t *A, size_t lda, const PackedInt8 &W, const Requantize &rq,
+                        Out *C, size_t ldc)
+        {
+            const size_t N = W.rows, K = W.depth;
+            if (M == 0 || N == 0)
+                return;
+            if (!rq.scale || !rq.offset)
+                throw std::invalid_argument("qgemm: requantization needs a per-column scale and offset");
+
+            Profiler::RecordScope scope("qgemm", Profiler::Category::Kernel, 2.0 * M * N * K,
+                                        double(M * K + N * K + M * N * sizeof(Out)));
+            const QKernels k = select_kernels();
+            const size_t groups = W.padded_depth() / 4, panel_stride = groups * group_bytes;
+            const size_t nr = k.panels * PackedInt8::panel, strips = (N + nr - 1) / nr;
+            // Tasks are column strips: each streams its weights once and reuses them for every row.
+            const size_t grain = std::max<size_t>(1, (size_t(1) << 20) / std::max<size_t>(1, M * K * nr));
+
+            Parallel::parallel_for(0, strips, grain, [&](size_t s0, size_t s1)
+                                   {
+                                       alignas(64) int32_t acc[6 * 32];
+                                       for (size_t s = s0; s < s1; s++)
+                                       {
+                                           const size_t col0 = s * nr, cols = std::min(nr, N - col0);
+                                           const size_t panels = (cols + PackedInt8::panel - 1) / PackedInt8::panel;
+                                           const int8_t *b = W.data.data() + col0 / PackedInt8::panel * panel_stride;
+                                           for (size_t i0 = 0; i0 < M; i0 += k.mr)
+                                           {
+                                               const size_t rows = std::min(k.mr, M - i0);
+                                               k.micro(groups, A + i0 * lda, lda, rows, b, panel_stride, panels, acc);
+                                               k.store(rq, acc, rows, col0, cols, C + i0 * ldc + col0, ldc);
+                                           }
+                                       } });
+        }
+    }
+
+    PackedInt8 pack_int8(size_t N, size_t K, const int8_t *W, size_t ldw)
+    {
+        // 255 * 128 * K must stay below 2^31
+        if (K > (size_t(1) << 16))
+            throw std::invalid_argument("pack_int8: depth " + std::to_string(K) + " could overflow int32 sums (max 65536)");
+
+        PackedInt8 packed;
+        packed.rows = N;
+        packed.depth = K;
+        const size_t panel_stride = packed.padded_depth() * PackedInt8::panel;
+        const size_t panels = (N + PackedInt8::panel - 1) / PackedInt8::panel;
+        packed.data = Memory::Buffer<int8_t>(panels * panel_stride, int8_t(0));
+        packed.row_sums.assign(N, 0);
+
+        for (size_t n = 0; n < N; n++)
+        {
+            int8_t *panel = packed.data.data() + n / PackedInt8::panel * panel_stride + 4 * (n % PackedInt8::panel);
+            for (size_t k = 0; k < K; k++)
+            {
+                const int8_t w = W[n * ldw + k];
+                panel[k / 4 * group_bytes + k % 4] = w;
+                packed.row_sums[n] += w;
+            }
+        }
+        return packed;
+    }
+
+    void qgemm(size_t M, const uint8_t *A, size_t lda, const PackedInt8 &W, const Requantize &rq,
+               uint8_t *C, size_t ldc)
+    {
+        qgemm_impl(M, A, lda, W, rq, C, ldc);
+    }
+
+    void qgemm(size_t M, const uint8_t *A, size_t lda, const PackedInt8 &W, const Requantize &rq,
+               float *C, size_t ldc)
+    {
+        qgemm_impl(M, A, lda, W, rq, C, ldc);
+    }
+
+    void quantize(size_t n, const float *x, float scale, int32_t zero_point, uint8_t *q)
+    {
+        const float inv_scale = 1.0f / scale, zp = float(zero_point);
+        for (size_t i = 0; i < n; i++)
+        {
+            const float v = std::min(std::max(x[i] * inv_scale + zp, 0.0f), 255.0f);
+            q[i] = static_cast<uint8_t>(int32_t(v + 0.5f));
+        }
+    }
+}
@@ -0,0 +1,43 @@
+// Requantization epilogue shared by every int8 kernel path.
+//
+// Included once per ISA by qgemm.cpp inside a target region, so the loops
+// are vectorized for that instruction set. No include guard on purpose.
+
+// C[rows x cols] = requantize(acc) for the output columns starting at col0;
+// acc holds the int32 sums of one tile with a row stride of 32.
+template <typename Out>
+void store_tile(const Requantize &rq, const int32_t *acc, size_t rows, size_t col0, size_t cols, Out *C, size_t ldc)
+{
+    const float *scale = rq.scale + col0;
+    const int32_t *offset = rq.offset + col0;
+    const float *bias = rq.bias ? rq.bias + col0 : nullptr;
+    const float inv_scale = 1.0f / rq.output_scale, zero_point = float(rq.output_zero_point);
+
+    for (size_t r = 0; r < rows; r++)
+    {
+        const int32_t *s = acc + r * 32;
+        float y[32];
+        for (size_t j = 0; j < cols; j++)
+            y[j] = scale[j] * float(s[j] + offset[j]);
+        if (bias)
+            for (size_t j = 0; j < cols; j++)
+                y[j] += bias[j];
+        if (rq.activation == Activation::ReLU)
+            for (size_t j = 0; j < cols; j++)
+                y[j] = std::max(y[j], 0.0f);
+        else if (rq.activation != Activation::None)
+            for (size_t j = 0; j < cols; j++)
+                y[j] = activate(rq.activation, y[j]);
+
+        Out *c = C + r * ldc;
+        if constexpr (std::is_same_v<Out, float>)
+            std::copy(y, y + cols, c);
+        else
+            for (size_t j = 0; j < cols; j++)
+            {
+                // Clamped to [0, 255] first, so rounding half up is a truncation.
+                const float q = std::min(std::max(y[j] * inv_scale + zero_point, 0.0f), 255.0f);
+                c[j] = static_cast<uint8_t>(int32_t(q + 0.5f));
+            }
+    }
+}
@@ -0,0 +1,305 @@
+#include "NovaML/Core/Kernel/vmath.hpp"
+#include "NovaML/Core/Kernel/cpu_features.hpp"
+#include "NovaML/Parallel/thread_pool.hpp"
+#include "NovaML/Profiler/profiler.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define NOVAML_HAS_X86_KERNELS 1
+#endif
+
+namespace NovaML::Core::Kernel
+{
+    namespace
+    {
+        // -------------------------
+        // Constants of the approximations, per element type
+        // -------------------------
+        template <typename T>
+        struct MathTraits;
+
+        template <>
+        struct MathTraits<float>
+        {
+            using UInt = uint32_t;
+            static constexpr UInt mantissa_bits = 23, exponent_bias = 127, exponent_mask = 0xff;
+            static constexpr UInt mantissa_mask = 0x007fffff;
+            static constexpr float round_magic = 12582912.0f; // 1.5 * 2^23: adding it rounds to an integer
+            static constexpr float infinity = std::numeric_limits<float>::infinity();
+            static constexpr float quiet_nan = std::numeric_limits<float>::quiet_NaN();
+            static constexpr float min_normal = std::numeric_limits<float>::min();
+            static constexpr float subnormal_scale = 16777216.0f, subnormal_shift = 24.0f; // 2^24
+            static constexpr float sqrt2 = 1.41421356f;
+            static constexpr float log2e = 1.44269504f;
+            static constexpr float ln2_hi = 6.9314575195e-01f, ln2_lo = 1.4286067653e-06f;
+            static constexpr float exp_max = 89.0f, exp_min = -104.0f;
+
+            // exp(r) = 1 + r + r^2 P(r) (Cephes expf, ~1 ulp)
+            static constexpr float exp_exact[] = {1.9875691500e-4f, 1.3981999507e-3f, 8.3334519073e-3f,
+                                                  4.1665795894e-2f, 1.6666665459e-1f, 5.0000001201e-1f};
+            // Taylor to r^4: 4e-5 relative at |r| = ln2 / 2
+            static constexpr float exp_fast[] = {1.0f / 24, 1.0f / 6, 0.5f, 1.0f, 1.0f};
+            // R(z) / z (FreeBSD logf)
+            static constexpr float log_exact[] = {0.24279078841f, 0.28498786688f, 0.40000972152f, 0.66666662693f};
+            static constexpr float log_fast[] = {0.4f, 2.0f / 3};
+
+            // tanh(x) = x + x z P(z) for |x| < 0.625 (Cephes tanhf)
+            static float tanh_small(float z)
+            {
+                return (((-5.70498872745e-3f * z + 2.06390887954e-2f) * z - 5.37397155531e-2f) * z +
+                        1.33314422036e-1f) * z - 3.33332819422e-1f;
+            }
+        };
+
+        template <>
+        struct MathTraits<double>
+        {
+            using UInt = uint64_t;
+            static constexpr UInt mantissa_bits = 52, exponent_bias = 1023, exponent_mask = 0x7ff;
+            static constexpr UInt mantissa_mask = 0x000fffffffffffffull;
+            static constexpr double round_magic = 6755399441055744.0; // 1.5 * 2^52
+            static constexpr double infinity = std::numeric_limits<double>::infinity();
+            static constexpr double quiet_nan = std::numeric_limits<double>::quiet_NaN();
+            static constexpr double min_normal = std::numeric_limits<double>::min();
+            static constexpr double subnormal_scale = 18014398509481984.0, subnormal_shift = 54.0; // 2^54
+            static constexpr double sqrt2 = 1.4142135623730951;
+            static constexpr double log2e = 1.4426950408889634;
+            static constexpr double ln2_hi = 6.93147180369123816490e-01, ln2_lo = 1.90821492927058770002e-10;
+            static constexpr double exp_max = 710.0, exp_min = -746.0;
+
+            // Taylor terms 1/13! .. 1/2!: truncation below 1e-17 at |r| = ln2 / 2
+            static constexpr double exp_exact[] = {1.0 / 6227020800.0, 1.0 / 479001600.0, 1.0 / 39916800.0,
+                                                   1.0 / 3628800.0, 1.0 / 362880.0, 1.0 / 40320.0, 1.0 / 5040.0,
+                                                   1.0 / 720.0, 1.0 / 120.0, 1.0 / 24.0, 1.0 / 6.0, 0.5};
+            static constexpr double exp_fast[] = {1.0 / 24, 1.0 / 6, 0.5, 1.0, 1.0};
+            // Lg7 .. Lg1 (fdlibm e_log.c)
+            static constexpr double log_exact[] = {1.479819860511658591e-01, 1.531383769920937332e-01,
+                                                   1.818357216161805012e-01, 2.222219843214978396e-01,
+                                                   2.857142874366239149e-01, 3.999999999940941908e-01,
+                                                   6.666666666666735130e-01};
+            static constexpr double log_fast[] = {0.4, 2.0 / 3};
+
+            // tanh(x) = x + x z P(z) / Q(z) for |x| < 0.625 (Cephes tanh)
+            static double tanh_small(double z)
+            {
+                const double p = (-9.64399179425052238628e-1 * z - 9.92877231001918586564e1) * z - 1.61468768441708447952e3;
+                const double q = ((z + 1.12811678491632931402e2) * z + 2.23548839060100448583e3) * z + 4.84406305325125486048e3;
+                return p / q;
+            }
+        };
+
+        // -------------------------
+        // Baseline target (SSE2 on x86-64, NEON on AArch64)
+        // -------------------------
+        namespace scalar
+        {
+#define NOVAML_SIMD_NS scalar
+#include "vmath_simd.inl"
+#undef NOVAML_SIMD_NS
+        }
+
+#ifdef NOVAML_HAS_X86_KERNELS
+#pragma GCC push_options
+#pragma GCC target("avx2,fma")
+#ifdef __clang__
+#pragma clang attribute push(__attribute__((target("avx2,fma"))), apply_to = function)
+#endif
+        namespace avx2
+        {
+#define NOVAML_SIMD_NS avx2
+#include "vmath_simd.inl"
+#undef NOVAML_SIMD_NS
+        }
+#ifdef __clang__
+#pragma clang attribute pop
+#endif
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target("avx512f")
+#ifdef __clang__
+#pragma clang attribute push(__attribute__((target("avx512f"))), apply_to = function)
+#endif
+        namespace avx512
+        {
+#define NOVAML_SIMD_NS avx512
+#include "vmath_simd.inl"
+#undef NOVAML_SIMD_NS
+        }
+#ifdef __clang__
+#pragma clang attribute pop
+#endif
+#pragma GCC pop_options
+#endif // NOVAML_HAS_X86_KERNELS
+
+        // -------------------------
+        // Dispatch table for one element type and accuracy tier
+        // -------------------------
+        template <typename T>
+        struct Kernels
+        {
+            void (*exp)(size_t, const T *, T *);
+            void (*log)(size_t, const T *, T *);
+            void (*tanh)(size_t, const T *, T *);
+            void (*sigmoid)(size_t, const T *, T *);
+            void (*pow_int)(size_t, const T *, T *, unsigned long long, bool);
+            void (*pow_general)(size_t, const T *, T *, T, bool, bool);
+        };
+
+        // The float Exact tier takes pow through double; double has no wider type and uses libm.
+        template <typename T>
+        void pow_libm(size_t n, const T *x, T *y, T exponent, bool, bool)
+        {
+            for (size_t i = 0; i < n; i++)
+                y[i] = std::pow(x[i], exponent);
+        }
+
+#define NOVAML_VMATH_KERNELS(NS, EXACT)                                                                    \
+    Kernels<T>                                                                                            \
+    {                                                                                                     \
+        NS::exp_kernel<T, EXACT>, NS::log_kernel<T, EXACT>, NS::tanh_kernel<T, EXACT>,                    \
+            NS::sigmoid_kernel<T, EXACT>, NS::pow_int_kernel<T>,                                          \
+            !EXACT                          ? NS::pow_general_kernel<T, T, false>                         \
+            : std::is_same_v<T, float>      ? NS::pow_general_kernel<T, double, true>                     \
+                                            : pow_libm<T>                                                 \
+    }
+
+        template <typename T>
+        Kernels<T> select_kernels(MathAccuracy accuracy)
+        {
+            const bool exact = accuracy == MathAccuracy::Exact;
+            switch (active_isa())
+            {
+#ifdef NOVAML_HAS_X86_KERNELS
+            case Isa::Avx512:
+                return exact ? NOVAML_VMATH_KERNELS(avx512, true) : NOVAML_VMATH_KERNELS(avx512, false);
+            case Isa::Avx2:
+                return exact ? NOVAML_VMATH_KERNELS(avx2, true) : NOVAML_VMATH_KERNELS(avx2, false);
+#endif
+            default:
+                return exact ? NOVAML_VMATH_KERNELS(scalar, true) : NOVAML_VMATH_KERNELS(scalar, false);
+            }
+        }
+#undef NOVAML_VMATH_KERNELS
+
+        /// Split [0, n) into cache-line aligned chunks over the intra-op pool.
+        template <typename F>
+        void for_chunks(size_t n, F &&fn)
+        {
+            Parallel::parallel_for(0, (n + 15) / 16, Parallel::elementwise_grain / 16, [&](size_t b, size_t e)
+                                   { fn(b * 16, std::min(n, e * 16)); });
+        }
+
+        // Rough flop counts of one element, for the profiler.
+        template <typename T>
+        void unary(const char *name, double flops, void (*kernel)(size_t, const T *, T *), size_t n, const T *x, T *y)
+        {
+            Profiler::RecordScope scope(name, Profiler::Category::Kernel, flops * n, 2.0 * n * sizeof(T));
+            for_chunks(n, [&](size_t b, size_t e)
+                       { kernel(e - b, x + b, y + b); });
+        }
+
+        template <typename T>
+        void pow_impl(size_t n, const T *x, T exponent, T *y, MathAccuracy accuracy)
+        {
+            Profiler::RecordScope scope("vpow", Profiler::Category::Kernel, 30.0 * n, 2.0 * n * sizeof(T));
+            const bool integral = std::trunc(exponent) == exponent && std::abs(exponent) < T(1ull << 62);
+            const unsigned long long magnitude = integral ? static_cast<unsigned long long>(std::abs(exponent)) : 0;
+            if (exponent == T(0) || exponent == T(1) || exponent == T(2) || exponent == T(-1))
+            {
+                for_chunks(n, [&](size_t b, size_t e)
+                           {
+                               for (size_t i = b; i < e; i++)
+                                   y[i] = exponent == T(0)   ? T(1)
+                                          : exponent == T(1) ? x[i]
+                                          : exponent == T(2) ? x[i] * x[i]
+                                                             : T(1) / x[i]; });
+                return;
+            }
+            const Kernels<T> k = select_kernels<T>(accuracy);
+            if (integral && accuracy == MathAccuracy::Fast && magnitude <= 64)
+            {
+                for_chunks(n, [&](size_t b, size_t e)
+                           { k.pow_int(e - b, x + b, y + b, magnitude, exponent < T(0)); });
+                return;
+            }
+            const bool odd = integral && (magnitude & 1);
+            for_chunks(n, [&](size_t b, size_t e)
+                       { k.pow_general(e - b, x + b, y + b, exponent, integral, odd); });
+        }
+
+        // NOVAML_MATH=fast|exact sets the default tier at startup.
+        std::atomic<MathAccuracy> &accuracy_slot()
+        {
+            static std::atomic<MathAccuracy> accuracy{[]
+                                                      {
+                                                          const char *env = std::getenv("NOVAML_MATH");
+                                                          return env && std::string(env) == "fast" ? MathAccuracy::Fast
+                                                                                                   : MathAccuracy::Exact;
+                                                      }()};
+            return accuracy;
+        }
+    }
+
+    MathAccuracy math_accuracy() { return accuracy_slot().load(std::memory_order_relaxed); }
+
+    void set_math_accuracy(MathAccuracy accuracy) { accuracy_slot().store(accuracy, std::memory_order_relaxed); }
+
+    void vexp(size_t n, const float *x, float *y, MathAccuracy accuracy)
+    {
+        unary<float>("vexp", 15.0, select_kernels<float>(accuracy).exp, n, x, y);
+    }
+
+    void vexp(size_t n, const double *x, double *y, MathAccuracy accuracy)
+    {
+        unary<double>("vexp", 25.0, select_kernels<double>(accuracy).exp, n, x, y);
+    }
+
+    void vlog(size_t n, const float *x, float *y, MathAccuracy accuracy)
+    {
+        unary<float>("vlog", 20.0, select_kernels<float>(accuracy).log, n, x, y);
+    }
+
+    void vlog(size_t n, const double *x, double *y, MathAccuracy accuracy)
+    {
+        unary<double>("vlog", 25.0, select_kernels<double>(accuracy).log, n, x, y);
+    }
+
+    void vtanh(size_t n, const float *x, float *y, MathAccuracy accuracy)
+    {
+        unary<float>("vtanh", 30.0, select_kernels<float>(accuracy).tanh, n, x, y);
+    }
+
+    void vtanh(size_t n, const double *x, double *y, MathAccuracy accuracy)
+    {
+        unary<double>("vtanh", 45.0, select_kernels<double>(accuracy).tanh, n, x, y);
+    }
+
+    void vsigmoid(size_t n, const float *x, float *y, MathAccuracy accuracy)
+    {
+        unary<float>("vsigmoid", 18.0, select_kernels<float>(accuracy).sigmoid, n, x, y);
+    }
+
+    void vsigmoid(size_t n, const double *x, double *y, MathAccuracy accuracy)
+    {
+        unary<double>("vsigmoid", 28.0, select_kernels<double>(accuracy).sigmoid, n, x, y);
+    }
+
+    void vpow(size_t n, const float *x, float exponent, float *y, MathAccuracy accuracy)
+    {
+        pow_impl<float>(n, x, exponent, y, accuracy);
+    }
+
+    void vpow(size_t n, const double *x, double exponent, double *y, MathAccuracy accuracy)
+    {
+        pow_impl<double>(n, x, exponent, y, accuracy);
+    }
+}
@@ -0,0 +1,192 @@
+// Transcendental kernels shared by every instruction set.
+//
+// Included once per ISA by vmath.cpp inside a target region, after the
+// namespace NOVAML_SIMD_NS has been opened. Every element goes through the
+// same straight-line code: special cases are selects, not branches, and
+// bit casts are memcpy, so the compiler vectorizes the loops for the
+// target of the enclosing region. The element helpers are defined here
+// (not shared) so they inline into that target. No include guard on purpose.
+
+template <typename T>
+inline typename MathTraits<T>::UInt to_bits(T v)
+{
+    typename MathTraits<T>::UInt u;
+    std::memcpy(&u, &v, sizeof(v));
+    return u;
+}
+
+template <typename T>
+inline T from_bits(typename MathTraits<T>::UInt u)
+{
+    T v;
+    std::memcpy(&v, &u, sizeof(v));
+    return v;
+}
+
+// Horner over coefficients listed from the highest degree down.
+template <typename T, size_t N>
+inline T horner(const T (&c)[N], T x)
+{
+    T p = c[0];
+    for (size_t k = 1; k < N; k++)
+        p = p * x + c[k];
+    return p;
+}
+
+// 2^k for an integral k in the normal exponent range, built in the exponent field.
+// k + round_magic holds k in its low mantissa bits, which avoids a float -> int
+// conversion the narrower ISAs lack for 64-bit lanes.
+template <typename T>
+inline T exp2_int(T k)
+{
+    using M = MathTraits<T>;
+    const typename M::UInt biased = to_bits(k + M::round_magic) - to_bits(M::round_magic) + M::exponent_bias;
+    return from_bits<T>(biased << M::mantissa_bits);
+}
+
+// exp: x = k ln2 + r with |r| <= ln2 / 2 (Cody-Waite), exp(r) by polynomial, then scaled by 2^k.
+template <typename T, bool Exact>
+inline T exp_elem(T x)
+{
+    using M = MathTraits<T>;
+    const T in = x;
+    x = x > M::exp_max ? M::exp_max : x;
+    x = x < M::exp_min ? M::exp_min : x;
+    x = in != in ? T(0) : x;
+    const T k = (x * M::log2e + M::round_magic) - M::round_magic;
+    const T r = (x - k * M::ln2_hi) - k * M::ln2_lo;
+    T p;
+    if constexpr (Exact)
+        p = horner(M::exp_exact, r) * (r * r) + r + T(1);
+    else
+        p = horner(M::exp_fast, r);
+    // 2^k as two factors: the result walks into the subnormals (or to inf)
+    // without either factor leaving the normal range.
+    const T k1 = (k * T(0.5) + M::round_magic) - M::round_magic;
+    const T y = p * exp2_int(k1) * exp2_int(k - k1);
+    return in != in ? in : y;
+}
+
+// log: x = 2^e m with m in [sqrt(1/2), sqrt(2)), log(m) = log1p(f) with s = f / (2 + f)
+// and log1p(f) = f - f^2/2 + s (f^2/2 + R(s^2)) (the fdlibm reduction).
+template <typename T, bool Exact>
+inline T log_elem(T x)
+{
+    using M = MathTraits<T>;
+    using U = typename M::UInt;
+    const bool subnormal = x < M::min_normal;
+    const U bits = to_bits(subnormal ? x * M::subnormal_scale : x);
+    const U field = (bits >> M::mantissa_bits) & M::exponent_mask;
+    T e = from_bits<T>(to_bits(M::round_magic) + field) - M::round_magic - T(M::exponent_bias);
+    e -= subnormal ? M::subnormal_shift : T(0);
+    T m = from_bits<T>((bits & M::mantissa_mask) | to_bits(T(1)));
+    const bool high = m > M::sqrt2;
+    m = high ? m * T(0.5) : m;
+    e += high ? T(1) : T(0);
+
+    const T f = m - T(1);
+    const T s = f / (T(2) + f);
+    const T z = s * s;
+    T R;
+    if constexpr (Exact)
+        R = z * horner(M::log_exact, z);
+    else
+        R = z * horner(M::log_fast, z);
+    const T hfsq = T(0.5) * f * f;
+    T y = e * M::ln2_hi - ((hfsq - (s * (hfsq + R) + e * M::ln2_lo)) - f);
+
+    y = x == M::infinity ? x : y;
+    y = x == T(0) ? -M::infinity : y;
+    return x < T(0) || x != x ? M::quiet_nan : y;
+}
+
+// tanh: odd polynomial for |x| < 0.625, 1 - 2 / (exp(2|x|) + 1) beyond, where it does not cancel.
+template <typename T, bool Exact>
+inline T tanh_elem(T x)
+{
+    using M = MathTraits<T>;
+    const T a = x < T(0) ? -x : x;
+    const T big = T(1) - T(2) / (exp_elem<T, Exact>(a + a) + T(1));
+    const T z = x * x;
+    const T small = x + x * z * M::tanh_small(z);
+    return a < T(0.625) ? small : (x < T(0) ? -big : big);
+}
+
+template <typename T, bool Exact>
+inline T sigmoid_elem(T x)
+{
+    return T(1) / (T(1) + exp_elem<T, Exact>(-x));
+}
+
+template <typename T, bool Exact>
+void exp_kernel(size_t n, const T *x, T *y)
+{
+    for (size_t i = 0; i < n; i++)
+        y[i] = exp_elem<T, Exact>(x[i]);
+}
+
+template <typename T, bool Exact>
+void log_kernel(size_t n, const T *x, T *y)
+{
+    for (size_t i = 0; i < n; i++)
+        y[i] = log_elem<T, Exact>(x[i]);
+}
+
+template <typename T, bool Exact>
+void tanh_kernel(size_t n, const T *x, T *y)
+{
+    for (size_t i = 0; i < n; i++)
+        y[i] = tanh_elem<T, Exact>(x[i]);
+}
+
+template <typename T, bool Exact>
+void sigmoid_kernel(size_t n, const T *x, T *y)
+{
+    for (size_t i = 0; i < n; i++)
+        y[i] = sigmoid_elem<T, Exact>(x[i]);
+}
+
+// x^e for an integral |e| >= 1 by repeated squaring, in blocks so the
+// per-bit passes stay in L1 and each one is a flat vectorized loop.
+template <typename T>
+void pow_int_kernel(size_t n, const T *x, T *y, unsigned long long magnitude, bool reciprocal)
+{
+    constexpr size_t block = 256;
+    T base[block], acc[block];
+    for (size_t b = 0; b < n; b += block)
+    {
+        const size_t m = std::min(block, n - b);
+        for (size_t i = 0; i < m; i++)
+        {
+            base[i] = x[b + i];
+            acc[i] = T(1);
+        }
+        for (unsigned long long bits = magnitude; bits; bits >>= 1)
+        {
+            if (bits & 1)
+                for (size_t i = 0; i < m; i++)
+                    acc[i] *= base[i];
+            if (bits > 1)
+                for (size_t i = 0; i < m; i++)
+                    base[i] *= base[i];
+        }
+        for (size_t i = 0; i < m; i++)
+            y[b + i] = reciprocal ? T(1) / acc[i] : acc[i];
+    }
+}
+
+// exp(e * log|x|) evaluated in W (double for the float Exact tier), sign of odd powers
+// restored, NaN for a negative base with a fractional exponent.
+template <typename T, typename W, bool Exact>
+void pow_general_kernel(size_t n, const T *x, T *y, T exponent, bool integral, bool odd)
+{
+    const W e = W(exponent);
+    for (size_t i = 0; i < n; i++)
+    {
+        const T v = x[i];
+        const W a = W(v < T(0) ? -v : v);
+        const T p = T(exp_elem<W, Exact>(e * log_elem<W, Exact>(a)));
+        const T negative = integral ? (odd ? -p : p) : MathTraits<T>::quiet_nan;
+        y[i] = v < T(0) ? negative : p;
+    }
+}
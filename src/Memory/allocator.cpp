@@ -0,0 +1,274 @@
+#include "NovaML/Memory/allocator.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+
+namespace NovaML::Memory
+{
+    namespace
+    {
+        constexpr size_t min_block = buffer_alignment;
+        constexpr size_t large_block = size_t(1) << 20;
+
+        void *system_alloc(size_t bytes)
+        {
+            return ::operator new(bytes, std::align_val_t(buffer_alignment));
+        }
+
+        void system_free(void *ptr)
+        {
+            ::operator delete(ptr, std::align_val_t(buffer_alignment));
+        }
+
+        thread_local ThreadAllocations thread_totals;
+
+        void note_allocation(AllocatorStats &s, size_t bytes)
+        {
+            thread_totals.allocations++;
+            thread_totals.bytes += bytes;
+            s.allocations++;
+            s.bytes_in_use += bytes;
+            s.peak_bytes_in_use = std::max(s.peak_bytes_in_use, s.bytes_in_use);
+        }
+
+        size_t env_size(const char *name, size_t fallback)
+        {
+            if (const char *env = std::getenv(name))
+            {
+                char *end = nullptr;
+                unsigned long long v = std::strtoull(env, &end, 10);
+                if (end != env)
+                    return static_cast<size_t>(v);
+            }
+            return fallback;
+        }
+    }
+
+    // -------------------------
+    // CachingAllocator
+    // -------------------------
+    struct CachingAllocator::Impl
+    {
+        mutable std::mutex mutex;
+        std::unordered_map<size_t, std::vector<void *>> free_lists; ///< Size class -> parked blocks
+        AllocatorStats stats;
+        size_t max_cached_bytes;
+
+        void release_all()
+        {
+            for (auto &[size, blocks] : free_lists)
+            {
+                for (void *ptr : blocks)
+                    system_free(ptr);
+                stats.system_frees += blocks.size();
+                stats.bytes_cached -= size * blocks.size();
+            }
+            free_lists.clear();
+        }
+    };
+
+    CachingAllocator::CachingAllocator(size_t max_cached_bytes) : impl(new Impl)
+    {
+        impl->max_cached_bytes = max_cached_bytes;
+    }
+
+    CachingAllocator::~CachingAllocator()
+    {
+        impl->release_all();
+        delete impl;
+    }
+
+    size_t CachingAllocator::round_size(size_t bytes)
+    {
+        if (bytes <= min_block)
+            return min_block;
+        if (bytes <= large_block)
+        {
+            size_t size = min_block;
+            while (size < bytes)
+                size <<= 1;
+            return size;
+        }
+        return (bytes + large_block - 1) / large_block * large_block;
+    }
+
+    void *CachingAllocator::allocate(size_t bytes)
+    {
+        size_t size = round_size(bytes);
+        {
+            std::lock_guard<std::mutex> lock(impl->mutex);
+            note_allocation(impl->stats, size);
+            auto it = impl->free_lists.find(size);
+            if (it != impl->free_lists.end() && !it->second.empty())
+            {
+                void *ptr = it->second.back();
+                it->second.pop_back();
+                impl->stats.cache_hits++;
+                impl->stats.bytes_cached -= size;
+                return ptr;
+            }
+            impl->stats.system_allocations++;
+        }
+
+        try
+        {
+            return system_alloc(size);
+        }
+        catch (const std::bad_alloc &)
+        {
+            // Out of memory: give the cache back and retry once.
+            std::lock_guard<std::mutex> lock(impl->mutex);
+            impl->release_all();
+        }
+        return system_alloc(size);
+    }
+
+    void CachingAllocator::deallocate(void *ptr, size_t bytes)
+    {
+        if (!ptr)
+            return;
+        size_t size = round_size(bytes);
+        {
+            std::lock_guard<std::mutex> lock(impl->mutex);
+            impl->stats.deallocations++;
+            impl->stats.bytes_in_use -= size;
+            if (impl->stats.bytes_cached + size <= impl->max_cached_bytes)
+            {
+                impl->free_lists[size].push_back(ptr);
+                impl->stats.bytes_cached += size;
+                return;
+            }
+            impl->stats.system_frees++;
+        }
+        system_free(ptr);
+    }
+
+    AllocatorStats CachingAllocator::stats() const
+    {
+        std::lock_guard<std::mutex> lock(impl->mutex);
+        return impl->stats;
+    }
+
+    void CachingAllocator::reset_stats()
+    {
+        std::lock_guard<std::mutex> lock(impl->mutex);
+        AllocatorStats fresh;
+        fresh.bytes_in_use = impl->stats.bytes_in_use;
+        fresh.peak_bytes_in_use = impl->stats.bytes_in_use;
+        fresh.bytes_cached = impl->stats.bytes_cached;
+        impl->stats = fresh;
+    }
+
+    void CachingAllocator::empty_cache()
+    {
+        std::lock_guard<std::mutex> lock(impl->mutex);
+        impl->release_all();
+    }
+
+    void CachingAllocator::set_max_cached_bytes(size_t bytes)
+    {
+        std::lock_guard<std::mutex> lock(impl->mutex);
+        impl->max_cached_bytes = bytes;
+        if (impl->stats.bytes_cached > bytes)
+            impl->release_all();
+    }
+
+    // -------------------------
+    // SystemAllocator
+    // -------------------------
+    struct SystemAllocator::Impl
+    {
+        mutable std::mutex mutex;
+        AllocatorStats stats;
+    };
+
+    SystemAllocator::SystemAllocator() : impl(new Impl) {}
+
+    SystemAllocator::~SystemAllocator() { delete impl; }
+
+    void *SystemAllocator::allocate(size_t bytes)
+    {
+        size_t size = std::max(bytes, min_block);
+        {
+            std::lock_guard<std::mutex> lock(impl->mutex);
+            note_allocation(impl->stats, size);
+            impl->stats.system_allocations++;
+        }
+        return system_alloc(size);
+    }
+
+    void SystemAllocator::deallocate(void *ptr, size_t bytes)
+    {
+        if (!ptr)
+            return;
+        {
+            std::lock_guard<std::mutex> lock(impl->mutex);
+            impl->stats.deallocations++;
+            impl->stats.system_frees++;
+            impl->stats.bytes_in_use -= std::max(bytes, min_block);
+        }
+        system_free(ptr);
+    }
+
+    AllocatorStats SystemAllocator::stats() const
+    {
+        std::lock_guard<std::mutex> lock(impl->mutex);
+        return impl->stats;
+    }
+
+    void SystemAllocator::reset_stats()
+    {
+        std::lock_guard<std::mutex> lock(impl->mutex);
+        AllocatorStats fresh;
+        fresh.bytes_in_use = impl->stats.bytes_in_use;
+        fresh.peak_bytes_in_use = impl->stats.bytes_in_use;
+        impl->stats = fresh;
+    }
+
+    // -------------------------
+    // Global selection
+    // -------------------------
+    // The allocators are intentionally leaked: buffers owned by static
+    // tensors may be released after any function-local static is destroyed.
+    CachingAllocator &caching_allocator()
+    {
+        static CachingAllocator *instance =
+            new CachingAllocator(env_size("NOVAML_CACHE_LIMIT_MB", 1024) << 20);
+        return *instance;
+    }
+
+    SystemAllocator &system_allocator()
+    {
+        static SystemAllocator *instance = new SystemAllocator();
+        return *instance;
+    }
+
+    namespace
+    {
+        Allocator *default_allocator()
+        {
+            const char *env = std::getenv("NOVAML_ALLOCATOR");
+            if (env && std::strcmp(env, "system") == 0)
+                return &system_allocator();
+            return &caching_allocator();
+        }
+
+        std::atomic<Allocator *> &current_allocator()
+        {
+            static std::atomic<Allocator *> current{default_allocator()};
+            return current;
+        }
+    }
+
+    Allocator *get_allocator() { return current_allocator().load(std::memory_order_acquire); }
+
+    ThreadAllocations thread_allocations() { return thread_totals; }
+
+    void set_allocator(Allocator *allocator)
+    {
+        current_allocator().store(allocator ? allocator : default_allocator(), std::memory_order_release);
+    }
+}
@@ -0,0 +1,106 @@
+#include "NovaML/Memory/mapped_file.hpp"
+#include "NovaML/Memory/allocator.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <new>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define NOVAML_HAS_MMAP 1
+#endif
+
+namespace NovaML::Memory
+{
+    namespace
+    {
+        // Heap copies stand in for mappings only where mmap is unavailable;
+        // heap_free also releases them in ~MappedFile, which is always compiled.
+#ifndef NOVAML_HAS_MMAP
+        char *heap_alloc(size_t bytes)
+        {
+            return static_cast<char *>(::operator new(std::max<size_t>(bytes, 1), std::align_val_t(buffer_alignment)));
+        }
+#endif
+
+        void heap_free(void *ptr)
+        {
+            ::operator delete(ptr, std::align_val_t(buffer_alignment));
+        }
+    }
+
+    std::shared_ptr<MappedFile> MappedFile::open(const std::string &path)
+    {
+#ifdef NOVAML_HAS_MMAP
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            throw std::runtime_error("MappedFile: cannot open " + path + ": " + std::strerror(errno));
+        struct stat st;
+        if (::fstat(fd, &st) != 0)
+        {
+            ::close(fd);
+            throw std::runtime_error("MappedFile: cannot stat " + path);
+        }
+        const size_t length = static_cast<size_t>(st.st_size);
+        void *base = nullptr;
+        if (length > 0)
+        {
+            base = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+            if (base == MAP_FAILED)
+            {
+                ::close(fd);
+                throw std::runtime_error("MappedFile: cannot map " + path + ": " + std::strerror(errno));
+            }
+        }
+        ::close(fd); // the mapping keeps the file referenced
+        return std::shared_ptr<MappedFile>(new MappedFile(static_cast<char *>(base), length, true));
+#else
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        if (!in)
+            throw std::runtime_error("MappedFile: cannot open " + path);
+        const size_t length = static_cast<size_t>(in.tellg());
+        char *base = heap_alloc(length);
+        in.seekg(0);
+        if (!in.read(base, static_cast<std::streamsize>(length)))
+        {
+            heap_free(base);
+            throw std::runtime_error("MappedFile: cannot read " + path);
+        }
+        return std::shared_ptr<MappedFile>(new MappedFile(base, length, false));
+#endif
+    }
+
+    MappedFile::~MappedFile()
+    {
+#ifdef NOVAML_HAS_MMAP
+        if (mapped)
+        {
+            if (base)
+                ::munmap(base, length);
+            return;
+        }
+#endif
+        heap_free(base);
+    }
+
+    std::shared_ptr<void> map_zeros(size_t bytes)
+    {
+        bytes = std::max<size_t>(bytes, 1);
+#ifdef NOVAML_HAS_MMAP
+        void *base = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (base == MAP_FAILED)
+            throw std::bad_alloc();
+        return std::shared_ptr<void>(base, [bytes](void *p)
+                                     { ::munmap(p, bytes); });
+#else
+        char *base = heap_alloc(bytes);
+        std::memset(base, 0, bytes);
+        return std::shared_ptr<void>(base, heap_free);
+#endif
+    }
+}
@@ -0,0 +1,283 @@
+#include "NovaML/Parallel/thread_pool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace NovaML::Parallel
+{
+    namespace
+    {
+        struct Job
+        {
+            ThreadPool::RangeFn fn;
+            void *ctx;
+            std::atomic<size_t> remaining{0};
+            std::mutex error_mutex;
+            std::exception_ptr error;
+        };
+
+        struct Task
+        {
+            Job *job;
+            size_t begin;
+            size_t end;
+        };
+
+        struct WorkQueue
+        {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+        };
+
+        size_t default_num_threads()
+        {
+            if (const char *env = std::getenv("NOVAML_NUM_THREADS"))
+            {
+                long n = std::strtol(env, nullptr, 10);
+                if (n > 0)
+                    return static_cast<size_t>(n);
+            }
+            return std::max(1u, std::thread::hardware_concurrency());
+        }
+    }
+
+    struct ThreadPool::Impl
+    {
+        std::vector<std::unique_ptr<WorkQueue>> queues; ///< One per worker thread
+        std::vector<std::thread> threads;
+        std::mutex sleep_mutex;
+        std::condition_variable wake;
+        std::atomic<size_t> queued{0};
+        bool stopping = false;
+        std::atomic<size_t> next_queue{0};
+        std::atomic<size_t> workers{0};
+
+        // resize() swaps the workers only while no run() is in flight.
+        std::mutex resize_mutex;
+        size_t active_runs = 0;
+
+        // Identifies the worker running on the current thread, if any.
+        static thread_local Impl *current_pool;
+        static thread_local size_t current_index;
+
+        void start(size_t workers)
+        {
+            stopping = false;
+            queues.clear();
+            for (size_t i = 0; i < workers; i++)
+                queues.push_back(std::make_unique<WorkQueue>());
+            for (size_t i = 0; i < workers; i++)
+                threads.emplace_back([this, i]
+                                     { worker_loop(i); });
+            this->workers.store(workers, std::memory_order_release);
+        }
+
+        void stop()
+        {
+            {
+                std::lock_guard<std::mutex> lock(sleep_mutex);
+                stopping = true;
+            }
+            wake.notify_all();
+            for (auto &t : threads)
+                t.join();
+            threads.clear();
+            workers.store(0, std::memory_order_release);
+        }
+
+        void push(size_t queue, const Task &task)
+        {
+            {
+                std::lock_guard<std::mutex> lock(queues[queue]->mutex);
+                queues[queue]->tasks.push_back(task);
+            }
+            queued.fetch_add(1, std::memory_order_release);
+        }
+
+        bool pop_local(size_t queue, Task &task)
+        {
+            auto &q = *queues[queue];
+            std::lock_guard<std::mutex> lock(q.mutex);
+            if (q.tasks.empty())
+                return false;
+            task = q.tasks.back();
+            q.tasks.pop_back();
+            queued.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+
+        bool steal(size_t start, Task &task)
+        {
+            for (size_t k = 0; k < queues.size(); k++)
+            {
+                auto &q = *queues[(start + k) % queues.size()];
+                std::lock_guard<std::mutex> lock(q.mutex);
+                if (q.tasks.empty())
+                    continue;
+                task = q.tasks.front();
+                q.tasks.pop_front();
+                queued.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+            return false;
+        }
+
+        bool try_run_one(size_t self)
+        {
+            if (queues.empty())
+                return false;
+            Task task;
+            bool found = self < queues.size() ? pop_local(self, task) || steal(self + 1, task)
+                                              : steal(next_queue++ % queues.size(), task);
+            if (!found)
+                return false;
+            execute(task);
+            return true;
+        }
+
+        static void execute(const Task &task)
+        {
+            Job *job = task.job;
+            try
+            {
+                job->fn(job->ctx, task.begin, task.end);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(job->error_mutex);
+                if (!job->error)
+                    job->error = std::current_exception();
+            }
+            job->remaining.fetch_sub(1, std::memory_order_acq_rel);
+        }
+
+        void worker_loop(size_t index)
+        {
+            current_pool = this;
+            current_index = index;
+            while (true)
+            {
+                if (try_run_one(index))
+                    continue;
+                std::unique_lock<std::mutex> lock(sleep_mutex);
+                wake.wait(lock, [this]
+                          { return stopping || queued.load(std::memory_order_acquire) > 0; });
+                if (stopping)
+                    return;
+            }
+        }
+    };
+
+    thread_local ThreadPool::Impl *ThreadPool::Impl::current_pool = nullptr;
+    thread_local size_t ThreadPool::Impl::current_index = 0;
+
+    ThreadPool &ThreadPool::instance()
+    {
+        static ThreadPool pool(default_num_threads());
+        return pool;
+    }
+
+    ThreadPool::ThreadPool(size_t num_threads) : impl(new Impl)
+    {
+        impl->start(num_threads > 1 ? num_threads - 1 : 0);
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        impl->stop();
+        delete impl;
+    }
+
+    size_t ThreadPool::num_threads() const { return impl->workers.load(std::memory_order_acquire) + 1; }
+
+    void ThreadPool::resize(size_t num_threads)
+    {
+        if (num_threads == 0)
+            num_threads = default_num_threads();
+        std::lock_guard<std::mutex> lock(impl->resize_mutex);
+        if (impl->active_runs > 0)
+            throw std::logic_error("ThreadPool::resize: called while a parallel range is running");
+        if (num_threads == this->num_threads())
+            return;
+        impl->stop();
+        impl->start(num_threads - 1);
+    }
+
+    void ThreadPool::run(size_t begin, size_t end, size_t grain, RangeFn fn, void *ctx)
+    {
+        if (end <= begin)
+            return;
+        // Registered runs keep resize() from tearing down the queues under us.
+        {
+            std::lock_guard<std::mutex> lock(impl->resize_mutex);
+            impl->active_runs++;
+        }
+        struct Unregister
+        {
+            Impl *impl;
+            ~Unregister()
+            {
+                std::lock_guard<std::mutex> lock(impl->resize_mutex);
+                impl->active_runs--;
+            }
+        } unregister{impl};
+
+        const size_t n = end - begin;
+        const size_t threads = num_threads();
+        grain = std::max<size_t>(grain, 1);
+
+        // A few chunks per thread keeps the load balanced without tiny tasks.
+        size_t chunks = std::min((n + grain - 1) / grain, threads * 4);
+        if (chunks <= 1 || impl->queues.empty())
+        {
+            fn(ctx, begin, end);
+            return;
+        }
+        const size_t chunk = (n + chunks - 1) / chunks;
+        chunks = (n + chunk - 1) / chunk;
+
+        Job job;
+        job.fn = fn;
+        job.ctx = ctx;
+        job.remaining.store(chunks, std::memory_order_relaxed);
+
+        const bool on_worker = Impl::current_pool == impl;
+        const size_t self = on_worker ? Impl::current_index : impl->queues.size();
+
+        // Keep the first chunk for this thread; spread the rest over the queues.
+        for (size_t c = 1; c < chunks; c++)
+        {
+            size_t b = begin + c * chunk;
+            Task task{&job, b, std::min(end, b + chunk)};
+            impl->push(on_worker ? self : (c - 1) % impl->queues.size(), task);
+        }
+        {
+            std::lock_guard<std::mutex> lock(impl->sleep_mutex);
+        }
+        impl->wake.notify_all();
+
+        Impl::execute({&job, begin, std::min(end, begin + chunk)});
+
+        // Help with any queued work (ours or others') until the job is done.
+        while (job.remaining.load(std::memory_order_acquire) > 0)
+        {
+            if (!impl->try_run_one(self))
+                std::this_thread::yield();
+        }
+
+        if (job.error)
+            std::rethrow_exception(job.error);
+    }
+
+    size_t get_num_threads() { return ThreadPool::instance().num_threads(); }
+
+    void set_num_threads(size_t num_threads) { ThreadPool::instance().resize(num_threads); }
+}
@@ -0,0 +1,285 @@
+#include "NovaML/Profiler/profiler.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+
+namespace NovaML::Profiler
+{
+    namespace detail
+    {
+        std::atomic<bool> enabled{false};
+    }
+
+    namespace
+    {
+        uint64_t now_ns()
+        {
+            using namespace std::chrono;
+            static const steady_clock::time_point origin = steady_clock::now();
+            return static_cast<uint64_t>(duration_cast<nanoseconds>(steady_clock::now() - origin).count());
+        }
+
+        /// Events of one thread. Only the owner touches `open`; `events` is
+        /// also read by the collecting thread, hence the mutex.
+        struct ThreadBuffer
+        {
+            uint32_t id = 0;
+            std::vector<uint64_t> open; ///< nested time accumulated per open scope
+            std::mutex mutex;
+            std::vector<Event> events;
+        };
+
+        struct Registry
+        {
+            std::mutex mutex;
+            std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+            std::atomic<uint64_t> epoch{0};
+        };
+
+        // Leaked on purpose: threads may still record while statics are destroyed.
+        Registry &registry()
+        {
+            static Registry *r = new Registry;
+            return *r;
+        }
+
+        ThreadBuffer &local_buffer()
+        {
+            thread_local std::shared_ptr<ThreadBuffer> buffer = []
+            {
+                auto b = std::make_shared<ThreadBuffer>();
+                Registry &r = registry();
+                std::lock_guard<std::mutex> lock(r.mutex);
+                b->id = static_cast<uint32_t>(r.buffers.size());
+                r.buffers.push_back(b);
+                return b;
+            }();
+            return *buffer;
+        }
+
+        std::string json_escape(const std::string &s)
+        {
+            std::string out;
+            for (char c : s)
+            {
+                if (c == '"' || c == '\\')
+                    out += '\\';
+                if (static_cast<unsigned char>(c) >= 0x20)
+                    out += c;
+            }
+            return out;
+        }
+
+        // NOVAML_PROFILE=<path>: profile the whole run, dump at exit.
+        struct EnvSession
+        {
+            EnvSession()
+            {
+                if (const char *env = std::getenv("NOVAML_PROFILE"); env && *env)
+                {
+                    path = env;
+                    enable();
+                }
+            }
+            ~EnvSession()
+            {
+                if (path.empty())
+                    return;
+                disable();
+                try
+                {
+                    export_chrome_trace(path);
+                    std::cerr << summary_table();
+                }
+                catch (const std::exception &e)
+                {
+                    std::cerr << "NOVAML_PROFILE: " << e.what() << "\n";
+                }
+            }
+            std::string path;
+        };
+        EnvSession env_session;
+    }
+
+    namespace detail
+    {
+        uint64_t begin_scope()
+        {
+            local_buffer().open.push_back(0);
+            return now_ns();
+        }
+
+        void end_scope(std::string name, Category category, uint64_t start_ns,
+                       double flops, double bytes, const Memory::ThreadAllocations &before)
+        {
+            const uint64_t end = now_ns();
+            ThreadBuffer &b = local_buffer();
+            const uint64_t duration = end - start_ns;
+            const uint64_t nested = b.open.back();
+            b.open.pop_back();
+            if (!b.open.empty())
+                b.open.back() += duration;
+
+            const Memory::ThreadAllocations after = Memory::thread_allocations();
+            const uint64_t epoch = registry().epoch.load(std::memory_order_relaxed);
+
+            Event e;
+            e.name = std::move(name);
+            e.category = category;
+            e.start_ns = start_ns > epoch ? start_ns - epoch : 0;
+            e.duration_ns = duration;
+            e.self_ns = duration > nested ? duration - nested : 0;
+            e.thread = b.id;
+            e.depth = static_cast<uint32_t>(b.open.size());
+            e.flops = flops;
+            e.bytes = bytes;
+            e.allocations = after.allocations - before.allocations;
+            e.allocated_bytes = after.bytes - before.bytes;
+
+            std::lock_guard<std::mutex> lock(b.mutex);
+            b.events.push_back(std::move(e));
+        }
+    }
+
+    std::string category_name(Category category)
+    {
+        switch (category)
+        {
+        case Category::Op:
+            return "op";
+        case Category::Backward:
+            return "backward";
+        case Category::Module:
+            return "module";
+        case Category::Kernel:
+            return "kernel";
+        default:
+            return "user";
+        }
+    }
+
+    void enable()
+    {
+        // First enable starts the clock; later ones continue the same timeline.
+        Registry &r = registry();
+        uint64_t expected = 0;
+        r.epoch.compare_exchange_strong(expected, now_ns());
+        detail::enabled.store(true, std::memory_order_relaxed);
+    }
+
+    void disable() { detail::enabled.store(false, std::memory_order_relaxed); }
+
+    void clear()
+    {
+        Registry &r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        for (auto &b : r.buffers)
+        {
+            std::lock_guard<std::mutex> buffer_lock(b->mutex);
+            b->events.clear();
+        }
+        r.epoch.store(now_ns(), std::memory_order_relaxed);
+    }
+
+    std::vector<Event> events()
+    {
+        Registry &r = registry();
+        std::vector<Event> out;
+        std::lock_guard<std::mutex> lock(r.mutex);
+        for (auto &b : r.buffers)
+        {
+            std::lock_guard<std::mutex> buffer_lock(b->mutex);
+            // Scopes are appended when they close; restore start order.
+            size_t first = out.size();
+            out.insert(out.end(), b->events.begin(), b->events.end());
+            std::stable_sort(out.begin() + first, out.end(), [](const Event &x, const Event &y)
+                             { return x.start_ns < y.start_ns || (x.start_ns == y.start_ns && x.depth < y.depth); });
+        }
+        return out;
+    }
+
+    std::vector<OpSummary> summarize()
+    {
+        std::map<std::pair<Category, std::string>, OpSummary> groups;
+        for (const Event &e : events())
+        {
+            OpSummary &s = groups[{e.category, e.name}];
+            s.name = e.name;
+            s.category = e.category;
+            s.calls++;
+            s.total_ns += e.duration_ns;
+            s.self_ns += e.self_ns;
+            s.flops += e.flops;
+            s.bytes += e.bytes;
+            s.allocations += e.allocations;
+        }
+        std::vector<OpSummary> out;
+        for (auto &entry : groups)
+            out.push_back(std::move(entry.second));
+        std::stable_sort(out.begin(), out.end(), [](const OpSummary &x, const OpSummary &y)
+                         { return x.self_ns > y.self_ns; });
+        return out;
+    }
+
+    std::string summary_table(size_t max_rows)
+    {
+        std::vector<OpSummary> rows = summarize();
+        uint64_t self_total = 0;
+        for (const auto &s : rows)
+            self_total += s.self_ns;
+
+        std::string out;
+        char line[256];
+        std::snprintf(line, sizeof(line), "%-32s %-8s %8s %11s %11s %7s %10s %9s %8s %8s\n", "name", "category", "calls",
+                      "total ms", "self ms", "self %", "avg us", "GFLOP/s", "GB/s", "allocs");
+        out += line;
+        for (size_t i = 0; i < rows.size() && i < max_rows; i++)
+        {
+            const OpSummary &s = rows[i];
+            const double total_ns = static_cast<double>(s.total_ns);
+            std::snprintf(line, sizeof(line), "%-32.32s %-8s %8zu %11.3f %11.3f %6.1f%% %10.2f %9.2f %8.2f %8zu\n",
+                          s.name.c_str(), category_name(s.category).c_str(), s.calls, total_ns / 1e6,
+                          static_cast<double>(s.self_ns) / 1e6,
+                          self_total ? 100.0 * static_cast<double>(s.self_ns) / static_cast<double>(self_total) : 0.0,
+                          total_ns / 1e3 / static_cast<double>(s.calls), total_ns > 0 ? s.flops / total_ns : 0.0,
+                          total_ns > 0 ? s.bytes / total_ns : 0.0, s.allocations);
+            out += line;
+        }
+        if (rows.size() > max_rows)
+            out += "... " + std::to_string(rows.size() - max_rows) + " more\n";
+        return out;
+    }
+
+    void export_chrome_trace(const std::string &path)
+    {
+        std::ofstream out(path);
+        if (!out)
+            throw std::runtime_error("export_chrome_trace: cannot write " + path);
+
+        std::vector<Event> all = events();
+        uint32_t threads = 0;
+        out << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [\n";
+        for (const Event &e : all)
+        {
+            threads = std::max(threads, e.thread + 1);
+            char times[96];
+            std::snprintf(times, sizeof(times), "\"ts\": %.3f, \"dur\": %.3f", static_cast<double>(e.start_ns) / 1e3,
+                          static_cast<double>(e.duration_ns) / 1e3);
+            out << "  {\"name\": \"" << json_escape(e.name) << "\", \"cat\": \"" << category_name(e.category)
+                << "\", \"ph\": \"X\", " << times << ", \"pid\": 0, \"tid\": " << e.thread
+                << ", \"args\": {\"flops\": " << e.flops << ", \"bytes\": " << e.bytes
+                << ", \"allocations\": " << e.allocations << ", \"allocated_bytes\": " << e.allocated_bytes << "}},\n";
+        }
+        for (uint32_t t = 0; t < threads; t++)
+            out << "  {\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 0, \"tid\": " << t
+                << ", \"args\": {\"name\": \"thread " << t << "\"}},\n";
+        out << "  {\"name\": \"process_name\", \"ph\": \"M\", \"pid\": 0, \"args\": {\"name\": \"NovaML\"}}\n]}\n";
+    }
+}
@@ -0,0 +1,95 @@
+#include <NovaML/Memory/allocator.hpp>
+#include <NovaML/Core/Tensor/tensor.hpp>
+#include <NovaML/Core/Tensor/tensor_math.hpp>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+
+using namespace NovaML::Core;
+namespace Memory = NovaML::Memory;
+
+// One forward/backward step over small tensors, the case where malloc dominates.
+double step(const std::shared_ptr<Tensor<double>> &w)
+{
+    auto x = std::make_shared<Tensor<double>>(std::vector<double>{0.5, -1.0, 2.0, 0.25}, false);
+    auto y = exp(w * x) + w;
+    auto loss = mean(y * y);
+    loss->backward();
+    return (*loss)[0];
+}
+
+void print_stats(const char *label, const Memory::AllocatorStats &s)
+{
+    std::cout << label << ": allocations=" << s.allocations << " cache_hits=" << s.cache_hits
+              << " system_allocations=" << s.system_allocations << " in_use=" << s.bytes_in_use
+              << " peak=" << s.peak_bytes_in_use << " cached=" << s.bytes_cached << "\n";
+}
+
+double time_steps(const std::shared_ptr<Tensor<double>> &w, int steps)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < steps; i++)
+        step(w);
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / steps;
+}
+
+int main()
+{
+    bool ok = true;
+
+    // ---------- Size classes ----------
+    ok = ok && Memory::CachingAllocator::round_size(1) == 64 &&
+         Memory::CachingAllocator::round_size(65) == 128 &&
+         Memory::CachingAllocator::round_size((1 << 20) + 1) == (size_t(2) << 20);
+
+    // ---------- Alignment ----------
+    Buffer<float> aligned(3);
+    ok = ok && reinterpret_cast<std::uintptr_t>(aligned.data()) % Memory::buffer_alignment == 0;
+
+    // ---------- Steady state never reaches the system allocator ----------
+    Memory::set_allocator(&Memory::caching_allocator());
+    auto w = std::make_shared<Tensor<double>>(std::vector<double>{0.1, 0.2, 0.3, 0.4}, true);
+    // Warm-up: the first step's buffer for w's gradient is adopted as its grad storage.
+    step(w);
+    step(w);
+    Memory::reset_stats();
+    for (int i = 0; i < 100; i++)
+        step(w);
+    Memory::AllocatorStats cached = Memory::get_stats();
+    print_stats("caching", cached);
+    ok = ok && cached.allocations > 0 && cached.system_allocations == 0 &&
+         cached.cache_hits == cached.allocations && cached.deallocations == cached.allocations;
+
+    // ---------- Same results through the uncached allocator ----------
+    double loss_cached = step(w);
+    Memory::set_allocator(&Memory::system_allocator());
+    Memory::reset_stats();
+    double loss_system = step(w);
+    Memory::AllocatorStats system = Memory::get_stats();
+    print_stats("system", system);
+    ok = ok && system.system_allocations == system.allocations && system.cache_hits == 0;
+    ok = ok && loss_cached == loss_system;
+
+    // Buffers created under one allocator are freed by it after a switch.
+    Memory::set_allocator(&Memory::caching_allocator());
+    size_t in_use_before = Memory::caching_allocator().stats().bytes_in_use;
+    {
+        Memory::set_allocator(&Memory::system_allocator());
+        Buffer<double> from_system(1000);
+        Memory::set_allocator(&Memory::caching_allocator());
+    }
+    ok = ok && Memory::caching_allocator().stats().bytes_in_use == in_use_before;
+
+    // ---------- empty_cache releases parked blocks ----------
+    Memory::empty_cache();
+    ok = ok && Memory::get_stats().bytes_cached == 0;
+
+    // ---------- Per-step cost ----------
+    Memory::set_allocator(&Memory::system_allocator());
+    double us_system = time_steps(w, 20000);
+    Memory::set_allocator(&Memory::caching_allocator());
+    double us_cached = time_steps(w, 20000);
+    std::cout << "small step: system " << us_system << " us, caching " << us_cached << " us\n";
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,41 @@
+#include <NovaML/Core/Tensor/tensor.hpp>
+#include <NovaML/Core/Tensor/tensor_math.hpp>
+#include <iostream>
+
+using namespace NovaML::Core;
+
+int main()
+{
+    // ---------- Diamond: y = x * x + x ----------
+    auto x = std::make_shared<Tensor<double>>(std::vector<double>{1.0, 2.0, 3.0}, true);
+    auto y = x * x + x;
+    y->backward();
+    std::cout << "Diamond x*x + x: " << *y << std::endl;
+    std::cout << "Gradients x: " << vector_to_string(x->get_grad()) << "\n\n"; // 2x + 1
+
+    // ---------- Deep chain of shared subexpressions ----------
+    // Each level reuses the previous node twice; a per-path walk would visit 2^depth paths.
+    const int depth = 40;
+    auto z = std::make_shared<Tensor<double>>(std::vector<double>{1.0}, true);
+    auto h = z;
+    for (int i = 0; i < depth; i++)
+        h = h + h;
+    h->backward();
+    std::cout << "Depth " << depth << " doubling: " << h->at(0) << std::endl;
+    std::cout << "Gradients z: " << vector_to_string(z->get_grad()) << "\n\n"; // 2^depth
+
+    // ---------- Long linear chain ----------
+    auto w = std::make_shared<Tensor<double>>(std::vector<double>{0.5, 1.5}, true);
+    auto c = w;
+    for (int i = 0; i < 100000; i++)
+        c = c + 1.0;
+    auto s = sum(c);
+    s->backward();
+    std::cout << "Chain of 100000 adds, sum: " << s->at(0) << std::endl;
+    std::cout << "Gradients w: " << vector_to_string(w->get_grad()) << "\n";
+
+    bool ok = x->get_grad() == Buffer<double>{3.0, 5.0, 7.0} &&
+              z->get_grad()[0] == static_cast<double>(1ULL << depth) &&
+              w->get_grad() == Buffer<double>{1.0, 1.0};
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,145 @@
+#include <NovaML/Core/Tensor/tensor.hpp>
+#include <NovaML/Core/Tensor/tensor_math.hpp>
+#include <NovaML/Memory/allocator.hpp>
+#include <cmath>
+#include <iostream>
+
+using namespace NovaML::Core;
+namespace Memory = NovaML::Memory;
+
+using TensorPtr = std::shared_ptr<Tensor<double>>;
+
+TensorPtr make(const std::vector<double> &v, const Shape &shape, bool requires_grad = true)
+{
+    return std::make_shared<Tensor<double>>(v, shape, requires_grad);
+}
+
+// Materialize `t` repeated to `shape`, the reference for the zero-copy path.
+TensorPtr tile(const TensorPtr &t, const Shape &shape)
+{
+    return make(expand(t, shape)->get_data(), shape);
+}
+
+template <typename A, typename B>
+double max_diff(const A &x, const B &y)
+{
+    double m = 0;
+    for (size_t i = 0; i < x.size(); i++)
+        m = std::max(m, std::abs(x[i] - y[i]));
+    return m;
+}
+
+template <typename F>
+bool throws(F f)
+{
+    try
+    {
+        f();
+    }
+    catch (const std::invalid_argument &err)
+    {
+        std::cout << "  rejected: " << err.what() << "\n";
+        return true;
+    }
+    return false;
+}
+
+int main()
+{
+    bool ok = true;
+
+    // ---------- Bias add: [B, N] + [N], gradient summed over the batch ----------
+    auto x = make({1, 2, 3, 4, 5, 6}, {2, 3});
+    auto bias = make({10, 20, 30}, {3});
+    auto y = x + bias;
+    sum(y * y)->backward();
+    std::cout << "bias add: " << vector_to_string(y->get_data()) << " shape " << shape_to_string(y->shape())
+              << ", bias grad " << vector_to_string(bias->get_grad()) << "\n";
+    ok = ok && y->shape() == Shape{2, 3} && y->get_data() == std::vector<double>{11, 22, 33, 14, 25, 36} &&
+         bias->get_grad() == Buffer<double>{50, 94, 138} &&
+         x->get_grad() == Buffer<double>{22, 44, 66, 28, 50, 72};
+
+    // ---------- Column [B, 1] and outer product [B, 1] * [1, N] ----------
+    auto col = make({2, 4}, {2, 1});
+    auto row = make({1, 10, 100}, {1, 3});
+    auto outer = col * row;
+    sum(outer)->backward();
+    std::cout << "outer: " << vector_to_string(outer->get_data()) << ", col grad " << vector_to_string(col->get_grad())
+              << ", row grad " << vector_to_string(row->get_grad()) << "\n";
+    ok = ok && outer->shape() == Shape{2, 3} && outer->get_data() == std::vector<double>{2, 20, 200, 4, 40, 400} &&
+         col->get_grad() == Buffer<double>{111, 111} && row->get_grad() == Buffer<double>{6, 6, 6};
+
+    // ---------- Every op against explicitly tiled operands, including strided ones ----------
+    auto a = make({0.5, -1.5, 2.0, 3.0, 1.25, -0.75}, {2, 3});
+    auto at = transpose(a); // [3, 2], strided
+    auto c = make({2.0, -4.0}, {2});
+    auto tiled = tile(c, {3, 2});
+    double err = 0;
+    for (int op = 0; op < 4; op++)
+    {
+        auto apply = [op](const TensorPtr &l, const TensorPtr &r)
+        {
+            switch (op)
+            {
+            case 0:
+                return l + r;
+            case 1:
+                return l - r;
+            case 2:
+                return l * r;
+            default:
+                return l / r;
+            }
+        };
+        a->zero_grad();
+        c->zero_grad();
+        tiled->zero_grad();
+        auto got = apply(at, c);
+        sum(got * got)->backward();
+        Buffer<double> grad_a = a->get_grad(), grad_c = c->get_grad();
+
+        a->zero_grad();
+        auto want = apply(contiguous(at), tiled);
+        sum(want * want)->backward();
+        // The tiled reference's gradient summed over its rows is the broadcast gradient.
+        const auto &gt = tiled->get_grad();
+        Buffer<double> reduced{gt[0] + gt[2] + gt[4], gt[1] + gt[3] + gt[5]};
+        err = std::max({err, max_diff(got->get_data(), want->get_data()), max_diff(grad_a, a->get_grad()),
+                        max_diff(grad_c, reduced)});
+        // Scalar-like {1} and the reversed operand order broadcast the same way.
+        auto s = make({3.0}, {1});
+        err = std::max(err, max_diff(apply(s, at)->get_data(), apply(tile(s, {3, 2}), contiguous(at))->get_data()));
+    }
+    std::cout << "max |broadcast - tiled|: " << err << "\n";
+    ok = ok && err < 1e-12;
+
+    // ---------- Incompatible shapes are rejected ----------
+    ok = ok && throws([&]
+                      { x + make({1, 2}, {2}); });
+    ok = ok && throws([&]
+                      { x * make({1, 2, 3, 4}, {4, 1}); });
+
+    // ---------- In-place updates broadcast the right operand ----------
+    {
+        NoGradGuard no_grad;
+        Tensor<double> m(std::vector<double>{1, 2, 3, 4, 5, 6}, Shape{2, 3});
+        add_(m, Tensor<double>(std::vector<double>{1, 2, 3}, Shape{3}));
+        mul_(m, Tensor<double>(std::vector<double>{1, 10}, Shape{2, 1}));
+        std::cout << "in-place: " << vector_to_string(m.get_data()) << "\n";
+        ok = ok && m.get_data() == std::vector<double>{2, 4, 6, 50, 70, 90};
+        Tensor<double> small(std::vector<double>{1, 2, 3}, Shape{3});
+        ok = ok && throws([&]
+                          { add_(small, m); });
+    }
+
+    // ---------- No expanded copies: one result buffer per op ----------
+    auto big = make(std::vector<double>(1 << 16, 1.0), {256, 256}, false);
+    auto vec = make(std::vector<double>(256, 2.0), {256}, false);
+    auto warm = big + vec;
+    Memory::reset_stats();
+    auto r = big + vec;
+    std::cout << "allocations for [256, 256] + [256]: " << Memory::get_stats().allocations << "\n";
+    ok = ok && Memory::get_stats().allocations == 1 && r->get_data()[1000] == 3.0;
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,489 @@
+#include <NovaML/Core/Layer/conv2d.hpp>
+#include <NovaML/Core/Layer/pool2d.hpp>
+#include <NovaML/Core/Layer/normalization.hpp>
+#include <NovaML/Core/Layer/flatten.hpp>
+#include <NovaML/Core/Layer/dense.hpp>
+#include <NovaML/Core/Kernel/vmath.hpp>
+#include <NovaML/Core/Activation/relu.hpp>
+#include <NovaML/Core/Module/sequential.hpp>
+#include <NovaML/Parallel/thread_pool.hpp>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <random>
+
+using namespace NovaML::Core;
+using LayerModule::DataFormat;
+using Kernel::Activation;
+
+template <typename T>
+TensorModule::Tensor<T> random_tensor(const Shape &shape, unsigned seed)
+{
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    std::vector<T> data(numel(shape));
+    for (auto &v : data)
+        v = T(dist(gen));
+    return TensorModule::Tensor<T>(data, shape);
+}
+
+template <typename A, typename B>
+double max_diff(const A &x, const B &y, size_t n)
+{
+    double m = 0;
+    for (size_t i = 0; i < n; i++)
+        m = std::max(m, std::abs(static_cast<double>(x[i]) - static_cast<double>(y[i])));
+    return m;
+}
+
+/// Element (n, c, h, w) of an image batch stored in `format`.
+size_t image_index(DataFormat format, size_t C, size_t H, size_t W, size_t n, size_t c, size_t h, size_t w)
+{
+    return format == DataFormat::NCHW ? ((n * C + c) * H + h) * W + w : ((n * H + h) * W + w) * C + c;
+}
+
+// Direct convolution, in the layer's weight and image formats.
+template <typename T>
+std::vector<double> reference_conv(const LayerModule::Conv2D<T> &conv, const TensorModule::Tensor<T> &x)
+{
+    const auto &o = conv.options();
+    const Shape in = x.shape(), out = conv.output_shape(in);
+    const bool nchw = o.format == DataFormat::NCHW;
+    const size_t N = in[0], C = nchw ? in[1] : in[3], H = nchw ? in[2] : in[1], W = nchw ? in[3] : in[2];
+    const size_t O = conv.output_channels(), K = conv.kernel_size();
+    const size_t OH = nchw ? out[2] : out[1], OW = nchw ? out[3] : out[2];
+    std::vector<double> y(numel(out));
+    for (size_t n = 0; n < N; n++)
+        for (size_t oc = 0; oc < O; oc++)
+            for (size_t oh = 0; oh < OH; oh++)
+                for (size_t ow = 0; ow < OW; ow++)
+                {
+                    double s = conv.bias()[oc];
+                    for (size_t c = 0; c < C; c++)
+                        for (size_t kh = 0; kh < K; kh++)
+                            for (size_t kw = 0; kw < K; kw++)
+                            {
+                                const long ih = long(oh * o.stride + kh) - long(o.padding);
+                                const long iw = long(ow * o.stride + kw) - long(o.padding);
+                                if (ih < 0 || iw < 0 || ih >= long(H) || iw >= long(W))
+                                    continue;
+                                const size_t wi = nchw ? ((oc * C + c) * K + kh) * K + kw : ((oc * K + kh) * K + kw) * C + c;
+                                s += double(conv.weights()[wi]) * double(x[image_index(o.format, C, H, W, n, c, ih, iw)]);
+                            }
+                    y[image_index(o.format, O, OH, OW, n, oc, oh, ow)] = Kernel::activate(o.activation, s);
+                }
+    return y;
+}
+
+/**
+ * Finite-difference check of a module on the loss sum(y * r): input
+ * gradient, and the parameter gradients at `params` / `grads` if given.
+ */
+double gradient_error(Module::BaseModule<double> &m, TensorModule::Tensor<double> x,
+                      double *params = nullptr, const double *grads = nullptr, size_t count = 0)
+{
+    const auto y0 = m.forward(x);
+    const auto r = random_tensor<double>(y0.shape(), 99);
+    const auto dx = m.backward(r);
+    std::vector<double> analytic(grads, grads + count);
+
+    auto loss = [&]
+    {
+        const auto y = m.forward(x);
+        double s = 0;
+        for (size_t i = 0; i < y.size(); i++)
+            s += y[i] * r[i];
+        return s;
+    };
+    auto numeric = [&](double &v)
+    {
+        const double h = 1e-6, keep = v;
+        v = keep + h;
+        const double up = loss();
+        v = keep - h;
+        const double down = loss();
+        v = keep;
+        return (up - down) / (2 * h);
+    };
+
+    double err = 0;
+    for (size_t i = 0; i < x.size(); i += 1 + x.size() / 40)
+        err = std::max(err, std::abs(numeric(x.data_ptr()[i]) - dx[i]));
+    for (size_t i = 0; i < count; i += 1 + count / 40)
+        err = std::max(err, std::abs(numeric(params[i]) - analytic[i]));
+    return err;
+}
+
+int main()
+{
+    bool ok = true;
+    // Outputs are compared against libm activations: keep the Exact tier whatever NOVAML_MATH says.
+    const Kernel::MathAccuracy tier = Kernel::math_accuracy();
+    Kernel::set_math_accuracy(Kernel::MathAccuracy::Exact);
+    const DataFormat formats[] = {DataFormat::NCHW, DataFormat::NHWC};
+
+    // ---------- Conv2D forward against the direct convolution ----------
+    struct Case
+    {
+        size_t C, O, K, stride, padding, H, W;
+        LayerModule::ConvAlgorithm algorithm;
+        Activation act;
+    };
+    using LayerModule::ConvAlgorithm;
+    const Case cases[] = {
+        {3, 5, 3, 1, 0, 8, 9, ConvAlgorithm::Im2col, Activation::None},
+        {4, 6, 3, 2, 1, 9, 7, ConvAlgorithm::Im2col, Activation::ReLU},
+        {2, 3, 5, 3, 2, 11, 10, ConvAlgorithm::Im2col, Activation::None},
+        {7, 4, 1, 1, 0, 5, 6, ConvAlgorithm::Im2col, Activation::Sigmoid},
+        {3, 5, 3, 1, 0, 7, 9, ConvAlgorithm::Winograd, Activation::None},
+        {5, 7, 3, 1, 1, 6, 5, ConvAlgorithm::Winograd, Activation::ReLU},
+        {16, 16, 3, 1, 1, 10, 12, ConvAlgorithm::Auto, Activation::None},
+    };
+    for (auto format : formats)
+        for (const auto &c : cases)
+        {
+            LayerModule::Conv2DOptions opts{c.stride, c.padding, format, c.act, c.algorithm};
+            LayerModule::Conv2D<double> conv(c.C, c.O, c.K, opts);
+            for (size_t o = 0; o < c.O; o++)
+                conv.bias()[o] = 0.1 * double(o % 3);
+            const auto x = random_tensor<double>(LayerModule::ImageShape{2, c.C, c.H, c.W}.to_shape(format), 1);
+            const auto y = conv.infer(x);
+            const auto ref = reference_conv(conv, x);
+            const double err = y.size() == ref.size() ? max_diff(y, ref, ref.size()) : 1.0;
+            const bool pass = err < 1e-10 && y.shape() == conv.output_shape(x.shape());
+            if (!pass)
+                std::cout << "FAIL conv " << conv.info(std::cout) << (conv.uses_winograd() ? " winograd" : " im2col") << ": " << err << "\n";
+            ok = ok && pass;
+        }
+    {
+        LayerModule::Conv2D<float> wide(128, 128, 3), narrow(16, 16, 3), strided(128, 128, 3, {2});
+        LayerModule::Conv2D<float> wide_nhwc(32, 32, 3, {1, 1, DataFormat::NHWC});
+        const bool pass = wide.uses_winograd() && wide_nhwc.uses_winograd() && !narrow.uses_winograd() && !strided.uses_winograd();
+        LayerModule::Conv2D<float> &conv = wide_nhwc;
+        const auto x = random_tensor<float>({3, 13, 11, 32}, 2);
+        const auto ref = reference_conv(conv, x);
+        const double err = max_diff(conv.infer(x), ref, ref.size());
+        std::cout << "float winograd max error " << err << "\n";
+        ok = ok && pass && err < 1e-4;
+    }
+    // The transformed Winograd weights follow every change of the weights.
+    {
+        LayerModule::Conv2D<double> conv(3, 5, 3, {1, 1, DataFormat::NCHW, Activation::None, ConvAlgorithm::Winograd});
+        const auto x = random_tensor<double>(LayerModule::ImageShape{2, 3, 8, 8}.to_shape(DataFormat::NCHW), 4);
+        auto err = [&]
+        { return max_diff(conv.infer(x), reference_conv(conv, x), conv.infer(x).size()); };
+        double e = err();
+        conv.forward(x);
+        conv.backward(random_tensor<double>(conv.output_shape(x.shape()), 5));
+        conv.update(0.5);
+        e = std::max(e, err());
+        conv.weights()[7] += 1.0; // an optimizer step writes the parameter buffer directly
+        e = std::max(e, err());
+        conv.fold_channel_affine(std::vector<double>(5, 2.0), std::vector<double>(5, 0.5));
+        e = std::max(e, err());
+        std::cout << "winograd after weight updates max error " << e << "\n";
+        ok = ok && e < 1e-10;
+    }
+    std::cout << (ok ? "ok" : "FAIL") << " conv forward\n";
+
+    // ---------- Same output for 1 and 4 threads ----------
+    // Above the serial GEMM threshold, so every image / tile task runs GEMMs with their own parallel_for.
+    {
+        bool same = true;
+        for (auto format : formats)
+            for (auto algorithm : {ConvAlgorithm::Im2col, ConvAlgorithm::Winograd})
+            {
+                LayerModule::Conv2D<float> conv(64, 64, 3, {1, 1, format, Activation::None, algorithm});
+                const auto x = random_tensor<float>(LayerModule::ImageShape{8, 64, 24, 24}.to_shape(format), 11);
+                NovaML::Parallel::set_num_threads(4);
+                const auto multi = conv.infer(x);
+                NovaML::Parallel::set_num_threads(1);
+                const auto single = conv.infer(x);
+                same = same && max_diff(multi, single, multi.size()) == 0;
+            }
+        NovaML::Parallel::set_num_threads(0);
+        std::cout << "conv deterministic across thread counts: " << (same ? "yes" : "NO") << "\n";
+        ok = ok && same;
+    }
+
+    // ---------- Conv2D gradients ----------
+    for (auto format : formats)
+        for (auto act : {Activation::None, Activation::GELU})
+        {
+            LayerModule::Conv2D<double> conv(3, 4, 3, {2, 1, format, act});
+            const auto x = random_tensor<double>(LayerModule::ImageShape{2, 3, 7, 6}.to_shape(format), 3);
+            const double err = gradient_error(conv, x, conv.weights(), conv.grad_weights(),
+                                              conv.bias() + 4 - conv.weights());
+            std::cout << conv.info(std::cout) << " gradient error " << err << "\n";
+            ok = ok && err < 1e-6;
+        }
+    // Per-image weight-gradient partials: same gradients for 1 and 4 threads, and an empty batch zeroes them.
+    for (auto format : formats)
+    {
+        LayerModule::Conv2D<float> conv(16, 32, 3, {1, 1, format});
+        const auto x = random_tensor<float>(LayerModule::ImageShape{20, 16, 12, 12}.to_shape(format), 5);
+        const auto r = random_tensor<float>(conv.forward(x).shape(), 6);
+        const size_t count = conv.bias() + 32 - conv.weights();
+        auto grads = [&](size_t threads)
+        {
+            NovaML::Parallel::set_num_threads(threads);
+            conv.forward(x);
+            const auto dx = conv.backward(r);
+            std::vector<float> g(conv.grad_weights(), conv.grad_weights() + count);
+            g.insert(g.end(), dx.data_ptr(), dx.data_ptr() + dx.size());
+            return g;
+        };
+        const bool same = grads(4) == grads(1);
+        NovaML::Parallel::set_num_threads(0);
+
+        const auto empty = TensorModule::Tensor<float>::zeros(LayerModule::ImageShape{0, 16, 12, 12}.to_shape(format));
+        conv.backward(TensorModule::Tensor<float>::zeros(conv.forward(empty).shape()));
+        bool zeroed = true;
+        for (size_t i = 0; i < count; i++)
+            zeroed = zeroed && conv.grad_weights()[i] == 0.0f;
+        std::cout << data_format_name(format) << " conv backward across thread counts: " << (same ? "identical" : "DIFFERENT")
+                  << ", empty batch gradient " << (zeroed ? "zero" : "STALE") << "\n";
+        ok = ok && same && zeroed;
+    }
+    std::cout << (ok ? "ok" : "FAIL") << " conv backward\n";
+
+    // ---------- Pooling ----------
+    for (auto format : formats)
+    {
+        const size_t C = 3, H = 7, W = 6;
+        const auto x = random_tensor<double>(LayerModule::ImageShape{2, C, H, W}.to_shape(format), 4);
+        LayerModule::MaxPool2D<double> maxpool(3, {2, 1, format});
+        LayerModule::AvgPool2D<double> avgpool(2, {0, 0, format});
+        const auto ym = maxpool.infer(x), ya = avgpool.infer(x);
+        double err = 0;
+        for (size_t n = 0; n < 2; n++)
+            for (size_t c = 0; c < C; c++)
+            {
+                for (size_t oh = 0; oh < 4; oh++)
+                    for (size_t ow = 0; ow < 3; ow++)
+                    {
+                        double best = -1e9;
+                        for (long ih = long(2 * oh) - 1; ih < long(2 * oh) + 2; ih++)
+                            for (long iw = long(2 * ow) - 1; iw < long(2 * ow) + 2; iw++)
+                                if (ih >= 0 && iw >= 0 && ih < long(H) && iw < long(W))
+                                    best = std::max(best, x[image_index(format, C, H, W, n, c, ih, iw)]);
+                        err = std::max(err, std::abs(best - ym[image_index(format, C, 4, 3, n, c, oh, ow)]));
+                    }
+                for (size_t oh = 0; oh < 3; oh++)
+                    for (size_t ow = 0; ow < 3; ow++)
+                    {
+                        double s = 0;
+                        for (size_t ih = 2 * oh; ih < 2 * oh + 2; ih++)
+                            for (size_t iw = 2 * ow; iw < 2 * ow + 2; iw++)
+                                s += x[image_index(format, C, H, W, n, c, ih, iw)];
+                        err = std::max(err, std::abs(s / 4 - ya[image_index(format, C, 3, 3, n, c, oh, ow)]));
+                    }
+            }
+        const double gm = gradient_error(maxpool, x), ga = gradient_error(avgpool, x);
+        LayerModule::AvgPool2D<double> padded(3, {1, 1, format});
+        const double gp = gradient_error(padded, x);
+        std::cout << data_format_name(format) << " pooling error " << err << ", gradient " << std::max({gm, ga, gp}) << "\n";
+        ok = ok && err < 1e-12 && std::max({gm, ga, gp}) < 1e-6 && ym.shape() == maxpool.output_shape(x.shape());
+    }
+    // A NaN in a window wins even before a larger value, and gets the gradient
+    for (auto format : formats)
+    {
+        const double nan = std::nan("");
+        std::vector<double> values(8);
+        const double plane0[] = {1, nan, 5, 2}, plane1[] = {3, 1, 4, 2};
+        for (size_t h = 0; h < 2; h++)
+            for (size_t w = 0; w < 2; w++)
+            {
+                values[image_index(format, 2, 2, 2, 0, 0, h, w)] = plane0[h * 2 + w];
+                values[image_index(format, 2, 2, 2, 0, 1, h, w)] = plane1[h * 2 + w];
+            }
+        const TensorModule::Tensor<double> x(values, LayerModule::ImageShape{1, 2, 2, 2}.to_shape(format));
+        LayerModule::MaxPool2D<double> maxpool(2, {0, 0, format});
+        const auto y = maxpool.forward(x);
+        const auto g = maxpool.backward(TensorModule::Tensor<double>(std::vector<double>{1, 1}, y.shape()));
+        const size_t c0 = image_index(format, 2, 1, 1, 0, 0, 0, 0), c1 = image_index(format, 2, 1, 1, 0, 1, 0, 0);
+        const bool nan_wins = std::isnan(y[c0]) && y[c1] == 4 && std::isnan(maxpool.infer(x)[c0]) &&
+                              g[image_index(format, 2, 2, 2, 0, 0, 0, 1)] == 1 && g[image_index(format, 2, 2, 2, 0, 0, 1, 0)] == 0 &&
+                              g[image_index(format, 2, 2, 2, 0, 1, 1, 0)] == 1;
+        std::cout << data_format_name(format) << " max pooling propagates NaN: " << (nan_wins ? "ok" : "FAILED") << "\n";
+        ok = ok && nan_wins;
+    }
+    std::cout << (ok ? "ok" : "FAIL") << " pooling\n";
+
+    // ---------- BatchNorm / LayerNorm ----------
+    {
+        const Shape shapes[] = {{2, 4, 5, 3}, {2, 5, 3, 4}, {9, 4}};
+        const DataFormat bn_formats[] = {DataFormat::NCHW, DataFormat::NHWC, DataFormat::NCHW};
+        for (size_t s = 0; s < 3; s++)
+        {
+            LayerModule::BatchNorm<double> bn(4, bn_formats[s]);
+            for (size_t c = 0; c < 4; c++)
+            {
+                bn.gamma()[c] = 1.0 + 0.25 * double(c);
+                bn.beta()[c] = 0.1 * double(c);
+            }
+            auto x = random_tensor<double>(shapes[s], 5);
+            for (size_t i = 0; i < x.size(); i++)
+                x.data_ptr()[i] = 3.0 * x[i] + 2.0; // off-center, so the statistics matter
+            const auto y = bn.forward(x);
+
+            // Normalized per channel: mean beta, standard deviation gamma
+            const size_t inner = s == 0 ? 15 : 1, C = 4, outer = x.size() / (C * inner);
+            double err = 0;
+            for (size_t c = 0; c < C; c++)
+            {
+                double m = 0, v = 0;
+                for (size_t o = 0; o < outer; o++)
+                    for (size_t i = 0; i < inner; i++)
+                        m += y[(o * C + c) * inner + i];
+                m /= double(outer * inner);
+                for (size_t o = 0; o < outer; o++)
+                    for (size_t i = 0; i < inner; i++)
+                        v += std::pow(y[(o * C + c) * inner + i] - m, 2);
+                v /= double(outer * inner);
+                err = std::max({err, std::abs(m - bn.beta()[c]), std::abs(std::sqrt(v) - bn.gamma()[c])});
+            }
+            const double g = gradient_error(bn, x, bn.gamma(), bn.grad_gamma(), bn.beta() + 4 - bn.gamma());
+            std::cout << bn.info(std::cout) << " on " << shape_to_string(x.shape()) << ": moments " << err << ", gradient " << g << "\n";
+            ok = ok && err < 1e-4 && g < 1e-6;
+        }
+
+        LayerModule::LayerNorm<double> ln(6);
+        for (size_t f = 0; f < 6; f++)
+        {
+            ln.gamma()[f] = 0.5 + 0.1 * double(f);
+            ln.beta()[f] = -0.2 * double(f);
+        }
+        const auto x = random_tensor<double>({3, 4, 6}, 6);
+        const double g = gradient_error(ln, x, ln.gamma(), ln.grad_gamma(), ln.beta() + 6 - ln.gamma());
+        const double same = max_diff(ln.forward(x), ln.infer(x), x.size());
+        std::cout << "LayerNorm gradient error " << g << "\n";
+        ok = ok && g < 1e-6 && same == 0;
+    }
+
+    // LayerNorm parameter gradients and update: same for 1 and 4 threads.
+    {
+        LayerModule::LayerNorm<float> ln(96);
+        const auto x = random_tensor<float>({2048, 96}, 7);
+        const auto r = random_tensor<float>({2048, 96}, 8);
+        auto step = [&](size_t threads)
+        {
+            NovaML::Parallel::set_num_threads(threads);
+            std::fill(ln.gamma(), ln.gamma() + 96, 1.0f);
+            std::fill(ln.beta(), ln.beta() + 96, 0.0f);
+            ln.forward(x);
+            ln.backward(r);
+            ln.update(0.1f);
+            std::vector<float> p(ln.grad_gamma(), ln.grad_beta() + 96);
+            p.insert(p.end(), ln.gamma(), ln.beta() + 96);
+            return p;
+        };
+        const bool same = step(4) == step(1);
+        NovaML::Parallel::set_num_threads(0);
+        std::cout << "LayerNorm parameter gradients across thread counts: " << (same ? "identical" : "DIFFERENT") << "\n";
+        ok = ok && same;
+    }
+    std::cout << (ok ? "ok" : "FAIL") << " normalization\n";
+
+    // ---------- BatchNorm folding ----------
+    for (auto format : formats)
+    {
+        auto make = [&]
+        {
+            auto model = std::make_shared<Module::Sequential<double>>();
+            model->add(std::make_shared<LayerModule::Conv2D<double>>(3, 8, 3, LayerModule::Conv2DOptions{1, 1, format}));
+            model->add(std::make_shared<LayerModule::BatchNorm<double>>(8, format));
+            model->add(std::make_shared<ActivationModule::ReLU<double>>());
+            model->add(std::make_shared<LayerModule::MaxPool2D<double>>(2, LayerModule::Pool2DOptions{0, 0, format}));
+            model->add(std::make_shared<LayerModule::Flatten<double>>());
+            model->add(std::make_shared<LayerModule::Dense<double>>(8 * 3 * 3, 5));
+            model->add(std::make_shared<LayerModule::BatchNorm<double>>(5));
+            return model;
+        };
+        auto model = make();
+        const auto x = random_tensor<double>(LayerModule::ImageShape{4, 3, 6, 6}.to_shape(format), 7);
+        // A few training steps move weights and running statistics away from their defaults.
+        for (int step = 0; step < 5; step++)
+        {
+            const auto y = model->forward(x);
+            model->backward(random_tensor<double>(y.shape(), 10 + step));
+            model->update(0.05);
+        }
+        const auto before = model->infer(x);
+        const size_t folded = model->fold_batch_norm();
+        const auto after = model->infer(x);
+        const double err = max_diff(before, after, before.size());
+        std::cout << data_format_name(format) << ": folded " << folded << " modules, max difference " << err << "\n";
+        ok = ok && folded == 2 && model->is_fused(1) && model->is_fused(2) && model->is_fused(6) && err < 1e-10;
+
+        // Nothing to fold into: a BatchNorm right after an activation stays.
+        Module::Sequential<double> plain;
+        plain.add(std::make_shared<ActivationModule::ReLU<double>>());
+        plain.add(std::make_shared<LayerModule::BatchNorm<double>>(3));
+        ok = ok && plain.fold_batch_norm() == 0;
+    }
+    std::cout << (ok ? "ok" : "FAIL") << " batch norm folding\n";
+
+    // ---------- BatchNorm under checkpointing and in eval mode ----------
+    {
+        struct Step
+        {
+            TensorModule::Tensor<double> output{0}, grad_input{0};
+            std::vector<double> grads, mean, var;
+            bool eval_uses_running = false;
+        };
+        auto run = [](const Module::CheckpointPolicy &policy)
+        {
+            auto model = std::make_shared<Module::Sequential<double>>();
+            model->add(std::make_shared<LayerModule::Dense<double>>(6, 10));
+            auto bn = std::make_shared<LayerModule::BatchNorm<double>>(10);
+            model->add(bn);
+            model->add(std::make_shared<ActivationModule::ReLU<double>>());
+            model->add(std::make_shared<LayerModule::Dense<double>>(10, 3));
+            auto flat = Module::flatten_parameters(*model);
+            model->set_checkpointing(policy);
+            auto x = random_tensor<double>({16, 6}, 11);
+            for (size_t i = 0; i < x.size(); i++)
+                x.data_ptr()[i] = 2.0 * x[i] + 1.0;
+            Step s;
+            s.output = model->forward(x);
+            s.grad_input = model->backward(random_tensor<double>(s.output.shape(), 12));
+            s.grads.assign(flat->grad.begin(), flat->grad.end());
+            s.mean = bn->running_mean();
+            s.var = bn->running_var();
+
+            // Eval mode normalizes with the running statistics, like infer().
+            model->set_training(false);
+            s.eval_uses_running = max_diff(model->forward(x), model->infer(x), s.output.size()) == 0 &&
+                                  bn->running_mean() == s.mean;
+            model->set_training(true);
+            return s;
+        };
+        const Step plain = run(Module::CheckpointPolicy::none());
+        const Step ckpt = run(Module::CheckpointPolicy::every_k(1));
+        const bool same = plain.eval_uses_running && ckpt.eval_uses_running && max_diff(plain.output, ckpt.output, plain.output.size()) == 0 &&
+                          max_diff(plain.grad_input, ckpt.grad_input, plain.grad_input.size()) == 0 &&
+                          plain.grads == ckpt.grads && plain.mean == ckpt.mean && plain.var == ckpt.var;
+        std::cout << "BatchNorm checkpointed every layer: " << (same ? "same" : "DIFFERENT") << " outputs, gradients and running statistics\n";
+        ok = ok && same;
+    }
+
+    // ---------- Shape errors ----------
+    {
+        LayerModule::Conv2D<float> conv(3, 4, 3);
+        bool threw = false;
+        try
+        {
+            conv.infer(random_tensor<float>({1, 4, 8, 8}, 8));
+        }
+        catch (const std::invalid_argument &)
+        {
+            threw = true;
+        }
+        ok = ok && threw;
+    }
+
+    std::cout << (ok ? "ok" : "FAIL") << "\n";
+    Kernel::set_math_accuracy(tier);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,200 @@
+#include <NovaML/Data/data_loader.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+using namespace NovaML;
+
+// Record r is {r, 10 r, -r}: two inputs, one target.
+std::vector<float> make_records(size_t n)
+{
+    std::vector<float> values;
+    for (size_t r = 0; r < n; r++)
+        values.insert(values.end(), {float(r), 10.0f * float(r), -float(r)});
+    return values;
+}
+
+// Every record index delivered by one epoch, checking each row's layout on the way.
+template <typename T>
+bool drain(Data::DataLoader<T> &loader, std::vector<size_t> &seen, std::vector<size_t> &batch_sizes)
+{
+    Data::Batch<T> batch;
+    while (loader.next(batch))
+    {
+        if (batch.inputs.shape() != Core::Shape{batch.size(), 2} || batch.targets.shape() != Core::Shape{batch.size(), 1} ||
+            !batch.inputs.is_contiguous())
+            return false;
+        for (size_t b = 0; b < batch.size(); b++)
+        {
+            const float r = float(batch.inputs[2 * b]);
+            if (float(batch.inputs[2 * b + 1]) != 10.0f * r || float(batch.targets[b]) != -r)
+                return false;
+            seen.push_back(size_t(r));
+        }
+        batch_sizes.push_back(batch.size());
+    }
+    return true;
+}
+
+bool is_permutation_of_range(std::vector<size_t> seen, size_t n)
+{
+    std::sort(seen.begin(), seen.end());
+    for (size_t i = 0; i < seen.size(); i++)
+        if (seen[i] != i)
+            return false;
+    return seen.size() == n;
+}
+
+int main()
+{
+    bool ok = true;
+    const size_t n = 1000;
+
+    // ---------- In order, collated into [batch, inputs] / [batch, targets] ----------
+    {
+        Data::DataLoaderOptions options;
+        options.batch_size = 64;
+        options.chunk_records = 100;
+        Data::DataLoader<float> loader(std::make_shared<Data::MemorySource<float>>(make_records(n), 3), 2, options);
+        std::vector<size_t> seen, sizes;
+        ok = drain(loader, seen, sizes) && ok;
+        bool ordered = seen.size() == n;
+        for (size_t i = 0; ordered && i < n; i++)
+            ordered = seen[i] == i;
+        ok = ok && ordered && sizes.size() == 16 && sizes.back() == n % 64;
+        std::cout << "sequential: " << (ordered ? "ok" : "FAILED") << "\n";
+
+        // The next epoch is the same data again
+        seen.clear();
+        sizes.clear();
+        ok = drain(loader, seen, sizes) && ok;
+        ok = ok && seen.size() == n && loader.epoch() == 3;
+    }
+
+    // ---------- Shuffled: every record exactly once, order depends on the seed and epoch ----------
+    {
+        Data::DataLoaderOptions options;
+        options.batch_size = 32;
+        options.shuffle_buffer = 256;
+        options.chunk_records = 50;
+        options.drop_last = true;
+        options.seed = 7;
+        auto run = [&](uint64_t seed, size_t epochs)
+        {
+            options.seed = seed;
+            Data::DataLoader<float> loader(std::make_shared<Data::MemorySource<float>>(make_records(n), 3), 2, options);
+            std::vector<std::vector<size_t>> orders;
+            for (size_t e = 0; e < epochs; e++)
+            {
+                std::vector<size_t> seen, sizes;
+                ok = drain(loader, seen, sizes) && ok;
+                if (options.drop_last)
+                    ok = ok && seen.size() == n / 32 * 32 && std::all_of(sizes.begin(), sizes.end(), [](size_t s)
+                                                                          { return s == 32; });
+                orders.push_back(seen);
+            }
+            return orders;
+        };
+        auto a = run(7, 2), b = run(7, 1);
+        ok = ok && a[0] == b[0] && a[0] != a[1];
+        options.drop_last = false;
+        auto full = run(7, 1);
+        const bool shuffled = is_permutation_of_range(full[0], n) && !std::is_sorted(full[0].begin(), full[0].end());
+        ok = ok && shuffled;
+        std::cout << "shuffle: " << (shuffled ? "ok" : "FAILED") << "\n";
+    }
+
+    // ---------- Files: binary (mapped and streaming) and CSV, several sources and workers ----------
+    {
+        const std::vector<float> records = make_records(n);
+        const std::string bin_a = "test_data_loader_a.bin", bin_b = "test_data_loader_b.bin", csv = "test_data_loader.csv";
+        const size_t half = n / 2 * 3;
+        std::ofstream(bin_a, std::ios::binary).write(reinterpret_cast<const char *>(records.data()), half * sizeof(float));
+        std::ofstream(bin_b, std::ios::binary).write(reinterpret_cast<const char *>(records.data() + half),
+                                                     (records.size() - half) * sizeof(float));
+        {
+            std::ofstream out(csv);
+            out << "x0,x1,y\n";
+            for (size_t r = 0; r < n; r++)
+                out << records[3 * r] << ", " << records[3 * r + 1] << "," << records[3 * r + 2] << "\n";
+            out << "\n";
+        }
+
+        Data::DataLoaderOptions options;
+        options.batch_size = 50;
+        options.shuffle_buffer = 100;
+        options.num_workers = 2;
+        options.prefetch = 4;
+        options.chunk_records = 64;
+        for (auto mode : {Data::ReadMode::Mapped, Data::ReadMode::Streaming})
+        {
+            Data::DataLoader<float> loader({std::make_shared<Data::BinaryFileSource<float>>(bin_a, 3, mode),
+                                            std::make_shared<Data::BinaryFileSource<float>>(bin_b, 3, mode)},
+                                           2, options);
+            std::vector<size_t> seen, sizes;
+            ok = drain(loader, seen, sizes) && ok;
+            const bool complete = is_permutation_of_range(seen, n);
+            ok = ok && complete;
+            std::cout << (mode == Data::ReadMode::Mapped ? "binary mapped: " : "binary streaming: ")
+                      << (complete ? "ok" : "FAILED") << "\n";
+        }
+        {
+            Data::DataLoader<float> loader(std::make_shared<Data::CsvFileSource<float>>(csv, 3, true), 2, options);
+            std::vector<size_t> seen, sizes;
+            ok = drain(loader, seen, sizes) && ok;
+            const bool complete = is_permutation_of_range(seen, n);
+            ok = ok && complete;
+            std::cout << "csv: " << (complete ? "ok" : "FAILED") << "\n";
+        }
+
+        // A malformed line surfaces from next(), not from the reader thread
+        {
+            std::ofstream(csv, std::ios::app) << "1,2\n";
+            Data::DataLoader<float> loader(std::make_shared<Data::CsvFileSource<float>>(csv, 3, true), 2, options);
+            bool threw = false;
+            try
+            {
+                std::vector<size_t> seen, sizes;
+                drain(loader, seen, sizes);
+            }
+            catch (const std::runtime_error &)
+            {
+                threw = true;
+            }
+            ok = ok && threw;
+        }
+
+        // A binary file that is not a whole number of records is rejected up front
+        bool threw = false;
+        try
+        {
+            Data::BinaryFileSource<float> source(bin_a, 7);
+        }
+        catch (const std::runtime_error &)
+        {
+            threw = true;
+        }
+        ok = ok && threw;
+
+        std::remove(bin_a.c_str());
+        std::remove(bin_b.c_str());
+        std::remove(csv.c_str());
+    }
+
+    // ---------- Abandoning an epoch, and destroying a loader mid-epoch, does not hang ----------
+    {
+        Data::DataLoaderOptions options;
+        options.batch_size = 8;
+        options.prefetch = 1;
+        options.chunk_records = 16;
+        Data::DataLoader<float> loader(std::make_shared<Data::MemorySource<float>>(make_records(n), 3), 2, options);
+        Data::Batch<float> batch;
+        ok = loader.next(batch) && float(batch.inputs[0]) == 0.0f && ok;
+        loader.reset();
+        ok = loader.next(batch) && float(batch.inputs[0]) == 0.0f && ok;
+    }
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,202 @@
+#include <NovaML/Parallel/data_parallel.hpp>
+#include <NovaML/Core/Layer/dense.hpp>
+#include <NovaML/Core/Activation/relu.hpp>
+#include <NovaML/Core/Activation/gelu.hpp>
+#include <NovaML/Core/Layer/normalization.hpp>
+#include <NovaML/Core/Optimizer/sgd.hpp>
+#include <cmath>
+#include <iostream>
+
+using namespace NovaML;
+using namespace NovaML::Core;
+
+// Every call builds the same weights (Dense initializes from a fixed seed).
+std::shared_ptr<Module::Sequential<double>> make_model()
+{
+    auto model = std::make_shared<Module::Sequential<double>>();
+    model->add(std::make_shared<LayerModule::Dense<double>>(5, 16));
+    model->add(std::make_shared<ActivationModule::ReLU<double>>());
+    model->add(std::make_shared<LayerModule::Dense<double>>(16, 12));
+    model->add(std::make_shared<ActivationModule::GELU<double>>());
+    model->add(std::make_shared<LayerModule::Dense<double>>(12, 2));
+    return model;
+}
+
+// Layers large enough that their GEMMs run parallel_for inside the replica tasks.
+std::shared_ptr<Module::Sequential<double>> make_wide_model()
+{
+    auto model = std::make_shared<Module::Sequential<double>>();
+    model->add(std::make_shared<LayerModule::Dense<double>>(256, 512));
+    model->add(std::make_shared<ActivationModule::ReLU<double>>());
+    model->add(std::make_shared<LayerModule::Dense<double>>(512, 512));
+    model->add(std::make_shared<ActivationModule::ReLU<double>>());
+    model->add(std::make_shared<LayerModule::Dense<double>>(512, 8));
+    return model;
+}
+
+Tensor<double> make_rows(size_t rows, size_t cols, double phase)
+{
+    std::vector<double> v(rows * cols);
+    for (size_t i = 0; i < v.size(); i++)
+        v[i] = std::sin(0.9 * double(i) + phase);
+    return Tensor<double>(v, Shape{rows, cols});
+}
+
+double max_diff(const Module::ParameterArray<double> &a, const Module::ParameterArray<double> &b)
+{
+    double d = 0;
+    for (size_t i = 0; i < a.size(); i++)
+        d = std::max(d, std::abs(a[i] - b[i]));
+    return d;
+}
+
+// Data-parallel gradients and loss against one model on the whole batch.
+bool matches_single_model(size_t replicas, size_t rows, LossModule::Reduction reduction, size_t bucket_bytes,
+                          std::shared_ptr<Module::Sequential<double>> (*factory)() = make_model,
+                          size_t in = 5, size_t out = 2, int steps = 3)
+{
+    Parallel::DataParallelOptions options;
+    options.replicas = replicas;
+    options.bucket_bytes = bucket_bytes;
+    options.reduction = reduction;
+    Parallel::DataParallel<double> trainer(factory(), factory, options);
+
+    auto reference = factory();
+    auto params = Module::flatten_parameters(*reference);
+    LossModule::MSELoss<double> criterion(reduction);
+
+    OptimizerModule::SGD<double> parallel_sgd(trainer.parameters(), 0.05);
+    OptimizerModule::SGD<double> reference_sgd(params, 0.05);
+    bool same = true;
+    for (int step = 0; step < steps; step++)
+    {
+        auto x = make_rows(rows, in, double(step));
+        auto y = make_rows(rows, out, 0.5 + double(step));
+        const double loss = trainer.backward(x, y);
+        const double expected = criterion.forward(reference->forward(x), y);
+        reference->backward(criterion.backward());
+        same = same && std::abs(loss - expected) < 1e-12 * (1 + expected) &&
+               max_diff(trainer.parameters()->grad, params->grad) < 1e-12;
+        parallel_sgd.step();
+        reference_sgd.step();
+        same = same && max_diff(trainer.parameters()->data, params->data) < 1e-12;
+    }
+    return same;
+}
+
+std::shared_ptr<Module::Sequential<double>> make_bn_model()
+{
+    auto model = std::make_shared<Module::Sequential<double>>();
+    model->add(std::make_shared<LayerModule::Dense<double>>(5, 16));
+    model->add(std::make_shared<LayerModule::BatchNorm<double>>(16, LayerModule::DataFormat::NCHW, 0.3));
+    model->add(std::make_shared<ActivationModule::ReLU<double>>());
+    model->add(std::make_shared<LayerModule::Dense<double>>(16, 2));
+    return model;
+}
+
+const LayerModule::BatchNorm<double> &batch_norm(const Module::Sequential<double> &model)
+{
+    return dynamic_cast<const LayerModule::BatchNorm<double> &>(*model.at(1));
+}
+
+double max_diff(const std::vector<double> &a, const std::vector<double> &b)
+{
+    double d = 0;
+    for (size_t i = 0; i < a.size(); i++)
+        d = std::max(d, std::abs(a[i] - b[i]));
+    return d;
+}
+
+int main()
+{
+    bool ok = true;
+    // More pool threads than cores is fine: the replicas still run as concurrent tasks.
+    Parallel::set_num_threads(4);
+
+    // ---------- Same gradients, loss and updates as one model on the full batch ----------
+    {
+        bool same = true;
+        // Uneven shards, one bucket per cache line, one bucket for everything
+        same = same && matches_single_model(3, 10, LossModule::Reduction::Mean, 64);
+        same = same && matches_single_model(4, 37, LossModule::Reduction::Mean, 1 << 20);
+        same = same && matches_single_model(3, 10, LossModule::Reduction::Sum, 256);
+        // Fewer rows than replicas
+        same = same && matches_single_model(4, 2, LossModule::Reduction::Mean, 64);
+        same = same && matches_single_model(1, 8, LossModule::Reduction::Mean, 64);
+        std::cout << "gradients match a single model: " << (same ? "ok" : "FAILED") << "\n";
+        ok = ok && same;
+    }
+
+    // ---------- More replicas than threads, GEMMs parallel inside each replica ----------
+    {
+        Parallel::set_num_threads(3);
+        bool same = true;
+        for (int trial = 0; trial < 3; trial++)
+            same = same && matches_single_model(8, 1024, LossModule::Reduction::Mean, 256 << 10, make_wide_model, 256, 8, 1);
+        std::cout << "8 replicas on 3 threads, wide layers: " << (same ? "ok" : "FAILED") << "\n";
+        ok = ok && same;
+        Parallel::set_num_threads(4);
+    }
+
+    // ---------- BatchNorm running statistics match a full-batch forward ----------
+    {
+        // No optimizer step in between: each shard normalizes with its own
+        // statistics, so its gradients (and the trained weights) differ from
+        // the full batch, but the running statistics must not.
+        Parallel::DataParallelOptions options;
+        options.replicas = 3;
+        auto model = make_bn_model();
+        Parallel::DataParallel<double> trainer(model, make_bn_model, options);
+        auto reference = make_bn_model();
+        bool same = true;
+        for (int step = 0; step < 3; step++)
+        {
+            auto x = make_rows(11, 5, 0.3 * double(step));
+            trainer.backward(x, make_rows(11, 2, 0.0));
+            reference->forward(x);
+            const auto &expected = batch_norm(*reference);
+            same = same && max_diff(batch_norm(*model).running_mean(), expected.running_mean()) < 1e-12 &&
+                   max_diff(batch_norm(*model).running_var(), expected.running_var()) < 1e-12;
+        }
+        same = same && max_diff(batch_norm(*model).running_var(), std::vector<double>(16, 1.0)) > 1e-3;
+        std::cout << "batch norm running statistics: " << (same ? "ok" : "FAILED") << "\n";
+        ok = ok && same;
+    }
+
+    // ---------- Defaults, buckets and errors ----------
+    {
+        Parallel::DataParallelOptions options;
+        options.bucket_bytes = 512;
+        Parallel::DataParallel<double> trainer(make_model(), make_model, options);
+        const size_t expected_buckets = (trainer.parameters()->size() * sizeof(double) + 511) / 512;
+        bool checks = trainer.num_replicas() == Parallel::get_num_threads() && trainer.num_buckets() == expected_buckets;
+
+        auto other = []
+        {
+            auto model = std::make_shared<Module::Sequential<double>>();
+            model->add(std::make_shared<LayerModule::Dense<double>>(5, 2));
+            return model;
+        };
+        try
+        {
+            Parallel::DataParallel<double>(make_model(), other, options);
+            checks = false;
+        }
+        catch (const std::invalid_argument &)
+        {
+        }
+        try
+        {
+            trainer.backward(make_rows(4, 5, 0.0), make_rows(3, 2, 0.0));
+            checks = false;
+        }
+        catch (const std::invalid_argument &)
+        {
+        }
+        std::cout << "options and errors: " << (checks ? "ok" : "FAILED") << "\n";
+        ok = ok && checks;
+    }
+
+    Parallel::set_num_threads(0);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,154 @@
+#include <NovaML/Core/Layer/dense.hpp>
+#include <NovaML/Core/Activation/relu.hpp>
+#include <NovaML/Core/Activation/sigmoid.hpp>
+#include <NovaML/Core/Activation/gelu.hpp>
+#include <NovaML/Core/Module/sequential.hpp>
+#include <NovaML/Core/Kernel/cpu_features.hpp>
+#include <NovaML/Core/Kernel/vmath.hpp>
+#include <NovaML/Memory/allocator.hpp>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+
+using namespace NovaML::Core;
+namespace Memory = NovaML::Memory;
+using Kernel::Activation;
+
+template <typename A, typename B>
+double max_diff(const A &x, const B &y, size_t n)
+{
+    double m = 0;
+    for (size_t i = 0; i < n; i++)
+        m = std::max(m, std::abs(static_cast<double>(x[i]) - static_cast<double>(y[i])));
+    return m;
+}
+
+std::shared_ptr<Module::BaseModule<double>> make_activation(Activation act)
+{
+    switch (act)
+    {
+    case Activation::ReLU:
+        return std::make_shared<ActivationModule::ReLU<double>>();
+    case Activation::Sigmoid:
+        return std::make_shared<ActivationModule::Sigmoid<double>>();
+    default:
+        return std::make_shared<ActivationModule::GELU<double>>();
+    }
+}
+
+// GEMM with an epilogue against GEMM followed by a separate bias + activation pass.
+template <typename T>
+double epilogue_error(size_t M, size_t N, size_t K, Activation act)
+{
+    std::vector<T> A(M * K), B(N * K), bias(N), fused(M * N), plain(M * N);
+    for (size_t i = 0; i < A.size(); i++)
+        A[i] = T(0.01) * static_cast<T>(static_cast<int>(i % 23) - 11);
+    for (size_t i = 0; i < B.size(); i++)
+        B[i] = T(0.02) * static_cast<T>(static_cast<int>(i % 17) - 8);
+    for (size_t j = 0; j < N; j++)
+        bias[j] = T(0.1) * static_cast<T>(static_cast<int>(j % 5) - 2);
+
+    Kernel::gemm(false, true, M, N, K, T(1), A.data(), K, B.data(), K, T(0), fused.data(), N, {bias.data(), act});
+    Kernel::gemm(false, true, M, N, K, T(1), A.data(), K, B.data(), K, T(0), plain.data(), N);
+    for (size_t i = 0; i < M; i++)
+        for (size_t j = 0; j < N; j++)
+            plain[i * N + j] = Kernel::activate(act, plain[i * N + j] + bias[j]);
+    return max_diff(fused, plain, M * N);
+}
+
+int main()
+{
+    bool ok = true;
+    // The sigmoid epilogue is compared against Kernel::activate: keep the Exact tier whatever NOVAML_MATH says.
+    const Kernel::MathAccuracy tier = Kernel::math_accuracy();
+    Kernel::set_math_accuracy(Kernel::MathAccuracy::Exact);
+    const Activation acts[] = {Activation::None, Activation::ReLU, Activation::Sigmoid, Activation::GELU};
+
+    // ---------- GEMM epilogue on every kernel path and shape class ----------
+    const size_t shapes[][3] = {{1, 40, 33}, {37, 1, 19}, {45, 70, 300}, {8, 16, 0}, {130, 257, 64}};
+    for (auto isa : {Kernel::Isa::Scalar, Kernel::Isa::Avx2, Kernel::Isa::Avx512, Kernel::Isa::Neon})
+    {
+        if (!Kernel::isa_supported(isa))
+            continue;
+        Kernel::set_active_isa(isa);
+        double err = 0;
+        for (auto &s : shapes)
+            for (auto act : acts)
+                err = std::max({err, epilogue_error<double>(s[0], s[1], s[2], act),
+                                epilogue_error<float>(s[0], s[1], s[2], act) * 1e-5});
+        std::cout << Kernel::isa_name(isa) << ": epilogue max error " << err << "\n";
+        ok = ok && err < 1e-12;
+    }
+    Kernel::set_active_isa(Kernel::detected_isa());
+
+    // ---------- One aligned parameter block ----------
+    LayerModule::Dense<float> small(3, 5);
+    auto aligned = [](const void *p)
+    { return reinterpret_cast<std::uintptr_t>(p) % Memory::buffer_alignment == 0; };
+    ok = ok && aligned(small.weights()) && aligned(small.bias()) && small.num_params() == 20;
+
+    // ---------- Sequential fuses Dense -> activation, same results both ways ----------
+    Tensor<double> x(std::vector<double>(6 * 10), Shape{6, 10});
+    for (size_t i = 0; i < x.size(); i++)
+        x[i] = 0.3 * std::sin(0.7 * static_cast<double>(i));
+    Tensor<double> g(std::vector<double>(6 * 4), Shape{6, 4});
+    for (size_t i = 0; i < g.size(); i++)
+        g[i] = 0.1 * std::cos(0.3 * static_cast<double>(i));
+
+    for (auto act : acts)
+    {
+        if (act == Activation::None)
+            continue;
+        Module::Sequential<double> fused, plain(false);
+        auto dense_fused = std::make_shared<LayerModule::Dense<double>>(10, 4);
+        auto dense_plain = std::make_shared<LayerModule::Dense<double>>(10, 4);
+        fused.add(dense_fused);
+        fused.add(make_activation(act));
+        plain.add(dense_plain);
+        plain.add(make_activation(act));
+
+        Tensor<double> y_fused = fused.forward(x), y_plain = plain.forward(x);
+        Tensor<double> dx_fused = fused.backward(g), dx_plain = plain.backward(g);
+        Tensor<double> y_infer(0);
+        {
+            NoGradGuard no_grad;
+            y_infer = fused.forward(x);
+        }
+        double err = std::max({max_diff(y_fused.get_data(), y_plain.get_data(), y_fused.size()),
+                               max_diff(y_infer.get_data(), y_plain.get_data(), y_infer.size()),
+                               max_diff(dx_fused.get_data(), dx_plain.get_data(), dx_fused.size()),
+                               max_diff(dense_fused->grad_weights(), dense_plain->grad_weights(), 40),
+                               max_diff(dense_fused->grad_bias(), dense_plain->grad_bias(), 4)});
+        std::cout << dense_fused->info(std::cout) << ": fused vs separate max diff " << err << "\n";
+        ok = ok && err < 1e-12 && fused.is_fused(1) && !plain.is_fused(1) &&
+             dense_fused->get_activation() == act && dense_plain->get_activation() == Activation::None;
+    }
+
+    // ---------- GELU derivative against finite differences ----------
+    double gelu_err = 0;
+    for (double v = -4.0; v <= 4.0; v += 0.25)
+    {
+        double numeric = (Kernel::activate(Activation::GELU, v + 1e-6) - Kernel::activate(Activation::GELU, v - 1e-6)) / 2e-6;
+        gelu_err = std::max(gelu_err, std::abs(numeric - Kernel::activation_derivative(Activation::GELU, v)));
+    }
+    ok = ok && gelu_err < 1e-8;
+
+    // ---------- Inference: the fused pair writes its output once ----------
+    auto buffers_per_forward = [&](bool fuse)
+    {
+        Module::Sequential<double> model(fuse);
+        model.add(std::make_shared<LayerModule::Dense<double>>(10, 4));
+        model.add(std::make_shared<ActivationModule::ReLU<double>>());
+        NoGradGuard no_grad;
+        model.forward(x);
+        Memory::reset_stats();
+        model.forward(x);
+        return Memory::get_stats().allocations;
+    };
+    size_t fused_buffers = buffers_per_forward(true), plain_buffers = buffers_per_forward(false);
+    std::cout << "buffers per inference forward: fused " << fused_buffers << ", separate " << plain_buffers << "\n";
+    ok = ok && fused_buffers < plain_buffers;
+
+    Kernel::set_math_accuracy(tier);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,165 @@
+#include <NovaML/Core/Tensor/tensor.hpp>
+#include <NovaML/Core/Tensor/tensor_math.hpp>
+#include <NovaML/Core/Tensor/expression.hpp>
+#include <NovaML/Memory/allocator.hpp>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+using namespace NovaML::Core;
+namespace Memory = NovaML::Memory;
+
+using TensorPtr = std::shared_ptr<Tensor<double>>;
+
+TensorPtr make(size_t n, double scale, double shift, bool requires_grad = true)
+{
+    std::vector<double> v(n);
+    for (size_t i = 0; i < n; i++)
+        v[i] = shift + scale * std::sin(0.37 * static_cast<double>(i + 1));
+    return std::make_shared<Tensor<double>>(v, requires_grad);
+}
+
+template <typename A, typename B>
+double max_diff(const A &x, const B &y)
+{
+    double m = 0;
+    for (size_t i = 0; i < x.size(); i++)
+        m = std::max(m, std::abs(x[i] - y[i]));
+    return m;
+}
+
+// Forward values and input gradients of an eager graph against the fused one.
+template <typename Eager, typename Fused>
+double compare(const std::vector<TensorPtr> &inputs, Eager eager, Fused fused)
+{
+    for (auto &t : inputs)
+        t->zero_grad();
+    TensorPtr y_eager = eager();
+    sum(y_eager)->backward();
+    std::vector<Buffer<double>> grads;
+    for (auto &t : inputs)
+        grads.push_back(t->get_grad());
+
+    for (auto &t : inputs)
+        t->zero_grad();
+    TensorPtr y_fused = fused();
+    sum(y_fused)->backward();
+
+    double err = max_diff(y_eager->get_data(), y_fused->get_data());
+    for (size_t k = 0; k < inputs.size(); k++)
+        err = std::max(err, max_diff(grads[k], inputs[k]->get_grad()));
+    return err;
+}
+
+int main()
+{
+    using Expr::lazy;
+    bool ok = true;
+    const size_t n = 1000;
+    auto a = make(n, 1.0, 0.0), b = make(n, 0.5, 1.0), c = make(n, 2.0, 0.0), d = make(n, 0.25, 2.0);
+
+    // ---------- Fused forward and backward match the eager graph ----------
+    double e1 = compare({a, b, c, d}, [&]
+                        { return (a * b + c) / d; },
+                        [&]
+                        { return Expr::evaluate((lazy(a) * b + c) / d); });
+    double e2 = compare({a, b, d}, [&]
+                        { return log(exp(a * 0.5) + d) - pow(b, 3.0) * 2.0 + 1.0 / d; },
+                        [&]
+                        { return Expr::evaluate(Expr::log(Expr::exp(lazy(a) * 0.5) + d) - Expr::pow(lazy(b), 3.0) * 2.0 + 1.0 / lazy(d)); });
+    double e3 = compare({a}, [&]
+                        { return a * a - (-a); },
+                        [&]
+                        { return Expr::evaluate(lazy(a) * a - (-lazy(a))); });
+    std::cout << "max |eager - fused|: " << e1 << ", " << e2 << ", " << e3 << "\n";
+    ok = ok && e1 < 1e-12 && e2 < 1e-12 && e3 < 1e-12;
+
+    // ---------- exp, log and pow run the eager vmath kernels in either accuracy tier ----------
+    const Kernel::MathAccuracy tier = Kernel::math_accuracy();
+    Kernel::set_math_accuracy(Kernel::MathAccuracy::Fast);
+    double e_fast = compare({a, b, d}, [&]
+                            { return log(exp(a * 0.5) + d) - pow(b, 2.5); },
+                            [&]
+                            { return Expr::evaluate(Expr::log(Expr::exp(lazy(a) * 0.5) + d) - Expr::pow(lazy(b), 2.5)); });
+    Kernel::set_math_accuracy(tier);
+    std::cout << "fast tier max |eager - fused|: " << e_fast << "\n";
+    ok = ok && e_fast < 1e-12;
+
+    // ---------- Strided inputs ----------
+    auto m = std::make_shared<Tensor<double>>(std::vector<double>{1, 2, 3, 4, 5, 6}, Shape{2, 3}, true);
+    auto mt = transpose(m);
+    auto k = std::make_shared<Tensor<double>>(std::vector<double>{1, 1, 2, 2, 3, 3}, Shape{3, 2}, true);
+    auto yt = Expr::evaluate(lazy(mt) * k + 1.0);
+    sum(yt)->backward();
+    std::cout << "transposed: " << vector_to_string(yt->get_data()) << ", grad " << vector_to_string(m->get_grad()) << "\n";
+    ok = ok && yt->get_data() == std::vector<double>{2, 5, 5, 11, 10, 19} &&
+         m->get_grad() == Buffer<double>{1, 2, 3, 1, 2, 3};
+
+    // ---------- One node, one closure, no grad under NoGradGuard ----------
+    auto fused = Expr::evaluate((lazy(a) * b + c) / d);
+    ok = ok && fused->get_edges().size() == 4;
+    {
+        NoGradGuard no_grad;
+        auto y = Expr::evaluate((lazy(a) * b + c) / d);
+        ok = ok && !y->get_requires_grad() && y->get_edges().empty();
+    }
+
+    bool threw = false;
+    try
+    {
+        Expr::evaluate(lazy(a) + m);
+    }
+    catch (const std::invalid_argument &err)
+    {
+        threw = true;
+        std::cout << "shape check: " << err.what() << "\n";
+    }
+    ok = ok && threw;
+
+    threw = false;
+    try
+    {
+        Expr::evaluate(Expr::Scalar<double>(1.0) + 2.0);
+    }
+    catch (const std::invalid_argument &err)
+    {
+        threw = true;
+        std::cout << "no tensor operand: " << err.what() << "\n";
+    }
+    ok = ok && threw;
+
+    threw = false;
+    try
+    {
+        Expr::evaluate(Expr::log(lazy(c) + 1.0));
+    }
+    catch (const std::runtime_error &err)
+    {
+        threw = true;
+        std::cout << "log domain: " << err.what() << "\n";
+    }
+    ok = ok && threw;
+
+    // ---------- Memory traffic: eager temporaries vs one fused pass ----------
+    const size_t big = 1 << 20;
+    auto ba = make(big, 1.0, 0.0), bb = make(big, 0.5, 1.0), bc = make(big, 2.0, 0.0), bd = make(big, 0.25, 2.0);
+    auto measure = [&](auto fn)
+    {
+        fn();
+        Memory::reset_stats();
+        auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < 10; r++)
+            fn();
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / 10;
+        return std::make_pair(ms, Memory::get_stats().allocations / 10);
+    };
+    auto eager = measure([&]
+                         { sum((ba * bb + bc) / bd)->backward(); });
+    auto fused_step = measure([&]
+                              { sum(Expr::evaluate((lazy(ba) * bb + bc) / bd))->backward(); });
+    std::cout << "forward+backward over 2^20: eager " << eager.first << " ms (" << eager.second
+              << " buffers), fused " << fused_step.first << " ms (" << fused_step.second << " buffers)\n";
+    ok = ok && fused_step.second < eager.second;
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,139 @@
+#include <NovaML/Core/Tensor/tensor.hpp>
+#include <NovaML/Core/Tensor/tensor_math.hpp>
+#include <NovaML/Core/Tensor/expression.hpp>
+#include <NovaML/Core/Tensor/graph.hpp>
+#include <NovaML/Memory/allocator.hpp>
+#include <cmath>
+#include <iostream>
+
+using namespace NovaML::Core;
+using Expr::evaluate;
+using Expr::lazy;
+namespace Memory = NovaML::Memory;
+
+using TensorPtr = std::shared_ptr<Tensor<double>>;
+
+// A regression step touching broadcasting, views, scalar ops, reductions and a fused expression.
+TensorPtr step(const TensorPtr &x, const TensorPtr &y, const TensorPtr &w, const TensorPtr &b)
+{
+    auto z = x * w + b;                              // [8, 4] * [1, 4] + [1] (expand views)
+    auto p = 1.0 / (1.0 + exp(-z));                  // scalar ops and exp
+    auto r = evaluate(lazy(p) - lazy(y));            // fused
+    auto t = contiguous(transpose(r, 0, 1));         // strided copy
+    return mean(t ^ 2.0) + sum(log(p + 1.0)) * 0.01; // reductions
+}
+
+std::vector<double> batch(size_t n, double phase)
+{
+    std::vector<double> v(n);
+    for (size_t i = 0; i < n; i++)
+        v[i] = std::sin(0.7 * double(i) + phase);
+    return v;
+}
+
+void sgd(const TensorPtr &param)
+{
+    NoGradGuard no_grad;
+    const Buffer<double> &g = param->get_grad();
+    add_(*param, Tensor<double>(std::vector<double>(g.begin(), g.end()), param->shape()), -0.5);
+}
+
+bool close(const Buffer<double> &a, const Buffer<double> &b)
+{
+    if (a.size() != b.size())
+        return false;
+    for (size_t i = 0; i < a.size(); i++)
+        if (std::abs(a[i] - b[i]) > 1e-12)
+            return false;
+    return true;
+}
+
+int main()
+{
+    bool ok = true;
+
+    // ---------- Replays match eager steps, with new inputs and updated parameters ----------
+    auto x = std::make_shared<Tensor<double>>(batch(32, 0.0), Shape{8, 4});
+    auto y = std::make_shared<Tensor<double>>(batch(32, 1.0), Shape{8, 4});
+    auto w = std::make_shared<Tensor<double>>(std::vector<double>{0.1, -0.2, 0.3, 0.05}, Shape{1, 4}, true);
+    auto b = std::make_shared<Tensor<double>>(std::vector<double>{0.02}, true);
+    auto w_ref = std::make_shared<Tensor<double>>(w->get_data(), w->shape(), true);
+    auto b_ref = std::make_shared<Tensor<double>>(b->get_data(), true);
+
+    auto graph = Graph<double>::capture([&]
+                                        { return step(x, y, w, b); });
+    std::cout << "captured " << graph.num_steps() << " ops, " << graph.num_nodes() << " backward nodes\n";
+
+    for (int it = 0; it < 5; it++)
+    {
+        if (it > 0)
+        {
+            NoGradGuard no_grad;
+            copy_(x, std::make_shared<Tensor<double>>(batch(32, 0.3 * it), Shape{8, 4}));
+            copy_(y, std::make_shared<Tensor<double>>(batch(32, 1.0 + 0.2 * it), Shape{8, 4}));
+            w->zero_grad();
+            b->zero_grad();
+            graph.replay();
+        }
+        auto loss = step(x, y, w_ref, b_ref);
+        loss->backward();
+        const bool same = std::abs(graph.output()->at(0) - loss->at(0)) < 1e-12 &&
+                          close(w->get_grad(), w_ref->get_grad()) && close(b->get_grad(), b_ref->get_grad());
+        std::cout << "step " << it << ": loss " << loss->at(0) << (same ? " ok" : " MISMATCH") << "\n";
+        ok = ok && same;
+
+        // SGD on both copies (bumps versions: replays must not trip the saved-tensor checks)
+        for (const auto &param : {w, w_ref, b, b_ref})
+            sgd(param);
+        w_ref->zero_grad();
+        b_ref->zero_grad();
+    }
+
+    // ---------- A steady-state replay allocates nothing ----------
+    graph.replay();
+    Memory::reset_stats();
+    graph.replay();
+    const size_t allocations = Memory::get_stats().allocations;
+    std::cout << "replay allocations: " << allocations << "\n";
+    ok = ok && allocations == 0;
+
+    // ---------- Inference capture: forward only ----------
+    {
+        NoGradGuard no_grad;
+        auto forward = Graph<double>::capture([&]
+                                              { return exp(x * w); });
+        copy_(x, std::make_shared<Tensor<double>>(batch(32, 2.0), Shape{8, 4}));
+        forward.replay();
+        auto expected = exp(x * w);
+        ok = ok && forward.num_nodes() == 0 && forward.output()->get_data() == expected->get_data();
+    }
+
+    // ---------- Refused while capturing ----------
+    auto refused = [&](const std::function<TensorPtr()> &fn)
+    {
+        try
+        {
+            Graph<double>::capture(fn);
+        }
+        catch (const std::runtime_error &)
+        {
+            return true;
+        }
+        return false;
+    };
+    ok = ok && refused([&]
+                       {
+                           NoGradGuard no_grad;
+                           auto t = x * 2.0;
+                           add_scalar_(t, 1.0);
+                           return t; });
+    ok = ok && refused([&]
+                       {
+                           auto t = sum(w);
+                           t->backward();
+                           return t; });
+    // Capture state does not leak out of a failed capture
+    ok = ok && GraphRecorder::active() == nullptr;
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,172 @@
+#include <NovaML/Core/Tensor/tensor.hpp>
+#include <NovaML/Core/Tensor/tensor_math.hpp>
+#include <NovaML/Core/Kernel/convert.hpp>
+#include <NovaML/Core/Kernel/gemm.hpp>
+#include <NovaML/Core/Kernel/cpu_features.hpp>
+#include <NovaML/Core/Layer/dense.hpp>
+#include <NovaML/Core/Loss/mse.hpp>
+#include <NovaML/Core/Optimizer/adam.hpp>
+#include <NovaML/Core/Optimizer/mixed_precision.hpp>
+#include <cmath>
+#include <iostream>
+#include <limits>
+
+using namespace NovaML::Core;
+
+// Bit-identical, or both NaN (NaN payloads may differ between paths).
+template <typename H>
+bool same(H a, H b) { return a.bits == b.bits || (std::isnan(float(a)) && std::isnan(float(b))); }
+
+template <typename H>
+bool conversions_ok()
+{
+    // Every 16-bit pattern survives widen -> narrow, in bulk and one at a time.
+    std::vector<H> all(65536), back(65536);
+    std::vector<float> wide(65536);
+    for (uint32_t b = 0; b < 65536; b++)
+        all[b] = H::from_bits(static_cast<uint16_t>(b));
+    Kernel::widen(all.size(), all.data(), wide.data());
+    Kernel::narrow(wide.size(), wide.data(), back.data());
+    bool ok = true;
+    for (uint32_t b = 0; b < 65536; b++)
+        ok = ok && same(all[b], back[b]) && same(H(float(all[b])), all[b]) &&
+             (float(all[b]) == wide[b] || std::isnan(wide[b]));
+
+    // Arbitrary floats: bulk rounding equals scalar rounding.
+    std::vector<float> values;
+    for (int i = -20000; i < 20000; i++)
+        values.push_back(std::ldexp(std::sin(0.731f * i), i % 40 - 25));
+    values.insert(values.end(), {0.0f, -0.0f, 65504.0f, 65519.9f, 65520.0f, 1e-8f, 5.96e-8f, 3e38f,
+                                 std::numeric_limits<float>::infinity(), std::numeric_limits<float>::quiet_NaN()});
+    std::vector<H> bulk(values.size());
+    Kernel::narrow(values.size(), values.data(), bulk.data());
+    for (size_t i = 0; i < values.size(); i++)
+        ok = ok && same(bulk[i], H(values[i]));
+    return ok;
+}
+
+// 16-bit GEMM against an fp32 GEMM on the same (widened) values: they must agree to one output rounding.
+template <typename H>
+double gemm_error(bool ta, bool tb, size_t M, size_t N, size_t K, Kernel::Activation act)
+{
+    std::vector<H> A(M * K), B(K * N), bias(N), C(M * N, H(0.5f));
+    std::vector<float> Af(M * K), Bf(K * N), biasf(N), Cf(M * N, 0.5f);
+    for (size_t i = 0; i < A.size(); i++)
+        Af[i] = float(A[i] = H(0.3f * std::sin(0.37f * i)));
+    for (size_t i = 0; i < B.size(); i++)
+        Bf[i] = float(B[i] = H(0.2f * std::cos(0.11f * i)));
+    for (size_t j = 0; j < N; j++)
+        biasf[j] = float(bias[j] = H(0.05f * (j % 7)));
+    const size_t lda = ta ? M : K, ldb = tb ? K : N;
+    Kernel::gemm(ta, tb, M, N, K, H(1.0f), A.data(), lda, B.data(), ldb, H(0.5f), C.data(), N, {bias.data(), act});
+    Kernel::gemm(ta, tb, M, N, K, 1.0f, Af.data(), lda, Bf.data(), ldb, 0.5f, Cf.data(), N, {biasf.data(), act});
+    double err = 0;
+    for (size_t i = 0; i < C.size(); i++)
+        err = std::max(err, std::abs(double(float(C[i])) - double(float(H(Cf[i])))) / (std::abs(Cf[i]) + 1e-3));
+    return err;
+}
+
+int main()
+{
+    bool ok = true;
+
+    // ---------- Conversions ----------
+    for (auto isa : {Kernel::Isa::Scalar, Kernel::Isa::Avx2, Kernel::Isa::Avx512, Kernel::Isa::Neon})
+    {
+        if (!Kernel::isa_supported(isa))
+            continue;
+        Kernel::set_active_isa(isa);
+        bool conv = conversions_ok<bfloat16>() && conversions_ok<float16>();
+        std::cout << Kernel::isa_name(isa) << ": conversions " << (conv ? "ok" : "FAILED") << "\n";
+        ok = ok && conv;
+    }
+    Kernel::set_active_isa(Kernel::detected_isa());
+    ok = ok && float(bfloat16(1.00390625f)) == 1.0f && float(bfloat16(1.01171875f)) == 1.015625f; // ties to even
+    ok = ok && std::isinf(float(float16(65520.0f))) && float(float16(65519.0f)) == 65504.0f;
+    ok = ok && float(float16(5.9604645e-8f)) == 5.9604645e-8f && float(bfloat16(3e38f)) > 2.9e38f;
+
+    // ---------- GEMM: every shape class and transpose ----------
+    double gemm_err = 0;
+    const size_t shapes[][3] = {{1, 300, 70}, {90, 1, 33}, {37, 45, 129}, {64, 64, 0}};
+    for (auto &s : shapes)
+        for (int t = 0; t < 4; t++)
+            for (auto act : {Kernel::Activation::None, Kernel::Activation::ReLU, Kernel::Activation::GELU})
+                gemm_err = std::max({gemm_err, gemm_error<bfloat16>(t & 1, t & 2, s[0], s[1], s[2], act),
+                                     gemm_error<float16>(t & 1, t & 2, s[0], s[1], s[2], act)});
+    std::cout << "16-bit gemm vs fp32 gemm, max relative error " << gemm_err << "\n";
+    ok = ok && gemm_err < 1.0 / 128;
+
+    // ---------- NaN in B propagates through the 16-bit GEMV, even for x = 0 ----------
+    {
+        const float nan = std::numeric_limits<float>::quiet_NaN();
+        const bfloat16 xb[] = {bfloat16(0.0f), bfloat16(1.0f)}, Bb[] = {bfloat16(nan), bfloat16(nan), bfloat16(1.0f), bfloat16(1.0f)};
+        const float16 xh[] = {float16(0.0f), float16(1.0f)}, Bh[] = {float16(nan), float16(nan), float16(1.0f), float16(1.0f)};
+        bfloat16 yb[2];
+        float16 yh[2];
+        Kernel::gemm(false, false, 1, 2, 2, bfloat16(1.0f), xb, 2, Bb, 2, bfloat16(0.0f), yb, 2);
+        Kernel::gemm(false, false, 1, 2, 2, float16(1.0f), xh, 2, Bh, 2, float16(0.0f), yh, 2);
+        std::cout << "16-bit gemv with NaN in B and x = 0: bf16 [" << float(yb[0]) << ", " << float(yb[1])
+                  << "], fp16 [" << float(yh[0]) << ", " << float(yh[1]) << "]\n";
+        ok = ok && std::isnan(float(yb[0])) && std::isnan(float(yb[1])) && std::isnan(float(yh[0])) && std::isnan(float(yh[1]));
+    }
+
+    // ---------- Reductions and losses accumulate in fp32 ----------
+    auto ones = std::make_shared<Tensor<bfloat16>>(std::vector<bfloat16>(4096, bfloat16(1.0f)), true);
+    auto total = sum(ones * ones);
+    total->backward();
+    ok = ok && float((*total)[0]) == 4096.0f && float(ones->get_grad()[17]) == 2.0f; // bf16 accumulation stops at 256
+    ok = ok && float((*mean(ones))[0]) == 1.0f;
+    LossModule::MSELoss<float16> mse;
+    Tensor<float16> pred(std::vector<float16>(4096, float16(1.0f))), target(std::vector<float16>(4096, float16(0.0f)));
+    ok = ok && float(mse.forward(pred, target)) == 1.0f;
+
+    // ---------- Dense in 16 bits tracks Dense in fp32 ----------
+    LayerModule::Dense<float> dense32(64, 32, Kernel::Activation::GELU);
+    LayerModule::Dense<bfloat16> dense16(64, 32, Kernel::Activation::GELU);
+    std::vector<float> xs(8 * 64);
+    for (size_t i = 0; i < xs.size(); i++)
+        xs[i] = std::sin(0.05f * i);
+    Tensor<float> x32(xs, Shape{8, 64});
+    Tensor<bfloat16> x16(std::vector<bfloat16>(xs.begin(), xs.end()), Shape{8, 64});
+    Tensor<float> y32 = dense32.forward(x32);
+    Tensor<bfloat16> y16 = dense16.forward(x16);
+    double dense_err = 0;
+    for (size_t i = 0; i < y32.size(); i++)
+        dense_err = std::max(dense_err, double(std::abs(float(y16[i]) - y32[i])));
+    std::cout << "Dense<bfloat16> vs Dense<float> max abs diff " << dense_err << "\n";
+    ok = ok && dense_err < 0.02;
+
+    // ---------- Mixed precision: fp16 model, fp32 master weights, loss scaling ----------
+    std::vector<float16> inputs, targets;
+    for (int i = 0; i < 32; i++)
+    {
+        float a = std::sin(1.3f * i), b = std::cos(0.7f * i);
+        inputs.insert(inputs.end(), {float16(a), float16(b)});
+        targets.push_back(float16(0.3f * a - 0.7f * b + 0.2f));
+    }
+    Tensor<float16> features(inputs, Shape{32, 2}), labels(targets, Shape{32, 1});
+    LayerModule::Dense<float16> linear(2, 1);
+    OptimizerModule::LossScaling scaling;
+    scaling.scale = 1e8f; // overflows fp16 on purpose: the first steps must back off
+    OptimizerModule::MixedPrecision<float16> amp(linear, [](std::shared_ptr<Module::ParameterBuffer<float>> master)
+                                                  { return std::make_unique<OptimizerModule::Adam<float>>(master, 0.02f); },
+                                                  scaling);
+    LossModule::MSELoss<float16> criterion;
+    float first_loss = 0, loss = 0;
+    for (int epoch = 0; epoch < 600; epoch++)
+    {
+        loss = float(criterion.forward(linear.forward(features), labels));
+        if (epoch == 0)
+            first_loss = loss;
+        linear.backward(amp.scale_grad(criterion.backward()));
+        amp.step();
+    }
+    std::cout << "mixed precision: loss " << first_loss << " -> " << loss << ", " << amp.skipped_steps()
+              << " skipped steps, final scale " << amp.get_scale() << ", optimizer steps " << amp.optimizer().steps() << "\n";
+    ok = ok && loss < 1e-3f * first_loss && amp.skipped_steps() > 0 && amp.get_scale() < 1e8f &&
+         amp.optimizer().steps() + amp.skipped_steps() == 600;
+    // The model holds the master weights rounded to fp16.
+    ok = ok && same(linear.weights()[0], float16(amp.master().data[0]));
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,226 @@
+#include <NovaML/Serving/inference_server.hpp>
+#include <NovaML/Core/Module/sequential.hpp>
+#include <NovaML/Core/Layer/dense.hpp>
+#include <NovaML/Core/Activation/relu.hpp>
+#include <NovaML/Core/Activation/sigmoid.hpp>
+#include <NovaML/Core/Activation/gelu.hpp>
+#include <cmath>
+#include <iostream>
+#include <thread>
+
+using namespace NovaML;
+using namespace NovaML::Core;
+
+std::shared_ptr<Module::Sequential<double>> make_model(bool fuse)
+{
+    auto model = std::make_shared<Module::Sequential<double>>(fuse);
+    model->add(std::make_shared<LayerModule::Dense<double>>(6, 16));
+    model->add(std::make_shared<ActivationModule::GELU<double>>());
+    model->add(std::make_shared<LayerModule::Dense<double>>(16, 8));
+    model->add(std::make_shared<ActivationModule::ReLU<double>>());
+    model->add(std::make_shared<LayerModule::Dense<double>>(8, 3));
+    model->add(std::make_shared<ActivationModule::Sigmoid<double>>());
+    return model;
+}
+
+Tensor<double> make_input(size_t rows, double phase)
+{
+    std::vector<double> v(rows * 6);
+    for (size_t i = 0; i < v.size(); i++)
+        v[i] = std::sin(0.7 * double(i) + phase);
+    return Tensor<double>(v, Shape{rows, 6});
+}
+
+double max_diff(const Tensor<double> &a, const Tensor<double> &b)
+{
+    if (a.shape() != b.shape())
+        return 1e30;
+    double d = 0;
+    for (size_t i = 0; i < a.size(); i++)
+        d = std::max(d, std::abs(a[i] - b[i]));
+    return d;
+}
+
+// A leaf module with no stateless path, and one whose inference fails.
+struct Opaque : Module::BaseModule<double>
+{
+    std::string info(std::ostream &) const override { return "Opaque"; }
+    Tensor<double> forward(const Tensor<double> &input) override { return input; }
+};
+
+struct Failing : Module::BaseModule<double>
+{
+    std::string info(std::ostream &) const override { return "Failing"; }
+    Tensor<double> forward(const Tensor<double> &input) override { return infer(input); }
+    Tensor<double> infer(const Tensor<double> &) const override { throw std::runtime_error("model failed"); }
+};
+
+int main()
+{
+    bool ok = true;
+
+    // ---------- infer() computes forward() and leaves the module untouched ----------
+    {
+        bool same = true;
+        for (bool fuse : {true, false})
+        {
+            auto model = make_model(fuse);
+            auto x = make_input(5, 0.0);
+            same = same && max_diff(model->infer(x), model->forward(x)) < 1e-14;
+
+            // A training forward, then infer() on other data: backward still sees the first input.
+            auto reference = make_model(fuse);
+            auto grad = make_input(5, 1.0);
+            Tensor<double> g(std::vector<double>(15, 1.0), Shape{5, 3});
+            model->forward(x);
+            model->infer(grad);
+            auto dx = model->backward(g);
+            reference->forward(x);
+            same = same && max_diff(dx, reference->backward(g)) < 1e-14;
+        }
+        bool threw = false;
+        try
+        {
+            Opaque().infer(make_input(1, 0.0));
+        }
+        catch (const std::logic_error &)
+        {
+            threw = true;
+        }
+        std::cout << "infer: " << (same && threw ? "ok" : "FAILED") << "\n";
+        ok = ok && same && threw;
+    }
+
+    // ---------- Concurrent clients: every answer matches a direct infer() ----------
+    {
+        auto model = make_model(true);
+        Serving::ServerOptions options;
+        options.max_batch_size = 16;
+        options.max_delay = std::chrono::milliseconds(20);
+        options.num_workers = 2;
+        Serving::InferenceServer<double> server(model, 6, options);
+
+        const size_t clients = 4, per_client = 50;
+        std::vector<bool> correct(clients, true);
+        std::vector<std::thread> threads;
+        for (size_t c = 0; c < clients; c++)
+            threads.emplace_back([&, c]
+                                 {
+                std::vector<std::future<Tensor<double>>> results;
+                std::vector<Tensor<double>> inputs;
+                for (size_t i = 0; i < per_client; i++)
+                {
+                    inputs.push_back(Tensor<double>(make_input(1, double(c * per_client + i)).get_data(), Shape{6}));
+                    results.push_back(server.submit(inputs.back()));
+                }
+                for (size_t i = 0; i < per_client; i++)
+                {
+                    auto expected = model->infer(Tensor<double>(inputs[i].get_data(), Shape{1, 6}));
+                    auto y = results[i].get();
+                    correct[c] = correct[c] && y.shape() == Shape{3} && max_diff(Tensor<double>(y.get_data(), Shape{1, 3}), expected) < 1e-14;
+                } });
+        for (auto &t : threads)
+            t.join();
+
+        // A block keeps its batch dimension
+        auto block = make_input(3, 9.0);
+        const bool block_ok = max_diff(server.submit(block).get(), model->infer(block)) < 1e-14;
+
+        const Serving::ServerStats stats = server.stats();
+        bool all = block_ok;
+        for (bool c : correct)
+            all = all && c;
+        const bool batched = stats.requests == clients * per_client + 1 && stats.rows == clients * per_client + 3 &&
+                             stats.mean_batch_size() > 1.0 && stats.failed == 0;
+        std::cout << "concurrent: " << stats.requests << " requests in " << stats.batches << " batches (mean "
+                  << stats.mean_batch_size() << ", " << stats.full_batches << " full)" << (all && batched ? " ok" : " FAILED") << "\n";
+        ok = ok && all && batched;
+    }
+
+    // ---------- A lone request leaves at its deadline; shutdown answers the queue ----------
+    {
+        Serving::ServerOptions options;
+        options.max_delay = std::chrono::milliseconds(2);
+        Serving::InferenceServer<double> server(make_model(true), 6, options);
+        auto lone = server.submit(make_input(1, 0.0));
+        const bool on_time = lone.wait_for(std::chrono::seconds(5)) == std::future_status::ready;
+
+        options.max_delay = std::chrono::seconds(60);
+        Serving::InferenceServer<double> slow(make_model(true), 6, options);
+        std::vector<std::future<Tensor<double>>> queued;
+        for (size_t i = 0; i < 5; i++)
+            queued.push_back(slow.submit(make_input(1, double(i))));
+        slow.shutdown();
+        bool drained = true;
+        for (auto &f : queued)
+            drained = drained && f.wait_for(std::chrono::seconds(0)) == std::future_status::ready && f.get().shape() == Shape{1, 3};
+        bool refused = false;
+        try
+        {
+            slow.submit(make_input(1, 0.0));
+        }
+        catch (const std::logic_error &)
+        {
+            refused = true;
+        }
+        std::cout << "deadline and shutdown: " << (on_time && drained && refused ? "ok" : "FAILED") << "\n";
+        ok = ok && on_time && drained && refused;
+    }
+
+    // ---------- The caller may overwrite its input while the request is queued ----------
+    {
+        Serving::ServerOptions options;
+        options.max_delay = std::chrono::seconds(60);
+        auto model = make_model(true);
+        Serving::InferenceServer<double> server(model, 6, options);
+        Tensor<double> input = make_input(2, 0.5);
+        const Tensor<double> expected = model->infer(make_input(2, 0.5));
+        auto result = server.submit(input);
+        std::fill(input.data_ptr(), input.data_ptr() + input.size(), 100.0);
+        server.shutdown();
+        const bool unchanged = max_diff(result.get(), expected) == 0.0;
+        std::cout << "input reused after submit: " << (unchanged ? "ok" : "FAILED") << "\n";
+        ok = ok && unchanged;
+    }
+
+    // ---------- Errors: bad shapes are refused, model failures reach every request of the batch ----------
+    {
+        bool errors = true;
+        Serving::InferenceServer<double> server(std::make_shared<Failing>(), 6);
+        try
+        {
+            server.submit(Tensor<double>(std::vector<double>(5, 0.0)));
+            errors = false;
+        }
+        catch (const std::invalid_argument &)
+        {
+        }
+        auto a = server.submit(make_input(2, 0.0));
+        auto b = server.submit(make_input(1, 0.0));
+        for (auto *f : {&a, &b})
+            try
+            {
+                f->get();
+                errors = false;
+            }
+            catch (const std::runtime_error &e)
+            {
+                errors = errors && std::string(e.what()) == "model failed";
+            }
+
+        Serving::InferenceServer<double> opaque(std::make_shared<Opaque>(), 6);
+        try
+        {
+            opaque.submit(make_input(1, 0.0)).get();
+            errors = false;
+        }
+        catch (const std::logic_error &)
+        {
+        }
+        errors = errors && server.stats().failed == 2;
+        std::cout << "errors: " << (errors ? "ok" : "FAILED") << "\n";
+        ok = ok && errors;
+    }
+
+    return ok ? 0 : 1;
+}
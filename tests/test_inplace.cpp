@@ -0,0 +1,124 @@
+#include <NovaML/Core/Tensor/tensor.hpp>
+#include <NovaML/Core/Tensor/tensor_math.hpp>
+#include <NovaML/Core/Tensor/expression.hpp>
+#include <NovaML/Core/Kernel/vmath.hpp>
+#include <NovaML/Memory/allocator.hpp>
+#include <iostream>
+#include <stdexcept>
+
+using namespace NovaML::Core;
+namespace Memory = NovaML::Memory;
+
+// Runs fn and reports whether it threw E.
+template <typename E, typename F>
+bool throws(F fn, const char *label)
+{
+    try
+    {
+        fn();
+    }
+    catch (const E &err)
+    {
+        std::cout << label << ": " << err.what() << "\n";
+        return true;
+    }
+    std::cout << label << ": no error\n";
+    return false;
+}
+
+int main()
+{
+    bool ok = true;
+    // sigmoid_ is checked against libm below: keep the Exact tier whatever NOVAML_MATH says.
+    const Kernel::MathAccuracy tier = Kernel::math_accuracy();
+    Kernel::set_math_accuracy(Kernel::MathAccuracy::Exact);
+
+    // ---------- Results and versions ----------
+    auto a = std::make_shared<Tensor<double>>(std::vector<double>{-2.0, -0.5, 0.5, 2.0});
+    auto b = std::make_shared<Tensor<double>>(std::vector<double>{1.0, 2.0, 3.0, 4.0});
+    const double *storage = a->data_ptr();
+    add_(a, b, 0.5);
+    mul_scalar_(a, 2.0);
+    clamp_(a, -1.0, 4.0);
+    std::cout << "a after add_/mul_scalar_/clamp_: " << vector_to_string(a->get_data()) << " version " << a->version() << "\n";
+    ok = ok && a->get_data() == std::vector<double>{-1.0, 1.0, 4.0, 4.0} && a->version() == 3 && a->data_ptr() == storage;
+
+    relu_(sub_(a, b));
+    ok = ok && a->get_data() == std::vector<double>{0.0, 0.0, 1.0, 0.0};
+
+    // Writes through a view land in (and version) the shared storage.
+    auto m = std::make_shared<Tensor<double>>(std::vector<double>{1, 2, 3, 4, 5, 6}, Shape{2, 3});
+    auto column = slice(m, 1, 1, 2);
+    fill_(column, 0.0);
+    auto mt = transpose(reshape(m, {3, 2}));
+    auto m2 = std::make_shared<Tensor<double>>(std::vector<double>{1, 2, 3, 4, 5, 6}, Shape{2, 3});
+    add_(m2, mt); // m2 += (a transposed view of other storage)
+    std::cout << "m after fill_ of column 1: " << vector_to_string(m->get_data()) << ", m2: " << vector_to_string(m2->get_data()) << "\n";
+    ok = ok && m->get_data() == std::vector<double>{1, 0, 3, 4, 0, 6} && m->version() == 1;
+    ok = ok && m2->get_data() == std::vector<double>{2, 5, 3, 4, 9, 12};
+
+    // Aliased operands: x += x^T over the same storage uses the old values.
+    auto sq = std::make_shared<Tensor<double>>(std::vector<double>{1, 2, 3, 4}, Shape{2, 2});
+    add_(sq, transpose(sq));
+    ok = ok && sq->get_data() == std::vector<double>{2, 5, 5, 8};
+
+    // ---------- Saved tensors are protected ----------
+    auto w = std::make_shared<Tensor<double>>(std::vector<double>{1.0, 2.0}, true);
+    auto x = std::make_shared<Tensor<double>>(std::vector<double>{3.0, 4.0});
+    auto y = sum(w * x);
+    mul_scalar_(x, 2.0); // x was saved by mul for dw = x
+    ok = ok && throws<std::runtime_error>([&]
+                                          { y->backward(); }, "backward after in-place write");
+
+    auto e = exp(w);
+    auto loss = sum(e);
+    {
+        NoGradGuard no_grad;
+        exp_(e); // the saved exp output changes under the graph
+    }
+    ok = ok && throws<std::runtime_error>([&]
+                                          { loss->backward(); }, "exp output modified");
+
+    auto fused = sum(Expr::evaluate(Expr::lazy(w) * x));
+    add_scalar_(x, 1.0);
+    ok = ok && throws<std::runtime_error>([&]
+                                          { fused->backward(); }, "fused input modified");
+
+    // Unmodified graphs still work.
+    w->zero_grad();
+    sum(w * x)->backward();
+    ok = ok && w->get_grad() == Buffer<double>{7.0, 9.0};
+
+    // ---------- Tensors in the graph are refused while grad mode is on ----------
+    ok = ok && throws<std::runtime_error>([&]
+                                          { mul_scalar_(w, 0.5); }, "in-place on requires_grad");
+    ok = ok && throws<std::invalid_argument>([&]
+                                             { add_(a, m); }, "shape mismatch");
+
+    // ---------- Expanded views alias storage and are not writable ----------
+    auto row = std::make_shared<Tensor<double>>(std::vector<double>{1.0, 2.0, 3.0}, Shape{1, 3});
+    auto tiled = expand(row, {4096, 3});
+    ok = ok && throws<std::invalid_argument>([&]
+                                             { exp_(tiled); }, "exp_ on expanded view");
+    ok = ok && throws<std::invalid_argument>([&]
+                                             { add_scalar_(tiled, 1.0); }, "add_scalar_ on expanded view");
+    auto tiled_copy = contiguous(tiled);
+    sigmoid_(tiled_copy);
+    ok = ok && row->version() == 0 && std::abs((*tiled_copy)[3 * 4095 + 2] - 1.0 / (1.0 + std::exp(-3.0))) < 1e-12;
+
+    // ---------- Zero-allocation update loop ----------
+    auto param = std::make_shared<Tensor<double>>(std::vector<double>(1024, 1.0), true);
+    auto grad = std::make_shared<Tensor<double>>(std::vector<double>(1024, 0.5));
+    Memory::reset_stats();
+    {
+        NoGradGuard no_grad;
+        for (int step = 0; step < 100; step++)
+            add_(param, grad, -0.01);
+    }
+    size_t allocations = Memory::get_stats().allocations;
+    std::cout << "param[0] after 100 steps: " << (*param)[0] << ", allocations: " << allocations << "\n";
+    ok = ok && allocations == 0 && std::abs((*param)[0] - 0.5) < 1e-12;
+
+    Kernel::set_math_accuracy(tier);
+    return ok ? 0 : 1;
+}
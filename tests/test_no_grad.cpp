@@ -0,0 +1,83 @@
+#include <NovaML/Core/Tensor/tensor.hpp>
+#include <NovaML/Core/Tensor/tensor_math.hpp>
+#include <NovaML/Core/Layer/dense.hpp>
+#include <NovaML/Core/Activation/relu.hpp>
+#include <NovaML/Core/Module/sequential.hpp>
+#include <NovaML/Memory/allocator.hpp>
+#include <iostream>
+
+using namespace NovaML::Core;
+namespace Memory = NovaML::Memory;
+
+// Peak tensor memory of one elementwise chain over n elements.
+size_t chain_peak(size_t n, bool grad_enabled)
+{
+    auto a = std::make_shared<Tensor<double>>(std::vector<double>(n, 0.5), true);
+    Memory::reset_stats();
+    size_t base = Memory::get_stats().bytes_in_use;
+    {
+        GradMode::set_enabled(grad_enabled);
+        // Separate statements, so temporaries die as soon as grad mode allows.
+        auto y = a * a;
+        y = y + a;
+        y = exp(y);
+        y = y * 2.0;
+        GradMode::set_enabled(true);
+    }
+    return Memory::get_stats().peak_bytes_in_use - base;
+}
+
+int main()
+{
+    bool ok = true;
+
+    // ---------- Gradient buffers are allocated on first use ----------
+    auto a = std::make_shared<Tensor<double>>(std::vector<double>{1.0, 2.0, 3.0}, true);
+    auto b = std::make_shared<Tensor<double>>(std::vector<double>{4.0, 5.0, 6.0});
+    auto c = a * b;
+    std::cout << "before backward: a.has_grad=" << a->has_grad() << " c.has_grad=" << c->has_grad() << "\n";
+    ok = ok && !a->has_grad() && !b->has_grad() && !c->has_grad();
+
+    sum(c)->backward();
+    std::cout << "a grad: " << vector_to_string(a->get_grad()) << ", b.has_grad=" << b->has_grad() << "\n";
+    ok = ok && a->get_grad() == Buffer<double>{4.0, 5.0, 6.0} && !b->has_grad();
+
+    // ---------- NoGradGuard: no graph, no closures ----------
+    {
+        NoGradGuard no_grad;
+        auto d = exp(a * b) + a;
+        auto v = transpose(reshape(d, {3, 1}));
+        std::cout << "no_grad: requires_grad=" << d->get_requires_grad() << " edges=" << d->get_edges().size()
+                  << " view requires_grad=" << v->get_requires_grad() << "\n";
+        ok = ok && !d->get_requires_grad() && d->get_edges().empty() && !v->get_requires_grad();
+
+        {
+            NoGradGuard nested;
+        }
+        ok = ok && !GradMode::is_enabled();
+    }
+    ok = ok && GradMode::is_enabled() && (a * b)->get_requires_grad();
+
+    // ---------- Inference keeps no activations alive ----------
+    size_t with_grad = chain_peak(1 << 16, true);
+    size_t without_grad = chain_peak(1 << 16, false);
+    std::cout << "peak bytes: grad mode " << with_grad << ", no_grad " << without_grad << "\n";
+    ok = ok && without_grad < with_grad;
+
+    // ---------- Module forward in inference mode matches training mode ----------
+    Module::Sequential<double> model;
+    model.add(std::make_shared<LayerModule::Dense<double>>(3, 4));
+    model.add(std::make_shared<ActivationModule::ReLU<double>>());
+    model.add(std::make_shared<LayerModule::Dense<double>>(4, 2));
+    Tensor<double> x(std::vector<double>{0.2, -0.4, 0.6, 1.0, 0.5, -0.5}, Shape{2, 3});
+    Tensor<double> train_out = model.forward(x);
+    Tensor<double> infer_out(0);
+    {
+        NoGradGuard no_grad;
+        infer_out = model.forward(x);
+    }
+    ok = ok && train_out.get_data() == infer_out.get_data();
+    std::cout << "inference output: " << vector_to_string(infer_out.get_data()) << "\n";
+
+    return ok ? 0 : 1;
+}
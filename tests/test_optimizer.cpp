@@ -0,0 +1,227 @@
+#include <NovaML/Core/Module/sequential.hpp>
+#include <NovaML/Core/Layer/dense.hpp>
+#include <NovaML/Core/Activation/relu.hpp>
+#include <NovaML/Core/Activation/sigmoid.hpp>
+#include <NovaML/Core/Loss/mse.hpp>
+#include <NovaML/Core/Optimizer/sgd.hpp>
+#include <NovaML/Core/Optimizer/adam.hpp>
+#include <NovaML/Core/Kernel/cpu_features.hpp>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+
+using namespace NovaML::Core;
+using Module::ParameterBuffer;
+
+std::shared_ptr<Module::Sequential<double>> make_model()
+{
+    auto model = std::make_shared<Module::Sequential<double>>();
+    model->add(std::make_shared<LayerModule::Dense<double>>(2, 8));
+    model->add(std::make_shared<ActivationModule::ReLU<double>>());
+    model->add(std::make_shared<LayerModule::Dense<double>>(8, 1));
+    model->add(std::make_shared<ActivationModule::Sigmoid<double>>());
+    return model;
+}
+
+// Flat buffer with reproducible values and gradients; n is not a multiple of any vector width.
+template <typename T>
+std::shared_ptr<ParameterBuffer<T>> make_buffer(size_t n)
+{
+    auto buffer = std::make_shared<ParameterBuffer<T>>(n);
+    for (size_t i = 0; i < n; i++)
+    {
+        buffer->data[i] = T(0.5) * static_cast<T>(std::sin(0.37 * static_cast<double>(i)));
+        buffer->grad[i] = T(0.1) * static_cast<T>(std::cos(0.11 * static_cast<double>(i)));
+    }
+    return buffer;
+}
+
+// Straightforward per-element references (PyTorch formulation).
+template <typename T>
+void reference_sgd(std::vector<double> &p, const ParameterBuffer<T> &b, std::vector<double> &vel,
+                   size_t step, double lr, double mu, double dampening, double wd, bool nesterov)
+{
+    for (size_t i = 0; i < p.size(); i++)
+    {
+        double g = static_cast<double>(b.grad[i]) + wd * p[i];
+        if (mu != 0)
+        {
+            vel[i] = step == 1 ? g : mu * vel[i] + (1 - dampening) * g;
+            g = nesterov ? g + mu * vel[i] : vel[i];
+        }
+        p[i] -= lr * g;
+    }
+}
+
+template <typename T>
+void reference_adam(std::vector<double> &p, const ParameterBuffer<T> &b, std::vector<double> &m, std::vector<double> &v,
+                    size_t step, double lr, double wd, bool decoupled)
+{
+    const double b1 = 0.9, b2 = 0.999, eps = 1e-8;
+    for (size_t i = 0; i < p.size(); i++)
+    {
+        double g = static_cast<double>(b.grad[i]);
+        if (decoupled)
+            p[i] *= 1 - lr * wd;
+        else
+            g += wd * p[i];
+        m[i] = b1 * m[i] + (1 - b1) * g;
+        v[i] = b2 * v[i] + (1 - b2) * g * g;
+        double m_hat = m[i] / (1 - std::pow(b1, double(step)));
+        double v_hat = v[i] / (1 - std::pow(b2, double(step)));
+        p[i] -= lr * m_hat / (std::sqrt(v_hat) + eps);
+    }
+}
+
+// Run 5 steps of every optimizer on a flat buffer and return the worst deviation from the reference.
+template <typename T>
+double optimizer_error(size_t n)
+{
+    double err = 0;
+    auto check = [&](const ParameterBuffer<T> &b, const std::vector<double> &p)
+    {
+        for (size_t i = 0; i < n; i++)
+            err = std::max(err, std::abs(static_cast<double>(b.data[i]) - p[i]));
+    };
+    auto initial = [&](const ParameterBuffer<T> &b)
+    { return std::vector<double>(b.data.begin(), b.data.end()); };
+
+    // Plain, momentum, Nesterov, dampened momentum.
+    for (int variant = 0; variant < 4; variant++)
+    {
+        const double mu = variant == 0 ? 0.0 : 0.9, wd = 1e-2, dampening = variant == 3 ? 0.5 : 0.0;
+        const bool nesterov = variant == 2;
+        auto buffer = make_buffer<T>(n);
+        auto p = initial(*buffer);
+        std::vector<double> vel(n, 0.0);
+        OptimizerModule::SGD<T> sgd(buffer, T(0.1), T(mu), T(wd), T(dampening), nesterov);
+        for (size_t s = 1; s <= 5; s++)
+        {
+            sgd.step();
+            reference_sgd(p, *buffer, vel, s, 0.1, mu, dampening, wd, nesterov);
+        }
+        check(*buffer, p);
+    }
+
+    for (bool decoupled : {false, true})
+    {
+        auto buffer = make_buffer<T>(n);
+        auto p = initial(*buffer);
+        std::vector<double> m(n, 0.0), v(n, 0.0);
+        std::unique_ptr<OptimizerModule::Adam<T>> adam;
+        if (decoupled)
+            adam = std::make_unique<OptimizerModule::AdamW<T>>(buffer, T(1e-2));
+        else
+            adam = std::make_unique<OptimizerModule::Adam<T>>(buffer, T(1e-2), T(0.9), T(0.999), T(1e-8), T(1e-2));
+        for (size_t s = 1; s <= 5; s++)
+        {
+            adam->step();
+            reference_adam(p, *buffer, m, v, s, 1e-2, 1e-2, decoupled);
+        }
+        check(*buffer, p);
+    }
+    return err;
+}
+
+int main()
+{
+    bool ok = true;
+
+    // ---------- Flattening keeps the values and rebinds every layer ----------
+    auto model = make_model();
+    Tensor<double> x(std::vector<double>{0, 0, 0, 1, 1, 0, 1, 1}, Shape{4, 2});
+    Tensor<double> y(std::vector<double>{0, 1, 1, 0}, Shape{4, 1});
+    Tensor<double> before = model->forward(x);
+    auto flat = Module::flatten_parameters(*model);
+    Tensor<double> after = model->forward(x);
+    double flatten_diff = 0;
+    for (size_t i = 0; i < before.size(); i++)
+        flatten_diff = std::max(flatten_diff, std::abs(before[i] - after[i]));
+    std::cout << "flat parameters: " << flat->size() << " elements for " << model->num_params()
+              << " parameters, forward diff after flatten " << flatten_diff << "\n";
+    ok = ok && flatten_diff == 0 && flat->size() == model->parameter_size() &&
+         flat->size() >= model->num_params() &&
+         reinterpret_cast<std::uintptr_t>(flat->data.data()) % NovaML::Memory::buffer_alignment == 0;
+
+    // ---------- Plain SGD through the optimizer matches Module::update ----------
+    auto reference = make_model();
+    OptimizerModule::SGD<double> sgd(*model, 0.5);
+    for (int epoch = 0; epoch < 50; epoch++)
+    {
+        LossModule::MSELoss<double> c1, c2;
+        c1.forward(model->forward(x), y);
+        c2.forward(reference->forward(x), y);
+        model->backward(c1.backward());
+        reference->backward(c2.backward());
+        sgd.step();
+        reference->update(0.5);
+    }
+    Tensor<double> p1 = model->forward(x), p2 = reference->forward(x);
+    double sgd_diff = 0;
+    for (size_t i = 0; i < p1.size(); i++)
+        sgd_diff = std::max(sgd_diff, std::abs(p1[i] - p2[i]));
+    std::cout << "optimizer SGD vs Module::update after 50 steps: " << sgd_diff << "\n";
+    ok = ok && sgd_diff < 1e-12 && sgd.steps() == 50;
+
+    // ---------- Every kernel path against the reference, large enough to split over threads ----------
+    for (auto isa : {NovaML::Core::Kernel::Isa::Scalar, NovaML::Core::Kernel::Isa::Avx2,
+                     NovaML::Core::Kernel::Isa::Avx512, NovaML::Core::Kernel::Isa::Neon})
+    {
+        if (!Kernel::isa_supported(isa))
+            continue;
+        Kernel::set_active_isa(isa);
+        double err_d = optimizer_error<double>(100003), err_f = optimizer_error<float>(1003);
+        std::cout << Kernel::isa_name(isa) << ": max error double " << err_d << ", float " << err_f << "\n";
+        ok = ok && err_d < 1e-12 && err_f < 1e-5;
+    }
+    Kernel::set_active_isa(Kernel::detected_isa());
+
+    // ---------- AdamW decay is decoupled: zero gradients still shrink the weights ----------
+    auto decay = make_buffer<double>(100);
+    std::fill(decay->grad.begin(), decay->grad.end(), 0.0);
+    std::vector<double> w0(decay->data.begin(), decay->data.end());
+    OptimizerModule::AdamW<double> adamw(decay, 0.1, 0.9, 0.999, 1e-8, 0.5);
+    adamw.step();
+    double decay_err = 0;
+    for (size_t i = 0; i < w0.size(); i++)
+        decay_err = std::max(decay_err, std::abs(decay->data[i] - 0.95 * w0[i]));
+    ok = ok && decay_err < 1e-15;
+
+    // ---------- Adam fits a linear target ----------
+    std::vector<double> inputs, targets;
+    for (int i = 0; i < 16; i++)
+    {
+        double a = std::sin(1.3 * i), b = std::cos(0.7 * i);
+        inputs.insert(inputs.end(), {a, b});
+        targets.push_back(0.3 * a - 0.7 * b + 0.2);
+    }
+    Tensor<double> xs(inputs, Shape{16, 2}), ys(targets, Shape{16, 1});
+    LayerModule::Dense<double> linear(2, 1);
+    OptimizerModule::Adam<double> adam(linear, 0.05);
+    LossModule::MSELoss<double> criterion;
+    double first_loss = 0, loss = 0;
+    for (int epoch = 0; epoch < 500; epoch++)
+    {
+        loss = criterion.forward(linear.forward(xs), ys);
+        if (epoch == 0)
+            first_loss = loss;
+        linear.backward(criterion.backward());
+        adam.step();
+    }
+    std::cout << "Adam linear fit loss " << first_loss << " -> " << loss << "\n";
+    ok = ok && loss < 1e-6 * first_loss;
+
+    // ---------- Invalid hyper-parameters ----------
+    bool threw = false;
+    try
+    {
+        OptimizerModule::SGD<double> bad(make_buffer<double>(4), 0.1, 0.0, 0.0, 0.0, true);
+    }
+    catch (const std::invalid_argument &)
+    {
+        threw = true;
+    }
+    ok = ok && threw;
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,104 @@
+#include <NovaML/Core/Tensor/tensor.hpp>
+#include <NovaML/Core/Tensor/tensor_math.hpp>
+#include <NovaML/Core/Layer/dense.hpp>
+#include <NovaML/Core/Activation/relu.hpp>
+#include <NovaML/Core/Module/sequential.hpp>
+#include <NovaML/Profiler/profiler.hpp>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+using namespace NovaML::Core;
+namespace Profiler = NovaML::Profiler;
+
+const Profiler::Event *find(const std::vector<Profiler::Event> &events, const std::string &name)
+{
+    for (const auto &e : events)
+        if (e.name == name)
+            return &e;
+    return nullptr;
+}
+
+int main()
+{
+    bool ok = true;
+    auto a = std::make_shared<Tensor<double>>(std::vector<double>(1000, 1.5), true);
+    auto b = std::make_shared<Tensor<double>>(std::vector<double>(1000, 2.0), true);
+
+    // ---------- Nothing is recorded while disabled ----------
+    sum(a * b + a)->backward();
+    ok = ok && !Profiler::is_enabled() && Profiler::events().empty();
+
+    // ---------- Forward ops, backward nodes, FLOPs / bytes / allocations ----------
+    Profiler::enable();
+    sum(a * b + a)->backward();
+    Profiler::disable();
+    auto events = Profiler::events();
+    const auto *mul = find(events, "mul");
+    const auto *mul_backward = find(events, "<MulBackward>");
+    const auto *pass = find(events, "backward");
+    if (!mul)
+        return 1;
+    std::cout << events.size() << " events; mul: " << mul->duration_ns << " ns, " << mul->flops << " flops, "
+              << mul->bytes << " bytes, " << mul->allocations << " allocation(s)\n";
+    ok = ok && mul->category == Profiler::Category::Op && mul->flops == 1000 &&
+         mul->bytes == 3000 * sizeof(double) && mul->allocations == 1;
+    ok = ok && mul_backward && mul_backward->category == Profiler::Category::Backward && mul_backward->depth == 1;
+    ok = ok && pass && pass->depth == 0 && pass->self_ns <= pass->duration_ns && find(events, "<SumBackward>");
+
+    // ---------- Module calls nest their kernels ----------
+    Profiler::clear();
+    Module::Sequential<double> model;
+    model.add(std::make_shared<LayerModule::Dense<double>>(16, 32));
+    model.add(std::make_shared<ActivationModule::ReLU<double>>());
+    Tensor<double> x(std::vector<double>(8 * 16, 0.25), Shape{8, 16});
+    Profiler::enable();
+    model.backward(model.forward(x));
+    model.update(0.1);
+    Profiler::disable();
+    events = Profiler::events();
+    const auto *dense = find(events, "Dense(16->32)+ReLU.forward");
+    const auto *gemm = find(events, "gemm");
+    // The ReLU runs as the Dense epilogue, so it has no events of its own.
+    ok = ok && dense && dense->category == Profiler::Category::Module && !find(events, "ReLU.forward") &&
+         find(events, "Dense(16->32)+ReLU.backward") && find(events, "Dense(16->32)+ReLU.update");
+    ok = ok && gemm && gemm->category == Profiler::Category::Kernel && gemm->depth == 1 &&
+         gemm->flops == 2.0 * 8 * 32 * 16 && gemm->start_ns >= dense->start_ns &&
+         dense->self_ns + gemm->duration_ns <= dense->duration_ns + 1;
+
+    std::string table = Profiler::summary_table();
+    std::cout << table;
+    auto summary = Profiler::summarize();
+    size_t gemm_calls = 0;
+    for (const auto &s : summary)
+        if (s.name == "gemm")
+            gemm_calls = s.calls;
+    ok = ok && table.find("Dense(16->32)+ReLU.forward") != std::string::npos && gemm_calls == 3;
+
+    // ---------- Events carry the thread they ran on ----------
+    Profiler::clear();
+    Profiler::enable();
+    {
+        Profiler::RecordScope scope("main", Profiler::Category::User);
+        std::thread worker([&]
+                           { Profiler::RecordScope inner("worker", Profiler::Category::User); });
+        worker.join();
+    }
+    Profiler::disable();
+    events = Profiler::events();
+    ok = ok && events.size() == 2 && find(events, "main")->thread != find(events, "worker")->thread;
+
+    // ---------- Chrome trace export ----------
+    const std::string path = "novaml_test_trace.json";
+    Profiler::export_chrome_trace(path);
+    std::ifstream in(path);
+    std::stringstream trace;
+    trace << in.rdbuf();
+    std::remove(path.c_str());
+    ok = ok && trace.str().find("\"traceEvents\"") != std::string::npos &&
+         trace.str().find("\"name\": \"worker\", \"cat\": \"user\", \"ph\": \"X\"") != std::string::npos;
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,168 @@
+#include <NovaML/Core/Quantization/quantized_sequential.hpp>
+#include <NovaML/Core/Module/sequential.hpp>
+#include <NovaML/Core/Layer/dense.hpp>
+#include <NovaML/Core/Activation/relu.hpp>
+#include <NovaML/Core/Activation/sigmoid.hpp>
+#include <NovaML/Core/Kernel/qgemm.hpp>
+#include <NovaML/Core/Kernel/cpu_features.hpp>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+
+using namespace NovaML::Core;
+
+// qgemm against a plain int32 loop; float outputs must match exactly, uint8 outputs within one step.
+int qgemm_error(size_t M, size_t N, size_t K, Kernel::Activation act)
+{
+    const size_t lda = (K + 3) / 4 * 4 + 3; // wider than needed: rows need not be packed tightly
+    std::vector<uint8_t> A(M * lda);
+    std::vector<int8_t> W(N * K);
+    std::vector<float> scale(N), bias(N);
+    std::vector<int32_t> offset(N);
+    for (size_t i = 0; i < A.size(); i++)
+        A[i] = static_cast<uint8_t>((i * 37 + 11) % 256);
+    for (size_t i = 0; i < W.size(); i++)
+        W[i] = static_cast<int8_t>(int(i * 53 + 7) % 255 - 127);
+    for (size_t n = 0; n < N; n++)
+    {
+        scale[n] = 1e-5f * float(1 + n % 5);
+        offset[n] = -int32_t(n % 9) * 1000;
+        bias[n] = 0.1f * float(n % 3) - 0.1f;
+    }
+
+    Kernel::PackedInt8 packed = Kernel::pack_int8(N, K, W.data(), K);
+    Kernel::Requantize raw{scale.data(), offset.data(), nullptr, Kernel::Activation::None};
+    Kernel::Requantize rq{scale.data(), offset.data(), bias.data(), act, 0.01f, 37};
+    std::vector<float> C(M * N);
+    std::vector<uint8_t> Q(M * N);
+    Kernel::qgemm(M, A.data(), lda, packed, raw, C.data(), N);
+    Kernel::qgemm(M, A.data(), lda, packed, rq, Q.data(), N);
+
+    int err = 0;
+    for (size_t i = 0; i < M; i++)
+        for (size_t n = 0; n < N; n++)
+        {
+            int32_t acc = offset[n];
+            for (size_t k = 0; k < K; k++)
+                acc += int32_t(A[i * lda + k]) * int32_t(W[n * K + k]);
+            if (C[i * N + n] != scale[n] * float(acc))
+                err = std::max(err, 1000);
+            const float y = Kernel::activate(act, scale[n] * float(acc) + bias[n]);
+            const int q = int(std::lround(std::min(std::max(y / 0.01f + 37.0f, 0.0f), 255.0f)));
+            err = std::max(err, std::abs(q - int(Q[i * N + n])));
+        }
+    return err;
+}
+
+std::shared_ptr<Module::Sequential<float>> make_model(bool fuse, Kernel::Activation last)
+{
+    auto model = std::make_shared<Module::Sequential<float>>(fuse);
+    model->add(std::make_shared<LayerModule::Dense<float>>(64, 96));
+    model->add(std::make_shared<ActivationModule::ReLU<float>>());
+    model->add(std::make_shared<LayerModule::Dense<float>>(96, 48));
+    model->add(std::make_shared<ActivationModule::ReLU<float>>());
+    model->add(std::make_shared<LayerModule::Dense<float>>(48, 10, last));
+    return model;
+}
+
+Tensor<float> make_batch(size_t batch, int seed)
+{
+    std::vector<float> v(batch * 64);
+    for (size_t i = 0; i < v.size(); i++)
+        v[i] = std::sin(0.37f * float(i) + float(seed)) * (1.0f + 0.5f * std::cos(0.011f * float(i)));
+    return Tensor<float>(v, Shape{batch, 64});
+}
+
+int main()
+{
+    bool ok = true;
+
+    // ---------- Kernel: every path, ragged shapes ----------
+    const size_t shapes[][3] = {{1, 1, 1}, {1, 300, 70}, {7, 37, 129}, {33, 64, 256}, {13, 17, 0}};
+    for (auto isa : {Kernel::Isa::Scalar, Kernel::Isa::Avx2, Kernel::Isa::Avx512, Kernel::Isa::Neon})
+    {
+        if (!Kernel::isa_supported(isa))
+            continue;
+        Kernel::set_active_isa(isa);
+        int err = 0;
+        for (auto &s : shapes)
+            for (auto act : {Kernel::Activation::None, Kernel::Activation::ReLU, Kernel::Activation::Sigmoid})
+                err = std::max(err, qgemm_error(s[0], s[1], s[2], act));
+        std::cout << Kernel::isa_name(isa) << (isa == Kernel::Isa::Avx512 && Kernel::has_avx512_vnni() ? " (vnni)" : "")
+                  << ": qgemm max error " << err << " steps\n";
+        ok = ok && err <= 1;
+    }
+    Kernel::set_active_isa(Kernel::detected_isa());
+
+    // ---------- Post-training quantization tracks the float model ----------
+    std::vector<Tensor<float>> calibration;
+    for (int b = 0; b < 4; b++)
+        calibration.push_back(make_batch(32, b));
+    const Tensor<float> test = make_batch(16, 17);
+
+    for (bool fuse : {true, false})
+        for (auto last : {Kernel::Activation::None, Kernel::Activation::Sigmoid})
+        {
+            auto model = make_model(fuse, last);
+            auto qmodel = QuantizationModule::quantize(*model, calibration);
+            NoGradGuard no_grad;
+            Tensor<float> expected = model->forward(test), actual = qmodel->forward(test);
+            float err = 0, range = 0;
+            for (size_t i = 0; i < expected.size(); i++)
+            {
+                err = std::max(err, std::abs(expected[i] - actual[i]));
+                range = std::max(range, std::abs(expected[i]));
+            }
+            std::cout << qmodel->info(std::cout) << (fuse ? " from fused" : " from unfused") << " model: max error "
+                      << err << " (outputs up to " << range << ")\n";
+            ok = ok && actual.shape() == expected.shape() && err < 0.02f * range && qmodel->num_layers() == 3 &&
+                 qmodel->num_params() == model->num_params();
+
+            // One sample at a time gives the same answer as the batch.
+            const std::vector<float> values = test.get_data();
+            Tensor<float> one(std::vector<float>(values.begin() + 64, values.begin() + 128), Shape{64});
+            Tensor<float> single = qmodel->forward(one);
+            ok = ok && single.shape() == Shape{10};
+            for (size_t i = 0; i < 10; i++)
+                ok = ok && single[i] == actual[10 + i];
+        }
+
+    // ---------- Calibration ranges and memory ----------
+    auto model = make_model(true, Kernel::Activation::None);
+    QuantizationModule::Calibrator<float> calibrator(*model);
+    for (auto &batch : calibration)
+        calibrator.observe(batch);
+    auto qmodel = calibrator.quantize();
+    // Hidden layers read ReLU outputs: non-negative, so zero point 0.
+    ok = ok && calibrator.batches() == 4 && qmodel->input_params(1).zero_point == 0 && qmodel->input_params(0).zero_point > 0;
+    const size_t float_bytes = model->num_params() * sizeof(float);
+    std::cout << "weights: " << float_bytes << " bytes fp32, " << qmodel->weight_bytes() << " bytes int8\n";
+    ok = ok && qmodel->weight_bytes() * 3 < float_bytes;
+
+    // ---------- Errors ----------
+    auto throws = [](auto fn)
+    {
+        try
+        {
+            fn();
+        }
+        catch (const std::logic_error &) // std::invalid_argument included
+        {
+            return true;
+        }
+        return false;
+    };
+    ok = ok && throws([&]
+                      { QuantizationModule::Calibrator<float>(*model).quantize(); });
+    ok = ok && throws([&]
+                      { qmodel->forward(Tensor<float>(std::vector<float>(128), Shape{4, 32})); });
+    ok = ok && throws([&]
+                      { qmodel->backward(test); });
+    auto unsupported = std::make_shared<Module::Sequential<float>>();
+    unsupported->add(std::make_shared<ActivationModule::ReLU<float>>());
+    unsupported->add(std::make_shared<LayerModule::Dense<float>>(4, 4));
+    ok = ok && throws([&]
+                      { QuantizationModule::Calibrator<float> c(*unsupported); });
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,268 @@
+#include <NovaML/Core/Tensor/tensor.hpp>
+#include <NovaML/Core/Tensor/tensor_math.hpp>
+#include <NovaML/Core/Tensor/graph.hpp>
+#include <NovaML/Core/Kernel/vmath.hpp>
+#include <NovaML/Parallel/thread_pool.hpp>
+#include <cmath>
+#include <functional>
+#include <iostream>
+
+using namespace NovaML::Core;
+
+using TensorPtr = std::shared_ptr<Tensor<double>>;
+using Reducer = std::function<double(const std::vector<double> &)>;
+
+TensorPtr make(const Shape &shape, double phase, bool requires_grad = false)
+{
+    std::vector<double> v(numel(shape));
+    for (size_t i = 0; i < v.size(); i++)
+        v[i] = std::sin(1.3 * double(i) + phase) * 2.0;
+    return std::make_shared<Tensor<double>>(v, shape, requires_grad);
+}
+
+// Reference: gather every slice through at() with a brute-force index walk.
+std::vector<double> naive(const TensorPtr &a, const std::vector<size_t> &dims, const Reducer &f)
+{
+    const Shape &shape = a->shape();
+    std::vector<bool> reduced(shape.size(), false);
+    for (size_t d : dims)
+        reduced[d] = true;
+    Shape out_shape;
+    for (size_t d = 0; d < shape.size(); d++)
+        out_shape.push_back(reduced[d] ? 1 : shape[d]);
+    std::vector<std::vector<double>> slices(numel(out_shape));
+    for (size_t i = 0; i < a->size(); i++)
+    {
+        size_t rem = i, o = 0, scale = 1;
+        for (size_t d = shape.size(); d-- > 0;)
+        {
+            const size_t idx = rem % shape[d];
+            rem /= shape[d];
+            if (!reduced[d])
+                o += idx * scale;
+            scale *= out_shape[d];
+        }
+        slices[o].push_back(a->at(i));
+    }
+    std::vector<double> out;
+    for (const auto &s : slices)
+        out.push_back(f(s));
+    return out;
+}
+
+bool close(const std::vector<double> &a, const std::vector<double> &b, double tol = 1e-10)
+{
+    if (a.size() != b.size())
+        return false;
+    for (size_t i = 0; i < a.size(); i++)
+        if (!(std::abs(a[i] - b[i]) <= tol * (1.0 + std::abs(b[i]))))
+            return false;
+    return true;
+}
+
+double ref_sum(const std::vector<double> &s)
+{
+    double t = 0;
+    for (double x : s)
+        t += x;
+    return t;
+}
+double ref_mean(const std::vector<double> &s) { return ref_sum(s) / double(s.size()); }
+double ref_var(const std::vector<double> &s)
+{
+    double m = ref_mean(s), t = 0;
+    for (double x : s)
+        t += (x - m) * (x - m);
+    return t / double(s.size() - 1);
+}
+double ref_max(const std::vector<double> &s) { return *std::max_element(s.begin(), s.end()); }
+double ref_min(const std::vector<double> &s) { return *std::min_element(s.begin(), s.end()); }
+double ref_lse(const std::vector<double> &s)
+{
+    double t = 0;
+    for (double x : s)
+        t += std::exp(x);
+    return std::log(t);
+}
+double ref_norm(const std::vector<double> &s)
+{
+    double t = 0;
+    for (double x : s)
+        t += x * x;
+    return std::sqrt(t);
+}
+
+// Central differences of sum(op(a) * weights) against the autograd gradient.
+bool gradcheck(const TensorPtr &a, const std::function<TensorPtr(const TensorPtr &)> &op)
+{
+    auto out = op(a);
+    auto weights = make(out->shape(), 0.4);
+    auto loss = sum(out * weights);
+    a->zero_grad();
+    loss->backward();
+    const Buffer<double> &grad = a->get_grad();
+    const double h = 1e-6;
+    for (size_t i = 0; i < a->size(); i++)
+    {
+        NoGradGuard no_grad;
+        double *p = a->data_ptr() + i;
+        const double x = *p;
+        *p = x + h;
+        const double up = sum(op(a) * weights)->at(0);
+        *p = x - h;
+        const double down = sum(op(a) * weights)->at(0);
+        *p = x;
+        if (std::abs((up - down) / (2 * h) - grad[i]) > 1e-5)
+            return false;
+    }
+    return true;
+}
+
+int main()
+{
+    bool ok = true;
+    // Tolerances below assume the Exact tier for exp / log, whatever NOVAML_MATH says.
+    const Kernel::MathAccuracy tier = Kernel::math_accuracy();
+    Kernel::set_math_accuracy(Kernel::MathAccuracy::Exact);
+
+    // ---------- Values and shapes along every combination of dimensions ----------
+    {
+        auto a = make({3, 4, 5}, 0.0);
+        auto strided = transpose(a, 0, 2); // [5, 4, 3], not contiguous
+        const std::vector<std::pair<std::vector<long>, std::vector<size_t>>> cases = {
+            {{0}, {0}}, {{1}, {1}}, {{2}, {2}}, {{-1}, {2}}, {{0, 2}, {0, 2}}, {{0, 1}, {0, 1}}, {{}, {0, 1, 2}}};
+        bool values = true;
+        for (const auto &input : {a, strided})
+            for (const auto &[dims, idx] : cases)
+            {
+                values = values && close(sum(input, dims)->get_data(), naive(input, idx, ref_sum));
+                values = values && close(mean(input, dims)->get_data(), naive(input, idx, ref_mean));
+                values = values && close(var(input, dims)->get_data(), naive(input, idx, ref_var));
+                values = values && close(max(input, dims)->get_data(), naive(input, idx, ref_max));
+                values = values && close(min(input, dims)->get_data(), naive(input, idx, ref_min));
+                values = values && close(logsumexp(input, dims)->get_data(), naive(input, idx, ref_lse));
+                values = values && close(norm(input, dims)->get_data(), naive(input, idx, ref_norm));
+            }
+        values = values && sum(a, {1})->shape() == Shape{3, 5} && sum(a, {1}, true)->shape() == Shape{3, 1, 5} &&
+                 mean(a, {0, 2}, true)->shape() == Shape{1, 4, 1} && max(a, std::vector<long>{})->shape() == Shape{1};
+        auto sd = stddev(a, {2});
+        auto vr = var(a, {2});
+        for (size_t i = 0; i < sd->size(); i++)
+            values = values && std::abs(sd->at(i) * sd->at(i) - vr->at(i)) < 1e-12;
+        values = values && std::abs(var(a, {}, 0)->at(0) * 60.0 / 59.0 - var(a, {})->at(0)) < 1e-12;
+        std::cout << "values: " << (values ? "ok" : "FAILED") << "\n";
+        ok = ok && values;
+
+        // argmax / argmin return positions along the dimension
+        auto t = std::make_shared<Tensor<double>>(std::vector<double>{1, 5, 3, 9, 2, 9}, Shape{2, 3});
+        ok = ok && argmax(t, 1)->get_data() == std::vector<double>{1, 0} && argmin(t, 1)->get_data() == std::vector<double>{0, 1} &&
+             argmax(t, 0)->get_data() == std::vector<double>{1, 0, 1} && argmax(t, 1, true)->shape() == Shape{2, 1};
+
+        bool threw = false;
+        try
+        {
+            sum(a, {3});
+        }
+        catch (const std::out_of_range &)
+        {
+            threw = true;
+        }
+        ok = ok && threw;
+    }
+
+    // ---------- Gradients ----------
+    {
+        bool grads = true;
+        for (std::vector<long> dims : {std::vector<long>{1}, std::vector<long>{0}, std::vector<long>{0, 2}})
+        {
+            auto a = make({3, 4, 5}, 0.5, true);
+            grads = grads && gradcheck(a, [&](const TensorPtr &x) { return sum(x, dims); });
+            grads = grads && gradcheck(a, [&](const TensorPtr &x) { return mean(x, dims, true); });
+            grads = grads && gradcheck(a, [&](const TensorPtr &x) { return var(x, dims); });
+            grads = grads && gradcheck(a, [&](const TensorPtr &x) { return stddev(x, dims); });
+            grads = grads && gradcheck(a, [&](const TensorPtr &x) { return max(x, dims); });
+            grads = grads && gradcheck(a, [&](const TensorPtr &x) { return min(x, dims); });
+            grads = grads && gradcheck(a, [&](const TensorPtr &x) { return logsumexp(x, dims); });
+            grads = grads && gradcheck(a, [&](const TensorPtr &x) { return norm(x, dims); });
+            grads = grads && gradcheck(a, [&](const TensorPtr &x) { return norm(x, dims, 1.0); });
+            grads = grads && gradcheck(a, [&](const TensorPtr &x) { return norm(x, dims, 3.0); });
+            // Through a strided view: gradients land at the right dense indices
+            grads = grads && gradcheck(a, [&](const TensorPtr &x) { return var(transpose(x, 0, 2), dims); });
+        }
+        // The graph records which extreme was taken
+        auto g = make({3, 4}, 0.5, true);
+        grads = grads && max(g, {1})->get_edges().front().op == OperatorType::Max &&
+                min(g, {1})->get_edges().front().op == OperatorType::Min;
+        std::cout << "gradients: " << (grads ? "ok" : "FAILED") << "\n";
+        ok = ok && grads;
+    }
+
+    // ---------- float precision: pairwise rows and Kahan columns vs a double reference ----------
+    {
+        const size_t rows = 4, cols = 1 << 20;
+        std::vector<float> v(rows * cols);
+        for (size_t i = 0; i < v.size(); i++)
+            v[i] = 0.1f + 1e-3f * float(i % 7);
+        auto a = std::make_shared<Tensor<float>>(v, Shape{rows, cols});
+        double exact = 0;
+        for (size_t j = 0; j < cols; j++)
+            exact += double(v[j]);
+        const double row_error = std::abs(double(sum(a, {1})->at(0)) - exact) / exact;
+        const double col_error = std::abs(double(sum(transpose(a, 0, 1), {0})->at(0)) - exact) / exact;
+        auto tall = std::make_shared<Tensor<float>>(v, Shape{cols, rows}); // column plan
+        double exact_col = 0;
+        for (size_t r = 0; r < cols; r++)
+            exact_col += double(v[r * rows]);
+        const double kahan_error = std::abs(double(sum(tall, {0})->at(0)) - exact_col) / exact_col;
+        const bool precise = row_error < 1e-6 && col_error < 1e-6 && kahan_error < 1e-6;
+        std::cout << "float sums: rows " << row_error << ", strided " << col_error << ", columns " << kahan_error
+                  << (precise ? " ok" : " FAILED") << "\n";
+        ok = ok && precise;
+    }
+
+    // ---------- Graph capture replays the reductions ----------
+    {
+        auto x = make({6, 8}, 0.0);
+        auto w = make({1, 8}, 1.0, true);
+        auto w_ref = std::make_shared<Tensor<double>>(w->get_data(), w->shape(), true);
+        auto step = [&](const TensorPtr &weights)
+        {
+            auto z = x * weights;
+            return mean(logsumexp(z, {1}) + var(z, {1}) + max(z, {1})) + sum(stddev(z, {0})) + sum(norm(z, {0}));
+        };
+        auto graph = Graph<double>::capture([&] { return step(w); });
+        {
+            NoGradGuard no_grad;
+            copy_(x, make({6, 8}, 2.0));
+        }
+        w->zero_grad();
+        graph.replay();
+        auto loss = step(w_ref);
+        loss->backward();
+        const bool replayed = std::abs(graph.output()->at(0) - loss->at(0)) < 1e-12 &&
+                              close(std::vector<double>(w->get_grad().begin(), w->get_grad().end()),
+                                    std::vector<double>(w_ref->get_grad().begin(), w_ref->get_grad().end()), 1e-12);
+        std::cout << "replay: " << (replayed ? "ok" : "FAILED") << "\n";
+        ok = ok && replayed;
+    }
+
+    // ---------- Wide slices: vexp inside a slice task runs its own parallel_for ----------
+    {
+        auto a = make({4, 1 << 20}, 0.5);
+        bool same = true;
+        for (std::vector<long> dims : {std::vector<long>{0}, std::vector<long>{1}})
+        {
+            NovaML::Parallel::set_num_threads(4);
+            const auto multi = logsumexp(a, dims)->get_data();
+            NovaML::Parallel::set_num_threads(1);
+            const auto single = logsumexp(a, dims)->get_data();
+            same = same && multi == single;
+        }
+        NovaML::Parallel::set_num_threads(0);
+        std::cout << "logsumexp deterministic across thread counts: " << (same ? "yes" : "NO") << "\n";
+        ok = ok && same;
+    }
+
+    Kernel::set_math_accuracy(tier);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,52 @@
+#include <NovaML/Core/Module/sequential.hpp>
+#include <NovaML/Core/Layer/dense.hpp>
+#include <NovaML/Core/Activation/relu.hpp>
+#include <NovaML/Core/Activation/sigmoid.hpp>
+#include <NovaML/Core/Loss/mse.hpp>
+#include <iostream>
+#include <cmath>
+
+using namespace NovaML::Core;
+
+int main()
+{
+    Module::Sequential<double> model;
+    model.add(std::make_shared<LayerModule::Dense<double>>(2, 8));
+    model.add(std::make_shared<ActivationModule::ReLU<double>>());
+    model.add(std::make_shared<LayerModule::Dense<double>>(8, 1));
+    model.add(std::make_shared<ActivationModule::Sigmoid<double>>());
+    LossModule::MSELoss<double> criterion;
+
+    // XOR as one [4, 2] mini-batch
+    Tensor<double> x(std::vector<double>{0, 0, 0, 1, 1, 0, 1, 1}, Shape{4, 2});
+    Tensor<double> y(std::vector<double>{0, 1, 1, 0}, Shape{4, 1});
+
+    // ---------- Batched forward matches per-sample forward ----------
+    Tensor<double> batch_out = model.forward(x);
+    double max_diff = 0;
+    for (size_t b = 0; b < 4; b++)
+    {
+        Tensor<double> sample(std::vector<double>{x[2 * b], x[2 * b + 1]});
+        max_diff = std::max(max_diff, std::abs(model.forward(sample)[0] - batch_out[b]));
+    }
+    std::cout << "batched vs per-sample max diff: " << max_diff << "\n";
+
+    // ---------- Mini-batch training ----------
+    double first_loss = 0, loss = 0;
+    for (int epoch = 0; epoch < 3000; epoch++)
+    {
+        Tensor<double> pred = model.forward(x);
+        loss = criterion.forward(pred, y);
+        if (epoch == 0)
+            first_loss = loss;
+        model.backward(criterion.backward());
+        model.update(0.5);
+        if (epoch % 1000 == 0)
+            std::cout << "epoch " << epoch << " loss " << loss << "\n";
+    }
+    Tensor<double> pred = model.forward(x);
+    std::cout << "final loss " << loss << ", predictions " << vector_to_string(pred.get_data())
+              << ", shape " << shape_to_string(pred.shape()) << "\n";
+
+    return max_diff < 1e-12 && loss < first_loss / 4 ? 0 : 1;
+}
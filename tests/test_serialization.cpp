@@ -0,0 +1,319 @@
+#include <NovaML/Core/Serialization/checkpoint.hpp>
+#include <NovaML/Core/Module/sequential.hpp>
+#include <NovaML/Core/Layer/dense.hpp>
+#include <NovaML/Core/Layer/conv2d.hpp>
+#include <NovaML/Core/Layer/normalization.hpp>
+#include <NovaML/Core/Layer/pool2d.hpp>
+#include <NovaML/Core/Layer/flatten.hpp>
+#include <NovaML/Core/Activation/relu.hpp>
+#include <NovaML/Core/Activation/gelu.hpp>
+#include <NovaML/Core/Activation/sigmoid.hpp>
+#include <NovaML/Core/Loss/mse.hpp>
+#include <NovaML/Core/Optimizer/sgd.hpp>
+#include <NovaML/Memory/allocator.hpp>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+using namespace NovaML::Core;
+namespace Memory = NovaML::Memory;
+
+// Nested containers, fused and unfused activations, a Dense with its own activation.
+template <typename T>
+std::shared_ptr<Module::Sequential<T>> make_model(bool fuse)
+{
+    auto block = std::make_shared<Module::Sequential<T>>(fuse);
+    block->add(std::make_shared<LayerModule::Dense<T>>(128, 256));
+    block->add(std::make_shared<ActivationModule::GELU<T>>());
+    block->add(std::make_shared<LayerModule::Dense<T>>(256, 64, Kernel::Activation::ReLU));
+    auto model = std::make_shared<Module::Sequential<T>>(fuse);
+    model->add(std::make_shared<LayerModule::Dense<T>>(32, 128));
+    model->add(std::make_shared<ActivationModule::ReLU<T>>());
+    model->add(block);
+    model->add(std::make_shared<LayerModule::Dense<T>>(64, 3));
+    model->add(std::make_shared<ActivationModule::Sigmoid<T>>());
+    // Different weights per layer than a fresh model would get.
+    auto flat = Module::flatten_parameters(*model);
+    for (size_t i = 0; i < flat->size(); i++)
+        flat->data[i] += T(0.01f * std::sin(0.3f * float(i)));
+    return model;
+}
+
+template <typename T>
+Tensor<T> make_input()
+{
+    std::vector<T> v(8 * 32);
+    for (size_t i = 0; i < v.size(); i++)
+        v[i] = T(std::cos(0.17f * float(i)));
+    return Tensor<T>(v, Shape{8, 32});
+}
+
+template <typename T>
+bool same_outputs(const Tensor<T> &a, const Tensor<T> &b)
+{
+    if (a.shape() != b.shape())
+        return false;
+    for (size_t i = 0; i < a.size(); i++)
+        if (float(a[i]) != float(b[i]))
+            return false;
+    return true;
+}
+
+template <typename T>
+bool round_trip(bool fuse, const std::string &path)
+{
+    auto model = make_model<T>(fuse);
+    SerializationModule::save(*model, path);
+    auto loaded = SerializationModule::load<T>(path);
+    NoGradGuard no_grad;
+    const Tensor<T> x = make_input<T>();
+    std::ostringstream a, b;
+    const bool ok = same_outputs(model->forward(x), loaded->forward(x)) && loaded->num_params() == model->num_params() &&
+                    loaded->info(a) == model->info(b) && a.str() == b.str();
+    std::cout << "round trip " << (fuse ? "fused" : "unfused") << " (" << sizeof(T) << "-byte elements): "
+              << (ok ? "ok" : "FAILED") << "\n";
+    return ok;
+}
+
+// Conv / BatchNorm / pooling image model, trained a few steps so the running statistics have moved.
+std::shared_ptr<Module::Sequential<float>> make_cnn(LayerModule::DataFormat format, const Tensor<float> &x)
+{
+    using namespace LayerModule;
+    auto model = std::make_shared<Module::Sequential<float>>();
+    model->add(std::make_shared<Conv2D<float>>(3, 8, 3, Conv2DOptions{1, 1, format}));
+    model->add(std::make_shared<BatchNorm<float>>(8, format, 0.2f));
+    model->add(std::make_shared<ActivationModule::ReLU<float>>());
+    model->add(std::make_shared<MaxPool2D<float>>(2, Pool2DOptions{0, 0, format}));
+    model->add(std::make_shared<Conv2D<float>>(8, 4, 1, Conv2DOptions{1, 0, format, Kernel::Activation::GELU}));
+    model->add(std::make_shared<AvgPool2D<float>>(3, Pool2DOptions{1, 1, format}));
+    model->add(std::make_shared<Flatten<float>>());
+    model->add(std::make_shared<LayerNorm<float>>(4 * 4 * 4, 1e-3f));
+    model->add(std::make_shared<Dense<float>>(4 * 4 * 4, 5));
+    for (int step = 0; step < 3; step++)
+    {
+        const auto y = model->forward(x);
+        model->backward(Tensor<float>(std::vector<float>(y.size(), 0.1f), y.shape()));
+        model->update(0.05f);
+    }
+    return model;
+}
+
+bool cnn_round_trip(LayerModule::DataFormat format, bool fold, const std::string &path)
+{
+    const bool nchw = format == LayerModule::DataFormat::NCHW;
+    const Shape shape = nchw ? Shape{4, 3, 8, 8} : Shape{4, 8, 8, 3};
+    std::vector<float> v(4 * 3 * 8 * 8);
+    for (size_t i = 0; i < v.size(); i++)
+        v[i] = 2.0f * std::sin(0.37f * float(i)) + 0.5f;
+    const Tensor<float> x(v, shape);
+
+    auto model = make_cnn(format, x);
+    if (fold && model->fold_batch_norm() != 1)
+        return false;
+    SerializationModule::save(*model, path);
+    auto loaded = SerializationModule::load<float>(path);
+    bool ok = same_outputs(model->infer(x), loaded->infer(x));
+    if (!fold)
+    {
+        std::ostringstream a, b;
+        ok = ok && loaded->info(a) == model->info(b) && a.str() == b.str();
+        // Running statistics come back with the weights.
+        auto &bn = dynamic_cast<LayerModule::BatchNorm<float> &>(*dynamic_cast<Module::Sequential<float> &>(*loaded).at(1));
+        auto &original = dynamic_cast<LayerModule::BatchNorm<float> &>(*model->at(1));
+        ok = ok && bn.running_mean() == original.running_mean() && bn.running_var() == original.running_var() &&
+             bn.running_mean() != std::vector<float>(8, 0.0f) && bn.get_momentum() == 0.2f;
+    }
+    else // the folded BatchNorm is not stored
+        ok = ok && dynamic_cast<Module::Sequential<float> &>(*loaded).size() == model->size() - 1;
+    std::cout << "CNN round trip " << data_format_name(format) << (fold ? ", batch norm folded" : "") << ": "
+              << (ok ? "ok" : "FAILED") << "\n";
+    return ok;
+}
+
+// Rewrite a Dense model's checkpoint in the version-1 layout (32-byte records) and load it.
+bool v1_round_trip(const std::string &path)
+{
+    using namespace SerializationModule;
+    auto model = make_model<float>(true);
+    save(*model, path);
+    std::ifstream in(path, std::ios::binary);
+    std::vector<char> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    in.close();
+
+    CheckpointHeader header;
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    std::vector<char> v1(header.data_offset, 0);
+    for (size_t i = 0; i < header.record_count; i++)
+    {
+        ModuleRecord r;
+        std::memcpy(&r, bytes.data() + sizeof(header) + i * sizeof(r), sizeof(r));
+        const struct
+        {
+            uint32_t kind, flags;
+            uint64_t a, b, offset;
+        } old{r.kind, r.flags, r.a, r.b, r.offset};
+        std::memcpy(v1.data() + sizeof(header) + i * sizeof(old), &old, sizeof(old));
+    }
+    header.version = 1;
+    header.state_elements = 0;
+    std::memcpy(v1.data(), &header, sizeof(header));
+    v1.insert(v1.end(), bytes.begin() + std::ptrdiff_t(header.data_offset), bytes.end());
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(v1.data(), std::streamsize(v1.size()));
+    }
+
+    auto loaded = load<float>(path);
+    NoGradGuard no_grad;
+    const Tensor<float> x = make_input<float>();
+    const bool ok = same_outputs(model->forward(x), loaded->forward(x));
+    std::cout << "version 1 checkpoint: " << (ok ? "ok" : "FAILED") << "\n";
+    return ok;
+}
+
+template <typename T>
+bool load_throws(const std::string &path)
+{
+    try
+    {
+        SerializationModule::load<T>(path);
+    }
+    catch (const std::runtime_error &err)
+    {
+        std::cout << err.what() << "\n";
+        return true;
+    }
+    return false;
+}
+
+int main()
+{
+    bool ok = true;
+    const std::string path = "test_serialization.novaml";
+
+    // ---------- Outputs and structure survive save / load ----------
+    for (bool fuse : {true, false})
+        ok = round_trip<float>(fuse, path) && round_trip<double>(fuse, path) && round_trip<bfloat16>(fuse, path) && ok;
+
+    // ---------- Image layers, BatchNorm running statistics, folded models ----------
+    for (auto format : {LayerModule::DataFormat::NCHW, LayerModule::DataFormat::NHWC})
+        for (bool fold : {false, true})
+            ok = cnn_round_trip(format, fold, path) && ok;
+
+    // ---------- Version-1 files still load ----------
+    ok = v1_round_trip(path) && ok;
+
+    // ---------- Loading maps the parameters: no copy, no per-weight allocation ----------
+    auto model = make_model<float>(true);
+    SerializationModule::save(*model, path);
+    Memory::reset_stats();
+    const size_t before = Memory::get_stats().bytes_in_use;
+    auto loaded = SerializationModule::load<float>(path);
+    const size_t allocated = Memory::get_stats().bytes_in_use - before;
+    std::cout << "load allocated " << allocated << " bytes for " << model->parameter_size() * sizeof(float)
+              << " bytes of parameters\n";
+    ok = ok && allocated < 4096;
+
+    // ---------- Training the loaded model works and never writes the file ----------
+    const Tensor<float> x = make_input<float>();
+    Tensor<float> reference = model->forward(x);
+    OptimizerModule::SGD<float> sgd(*loaded, 0.5f);
+    LossModule::MSELoss<float> criterion;
+    criterion.forward(loaded->forward(x), Tensor<float>::zeros({8, 3}));
+    loaded->backward(criterion.backward());
+    sgd.step();
+    ok = ok && !same_outputs(loaded->forward(x), reference);
+    ok = ok && same_outputs(SerializationModule::load<float>(path)->forward(x), reference);
+
+    // ---------- Malformed files ----------
+    ok = ok && load_throws<double>(path); // another element type
+    {
+        std::ifstream in(path, std::ios::binary);
+        std::vector<char> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        auto write = [&](const std::vector<char> &content)
+        {
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            out.write(content.data(), std::streamsize(content.size()));
+        };
+        write(std::vector<char>(bytes.begin(), bytes.end() - 4)); // truncated
+        ok = ok && load_throws<float>(path);
+        auto bad_version = bytes;
+        bad_version[8] = 99;
+        write(bad_version);
+        ok = ok && load_throws<float>(path);
+        auto bad_magic = bytes;
+        bad_magic[0] = 'X';
+        write(bad_magic);
+        ok = ok && load_throws<float>(path);
+
+        // Record 1 is the first Dense: sizes whose product wraps, and an offset whose block end wraps.
+        using SerializationModule::ModuleRecord;
+        auto patch_dense = [&](std::initializer_list<std::pair<size_t, uint64_t>> fields)
+        {
+            auto patched = bytes;
+            for (auto [field, value] : fields)
+                std::memcpy(patched.data() + sizeof(SerializationModule::CheckpointHeader) + sizeof(ModuleRecord) + field,
+                            &value, sizeof(value));
+            return patched;
+        };
+        const uint64_t wraps = (uint64_t(1) << 32) + 1;
+        write(patch_dense({{offsetof(ModuleRecord, a), wraps}, {offsetof(ModuleRecord, b), wraps}}));
+        ok = ok && load_throws<float>(path);
+        write(patch_dense({{offsetof(ModuleRecord, offset), ~uint64_t(0) - 15}}));
+        ok = ok && load_throws<float>(path);
+
+        // A record table that runs into the parameter data.
+        using SerializationModule::CheckpointHeader;
+        CheckpointHeader header;
+        std::memcpy(&header, bytes.data(), sizeof(header));
+        auto overlapping = bytes;
+        const uint64_t records = (header.data_offset - sizeof(header)) / sizeof(ModuleRecord) + 1;
+        std::memcpy(overlapping.data() + offsetof(CheckpointHeader, record_count), &records, sizeof(records));
+        write(overlapping);
+        ok = ok && load_throws<float>(path);
+
+        // Sequentials nested far deeper than any model, each with one child.
+        const size_t depth = 100000;
+        header.record_count = depth + 1;
+        header.data_offset = (sizeof(header) + (depth + 1) * sizeof(ModuleRecord) + 4095) / 4096 * 4096;
+        header.data_elements = 0;
+        header.state_elements = 0;
+        std::vector<char> nested(header.data_offset, 0);
+        std::memcpy(nested.data(), &header, sizeof(header));
+        for (size_t i = 0; i <= depth; i++)
+        {
+            ModuleRecord r{};
+            r.kind = uint32_t(i < depth ? SerializationModule::ModuleKind::Sequential : SerializationModule::ModuleKind::ReLU);
+            r.a = i < depth ? 1 : 0;
+            std::memcpy(nested.data() + sizeof(header) + i * sizeof(ModuleRecord), &r, sizeof(r));
+        }
+        write(nested);
+        ok = ok && load_throws<float>(path);
+    }
+    ok = ok && load_throws<float>("does/not/exist.novaml");
+
+    // ---------- Modules the format cannot describe ----------
+    struct Custom : Module::BaseModule<float>
+    {
+        std::string info(std::ostream &) const override { return "Custom"; }
+        Tensor<float> forward(const Tensor<float> &x) override { return x; }
+    };
+    Module::Sequential<float> unsupported;
+    unsupported.add(std::make_shared<Custom>());
+    bool threw = false;
+    try
+    {
+        SerializationModule::save(unsupported, path);
+    }
+    catch (const std::invalid_argument &)
+    {
+        threw = true;
+    }
+    ok = ok && threw;
+
+    std::remove(path.c_str());
+    return ok ? 0 : 1;
+}
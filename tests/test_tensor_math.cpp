@@ -1,5 +1,5 @@
-#include "NovaML/core/tensor/tensor.hpp"
-#include "NovaML/core/tensor/tensor_math.hpp"
+#include "NovaML/Core/Tensor/tensor.hpp"
+#include "NovaML/Core/Tensor/tensor_math.hpp"
 #include <iostream>
 
 using namespace NovaML::Core;
@@ -1,4 +1,4 @@
-#include <NovaML/core/tensor/tensor.hpp>
+#include <NovaML/Core/Tensor/tensor.hpp>
 #include <iostream>
 
 using namespace NovaML::Core;
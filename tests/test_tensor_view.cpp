@@ -0,0 +1,46 @@
+#include <NovaML/Core/Tensor/tensor.hpp>
+#include <NovaML/Core/Tensor/tensor_math.hpp>
+#include <iostream>
+
+using namespace NovaML::Core;
+
+int main()
+{
+    auto a = std::make_shared<Tensor<double>>(std::vector<double>{1, 2, 3, 4, 5, 6}, Shape{2, 3}, true);
+    std::cout << "a: " << *a << "\n\n";
+
+    // ---------- Reshape (zero-copy) ----------
+    auto r = reshape(a, {3, 2});
+    std::cout << "reshape(a, 3x2): " << *r << std::endl;
+    std::cout << "shares storage: " << (r->get_storage() == a->get_storage() ? "yes" : "no") << "\n\n";
+
+    // ---------- Transpose ----------
+    auto t = transpose(a, 0, 1);
+    std::cout << "transpose(a): " << *t << std::endl;
+    std::cout << "contiguous: " << (t->is_contiguous() ? "yes" : "no") << "\n\n";
+
+    // ---------- Slice ----------
+    auto s = slice(a, 1, 0, 3, 2); // columns 0 and 2
+    std::cout << "slice(a, dim=1, 0:3:2): " << *s << "\n\n";
+
+    // ---------- Squeeze / Unsqueeze ----------
+    auto u = unsqueeze(a, 0);
+    auto q = squeeze(u);
+    std::cout << "unsqueeze(a, 0): " << *u << std::endl;
+    std::cout << "squeeze(unsqueeze(a, 0)): " << *q << "\n\n";
+
+    // ---------- Gradients through views ----------
+    auto loss = sum(transpose(a, 0, 1) * reshape(a, {3, 2})) + sum(s * 2.0);
+    loss->backward();
+    std::cout << "loss: " << *loss << std::endl;
+    std::cout << "Gradients a: " << vector_to_string(a->get_grad()) << "\n\n"; // [4, 7, 9, 9, 7, 14]
+    bool ok = a->get_grad() == Buffer<double>{4, 7, 9, 9, 7, 14};
+
+    // ---------- Writes through a view are visible in the base ----------
+    auto row = slice(a, 0, 1, 2);
+    (*row)[0] = 40.0;
+    std::cout << "after row[0] = 40: " << vector_to_string(a->get_data()) << "\n";
+
+    ok = ok && a->at(3) == 40.0;
+    return ok ? 0 : 1;
+}
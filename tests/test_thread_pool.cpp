@@ -0,0 +1,136 @@
+#include <NovaML/Parallel/thread_pool.hpp>
+#include <NovaML/Core/Tensor/tensor.hpp>
+#include <NovaML/Core/Tensor/tensor_math.hpp>
+#include <NovaML/Core/Kernel/gemm.hpp>
+#include <atomic>
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace NovaML::Core;
+namespace Parallel = NovaML::Parallel;
+
+// Elementwise ops, a reduction and a GEMM evaluated at the current thread count.
+struct Snapshot
+{
+    std::vector<double> values;
+    double total;
+    Buffer<double> grad;
+    std::vector<float> product;
+};
+
+Snapshot compute()
+{
+    const size_t n = 200000;
+    std::vector<double> va(n), vb(n);
+    for (size_t i = 0; i < n; i++)
+    {
+        va[i] = std::sin(0.001 * static_cast<double>(i));
+        vb[i] = 0.5 + static_cast<double>(i % 13) * 0.1;
+    }
+    auto a = std::make_shared<Tensor<double>>(va, true);
+    auto b = std::make_shared<Tensor<double>>(vb, true);
+    auto y = exp(a * b - a);
+    auto s = sum(y);
+    s->backward();
+
+    const size_t M = 150, N = 130, K = 300;
+    std::vector<float> A(M * K), B(K * N), C(M * N);
+    for (size_t i = 0; i < A.size(); i++)
+        A[i] = static_cast<float>(i % 17) * 0.25f - 2.0f;
+    for (size_t i = 0; i < B.size(); i++)
+        B[i] = static_cast<float>(i % 11) * 0.5f - 2.5f;
+    Kernel::gemm(false, false, M, N, K, 1.0f, A.data(), K, B.data(), N, 0.0f, C.data(), N);
+
+    return {y->get_data(), (*s)[0], a->get_grad(), C};
+}
+
+int main()
+{
+    bool ok = true;
+
+    Parallel::set_num_threads(4);
+    std::cout << "threads=" << Parallel::get_num_threads() << "\n";
+    ok = ok && Parallel::get_num_threads() == 4;
+
+    // ---------- Every index visited exactly once ----------
+    std::vector<std::atomic<int>> hits(100003);
+    Parallel::parallel_for(0, hits.size(), 64, [&](size_t b, size_t e)
+                           {
+                               for (size_t i = b; i < e; i++)
+                                   hits[i]++; });
+    bool covered = true;
+    for (auto &h : hits)
+        covered = covered && h.load() == 1;
+    std::cout << "parallel_for coverage: " << (covered ? "ok" : "FAILED") << "\n";
+    ok = ok && covered;
+
+    // ---------- Nested parallel_for inside a task ----------
+    std::atomic<size_t> nested{0};
+    Parallel::parallel_for(0, 16, 1, [&](size_t b, size_t e)
+                           {
+                               for (size_t i = b; i < e; i++)
+                                   Parallel::parallel_for(0, 1000, 10, [&](size_t b2, size_t e2)
+                                                          { nested += e2 - b2; }); });
+    std::cout << "nested parallel_for: " << nested.load() << "\n";
+    ok = ok && nested.load() == 16000;
+
+    // ---------- Exceptions reach the caller ----------
+    bool caught = false;
+    try
+    {
+        Parallel::parallel_for(0, 1000, 1, [](size_t b, size_t e)
+                               {
+                                   if (b <= 500 && 500 < e)
+                                       throw std::runtime_error("chunk failed"); });
+    }
+    catch (const std::runtime_error &err)
+    {
+        caught = true;
+        std::cout << "exception propagated: " << err.what() << "\n";
+    }
+    ok = ok && caught;
+
+    // ---------- resize() is refused while another thread is inside parallel_for ----------
+    {
+        std::atomic<bool> started{false}, release{false};
+        std::thread runner([&]
+                           { Parallel::parallel_for(0, 64, 1, [&](size_t, size_t)
+                                                    {
+                                                        started = true;
+                                                        while (!release)
+                                                            std::this_thread::yield(); }); });
+        while (!started)
+            std::this_thread::yield();
+        bool refused = false;
+        try
+        {
+            Parallel::set_num_threads(2);
+        }
+        catch (const std::logic_error &err)
+        {
+            refused = true;
+            std::cout << "resize during a run: " << err.what() << "\n";
+        }
+        release = true;
+        runner.join();
+        Parallel::set_num_threads(2);
+        Parallel::set_num_threads(4);
+        ok = ok && refused && Parallel::get_num_threads() == 4;
+    }
+
+    // ---------- Same results for 1 and 4 threads ----------
+    Snapshot multi = compute();
+    Parallel::set_num_threads(1);
+    Snapshot single = compute();
+
+    bool same = multi.values == single.values && multi.total == single.total &&
+                multi.grad == single.grad && multi.product == single.product;
+    std::cout << "sum=" << multi.total << " deterministic across thread counts: "
+              << (same ? "yes" : "NO") << "\n";
+    ok = ok && same;
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,162 @@
+#include <NovaML/Core/Kernel/vmath.hpp>
+#include <NovaML/Core/Kernel/cpu_features.hpp>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+using namespace NovaML::Core;
+using namespace NovaML::Core::Kernel;
+
+// Distance to the reference in units of the last place of T at the reference.
+template <typename T>
+double ulps(T y, long double ref)
+{
+    if (std::isnan(ref) || std::isinf(ref))
+        return (std::isnan(ref) ? std::isnan(y) : y == T(ref)) ? 0.0 : 1e30;
+    const int exponent = std::max(std::ilogb(ref), std::numeric_limits<T>::min_exponent - 1);
+    const long double ulp = std::ldexp(1.0L, exponent - std::numeric_limits<T>::digits + 1);
+    return double(std::abs((long double)y - ref) / ulp);
+}
+
+template <typename T>
+double relative(T y, long double ref)
+{
+    if (std::isnan(ref) || std::isinf(ref) || ref == 0)
+        return ulps(y, ref) == 0.0 ? 0.0 : 1e30;
+    return double(std::abs((long double)y - ref) / std::abs(ref));
+}
+
+struct Error
+{
+    double ulp = 0, rel = 0;
+};
+
+template <typename T>
+Error measure(const std::vector<T> &x, const std::function<void(size_t, const T *, T *)> &kernel,
+              const std::function<long double(long double)> &reference)
+{
+    std::vector<T> y(x.size());
+    kernel(x.size(), x.data(), y.data());
+    Error err;
+    for (size_t i = 0; i < x.size(); i++)
+    {
+        const long double ref = (long double)T(reference((long double)x[i])); // correctly rounded to T
+        err.ulp = std::max(err.ulp, ulps(y[i], ref));
+        if (std::abs(ref) >= (long double)std::numeric_limits<T>::min())
+            err.rel = std::max(err.rel, relative(y[i], ref));
+    }
+    return err;
+}
+
+template <typename T>
+std::vector<T> linspace(T lo, T hi, size_t n)
+{
+    std::vector<T> v(n);
+    for (size_t i = 0; i < n; i++)
+        v[i] = lo + (hi - lo) * T(i) / T(n - 1);
+    return v;
+}
+
+template <typename T>
+bool check_type(const char *type)
+{
+    bool ok = true;
+    const bool is_float = std::is_same_v<T, float>;
+    const std::vector<T> exp_x = is_float ? linspace<T>(-103, 88.7, 100003) : linspace<T>(-744, 709.7, 100003);
+    std::vector<T> log_x;
+    for (T u : linspace<T>(T(is_float ? -148 : -1073), T(is_float ? 127 : 1023), 100003))
+        log_x.push_back(std::exp2(u));
+    for (T v : {T(1), T(0.75), T(1.25), T(2) / T(3)})
+        log_x.push_back(v);
+    const std::vector<T> tanh_x = linspace<T>(-12, 12, 100003);
+    const std::vector<T> sigmoid_x = linspace<T>(is_float ? -80 : -700, 40, 100003);
+
+    for (MathAccuracy accuracy : {MathAccuracy::Exact, MathAccuracy::Fast})
+    {
+        const bool exact = accuracy == MathAccuracy::Exact;
+        auto report = [&](const char *name, Error err, double max_ulp)
+        {
+            const bool pass = exact ? err.ulp <= max_ulp : err.rel <= 1e-4;
+            std::cout << "  " << type << " " << name << (exact ? " exact" : " fast") << ": " << err.ulp << " ulp, "
+                      << err.rel << " rel" << (pass ? " ok" : " FAILED") << "\n";
+            ok = ok && pass;
+        };
+        report("exp", measure<T>(exp_x, [&](size_t n, const T *x, T *y)
+                                 { vexp(n, x, y, accuracy); }, [](long double v)
+                                 { return std::exp(v); }),
+               1.0);
+        report("log", measure<T>(log_x, [&](size_t n, const T *x, T *y)
+                                 { vlog(n, x, y, accuracy); }, [](long double v)
+                                 { return std::log(v); }),
+               1.0);
+        report("tanh", measure<T>(tanh_x, [&](size_t n, const T *x, T *y)
+                                  { vtanh(n, x, y, accuracy); }, [](long double v)
+                                  { return std::tanh(v); }),
+               2.0);
+        report("sigmoid", measure<T>(sigmoid_x, [&](size_t n, const T *x, T *y)
+                                     { vsigmoid(n, x, y, accuracy); }, [](long double v)
+                                     { return 1.0L / (1.0L + std::exp(-v)); }),
+               2.0);
+        for (T e : {T(2.5), T(-1.7), T(0.5), T(3), T(-4), T(7)})
+        {
+            // Negative bases only where the power is real
+            const std::vector<T> base = linspace<T>(std::trunc(e) == e ? T(-6) : T(0), T(6), 10001);
+            report("pow", measure<T>(base, [&](size_t n, const T *x, T *y)
+                                     { vpow(n, x, e, y, accuracy); }, [e](long double v)
+                                     { return std::pow(v, (long double)e); }),
+                   2.0);
+        }
+    }
+
+    // Special values
+    const T inf = std::numeric_limits<T>::infinity(), nan = std::numeric_limits<T>::quiet_NaN();
+    std::vector<T> x = {inf, -inf, nan, T(0), T(-1), T(1e4), T(-1e4)}, y(x.size());
+    vexp(x.size(), x.data(), y.data());
+    ok = ok && y[0] == inf && y[1] == 0 && std::isnan(y[2]) && y[3] == 1 && y[5] == inf && y[6] == 0;
+    vlog(x.size(), x.data(), y.data());
+    ok = ok && y[0] == inf && std::isnan(y[1]) && std::isnan(y[2]) && y[3] == -inf && std::isnan(y[4]);
+    vtanh(x.size(), x.data(), y.data());
+    ok = ok && y[0] == 1 && y[1] == -1 && std::isnan(y[2]) && y[3] == 0 && y[5] == 1 && y[6] == -1;
+    vsigmoid(x.size(), x.data(), y.data());
+    ok = ok && y[0] == 1 && y[1] == 0 && std::isnan(y[2]) && y[3] == T(0.5);
+    vpow(x.size(), x.data(), T(0.5), y.data());
+    ok = ok && y[0] == inf && std::isnan(y[4]) && y[3] == 0;
+    return ok;
+}
+
+int main()
+{
+    bool ok = true;
+    // The calls without a tier below expect Exact, whatever NOVAML_MATH says.
+    const MathAccuracy tier = math_accuracy();
+    set_math_accuracy(MathAccuracy::Exact);
+    const Isa detected = detected_isa();
+    for (Isa isa : {Isa::Scalar, Isa::Avx2, Isa::Avx512})
+    {
+        if (!isa_supported(isa))
+            continue;
+        set_active_isa(isa);
+        std::cout << isa_name(isa) << "\n";
+        ok = check_type<float>("float") && ok;
+        ok = check_type<double>("double") && ok;
+    }
+    set_active_isa(detected);
+
+    // In place, and 16-bit types through the float kernels
+    std::vector<float> v = {0.0f, 1.0f, -2.0f};
+    vexp(v.size(), v.data(), v.data());
+    ok = ok && v[0] == 1.0f && std::abs(v[1] - std::exp(1.0f)) < 1e-6f;
+    std::vector<bfloat16> h = {bfloat16(0.0f), bfloat16(1.0f)};
+    vexp(h.size(), h.data(), h.data());
+    ok = ok && float(h[0]) == 1.0f && std::abs(float(h[1]) - 2.71828f) < 0.02f;
+
+    // Domain check of log
+    std::vector<double> positive = {1.0, 2.0, std::nan("")}, negative = {1.0, 0.0};
+    ok = ok && all_positive(positive.size(), positive.data()) && !all_positive(negative.size(), negative.data());
+
+    set_math_accuracy(tier);
+    std::cout << (ok ? "vmath ok" : "vmath FAILED") << "\n";
+    return ok ? 0 : 1;
+}